@@ -50,6 +50,25 @@ def main():
     pretty_data(results)
     print()
 
+    # decomp - n_qubits, pivot and m4ri elimination
+    results = []
+    curr_res = []
+    # n_qubits = 2^10 - 2^14
+    for qubit_exp in range(10, 14):
+        for m4ri in ("0", "1"):
+            time_total = 0
+
+            for i in range(0, n_iterations):
+                time_total += run_benchmark("decomp.out", str(2 ** qubit_exp), str(2 ** 12), seed, m4ri)
+
+            curr_res.append(("m4ri" if m4ri == "1" else "pivot", time_total / n_iterations))
+        results.append((2 ** qubit_exp, curr_res))
+        curr_res = []
+
+    print("-----===[ decomp m4ri ]===-----")
+    pretty_data(results)
+    print()
+
     # input_stream - n_qubits, n_gates
     results = []
     curr_res = []
@@ -70,6 +89,84 @@ def main():
     pretty_data(results)
     print()
 
+    # gate_block - n_qubits, n_gates, serial and tiled
+    results = []
+    curr_res = []
+    # n_qubits = 2^13 - 2^15
+    for qubit_exp in range(13, 16):
+        for tiled in ("0", "1"):
+            time_total = 0
+
+            for i in range(0, n_iterations):
+                time_total += run_benchmark("gate_block.out", str(2 ** qubit_exp), str(2 ** 14), seed, tiled)
+
+            curr_res.append(("tiled" if tiled == "1" else "serial", time_total / n_iterations))
+        results.append((2 ** qubit_exp, curr_res))
+        curr_res = []
+
+    print("-----===[ gate_block ]===-----")
+    pretty_data(results, align=6)
+    print()
+
+    # tableau_layout - n_qubits, planar and interleaved slices
+    results = []
+    curr_res = []
+    # n_qubits = 2^12 - 2^15
+    for qubit_exp in range(12, 16):
+        for interleaved in ("0", "1"):
+            time_total = 0
+
+            for i in range(0, n_iterations):
+                time_total += run_benchmark("tableau_layout.out", str(2 ** qubit_exp), str(2 ** 14), seed, interleaved)
+
+            curr_res.append(("interleaved" if interleaved == "1" else "planar", time_total / n_iterations))
+        results.append((2 ** qubit_exp, curr_res))
+        curr_res = []
+
+    print("-----===[ tableau_layout ]===-----")
+    pretty_data(results, align=11)
+    print()
+
+
+    # instruction_packed - n_qubits, fixed and packed instruction streams
+    results = []
+    curr_res = []
+    # n_qubits = 2^6 - 2^12
+    for qubit_exp in range(6, 13, 3):
+        for packed in ("0", "1"):
+            time_total = 0
+
+            for i in range(0, n_iterations):
+                time_total += run_benchmark("instruction_packed.out", str(2 ** qubit_exp), str(2 ** 22), seed, packed)
+
+            curr_res.append(("packed" if packed == "1" else "fixed", time_total / n_iterations))
+        results.append((2 ** qubit_exp, curr_res))
+        curr_res = []
+
+    print("-----===[ instruction_packed ]===-----")
+    pretty_data(results, align=6)
+    print()
+
+
+    # peephole - n_qubits, with and without the peephole pre-pass
+    results = []
+    curr_res = []
+    # n_qubits = 2^6 - 2^12
+    for qubit_exp in range(6, 13, 3):
+        for peephole in ("0", "1"):
+            time_total = 0
+
+            for i in range(0, n_iterations):
+                time_total += run_benchmark("peephole.out", str(2 ** qubit_exp), str(2 ** 22), seed, peephole)
+
+            curr_res.append(("peephole" if peephole == "1" else "direct", time_total / n_iterations))
+        results.append((2 ** qubit_exp, curr_res))
+        curr_res = []
+
+    print("-----===[ peephole ]===-----")
+    pretty_data(results, align=8)
+    print()
+
 
     # qft - n_qubits
     results = []
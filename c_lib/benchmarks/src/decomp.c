@@ -50,13 +50,20 @@ widget_t* widget_random_create(size_t n_qubits, size_t n_gates)
 
 
 
-void decomp_benchmark(const size_t n_qubits, const size_t n_gates)
+void decomp_benchmark(const size_t n_qubits, const size_t n_gates, const bool m4ri)
 {
     widget_t* wid = widget_random_create(n_qubits, n_gates);
 
     printf("Created\n");
 
-    widget_decompose(wid);    
+    if (m4ri)
+    {
+        widget_decompose_m4ri(wid);
+    }
+    else
+    {
+        widget_decompose(wid);    
+    }
 
     printf("Asserting\n");
 
@@ -75,17 +82,18 @@ int main(int argc, char** argv)
 {
     if (argc < 4)
     {
-        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed>\n");
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed> [m4ri]\n");
     return 0;
     }
 
     size_t tableau_size = atoi(argv[1]);
     size_t n_gates = atoi(argv[2]);
     uint32_t seed = atoi(argv[3]);
+    bool m4ri = (argc > 4) && atoi(argv[4]);
      
     srand(seed);
 
-    decomp_benchmark(tableau_size, n_gates);
+    decomp_benchmark(tableau_size, n_gates, m4ri);
 
     return 0;
 }
@@ -0,0 +1,73 @@
+#define INSTRUCTIONS_TABLE
+
+#include <stdlib.h>
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+/*
+ * create_two_qubit_stream
+ * Random stream of CNOT and CZ gates
+ */
+instruction_stream_u* create_two_qubit_stream(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));  
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        uint8_t opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+        size_t ctrl = rand() % n_qubits; 
+        size_t targ;
+
+        while ((targ = (rand() % n_qubits)) == ctrl){}; 
+
+        inst[i].multi.opcode = opcode;
+        inst[i].multi.ctrl = ctrl;
+        inst[i].multi.targ = targ;
+    }
+    return inst;
+}
+
+void gate_block_benchmark(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const bool tiled)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    instruction_stream_u* inst = create_two_qubit_stream(n_qubits, n_gates);
+
+    if (tiled)
+    {
+        parse_instruction_block_tiled(wid, inst, n_gates);
+    }
+    else
+    {
+        parse_instruction_block(wid, inst, n_gates);
+    }
+
+    widget_destroy(wid);
+    free(inst);
+    return;
+} 
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed> <tiled>\n");
+        return 0;
+    }
+
+    size_t tableau_size = atoi(argv[1]);
+    size_t n_gates = atoi(argv[2]);
+    uint32_t seed = atoi(argv[3]);
+    bool tiled = atoi(argv[4]);
+     
+    srand(seed);
+
+    gate_block_benchmark(tableau_size, n_gates, tiled);
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#define INSTRUCTIONS_TABLE
+
+#include <stdlib.h>
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "instruction_packed.h"
+
+/*
+ * create_instruction_stream
+ * Stream dominated by local Cliffords, with one two qubit gate in every four instructions
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = calloc(n_gates, sizeof(instruction_stream_u));
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        size_t ctrl = rand() % n_qubits;
+        if (3 == i % 4)
+        {
+            size_t targ;
+            while ((targ = (rand() % n_qubits)) == ctrl){};
+
+            inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].multi.ctrl = ctrl;
+            inst[i].multi.targ = targ;
+        }
+        else
+        {
+            inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].single.arg = ctrl;
+        }
+    }
+    return inst;
+}
+
+/*
+ * instruction_packed_benchmark
+ * Parses a stream in either encoding
+ * :: packed : const bool :: Parses the packed encoding of the stream
+ * The stream is encoded before parsing in both cases
+ */
+void instruction_packed_benchmark(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const bool packed)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates);
+    uint8_t* buf = malloc(instruction_packed_bound(n_gates));
+    const size_t n_bytes = instruction_pack(inst, n_gates, buf);
+
+    if (packed)
+    {
+        free(inst);
+        parse_instruction_block_packed(wid, buf, n_bytes);
+        free(buf);
+    }
+    else
+    {
+        free(buf);
+        parse_instruction_block(wid, inst, n_gates);
+        free(inst);
+    }
+
+    widget_destroy(wid);
+    return;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed> <packed>\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    size_t n_gates = atoi(argv[2]);
+    uint32_t seed = atoi(argv[3]);
+    bool packed = atoi(argv[4]);
+
+    srand(seed);
+
+    instruction_packed_benchmark(n_qubits, n_gates, packed);
+
+    return 0;
+}
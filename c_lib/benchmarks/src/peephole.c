@@ -0,0 +1,100 @@
+#define INSTRUCTIONS_TABLE
+
+#include <stdlib.h>
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "peephole.h"
+
+/*
+ * create_instruction_stream
+ * Random stream in which a third of the two qubit gates are followed by their inverse,
+ * and a third are conjugated by Hadamards on the target
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = calloc(n_gates, sizeof(instruction_stream_u));
+
+    size_t i = 0;
+    while (i < n_gates)
+    {
+        size_t ctrl = rand() % n_qubits;
+        size_t targ;
+        while ((targ = (rand() % n_qubits)) == ctrl){};
+
+        const size_t pattern = rand() % 3;
+        if ((1 == pattern) && (i + 1 < n_gates))
+        {
+            inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].multi.ctrl = ctrl;
+            inst[i].multi.targ = targ;
+            inst[i + 1] = inst[i];
+            i += 2;
+        }
+        else if ((2 == pattern) && (i + 2 < n_gates))
+        {
+            inst[i].single.opcode = _H_;
+            inst[i].single.arg = targ;
+            inst[i + 1].multi.opcode = _CNOT_;
+            inst[i + 1].multi.ctrl = ctrl;
+            inst[i + 1].multi.targ = targ;
+            inst[i + 2] = inst[i];
+            i += 3;
+        }
+        else
+        {
+            inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].single.arg = ctrl;
+            i += 1;
+        }
+    }
+    return inst;
+}
+
+/*
+ * peephole_benchmark
+ * Parses a stream with or without the peephole pre-pass
+ * :: peephole : const bool :: Optimises the stream as part of the parse
+ */
+void peephole_benchmark(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const bool peephole)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates);
+
+    if (peephole)
+    {
+        parse_instruction_block_peephole(wid, inst, n_gates, false);
+    }
+    else
+    {
+        parse_instruction_block(wid, inst, n_gates);
+    }
+
+    free(inst);
+    widget_destroy(wid);
+    return;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed> <peephole>\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    size_t n_gates = atoi(argv[2]);
+    uint32_t seed = atoi(argv[3]);
+    bool peephole = atoi(argv[4]);
+
+    srand(seed);
+
+    peephole_benchmark(n_qubits, n_gates, peephole);
+
+    return 0;
+}
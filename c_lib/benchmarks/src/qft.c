@@ -6,6 +6,7 @@
 #include "tableau_operations.h"
 #include "input_stream.h"
 #include "instructions.h"
+#include "threadpool.h"
 
 
 instruction_stream_u* create_instruction_stream_qft(const size_t n_qubits, size_t* n_gates_ret)
@@ -92,13 +93,20 @@ int main(int argc, char** argv)
 {
     if (argc < 2)
     {
-        printf("Insufficient parameters, requires <n_qubits>\n");
+        printf("Insufficient parameters, requires <n_qubits> [n_workers]\n");
 	return 0;
     }
 
     size_t tableau_size = atoi(argv[1]);
 
+    if (argc > 2)
+    {
+        threadpool_init(atoi(argv[2]));
+    }
+
     qft_benchmark(tableau_size);
 
+    threadpool_destroy();
+
     return 0;
 }
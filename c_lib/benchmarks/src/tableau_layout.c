@@ -0,0 +1,54 @@
+#include <stdlib.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "instruction_table.h"
+
+/*
+ * tableau_layout_benchmark
+ * Applies random local Cliffords and two qubit gates to a tableau
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: n_gates : const size_t :: Number of gates
+ * :: layout : const enum tableau_layout_e :: Placement of the slices
+ */
+void tableau_layout_benchmark(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const enum tableau_layout_e layout)
+{
+    tableau_t* tab = tableau_create_layout(n_qubits, layout);
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        size_t ctrl = rand() % n_qubits; 
+        size_t targ;
+
+        while ((targ = (rand() % n_qubits)) == ctrl){}; 
+
+        SINGLE_QUBIT_OPERATIONS[rand() % N_LOCAL_CLIFFORDS](tab, ctrl);
+        TWO_QUBIT_OPERATIONS[rand() % N_NON_LOCAL_CLIFFORDS](tab, ctrl, targ);
+    }
+
+    tableau_destroy(tab);
+    return;
+} 
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed> <interleaved>\n");
+        return 0;
+    }
+
+    size_t tableau_size = atoi(argv[1]);
+    size_t n_gates = atoi(argv[2]);
+    uint32_t seed = atoi(argv[3]);
+    bool interleaved = atoi(argv[4]);
+     
+    srand(seed);
+
+    tableau_layout_benchmark(tableau_size, n_gates, interleaved ? TABLEAU_LAYOUT_INTERLEAVED : TABLEAU_LAYOUT_PLANAR);
+
+    return 0;
+}
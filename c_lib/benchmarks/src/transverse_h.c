@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "tableau.h"
+#include "transverse_hadamard.h"
 
 
 /*
@@ -62,6 +63,17 @@ void benchmark_transposed_hadamard(size_t n_qubits)
     tableau_destroy(tab_cmp);
 }
 
+void benchmark_simd_transposed_hadamard(size_t n_qubits)
+{
+    tableau_t* tab = tableau_random_create(n_qubits); 
+
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        simd_tableau_transverse_hadamard(tab, i); 
+    }
+    tableau_destroy(tab);
+}
+
 int main(int argc, char** argv)
 {
     if (argc < 3)
@@ -76,6 +88,7 @@ int main(int argc, char** argv)
     srand(seed);
 
     benchmark_transposed_hadamard(tableau_size);
+    benchmark_simd_transposed_hadamard(tableau_size);
 
     return 0;
 }
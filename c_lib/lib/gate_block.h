@@ -0,0 +1,73 @@
+#ifndef GATE_BLOCK_H
+#define GATE_BLOCK_H
+
+#include "tableau.h"
+#include "tableau_fused_operations.h"
+
+// Number of gates buffered before the block is applied
+#ifndef GATE_BLOCK_SIZE
+#define GATE_BLOCK_SIZE (64)
+#endif
+
+// Bytes of each slice in a tile, all gates in the block are applied to a tile before moving to the next
+// Should be a multiple of CACHE_SIZE
+#ifndef GATE_BLOCK_TILE_BYTES
+#define GATE_BLOCK_TILE_BYTES (1024)
+#endif
+
+/*
+ * gate_block_op
+ * A buffered two qubit gate
+ * The kernel is a fused kernel that also applies the queued local Cliffords
+ */
+struct gate_block_op
+{
+    size_t ctrl;
+    size_t targ;
+    void (*kernel)(tableau_t*, const size_t, const size_t, const size_t, const size_t);
+};
+
+/*
+ * gate_block_t
+ * Block of buffered two qubit gates
+ * Applying a gate streams each of its slices through the cache, for large tableaus this is bandwidth bound
+ * Instead the block is applied one tile of rows at a time, so the tile of the phase slice and of 
+ * any slices shared between gates stays in cache for the whole block 
+ */
+struct gate_block_t
+{
+    size_t n_ops;
+    struct gate_block_op ops[GATE_BLOCK_SIZE];
+};
+typedef struct gate_block_t gate_block_t;
+
+/*
+ * gate_block_push
+ * Adds a gate to the block, applying the block if it is full
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: block : gate_block_t* :: Block of buffered gates
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ : const size_t :: Target qubit
+ * :: ctrl_clifford : const instruction_t :: Local Clifford queued on the control qubit 
+ * :: targ_clifford : const instruction_t :: Local Clifford queued on the target qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ */
+void gate_block_push(
+    tableau_t* tab,
+    gate_block_t* block,
+    const size_t ctrl,
+    const size_t targ,
+    const instruction_t ctrl_clifford,
+    const instruction_t targ_clifford,
+    const instruction_t opcode);
+
+/*
+ * gate_block_flush
+ * Applies all buffered gates to the tableau, one tile of rows at a time
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: block : gate_block_t* :: Block of buffered gates
+ * Empties the block 
+ */
+void gate_block_flush(tableau_t* tab, gate_block_t* block);
+
+#endif
@@ -4,8 +4,18 @@
 
 #include "instructions.h"
 #include "tableau_operations.h"
+#include "tableau_operations_par.h"
+#include "tableau_fused_operations.h"
+#include "gate_block.h"
+#include "threadpool.h"
 #include "conditional_operations.h"
 #include "widget.h"
+#include "instruction_packed.h"
+
+// Instructions decoded at a time when packed instructions are handed to the threadpool
+#ifndef INSTRUCTION_PACKED_DECODE_BLOCK
+#define INSTRUCTION_PACKED_DECODE_BLOCK (1024)
+#endif
 
 
 /*
@@ -14,13 +24,67 @@
  * :: wid : widget_t* :: Current widget 
  * :: instructions : instruction_stream_u* :: Array of instructions 
  * :: n_instructions : const size_t :: Number of instructions in the stream 
- * This implementation may be replaced with a thread pool dispatcher
+ * Large tableaus are split between the workers by rows, otherwise gates on disjoint qubits are run concurrently
  */
 void parse_instruction_block(
     widget_t* wid,
     instruction_stream_u* instructions,
     const size_t n_instructions);
 
+/*
+ * parse_instruction_block_packed
+ * Parses a block of packed instructions
+ * :: wid : widget_t* :: Current widget 
+ * :: stream : const uint8_t* :: Packed instructions, see instruction_packed.h 
+ * :: n_bytes : const size_t :: Length of the packed stream 
+ * Instructions are dispatched as they are decoded, 
+ * with threadpool workers available they are decoded a block at a time and passed to parse_instruction_block 
+ * Returns the number of instructions parsed
+ */
+size_t parse_instruction_block_packed(
+    widget_t* wid,
+    const uint8_t* stream,
+    const size_t n_bytes);
+
+/*
+ * parse_instruction_block_par
+ * Parses a block of instructions, distributing tableau operations over the threadpool 
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * Each worker operates on a fixed range of rows, blocks until all workers have completed
+ */
+void parse_instruction_block_par(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions);
+
+/*
+ * parse_instruction_block_batch
+ * Parses a block of instructions, running gates on disjoint qubits concurrently
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * Consecutive gates are batched until a gate shares a qubit with the batch
+ * Local Cliffords and conditional operations do not touch the tableau and never close a batch
+ */
+void parse_instruction_block_batch(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions);
+
+/*
+ * parse_instruction_block_tiled
+ * Parses a block of instructions, buffering two qubit gates and applying them one tile of rows at a time
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * Intended for large tableaus, where the serial parser is bound by memory bandwidth 
+ */
+void parse_instruction_block_tiled(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions);
 
 /*
  * apply_local_cliffords
@@ -30,6 +94,22 @@ void parse_instruction_block(
  */
 void apply_local_cliffords(widget_t* wid);
 
+/*
+ * apply_local_cliffords_par
+ * Empties the local clifford table and distributes the local cliffords over the threadpool
+ * :: wid : widget_t* :: The widget
+ * Acts in place over the tableau and the clifford table
+ */
+void apply_local_cliffords_par(widget_t* wid);
+
+/*
+ * apply_local_cliffords_batch
+ * Empties the local clifford table, the local cliffords are split between the workers
+ * :: wid : widget_t* :: The widget
+ * Acts in place over the tableau and the clifford table
+ */
+void apply_local_cliffords_batch(widget_t* wid);
+
 /*
  * teleport_input
  * Sets the widget up to accept teleported inputs
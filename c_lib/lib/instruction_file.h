@@ -0,0 +1,216 @@
+#ifndef INSTRUCTION_FILE_H
+#define INSTRUCTION_FILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "instruction_table.h"
+#include "instruction_packed.h"
+#include "widget.h"
+
+#define INSTRUCTION_FILE_MAGIC ("CABINST")
+#define INSTRUCTION_FILE_VERSION (1)
+
+// Instructions are stored immediately after the header
+#define INSTRUCTION_FILE_HEADER_BYTES (64)
+
+// Number of instructions parsed between releasing the pages that have been read
+#ifndef INSTRUCTION_FILE_CHUNK
+#define INSTRUCTION_FILE_CHUNK (1 << 16)
+#endif
+
+/*
+ * instruction_file_encoding_e
+ * Encoding of the instructions following the header
+ * INSTRUCTION_FILE_FIXED : An array of instruction_stream_u in native byte order
+ * INSTRUCTION_FILE_PACKED : Variable length instructions, see instruction_packed.h
+ */
+enum instruction_file_encoding_e
+{
+    INSTRUCTION_FILE_FIXED = 0,
+    INSTRUCTION_FILE_PACKED = 1
+};
+
+/*
+ * instruction_file_header_t
+ * Header of a binary instruction stream
+ */
+struct instruction_file_header_t
+{
+    char magic[8]; // INSTRUCTION_FILE_MAGIC, null terminated
+    uint32_t version;
+    uint32_t instruction_bytes; // sizeof(instruction_stream_u) of the writer
+    uint64_t n_instructions;
+    uint64_t n_qubits; // One more than the largest qubit index in the stream
+    uint64_t n_rz; // Number of Rz gates in the stream
+    uint32_t encoding; // instruction_file_encoding_e
+    uint32_t padding;
+    uint64_t n_bytes; // Length of the encoded instructions
+    uint8_t reserved[INSTRUCTION_FILE_HEADER_BYTES - 56];
+};
+typedef struct instruction_file_header_t instruction_file_header_t;
+
+/*
+ * instruction_file_t
+ * Read only mapping of a binary instruction stream
+ */
+struct instruction_file_t
+{
+    void* map;
+    size_t map_bytes;
+    const instruction_file_header_t* header;
+    uint8_t* data; // Encoded instructions, points into the mapping
+    size_t cursor_instruction; // Packed streams only, the next instruction to parse
+    size_t cursor_byte; // Packed streams only, the offset of cursor_instruction
+};
+typedef struct instruction_file_t instruction_file_t;
+
+/*
+ * instruction_file_writer_t
+ * Appends instructions to a binary instruction stream
+ * The header is written when the writer is closed
+ */
+struct instruction_file_writer_t
+{
+    FILE* fp;
+    instruction_file_header_t header;
+    uint8_t* buf; // Packed streams only, encoding buffer
+    size_t buf_bytes;
+};
+typedef struct instruction_file_writer_t instruction_file_writer_t;
+
+/*
+ * instruction_file_writer_open
+ * Creates a binary instruction stream
+ * :: path : const char* :: Path of the file, any existing file is replaced
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the instructions
+ * Returns NULL if the file could not be created
+ */
+instruction_file_writer_t* instruction_file_writer_open(
+    const char* path,
+    const enum instruction_file_encoding_e encoding);
+
+/*
+ * instruction_file_writer_append
+ * Appends instructions to the stream
+ * :: writer : instruction_file_writer_t* :: Writer
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions to append
+ * Returns false if the instructions could not be written
+ */
+bool instruction_file_writer_append(
+    instruction_file_writer_t* writer,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions);
+
+/*
+ * instruction_file_writer_close
+ * Writes the header and closes the stream
+ * :: writer : instruction_file_writer_t* :: Writer, freed by this call
+ * Returns false if the header could not be written
+ */
+bool instruction_file_writer_close(instruction_file_writer_t* writer);
+
+/*
+ * instruction_file_write
+ * Writes an array of instructions as a binary instruction stream
+ * :: path : const char* :: Path of the file, any existing file is replaced
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the instructions
+ * Returns false if the file could not be written
+ */
+bool instruction_file_write(
+    const char* path,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const enum instruction_file_encoding_e encoding);
+
+/*
+ * instruction_file_open
+ * Maps a binary instruction stream
+ * :: path : const char* :: Path of the file
+ * Returns NULL if the file could not be mapped, is not a stream written by this version,
+ * or is a packed stream that does not decode to the number of instructions in its header
+ */
+instruction_file_t* instruction_file_open(const char* path);
+
+/*
+ * instruction_file_close
+ * Unmaps a binary instruction stream
+ * :: file : instruction_file_t* :: File, freed by this call
+ */
+void instruction_file_close(instruction_file_t* file);
+
+/*
+ * instruction_file_get_n_instructions
+ * :: file : const instruction_file_t* :: File
+ * Returns the number of instructions in the stream
+ */
+size_t instruction_file_get_n_instructions(const instruction_file_t* file);
+
+/*
+ * instruction_file_get_n_qubits
+ * :: file : const instruction_file_t* :: File
+ * Returns one more than the largest qubit index in the stream
+ */
+size_t instruction_file_get_n_qubits(const instruction_file_t* file);
+
+/*
+ * instruction_file_get_n_rz
+ * :: file : const instruction_file_t* :: File
+ * Returns the number of Rz gates in the stream
+ */
+size_t instruction_file_get_n_rz(const instruction_file_t* file);
+
+/*
+ * instruction_file_get_encoding
+ * :: file : const instruction_file_t* :: File
+ * Returns the encoding of the stream
+ */
+enum instruction_file_encoding_e instruction_file_get_encoding(const instruction_file_t* file);
+
+/*
+ * instruction_file_get_n_bytes
+ * :: file : const instruction_file_t* :: File
+ * Returns the length of the encoded instructions
+ */
+size_t instruction_file_get_n_bytes(const instruction_file_t* file);
+
+/*
+ * instruction_file_get_data
+ * :: file : const instruction_file_t* :: File
+ * Returns the encoded instructions, valid until the file is closed
+ */
+const uint8_t* instruction_file_get_data(const instruction_file_t* file);
+
+/*
+ * instruction_file_get_instructions
+ * :: file : const instruction_file_t* :: File
+ * Returns the mapped instructions, valid until the file is closed
+ * The mapping is read only, instructions must be copied before they are modified
+ * Returns NULL for packed streams
+ */
+const instruction_stream_u* instruction_file_get_instructions(const instruction_file_t* file);
+
+/*
+ * instruction_file_parse
+ * Parses a range of a mapped stream into a widget
+ * :: wid : widget_t* :: Widget
+ * :: file : instruction_file_t* :: File
+ * :: start : const size_t :: First instruction to parse
+ * :: n_instructions : const size_t :: Number of instructions to parse
+ * Parses INSTRUCTION_FILE_CHUNK instructions at a time, releasing the pages behind each chunk
+ * Packed streams are fastest to parse front to back, other ranges are found by scanning from the start
+ * Packed streams keep a cursor in the file, so a packed file must not be parsed by several threads at once
+ * Returns false if a packed range could not be decoded, instructions before the failure have been parsed
+ */
+bool instruction_file_parse(
+    widget_t* wid,
+    instruction_file_t* file,
+    const size_t start,
+    const size_t n_instructions);
+
+#endif
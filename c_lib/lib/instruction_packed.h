@@ -0,0 +1,197 @@
+#ifndef INSTRUCTION_PACKED_H
+#define INSTRUCTION_PACKED_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "instruction_table.h"
+
+/*
+ * Packed instruction encoding
+ * Each instruction is a one byte opcode followed by its operands as LEB128 varints
+ * Local Cliffords carry one operand, all other instructions carry two
+ * Qubit indices below 128 take a single byte, so most single qubit gates pack into two bytes
+ * Operands are read and written through the two_qubit_instruction member,
+ * every member of instruction_stream_u places its operands at the same offsets
+ */
+
+// An opcode and two five byte varints
+#define INSTRUCTION_PACKED_MAX_BYTES (11)
+
+// Number of operands for each instruction type, instruction types without a handler carry none
+static const uint8_t INSTRUCTION_PACKED_OPERANDS[8] = {0, 1, 2, 2, 2, 0, 2, 0};
+
+/*
+ * instruction_packed_bound
+ * Returns the largest number of bytes that n_instructions instructions may pack into
+ * :: n_instructions : const size_t :: Number of instructions
+ */
+static inline
+size_t instruction_packed_bound(const size_t n_instructions)
+{
+    return n_instructions * INSTRUCTION_PACKED_MAX_BYTES;
+}
+
+/*
+ * __inline_instruction_pack_varint
+ * Writes a LEB128 varint
+ * :: value : uint32_t :: Value to write
+ * :: buf : uint8_t* :: Output buffer
+ * Returns the number of bytes written
+ */
+static inline
+size_t __inline_instruction_pack_varint(uint32_t value, uint8_t* buf)
+{
+    size_t n_bytes = 0;
+    while (value >= 0x80)
+    {
+        buf[n_bytes++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buf[n_bytes++] = (uint8_t)value;
+    return n_bytes;
+}
+
+/*
+ * __inline_instruction_unpack_varint
+ * Reads a LEB128 varint
+ * :: buf : const uint8_t* :: Input buffer
+ * :: end : const uint8_t* :: End of the input buffer
+ * :: value : uint32_t* :: Set to the decoded value
+ * Returns the number of bytes read, zero if the varint runs past the end of the buffer
+ */
+static inline
+size_t __inline_instruction_unpack_varint(const uint8_t* buf, const uint8_t* end, uint32_t* value)
+{
+    // Single byte fast path, covers qubit indices below 128
+    if ((buf < end) && (buf[0] < 0x80))
+    {
+        *value = buf[0];
+        return 1;
+    }
+
+    // Two byte path, covers qubit indices below 16384
+    if ((buf + 1 < end) && (buf[1] < 0x80))
+    {
+        *value = (uint32_t)(buf[0] & 0x7f) | ((uint32_t)buf[1] << 7);
+        return 2;
+    }
+
+    uint32_t acc = 0;
+    for (size_t i = 0; (i < 5) && (buf + i < end); i++)
+    {
+        acc |= (uint32_t)(buf[i] & 0x7f) << (7 * i);
+        if (buf[i] < 0x80)
+        {
+            *value = acc;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * __inline_instruction_unpack
+ * Decodes a single packed instruction
+ * :: buf : const uint8_t* :: Packed instruction
+ * :: end : const uint8_t* :: End of the packed stream
+ * :: inst : instruction_stream_u* :: Set to the decoded instruction
+ * Returns the number of bytes read, zero if the instruction runs past the end of the stream
+ */
+static inline
+size_t __inline_instruction_unpack(const uint8_t* buf, const uint8_t* end, instruction_stream_u* inst)
+{
+    if (buf >= end)
+    {
+        return 0;
+    }
+
+    const uint8_t n_operands = INSTRUCTION_PACKED_OPERANDS[INSTRUCTION_TYPE(buf[0])];
+    inst->multi.opcode = buf[0];
+    inst->multi.ctrl = 0;
+    inst->multi.targ = 0;
+
+    // Fast path, every operand fits in a single byte
+    if (buf + 1 + n_operands <= end)
+    {
+        if ((1 == n_operands) && (buf[1] < 0x80))
+        {
+            inst->multi.ctrl = buf[1];
+            return 2;
+        }
+        if ((2 == n_operands) && ((buf[1] | buf[2]) < 0x80))
+        {
+            inst->multi.ctrl = buf[1];
+            inst->multi.targ = buf[2];
+            return 3;
+        }
+    }
+
+    size_t n_bytes = 1;
+    if (n_operands > 0)
+    {
+        const size_t n_read = __inline_instruction_unpack_varint(buf + n_bytes, end, &inst->multi.ctrl);
+        if (0 == n_read)
+        {
+            return 0;
+        }
+        n_bytes += n_read;
+    }
+    if (n_operands > 1)
+    {
+        const size_t n_read = __inline_instruction_unpack_varint(buf + n_bytes, end, &inst->multi.targ);
+        if (0 == n_read)
+        {
+            return 0;
+        }
+        n_bytes += n_read;
+    }
+    return n_bytes;
+}
+
+/*
+ * instruction_pack
+ * Packs an array of instructions
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: buf : uint8_t* :: Output buffer of at least instruction_packed_bound(n_instructions) bytes
+ * Returns the number of bytes written
+ */
+size_t instruction_pack(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    uint8_t* buf);
+
+/*
+ * instruction_unpack
+ * Unpacks a packed stream
+ * :: buf : const uint8_t* :: Packed stream
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: instructions : instruction_stream_u* :: Output array
+ * :: max_instructions : const size_t :: Length of the output array
+ * :: n_read : size_t* :: Optional, set to the number of bytes consumed
+ * Stops when the output array is full or the stream is exhausted
+ * Returns the number of instructions written
+ */
+size_t instruction_unpack(
+    const uint8_t* buf,
+    const size_t n_bytes,
+    instruction_stream_u* instructions,
+    const size_t max_instructions,
+    size_t* n_read);
+
+/*
+ * instruction_packed_skip
+ * Finds the offset of an instruction in a packed stream
+ * :: buf : const uint8_t* :: Packed stream
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: n_instructions : const size_t :: Number of instructions to skip
+ * Returns the offset in bytes, or n_bytes if the stream holds fewer instructions
+ */
+size_t instruction_packed_skip(
+    const uint8_t* buf,
+    const size_t n_bytes,
+    const size_t n_instructions);
+
+#endif
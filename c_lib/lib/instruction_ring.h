@@ -0,0 +1,169 @@
+#ifndef INSTRUCTION_RING_H
+#define INSTRUCTION_RING_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "consts.h"
+#include "instruction_table.h"
+#include "instruction_file.h"
+#include "widget.h"
+
+/*
+ * Instruction ring
+ * Lock free single producer, single consumer queue of instructions
+ * A producer thread pushes instructions while the widget thread parses them from the ring in place
+ * Memory use is bounded by the capacity of the ring rather than the length of the circuit
+ */
+
+// Default capacity of a ring, in instructions
+#ifndef INSTRUCTION_RING_CAPACITY
+#define INSTRUCTION_RING_CAPACITY (1 << 16)
+#endif
+
+// Number of polls of a full or empty ring before yielding the core
+#ifndef INSTRUCTION_RING_SPIN
+#define INSTRUCTION_RING_SPIN (64)
+#endif
+
+// Bytes requested by each read of a ring reader
+#ifndef INSTRUCTION_RING_READ_BYTES
+#define INSTRUCTION_RING_READ_BYTES (1 << 16)
+#endif
+
+/*
+ * instruction_ring_t
+ * The producer owns head and the consumer owns tail, each on its own cache line
+ * Both indices increase monotonically and are masked on access
+ */
+struct instruction_ring_t
+{
+    instruction_stream_u* buf;
+    size_t capacity; // Power of two
+    size_t mask;
+    size_t head __attribute__((aligned(CACHE_SIZE))); // Next slot to write
+    bool closed; // Set by the producer after its final push
+    size_t tail __attribute__((aligned(CACHE_SIZE))); // Next slot to read
+};
+typedef struct instruction_ring_t instruction_ring_t;
+
+/*
+ * instruction_ring_reader_t
+ * Producer thread that fills a ring from a file descriptor
+ */
+struct instruction_ring_reader_t
+{
+    instruction_ring_t* ring;
+    int fd;
+    enum instruction_file_encoding_e encoding;
+    bool success;
+    pthread_t thread;
+};
+typedef struct instruction_ring_reader_t instruction_ring_reader_t;
+
+/*
+ * instruction_ring_create
+ * Allocates a ring
+ * :: capacity : const size_t :: Minimum number of instructions held by the ring, rounded up to a power of two
+ */
+instruction_ring_t* instruction_ring_create(const size_t capacity);
+
+/*
+ * instruction_ring_destroy
+ * Frees a ring
+ * :: ring : instruction_ring_t* :: Ring, neither end may be in use
+ */
+void instruction_ring_destroy(instruction_ring_t* ring);
+
+/*
+ * instruction_ring_get_capacity
+ * :: ring : const instruction_ring_t* :: Ring
+ * Returns the number of instructions held by the ring
+ */
+size_t instruction_ring_get_capacity(const instruction_ring_t* ring);
+
+/*
+ * instruction_ring_try_push
+ * Pushes as many instructions as there is space for without waiting
+ * :: ring : instruction_ring_t* :: Ring
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions to push
+ * Producer only
+ * Returns the number of instructions pushed
+ */
+size_t instruction_ring_try_push(
+    instruction_ring_t* ring,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions);
+
+/*
+ * instruction_ring_push
+ * Pushes instructions, waiting for the consumer to free space as needed
+ * :: ring : instruction_ring_t* :: Ring
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions to push
+ * Producer only
+ */
+void instruction_ring_push(
+    instruction_ring_t* ring,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions);
+
+/*
+ * instruction_ring_close
+ * Marks the end of the stream
+ * :: ring : instruction_ring_t* :: Ring
+ * Producer only, no instructions may be pushed after the ring is closed
+ */
+void instruction_ring_close(instruction_ring_t* ring);
+
+/*
+ * instruction_ring_try_pop
+ * Copies out as many instructions as are available without waiting
+ * :: ring : instruction_ring_t* :: Ring
+ * :: instructions : instruction_stream_u* :: Output array
+ * :: max_instructions : const size_t :: Length of the output array
+ * Consumer only
+ * Returns the number of instructions copied
+ */
+size_t instruction_ring_try_pop(
+    instruction_ring_t* ring,
+    instruction_stream_u* instructions,
+    const size_t max_instructions);
+
+/*
+ * parse_instruction_ring
+ * Parses instructions from a ring until it is closed and drained
+ * :: wid : widget_t* :: Widget
+ * :: ring : instruction_ring_t* :: Ring
+ * Instructions are parsed in place, each contiguous run in the ring is passed to parse_instruction_block
+ * Consumer only
+ * Returns the number of instructions parsed
+ */
+size_t parse_instruction_ring(widget_t* wid, instruction_ring_t* ring);
+
+/*
+ * instruction_ring_reader_start
+ * Starts a producer thread that reads a raw instruction stream from a file descriptor into a ring
+ * :: ring : instruction_ring_t* :: Ring, closed by the reader at the end of the stream
+ * :: fd : const int :: File descriptor of a file or pipe, read until end of file and not closed
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the stream
+ * The stream carries no header, instruction files may be streamed by first seeking past INSTRUCTION_FILE_HEADER_BYTES
+ * Returns NULL if the thread could not be started
+ */
+instruction_ring_reader_t* instruction_ring_reader_start(
+    instruction_ring_t* ring,
+    const int fd,
+    const enum instruction_file_encoding_e encoding);
+
+/*
+ * instruction_ring_reader_join
+ * Waits for a reader to reach the end of its stream
+ * :: reader : instruction_ring_reader_t* :: Reader, freed by this call
+ * Returns false if the stream could not be read or ended part way through an instruction
+ */
+bool instruction_ring_reader_join(instruction_ring_reader_t* reader);
+
+#endif
@@ -10,6 +10,9 @@
 
 #define MEASUREMENT_CONDITIONED_MASK ((uint8_t)((1 << 6) | (1 << 7)))    
 
+// Relabels qubits through the qubit map, without touching the tableau
+#define QUBIT_PERMUTATION_MASK ((uint8_t)((1 << 5) | (1 << 6)))
+
 #define N_LOCAL_CLIFFORDS 24 
 #define N_NON_LOCAL_CLIFFORDS 2 
 
@@ -52,8 +55,11 @@
 #define _CZ_ (0x01 | NON_LOCAL_CLIFFORD_MASK) 
 #define _RZ_ (RZ_MASK)
 
+#define _SWAP_ (0x00 | QUBIT_PERMUTATION_MASK)
+
 #define _NOP_ (0xff) 
 
+#define _MEAS_ (0x00 | MEASUREMENT_CONDITIONED_MASK)
 #define _MCX_ (0x01 | MEASUREMENT_CONDITIONED_MASK)
 #define _MCY_ (0x02 | MEASUREMENT_CONDITIONED_MASK)
 #define _MCZ_ (0x03 | MEASUREMENT_CONDITIONED_MASK)
@@ -71,14 +71,36 @@ void clifford_queue_destroy(clifford_queue_t* que);
 #ifdef INSTRUCTIONS_SRC
 
 
-const instruction_t SINGLE_QUBIT_CLIFFORD_MAP[168] = {
+/*
+ * SINGLE_QUBIT_CLIFFORD_MAP
+ * Entry left * N_LOCAL_CLIFFORDS + right is the local Clifford left applied after right
+ * Every local Clifford may be applied, stream instructions include the composite Cliffords
+ */
+const instruction_t SINGLE_QUBIT_CLIFFORD_MAP[N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS] = {
     /* I */ _I_, _X_, _Y_, _Z_, _H_, _S_, _R_, _HX_, _SX_, _RX_, _HY_, _HZ_, _SH_, _RH_, _HS_, _HR_, _HSX_, _HRX_, _SHY_, _RHY_, _HSH_, _HRH_, _RHS_, _SHR_,
     /* X */ _X_, _I_, _Z_, _Y_, _HZ_, _RX_, _SX_, _HY_, _R_, _S_, _HX_, _H_, _SHY_, _RHY_, _HR_, _HS_, _HRX_, _HSX_, _SH_, _RH_, _HRH_, _HSH_, _SHR_, _RHS_,
     /* Y */ _Y_, _Z_, _I_, _X_, _HY_, _SX_, _RX_, _HZ_, _S_, _R_, _H_, _HX_, _RHY_, _SHY_, _HSX_, _HRX_, _HS_, _HR_, _RH_, _SH_, _RHS_, _SHR_, _HSH_, _HRH_,
     /* Z */ _Z_, _Y_, _X_, _I_, _HX_, _R_, _S_, _H_, _RX_, _SX_, _HZ_, _HY_, _RH_, _SH_, _HRX_, _HSX_, _HR_, _HS_, _RHY_, _SHY_, _SHR_, _RHS_, _HRH_, _HSH_,
     /* H */ _H_, _HX_, _HY_, _HZ_, _I_, _HS_, _HR_, _X_, _HSX_, _HRX_, _Y_, _Z_, _HSH_, _HRH_, _S_, _R_, _SX_, _RX_, _SHR_, _RHS_, _SH_, _RH_, _RHY_, _SHY_,
     /* S */ _S_, _SX_, _RX_, _R_, _SH_, _Z_, _I_, _RH_, _Y_, _X_, _SHY_, _RHY_, _HX_, _H_, _HRH_, _SHR_, _HSH_, _RHS_, _HZ_, _HY_, _HR_, _HRX_, _HS_, _HSX_,
-    /* R */ _R_, _RX_, _SX_, _S_, _RH_, _I_, _Z_, _SH_, _X_, _Y_, _RHY_, _SHY_, _H_, _HX_, _RHS_, _HSH_, _SHR_, _HRH_, _HY_, _HZ_, _HSX_, _HS_, _HRX_, _HR_
+    /* R */ _R_, _RX_, _SX_, _S_, _RH_, _I_, _Z_, _SH_, _X_, _Y_, _RHY_, _SHY_, _H_, _HX_, _RHS_, _HSH_, _SHR_, _HRH_, _HY_, _HZ_, _HSX_, _HS_, _HRX_, _HR_,
+    /* HX */ _HX_, _H_, _HZ_, _HY_, _Z_, _HRX_, _HSX_, _Y_, _HR_, _HS_, _X_, _I_, _SHR_, _RHS_, _R_, _S_, _RX_, _SX_, _HSH_, _HRH_, _RH_, _SH_, _SHY_, _RHY_,
+    /* SX */ _SX_, _S_, _R_, _RX_, _RHY_, _X_, _Y_, _SHY_, _I_, _Z_, _RH_, _SH_, _HZ_, _HY_, _SHR_, _HRH_, _RHS_, _HSH_, _HX_, _H_, _HRX_, _HR_, _HSX_, _HS_,
+    /* RX */ _RX_, _R_, _S_, _SX_, _SHY_, _Y_, _X_, _RHY_, _Z_, _I_, _SH_, _RH_, _HY_, _HZ_, _HSH_, _RHS_, _HRH_, _SHR_, _H_, _HX_, _HS_, _HSX_, _HR_, _HRX_,
+    /* HY */ _HY_, _HZ_, _H_, _HX_, _Y_, _HSX_, _HRX_, _Z_, _HS_, _HR_, _I_, _X_, _RHS_, _SHR_, _SX_, _RX_, _S_, _R_, _HRH_, _HSH_, _RHY_, _SHY_, _SH_, _RH_,
+    /* HZ */ _HZ_, _HY_, _HX_, _H_, _X_, _HR_, _HS_, _I_, _HRX_, _HSX_, _Z_, _Y_, _HRH_, _HSH_, _RX_, _SX_, _R_, _S_, _RHS_, _SHR_, _SHY_, _RHY_, _RH_, _SH_,
+    /* SH */ _SH_, _RH_, _SHY_, _RHY_, _S_, _HRH_, _SHR_, _SX_, _HSH_, _RHS_, _RX_, _R_, _HR_, _HRX_, _Z_, _I_, _Y_, _X_, _HSX_, _HS_, _HX_, _H_, _HY_, _HZ_,
+    /* RH */ _RH_, _SH_, _RHY_, _SHY_, _R_, _RHS_, _HSH_, _RX_, _SHR_, _HRH_, _SX_, _S_, _HSX_, _HS_, _I_, _Z_, _X_, _Y_, _HR_, _HRX_, _H_, _HX_, _HZ_, _HY_,
+    /* HS */ _HS_, _HSX_, _HRX_, _HR_, _HSH_, _HZ_, _H_, _HRH_, _HY_, _HX_, _SHR_, _RHS_, _X_, _I_, _RH_, _SHY_, _SH_, _RHY_, _Z_, _Y_, _R_, _RX_, _S_, _SX_,
+    /* HR */ _HR_, _HRX_, _HSX_, _HS_, _HRH_, _H_, _HZ_, _HSH_, _HX_, _HY_, _RHS_, _SHR_, _I_, _X_, _RHY_, _SH_, _SHY_, _RH_, _Y_, _Z_, _SX_, _S_, _RX_, _R_,
+    /* HSX */ _HSX_, _HS_, _HR_, _HRX_, _RHS_, _HX_, _HY_, _SHR_, _H_, _HZ_, _HRH_, _HSH_, _Z_, _Y_, _SHY_, _RH_, _RHY_, _SH_, _X_, _I_, _RX_, _R_, _SX_, _S_,
+    /* HRX */ _HRX_, _HR_, _HS_, _HSX_, _SHR_, _HY_, _HX_, _RHS_, _HZ_, _H_, _HSH_, _HRH_, _Y_, _Z_, _SH_, _RHY_, _RH_, _SHY_, _I_, _X_, _S_, _SX_, _R_, _RX_,
+    /* SHY */ _SHY_, _RHY_, _SH_, _RH_, _RX_, _HSH_, _RHS_, _R_, _HRH_, _SHR_, _S_, _SX_, _HS_, _HSX_, _Y_, _X_, _Z_, _I_, _HRX_, _HR_, _HY_, _HZ_, _HX_, _H_,
+    /* RHY */ _RHY_, _SHY_, _RH_, _SH_, _SX_, _SHR_, _HRH_, _S_, _RHS_, _HSH_, _R_, _RX_, _HRX_, _HR_, _X_, _Y_, _I_, _Z_, _HS_, _HSX_, _HZ_, _HY_, _H_, _HX_,
+    /* HSH */ _HSH_, _HRH_, _SHR_, _RHS_, _HS_, _RH_, _SHY_, _HSX_, _SH_, _RHY_, _HRX_, _HR_, _R_, _RX_, _HZ_, _H_, _HY_, _HX_, _SX_, _S_, _X_, _I_, _Y_, _Z_,
+    /* HRH */ _HRH_, _HSH_, _RHS_, _SHR_, _HR_, _RHY_, _SH_, _HRX_, _SHY_, _RH_, _HSX_, _HS_, _SX_, _S_, _H_, _HZ_, _HX_, _HY_, _R_, _RX_, _I_, _X_, _Z_, _Y_,
+    /* RHS */ _RHS_, _SHR_, _HRH_, _HSH_, _HSX_, _SHY_, _RH_, _HS_, _RHY_, _SH_, _HR_, _HRX_, _RX_, _R_, _HX_, _HY_, _H_, _HZ_, _S_, _SX_, _Z_, _Y_, _I_, _X_,
+    /* SHR */ _SHR_, _RHS_, _HSH_, _HRH_, _HRX_, _SH_, _RHY_, _HR_, _RH_, _SHY_, _HS_, _HSX_, _S_, _SX_, _HY_, _HX_, _HZ_, _H_, _RX_, _R_, _Y_, _Z_, _X_, _I_
 };
 
 
@@ -134,7 +156,7 @@ void __inline_clifford_queue_local_clifford_left(clifford_queue_t* que, instruct
 
 #else
 
-extern const instruction_t SINGLE_QUBIT_CLIFFORD_MAP[168]; 
+extern const instruction_t SINGLE_QUBIT_CLIFFORD_MAP[N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS]; 
 extern const instruction_t SINGLE_QUBIT_CLIFFORD_MAP_RIGHT[168]; 
 extern const instruction_t CNOT_MAP_TARG_CTRL[N_LOCAL_CLIFFORDS];
 
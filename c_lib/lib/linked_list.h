@@ -6,8 +6,12 @@
 
 #include <string.h>
 
-#define NODE_TO_OBJ(node) (node + sizeof(list_node_t))
-
+/*
+ * linked_list_t
+ * Singly linked FIFO queue of opaque objects
+ * Objects are pushed to the tail and popped from the head
+ * Popped nodes are retained on a reuse stack, this cuts down on reallocations
+ */
 struct linked_list_t
 {
     size_t n_elements;
@@ -19,17 +23,39 @@ struct linked_list_t
 
 struct list_node_t
 {
-    struct list_node_t* prev; 
+    struct list_node_t* next; // Next node towards the tail 
     void* obj;
 };
 
-
+/*
+ * linked_list_create
+ * Constructor for a linked list
+ * Returns a heap allocated empty list
+ */
 struct linked_list_t* linked_list_create();
-void linked_list_destroy(struct linked_list_t* ll);
-void linked_list_push(struct linked_list_t* ll, void* obj);
-void* linked_list_pop(struct linked_list_t* ll);
 
+/*
+ * linked_list_destroy
+ * Destructor for a linked list
+ * :: ll : struct linked_list_t* :: List to free
+ * Frees all nodes, objects held by the list are not freed
+ */
+void linked_list_destroy(struct linked_list_t* ll);
 
+/*
+ * linked_list_push
+ * Pushes an object to the tail of the list
+ * :: ll : struct linked_list_t* :: The list
+ * :: obj : void* :: Object to push
+ */
+void linked_list_push(struct linked_list_t* ll, void* obj);
 
+/*
+ * linked_list_pop
+ * Pops an object from the head of the list
+ * :: ll : struct linked_list_t* :: The list
+ * Returns NULL if the list is empty
+ */
+void* linked_list_pop(struct linked_list_t* ll);
 
 #endif
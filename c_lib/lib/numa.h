@@ -0,0 +1,67 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Returned when a worker cannot be assigned its own CPU
+#define NUMA_NO_CPU (~(0ull))
+
+// Largest number of nodes tracked, nodes past this are treated as node zero
+#ifndef NUMA_MAX_NODES
+#define NUMA_MAX_NODES (64)
+#endif
+
+/*
+ * numa_topology_t
+ * CPUs the process may run on, ordered by NUMA node
+ * Read from sysfs on first use, without sysfs every CPU is on node zero
+ */
+struct numa_topology_t
+{
+    size_t n_nodes; // Number of online nodes
+    size_t n_cpus; // Number of CPUs the process may run on
+    size_t* cpus; // CPU ids, grouped by node
+    size_t* nodes; // Node of each entry in cpus
+};
+
+/*
+ * numa_n_nodes
+ * Returns the number of online NUMA nodes, one on systems without NUMA
+ */
+size_t numa_n_nodes();
+
+/*
+ * numa_worker_cpu
+ * Assigns a CPU to a worker
+ * :: worker : const size_t :: Worker index
+ * :: n_workers : const size_t :: Number of workers
+ * :: node : size_t* :: Set to the node of the CPU
+ * Workers are spread evenly over the node ordered CPUs,
+ * so consecutive workers share a node
+ * Returns NUMA_NO_CPU if there are more workers than CPUs
+ */
+size_t numa_worker_cpu(const size_t worker, const size_t n_workers, size_t* node);
+
+/*
+ * numa_pin_thread
+ * Pins a thread to a single CPU
+ * :: thread : pthread_t :: Thread to pin
+ * :: cpu : const size_t :: CPU id
+ * Returns false if the thread could not be pinned
+ */
+bool numa_pin_thread(pthread_t thread, const size_t cpu);
+
+/*
+ * numa_interleave
+ * Interleaves the pages of a mapping over all online nodes
+ * :: addr : void* :: Page aligned start of the mapping
+ * :: n_bytes : const size_t :: Length of the mapping
+ * Only applies to pages that have not yet been touched
+ * Advisory only, returns false if the policy was not applied
+ */
+bool numa_interleave(void* addr, const size_t n_bytes);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "instruction_table.h"
+#include "widget.h"
+
+/*
+ * Peephole optimisation
+ * Optional pre-pass that rewrites a block of instructions in place before it reaches the widget
+ * Each qubit keeps a chain of the instructions acting on it, patterns are matched against the ends of these chains
+ *
+ * CNOT(a, b) CNOT(a, b), CZ(a, b) CZ(a, b) and SWAP(a, b) SWAP(a, b) with no instruction on a or b between them cancel
+ * H(b) CNOT(a, b) H(b) with no instruction on b between them is replaced by CZ(a, b),
+ *  avoiding the tableau flush of a CNOT against a queued Hadamard
+ * Identity local Cliffords are removed
+ *
+ * Rz merging is opt in, as it requires tags that hold single precision angles, see rz_tag.h
+ * An Rz is merged into an earlier Rz on the same qubit when every instruction between them on that qubit is diagonal,
+ *  merged angles that are multiples of pi / 2 are lowered to local Cliffords
+ * Each merged Rz is one fewer teleported qubit
+ *
+ * Instructions are optimised in blocks of PEEPHOLE_BLOCK, patterns spanning two blocks are not matched
+ */
+
+// Instructions optimised together
+#ifndef PEEPHOLE_BLOCK
+#define PEEPHOLE_BLOCK (1 << 16)
+#endif
+
+// Instructions on a qubit searched for an earlier Rz to merge with
+#ifndef PEEPHOLE_WINDOW
+#define PEEPHOLE_WINDOW (16)
+#endif
+
+// Merged Rz angles within this many quarter turns of a multiple of pi / 2 are lowered to local Cliffords
+// Tags hold single precision angles, so this is looser than QASM_CLIFFORD_EPS
+#ifndef PEEPHOLE_CLIFFORD_EPS
+#define PEEPHOLE_CLIFFORD_EPS (1e-6)
+#endif
+
+// Marks the end of a chain
+#define PEEPHOLE_NONE (UINT32_MAX)
+
+/*
+ * peephole_optimise
+ * Optimises a block of instructions in place
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: merge_rz : const bool :: Merges Rz gates, tags must hold single precision angles
+ * The optimised instructions are compacted to the front of the array
+ * Returns the number of optimised instructions
+ */
+size_t peephole_optimise(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const bool merge_rz);
+
+/*
+ * parse_instruction_block_peephole
+ * Optimises a block of instructions in place and parses the optimised block
+ * :: wid : widget_t* :: Current widget
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: merge_rz : const bool :: Merges Rz gates, tags must hold single precision angles
+ * Returns the number of instructions parsed
+ */
+size_t parse_instruction_block_peephole(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const bool merge_rz);
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef QASM_H
+#define QASM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "instruction_table.h"
+#include "instruction_file.h"
+#include "widget.h"
+
+/*
+ * OpenQASM frontend
+ * Streaming parser for the Clifford, Rz and classically conditioned Pauli subset of OpenQASM 2 and 3
+ * Source text may be fed in arbitrary pieces, instructions are emitted a block at a time
+ *
+ * Declarations : qreg, creg, qubit, bit, registers are allocated consecutive qubit indices
+ * Gates : id, x, y, z, h, s, sdg, cx, CX, cnot, cz, swap, rz, p, phase, u1, t, tdg
+ * Measurement : measure q -> c, c = measure q
+ * Conditionals : if (c[i]) or if (c[i] == 1), or a single bit register compared to 1,
+ *  followed by an x, y or z gate or a braced block of them
+ * include and barrier statements are ignored, any other statement is an error
+ *
+ * Rz angles that are multiples of pi / 2 are lowered to local Cliffords,
+ * other angles are interned as the bits of the single precision angle, matching angle_to_tag in the Python library
+ */
+
+// Instructions buffered between calls to the emitter
+#ifndef QASM_BLOCK_INSTRUCTIONS
+#define QASM_BLOCK_INSTRUCTIONS (1 << 12)
+#endif
+
+// Bytes read from a file between calls to qasm_parser_feed
+#ifndef QASM_READ_BYTES
+#define QASM_READ_BYTES (1 << 16)
+#endif
+
+// Rz angles within this many quarter turns of a multiple of pi / 2 are lowered to local Cliffords
+#ifndef QASM_CLIFFORD_EPS
+#define QASM_CLIFFORD_EPS (1e-9)
+#endif
+
+#define QASM_MAX_IDENTIFIER (64)
+#define QASM_MAX_DEPTH (16)
+#define QASM_ERROR_BYTES (128)
+
+// Marks a classical bit that has not been measured into
+#define QASM_UNMEASURED (UINT32_MAX)
+
+/*
+ * qasm_emit_t
+ * Consumer of parsed instructions
+ * :: ctx : void* :: Context passed to qasm_parser_create
+ * :: instructions : instruction_stream_u* :: Block of instructions, only valid for the duration of the call
+ * :: n_instructions : const size_t :: Number of instructions in the block
+ * Returns false to stop the parser
+ */
+typedef bool (*qasm_emit_t)(void* ctx, instruction_stream_u* instructions, const size_t n_instructions);
+
+/*
+ * qasm_register_t
+ * Declared quantum or classical register
+ */
+struct qasm_register_t
+{
+    char name[QASM_MAX_IDENTIFIER];
+    size_t offset; // Index of the first qubit or bit of the register
+    size_t width;
+};
+typedef struct qasm_register_t qasm_register_t;
+
+/*
+ * qasm_parser_t
+ * Streaming OpenQASM parser
+ */
+struct qasm_parser_t
+{
+    qasm_emit_t emit;
+    void* ctx;
+    instruction_stream_u block[QASM_BLOCK_INSTRUCTIONS];
+    size_t n_block;
+
+    // Text of the statement being read
+    char* statement;
+    size_t statement_bytes;
+    size_t statement_capacity;
+    bool line_comment;
+    bool block_comment;
+    char prev; // Previous character, for comment delimiters
+
+    qasm_register_t* qregs;
+    size_t n_qregs;
+    qasm_register_t* cregs;
+    size_t n_cregs;
+    size_t n_qubits;
+    size_t n_bits;
+    uint32_t* bit_qubits; // Qubit last measured into each bit, or QASM_UNMEASURED
+
+    // Measured qubit conditioning each open braced block, or QASM_UNMEASURED for an unconditioned block
+    uint32_t conditions[QASM_MAX_DEPTH];
+    size_t depth;
+
+    size_t n_instructions;
+    size_t n_rz;
+    size_t line;
+    int version;
+    bool failed;
+    char error[QASM_ERROR_BYTES];
+};
+typedef struct qasm_parser_t qasm_parser_t;
+
+/*
+ * qasm_parser_create
+ * Creates a parser
+ * :: emit : qasm_emit_t :: Consumer of parsed instructions, NULL only counts the instructions
+ * :: ctx : void* :: Passed to emit
+ */
+qasm_parser_t* qasm_parser_create(qasm_emit_t emit, void* ctx);
+
+/*
+ * qasm_parser_destroy
+ * Frees a parser
+ * :: parser : qasm_parser_t* :: Parser
+ */
+void qasm_parser_destroy(qasm_parser_t* parser);
+
+/*
+ * qasm_parser_feed
+ * Parses a piece of source text
+ * :: parser : qasm_parser_t* :: Parser
+ * :: text : const char* :: Source text, statements may be split across calls
+ * :: n_bytes : const size_t :: Length of the text
+ * Returns false if the text could not be parsed, see qasm_parser_get_error
+ */
+bool qasm_parser_feed(qasm_parser_t* parser, const char* text, const size_t n_bytes);
+
+/*
+ * qasm_parser_finish
+ * Ends the source text and emits any buffered instructions
+ * :: parser : qasm_parser_t* :: Parser
+ * Returns false if the text ended part way through a statement or block
+ */
+bool qasm_parser_finish(qasm_parser_t* parser);
+
+/*
+ * qasm_parser_read_file
+ * Parses a source file and finishes the parser
+ * :: parser : qasm_parser_t* :: Parser
+ * :: path : const char* :: Path of the source file
+ * The file is read QASM_READ_BYTES at a time
+ * Returns false if the file could not be read or parsed
+ */
+bool qasm_parser_read_file(qasm_parser_t* parser, const char* path);
+
+/*
+ * qasm_parser_get_n_qubits
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns the number of declared qubits
+ */
+size_t qasm_parser_get_n_qubits(const qasm_parser_t* parser);
+
+/*
+ * qasm_parser_get_n_bits
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns the number of declared classical bits
+ */
+size_t qasm_parser_get_n_bits(const qasm_parser_t* parser);
+
+/*
+ * qasm_parser_get_n_instructions
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns the number of instructions parsed
+ */
+size_t qasm_parser_get_n_instructions(const qasm_parser_t* parser);
+
+/*
+ * qasm_parser_get_n_rz
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns the number of Rz gates parsed
+ */
+size_t qasm_parser_get_n_rz(const qasm_parser_t* parser);
+
+/*
+ * qasm_parser_get_line
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns the current line of the source text, counting from one
+ */
+size_t qasm_parser_get_line(const qasm_parser_t* parser);
+
+/*
+ * qasm_parser_get_error
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns a description of the first error, or NULL if the parser has not failed
+ */
+const char* qasm_parser_get_error(const qasm_parser_t* parser);
+
+/*
+ * qasm_emit_widget
+ * Emitter that parses each block into a widget
+ * :: ctx : void* :: widget_t*
+ * :: instructions : instruction_stream_u* :: Block of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the block
+ */
+bool qasm_emit_widget(void* ctx, instruction_stream_u* instructions, const size_t n_instructions);
+
+/*
+ * qasm_emit_instruction_file
+ * Emitter that appends each block to a binary instruction stream
+ * :: ctx : void* :: instruction_file_writer_t*
+ * :: instructions : instruction_stream_u* :: Block of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the block
+ */
+bool qasm_emit_instruction_file(void* ctx, instruction_stream_u* instructions, const size_t n_instructions);
+
+#endif
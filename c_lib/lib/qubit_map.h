@@ -1,8 +1,12 @@
 #ifndef QUBIT_MAP_H
 #define QUBIT_MAP_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
+#include "instruction_table.h"
+
 
 typedef size_t qubit_map_t;
 
@@ -22,5 +26,19 @@ qubit_map_t* qubit_map_create(const size_t initial_qubits, const size_t max_qubi
  */
 void qubit_map_destroy(qubit_map_t* q_map);
 
+/*
+ * qubit_permutation_swaps
+ * Lowers a permutation of qubits to swap instructions
+ * :: perm : const uint32_t* :: The state of qubit i is moved to qubit perm[i]
+ * :: n_qubits : const size_t :: Length of the permutation
+ * :: swaps : instruction_stream_u* :: Written with at most n_qubits - 1 swap instructions
+ * Each cycle of length k is lowered to k - 1 swaps, swaps only relabel the qubit map
+ * Returns the number of swaps written, or SIZE_MAX if perm is not a permutation
+ */
+size_t qubit_permutation_swaps(
+    const uint32_t* perm,
+    const size_t n_qubits,
+    instruction_stream_u* swaps);
+
 
 #endif
@@ -0,0 +1,90 @@
+#ifndef RZ_TAG_H
+#define RZ_TAG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "instruction_table.h"
+
+/*
+ * Rz angle tags
+ * Tags are opaque to the widget, frontends that carry angles intern them as the bits of the single precision angle
+ * This matches angle_to_tag and tag_to_angle in the Python library, a tag of zero is a zero angle
+ */
+
+#define RZ_TAG_HALF_PI (1.57079632679489661923)
+
+// Angles of more quarter turns than this are never lowered, the nearest quarter turn would not fit in a long long
+#define RZ_TAG_MAX_QUARTER_TURNS (1e15)
+
+/*
+ * __inline_rz_tag_to_angle
+ * :: tag : const non_clifford_tag_t :: Tag holding the bits of a single precision angle
+ * Returns the angle in radians
+ */
+static inline
+double __inline_rz_tag_to_angle(const non_clifford_tag_t tag)
+{
+    float angle = 0;
+    memcpy(&angle, &tag, sizeof(angle));
+    return angle;
+}
+
+/*
+ * __inline_rz_angle_to_tag
+ * :: angle : const double :: Angle in radians
+ * Returns the bits of the angle rounded to single precision
+ */
+static inline
+non_clifford_tag_t __inline_rz_angle_to_tag(const double angle)
+{
+    const float single = (float)angle;
+    non_clifford_tag_t tag = 0;
+    memcpy(&tag, &single, sizeof(tag));
+    return tag;
+}
+
+/*
+ * __inline_rz_angle_finite
+ * :: angle : const double :: Angle in radians
+ * Returns false for infinite and NaN angles
+ * The exponent is tested directly, as the library is built with -ffast-math under which isfinite may be folded away
+ */
+static inline
+bool __inline_rz_angle_finite(const double angle)
+{
+    uint64_t bits = 0;
+    memcpy(&bits, &angle, sizeof(bits));
+    return 0x7ff != ((bits >> 52) & 0x7ff);
+}
+
+/*
+ * __inline_rz_quarter_turn
+ * Finds the local Clifford of an Rz angle that is a multiple of pi / 2
+ * :: angle : const double :: Angle in radians
+ * :: eps : const double :: Tolerance in quarter turns
+ * :: opcode : instruction_t* :: Set to one of _I_, _S_, _Z_ or _R_ if the angle is a multiple of pi / 2
+ * Returns true if the angle is within eps of a multiple of pi / 2
+ * Non-finite angles and angles beyond RZ_TAG_MAX_QUARTER_TURNS are not lowered
+ */
+static inline
+bool __inline_rz_quarter_turn(const double angle, const double eps, instruction_t* opcode)
+{
+    static const instruction_t quarter_turns[4] = {_I_, _S_, _Z_, _R_};
+    const double quarter = angle / RZ_TAG_HALF_PI;
+    if (!__inline_rz_angle_finite(angle) || (quarter > RZ_TAG_MAX_QUARTER_TURNS) || (quarter < -RZ_TAG_MAX_QUARTER_TURNS))
+    {
+        return false;
+    }
+    const long long nearest = (long long)(quarter + ((quarter < 0) ? -0.5 : 0.5));
+    const double residual = quarter - (double)nearest;
+    if ((residual < eps) && (residual > -eps))
+    {
+        *opcode = quarter_turns[((nearest % 4) + 4) % 4];
+        return true;
+    }
+    return false;
+}
+
+#endif
@@ -4,11 +4,23 @@
 
 #include "widget.h"
 #include "tableau_operations.h"
+#include "threadpool.h"
 
 #include "simd_headers.h"
 
 typedef struct widget_t widget_t;
 
+// Tableaus with at least this many qubits distribute the elimination over the threadpool
+#ifndef DECOMP_PAR_MIN_QUBITS
+#define DECOMP_PAR_MIN_QUBITS (1024)
+#endif
+
+// Number of pivot columns combined in each table of the M4RI elimination
+#ifndef M4RI_STRIP_BITS
+#define M4RI_STRIP_BITS (8)
+#endif
+#define M4RI_TABLE_ROWS (1ull << M4RI_STRIP_BITS)
+
 /*
  * simd_widget_decompose
  * Decomposes the stabiliser tableau into a graph state plus local Cliffords 
@@ -18,6 +30,16 @@ typedef struct widget_t widget_t;
 void simd_widget_decompose(struct widget_t* wid);
 void naive_widget_decompose(struct widget_t* wid);
 
+/*
+ * m4ri_widget_decompose
+ * Decomposes the stabiliser tableau into a graph state plus local Cliffords
+ * :: wid : widget_t* :: Widget to decompose
+ * Acts in place on the tableau
+ * Pivot columns are eliminated in strips of M4RI_STRIP_BITS columns,
+ * each row takes a single rowsum per strip from a table of pivot row products
+ */
+void m4ri_widget_decompose(struct widget_t* wid);
+
 
 /*
  * simd_tableau_idx_swap_transverse 
@@ -39,6 +61,7 @@ size_t simd_tableau_X_diag_element(tableau_t* tab, clifford_queue_t* queue, cons
 
 
 void simd_tableau_elim(widget_t* wid);
+void m4ri_tableau_elim(widget_t* wid);
 
 void tableau_elim_upper(widget_t* wid);
 void tableau_elim_lower(widget_t* wid);
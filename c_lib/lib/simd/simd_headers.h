@@ -1,12 +1,35 @@
 #ifndef SIMD_HEADERS_H
 #define SIMD_HEADERS_H
 
+#include "simd_tier.h"
+
 #if defined(__x86_64__)
 #include <emmintrin.h>
 #include <smmintrin.h>
 #include <immintrin.h>
 #include <x86gprintrin.h>
+#if defined(SIMD_AVX512)
+#define ROWSUM_STRIDE (512 / 8) 
+
+// Truth tables for _mm512_ternarylogic_epi64(a, b, c, imm)
+#define TERNLOG_A_XOR_BC (0x78) // a ^ (b & c)
+#define TERNLOG_A_OR_BC (0xf8) // a | (b & c)
+#define TERNLOG_A_XOR_NBC (0xd2) // a ^ (~b & c)
+#define TERNLOG_A_XOR_BNC (0xb4) // a ^ (b & ~c)
+#define TERNLOG_A_XOR_B_OR_C (0x1e) // a ^ (b | c)
+#define TERNLOG_XOR3 (0x96) // a ^ b ^ c
+#define TERNLOG_AND3 (0x80) // a & b & c
+#define TERNLOG_ABNC (0x40) // a & b & ~c
+#define TERNLOG_AXB_AND_C (0x28) // (a ^ b) & c
+#define TERNLOG_AXNB_AND_C (0x82) // ~(a ^ b) & c
+#define TERNLOG_AXNB_AND_AXC (0x42) // ~(a ^ b) & (a ^ c)
+#define TERNLOG_SELECT (0xca) // a ? b : c
+
+// Byte mask covering the first n bytes of a 512 bit lane
+#define AVX512_TAIL_MASK(n) ((__mmask64)((n) >= 64 ? ~0ull : ((1ull << (n)) - 1)))
+#else
 #define ROWSUM_STRIDE (256 / 8) 
+#endif
 #elif defined(__arm__) || defined(__aarch64__)
 #include <stddef.h>
 #include <arm_neon.h>
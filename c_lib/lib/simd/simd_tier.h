@@ -0,0 +1,104 @@
+#ifndef SIMD_TIER_H
+#define SIMD_TIER_H
+
+/*
+ * Kernels for instruction sets beyond the baseline are compiled alongside the baseline kernels
+ * Every symbol exported by these objects is suffixed with the name of the instruction set,
+ * the dispatch layer then binds the suffixed kernels at runtime
+ * See simd_dispatch.h
+ */
+#if defined(SIMD_AVX512)
+#define SIMD_TIER_NAME(name) name##_avx512
+#else
+#define SIMD_TIER_NAME(name) name
+#endif
+
+#if defined(SIMD_AVX512)
+// simd_tableau_operations.c
+#define SINGLE_QUBIT_OPERATIONS SIMD_TIER_NAME(SINGLE_QUBIT_OPERATIONS)
+#define SINGLE_QUBIT_OPERATIONS_RANGE SIMD_TIER_NAME(SINGLE_QUBIT_OPERATIONS_RANGE)
+#define TWO_QUBIT_OPERATIONS SIMD_TIER_NAME(TWO_QUBIT_OPERATIONS)
+#define TWO_QUBIT_OPERATIONS_RANGE SIMD_TIER_NAME(TWO_QUBIT_OPERATIONS_RANGE)
+#define tableau_CNOT_range SIMD_TIER_NAME(tableau_CNOT_range)
+#define tableau_CZ_range SIMD_TIER_NAME(tableau_CZ_range)
+#define tableau_HRH_range SIMD_TIER_NAME(tableau_HRH_range)
+#define tableau_HRX_range SIMD_TIER_NAME(tableau_HRX_range)
+#define tableau_HR_range SIMD_TIER_NAME(tableau_HR_range)
+#define tableau_HSH_range SIMD_TIER_NAME(tableau_HSH_range)
+#define tableau_HSX_range SIMD_TIER_NAME(tableau_HSX_range)
+#define tableau_HS_range SIMD_TIER_NAME(tableau_HS_range)
+#define tableau_HX_range SIMD_TIER_NAME(tableau_HX_range)
+#define tableau_HY_range SIMD_TIER_NAME(tableau_HY_range)
+#define tableau_HZ_range SIMD_TIER_NAME(tableau_HZ_range)
+#define tableau_H_range SIMD_TIER_NAME(tableau_H_range)
+#define tableau_I_range SIMD_TIER_NAME(tableau_I_range)
+#define tableau_RHS_range SIMD_TIER_NAME(tableau_RHS_range)
+#define tableau_RHY_range SIMD_TIER_NAME(tableau_RHY_range)
+#define tableau_RH_range SIMD_TIER_NAME(tableau_RH_range)
+#define tableau_RX_range SIMD_TIER_NAME(tableau_RX_range)
+#define tableau_R_range SIMD_TIER_NAME(tableau_R_range)
+#define tableau_SHR_range SIMD_TIER_NAME(tableau_SHR_range)
+#define tableau_SHY_range SIMD_TIER_NAME(tableau_SHY_range)
+#define tableau_SH_range SIMD_TIER_NAME(tableau_SH_range)
+#define tableau_SX_range SIMD_TIER_NAME(tableau_SX_range)
+#define tableau_S_range SIMD_TIER_NAME(tableau_S_range)
+#define tableau_X_range SIMD_TIER_NAME(tableau_X_range)
+#define tableau_Y_range SIMD_TIER_NAME(tableau_Y_range)
+#define tableau_Z_range SIMD_TIER_NAME(tableau_Z_range)
+
+// simd_tableau_fused_operations.c
+#define FUSED_OPERATIONS_RANGE SIMD_TIER_NAME(FUSED_OPERATIONS_RANGE)
+
+// simd_rowsum.c
+#define rowsum_cnf SIMD_TIER_NAME(rowsum_cnf)
+#define rowsum_naive_lookup_table SIMD_TIER_NAME(rowsum_naive_lookup_table)
+#define simd_rowsum SIMD_TIER_NAME(simd_rowsum)
+#define simd_rowsum_cnf SIMD_TIER_NAME(simd_rowsum_cnf)
+#define simd_rowsum_cnf_popcnt SIMD_TIER_NAME(simd_rowsum_cnf_popcnt)
+#define simd_rowsum_cnf_vpopcnt SIMD_TIER_NAME(simd_rowsum_cnf_vpopcnt)
+#define simd_rowsum_xor_only SIMD_TIER_NAME(simd_rowsum_xor_only)
+#define simd_xor_rowsum SIMD_TIER_NAME(simd_xor_rowsum)
+
+// simd_transpose.c
+#define __inline_set_bit SIMD_TIER_NAME(__inline_set_bit)
+#define chunk_transpose_2x16 SIMD_TIER_NAME(chunk_transpose_2x16)
+#define chunk_transpose_64x64 SIMD_TIER_NAME(chunk_transpose_64x64)
+#define simd_transpose_2x16 SIMD_TIER_NAME(simd_transpose_2x16)
+#define simd_transpose_64x64 SIMD_TIER_NAME(simd_transpose_64x64)
+#define simd_transpose_64x64_inplace SIMD_TIER_NAME(simd_transpose_64x64_inplace)
+#define transpose_naive SIMD_TIER_NAME(transpose_naive)
+
+// tableau_row_swap.c
+#define simd_row_swap SIMD_TIER_NAME(simd_row_swap)
+
+// transverse_hadamard.c
+#define simd_tableau_transverse_hadamard SIMD_TIER_NAME(simd_tableau_transverse_hadamard)
+
+// simd_gaussian_elim.c
+#define debug_print_block SIMD_TIER_NAME(debug_print_block)
+#define debug_print_chunk SIMD_TIER_NAME(debug_print_chunk)
+#define decomp_load_block SIMD_TIER_NAME(decomp_load_block)
+#define decomp_store_block SIMD_TIER_NAME(decomp_store_block)
+#define m4ri_tableau_elim SIMD_TIER_NAME(m4ri_tableau_elim)
+#define m4ri_widget_decompose SIMD_TIER_NAME(m4ri_widget_decompose)
+#define naive_tableau_idx_swap_transverse SIMD_TIER_NAME(naive_tableau_idx_swap_transverse)
+#define naive_widget_decompose SIMD_TIER_NAME(naive_widget_decompose)
+#define naive_zero_phases SIMD_TIER_NAME(naive_zero_phases)
+#define simd_swap SIMD_TIER_NAME(simd_swap)
+#define simd_tableau_X_diag_col_lower SIMD_TIER_NAME(simd_tableau_X_diag_col_lower)
+#define simd_tableau_X_diag_col_upper SIMD_TIER_NAME(simd_tableau_X_diag_col_upper)
+#define simd_tableau_X_diag_element SIMD_TIER_NAME(simd_tableau_X_diag_element)
+#define simd_tableau_elim SIMD_TIER_NAME(simd_tableau_elim)
+#define simd_widget_decompose SIMD_TIER_NAME(simd_widget_decompose)
+#define tableau_X_diag_col_lower SIMD_TIER_NAME(tableau_X_diag_col_lower)
+#define tableau_X_diag_col_upper SIMD_TIER_NAME(tableau_X_diag_col_upper)
+#define tableau_X_diag_element SIMD_TIER_NAME(tableau_X_diag_element)
+#define tableau_elim_lower SIMD_TIER_NAME(tableau_elim_lower)
+#define tableau_elim_upper SIMD_TIER_NAME(tableau_elim_upper)
+#define tableau_remove_zero_X_columns SIMD_TIER_NAME(tableau_remove_zero_X_columns)
+#define zero_phases SIMD_TIER_NAME(zero_phases)
+#define zero_z_diagonal SIMD_TIER_NAME(zero_z_diagonal)
+
+#endif
+
+#endif
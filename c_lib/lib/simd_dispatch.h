@@ -0,0 +1,64 @@
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+#include <stdbool.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "tableau_fused_operations.h"
+
+struct widget_t;
+
+/*
+ * simd_dispatch_t
+ * A set of architecture specific kernels
+ * On x86 the AVX2 and AVX-512 kernels are both compiled into the library and the widest set
+ * supported by the host is bound when the library is loaded
+ * The gate kernels are bound by copying the kernel tables into the live tables
+ * used by the tableau operations, the remaining kernels are called through SIMD_DISPATCH_g
+ */
+struct simd_dispatch_t
+{
+    const char* name;
+    bool (*supported)(void); // Checks if the host supports the instruction set
+    void (**single_qubit_range)(tableau_t*, const size_t, const size_t, const size_t);
+    void (**two_qubit_range)(tableau_t*, const size_t, const size_t, const size_t, const size_t);
+    void (**fused_range)(tableau_t*, const size_t, const size_t, const size_t, const size_t);
+    int8_t (*rowsum)(const size_t, void* restrict, void* restrict, void* restrict, void* restrict);
+    void (*transpose_64x64)(uint64_t* restrict[64], uint64_t* restrict[64]);
+    void (*transpose_64x64_inplace)(uint64_t*[64]);
+    void (*widget_decompose)(struct widget_t*);
+    void (*widget_decompose_m4ri)(struct widget_t*);
+};
+
+#ifdef SIMD_DISPATCH_SRC
+    struct simd_dispatch_t SIMD_DISPATCH_g;
+#else
+    extern struct simd_dispatch_t SIMD_DISPATCH_g;
+#endif
+
+/*
+ * simd_dispatch_init
+ * Binds the widest set of kernels supported by the host
+ * Called when the library is loaded
+ * Exits with an error message if the host does not support the instruction set the library was compiled for
+ * The CABALISER_SIMD environment variable may be set to the name of a narrower set of kernels
+ */
+void simd_dispatch_init();
+
+/*
+ * simd_dispatch_select
+ * Binds a set of kernels by name
+ * :: name : const char* :: Name of the instruction set, one of "avx2", "avx512" or "avx512vpopcntdq" on x86 and "neon" on arm
+ * Returns false if the kernels were not compiled or are not supported by the host
+ * Must not be called while tableau operations are running
+ */
+bool simd_dispatch_select(const char* name);
+
+/*
+ * simd_dispatch_name
+ * Returns the name of the bound set of kernels
+ */
+const char* simd_dispatch_name();
+
+#endif
@@ -21,6 +21,17 @@ typedef struct tableau_t tableau_t;
 
 #define CTZ_SENTINEL (~0ll)
 
+// Side length of the super-tiles of the transpose in 64x64 blocks 
+// A pair of super-tiles of 8 blocks touches 64KiB of the tableau
+#ifndef TRANSPOSE_TILE_BLOCKS
+#define TRANSPOSE_TILE_BLOCKS (8)
+#endif
+
+// Tableaus with at least this many qubits distribute the transpose over the threadpool
+#ifndef TRANSPOSE_PAR_MIN_QUBITS
+#define TRANSPOSE_PAR_MIN_QUBITS (4096)
+#endif
+
 #define SLICE_LEN_BYTES(n_qubits, stride_bytes) (size_t)(((n_qubits) / 8) + (!!(n_qubits % (stride_bytes * 8))) * ((stride_bytes) - (n_qubits / 8) % (stride_bytes)))
 
 #define SLICE_LEN(n_qubits, stride_bytes) (SLICE_LEN_BYTES(n_qubits, stride_bytes) / (stride_bytes))
@@ -38,8 +49,8 @@ typedef struct tableau_t tableau_t;
 
 
 #define SLICE_IDX(ptr, idx, slice_len) ((void*)(ptr) + (idx * slice_len)) 
-#define SLICE_X_IDX(tab, idx) SLICE_IDX(tab->slices_x[0], idx, tab->slice_len)
-#define SLICE_Z_IDX(tab, idx) SLICE_IDX(tab->slices_z[0], idx, tab->slice_len)
+#define SLICE_X_IDX(tab, idx) SLICE_IDX(tab->slices_x[0], idx, TABLEAU_SLICE_STRIDE(tab))
+#define SLICE_Z_IDX(tab, idx) SLICE_IDX(tab->slices_z[0], idx, TABLEAU_SLICE_STRIDE(tab))
 
 // Non-simd stride helpers
 #define CHUNK_OBJ uint64_t
@@ -52,7 +63,9 @@ typedef struct tableau_t tableau_t;
 #define CHUNK_IDX(slice, offset_byte) (*(CHUNK_OBJ*)((void*)slice + offset_byte))
 
 // TODO - This may be gcc only
-#if defined(__x86_64__)
+#if defined(__x86_64__) && defined(SIMD_AVX512)
+#define TABLEAU_SIMD_VEC __m512i
+#elif defined(__x86_64__)
 #define TABLEAU_SIMD_VEC __m256i
 #elif defined(__arm__) || defined(__aarch64__)
 #define TABLEAU_SIMD_VEC uint8x16_t
@@ -70,10 +83,74 @@ typedef CHUNK_OBJ tableau_slice;
 typedef CHUNK_OBJ* tableau_slice_p;
 
 
+/*
+ * tableau_alloc_mode_e
+ * Allocators for the tableau bitmap
+ * TABLEAU_ALLOC_HEAP : Aligned heap allocation, zeroed with a memset
+ * TABLEAU_ALLOC_MMAP : Anonymous mapping, pages are zeroed by the kernel when first touched
+ * TABLEAU_ALLOC_THP : Anonymous mapping, advised to use transparent huge pages
+ * TABLEAU_ALLOC_HUGETLB : Anonymous mapping of explicit 2MiB huge pages,
+ *   falls back to TABLEAU_ALLOC_THP if no huge pages are reserved
+ */
+enum tableau_alloc_mode_e
+{
+    TABLEAU_ALLOC_HEAP = 0,
+    TABLEAU_ALLOC_MMAP = 1,
+    TABLEAU_ALLOC_THP = 2,
+    TABLEAU_ALLOC_HUGETLB = 3
+};
+
+// Bitmaps smaller than this are always allocated on the heap
+#ifndef TABLEAU_MMAP_MIN_BYTES
+#define TABLEAU_MMAP_MIN_BYTES (1 << 21)
+#endif
+
+#define TABLEAU_HUGE_PAGE_BYTES (1 << 21)
+
+/*
+ * tableau_numa_policy_e
+ * Placement of mapped bitmaps on NUMA nodes
+ * TABLEAU_NUMA_AUTO : TABLEAU_NUMA_FIRST_TOUCH if the threadpool workers span more than one node,
+ *   otherwise TABLEAU_NUMA_LOCAL
+ * TABLEAU_NUMA_LOCAL : Pages are placed on the node of the thread that first writes them
+ * TABLEAU_NUMA_INTERLEAVE : Pages are interleaved over all online nodes
+ * TABLEAU_NUMA_FIRST_TOUCH : Each threadpool worker first writes the range of rows that it
+ *   is assigned by the distributed operations, placing those rows on the worker's node
+ * Heap allocated bitmaps are always TABLEAU_NUMA_LOCAL
+ */
+enum tableau_numa_policy_e
+{
+    TABLEAU_NUMA_AUTO = 0,
+    TABLEAU_NUMA_LOCAL = 1,
+    TABLEAU_NUMA_INTERLEAVE = 2,
+    TABLEAU_NUMA_FIRST_TOUCH = 3
+};
+
+/*
+ * tableau_layout_e
+ * Placement of the X and Z slices in the bitmap
+ * TABLEAU_LAYOUT_PLANAR : All X slices followed by all Z slices
+ * TABLEAU_LAYOUT_INTERLEAVED : The Z slice of each qubit directly follows its X slice,
+ *   a gate then streams from one region per qubit rather than two
+ * The phases are held separately in both layouts
+ * Decomposition requires the planar layout, see tableau_relayout
+ */
+enum tableau_layout_e
+{
+    TABLEAU_LAYOUT_PLANAR = 0,
+    TABLEAU_LAYOUT_INTERLEAVED = 1
+};
+
+// Bytes between the starts of consecutive X slices, or of consecutive Z slices
+#define TABLEAU_SLICE_STRIDE(tab) ((tab)->slice_len * (1 + (TABLEAU_LAYOUT_INTERLEAVED == (tab)->layout)))
+
 struct tableau_t {
     size_t n_qubits; // Number of qubits
     size_t slice_len; // Number of bytes
     void* chunks; // Pointer to allocated chunks
+    size_t chunks_bytes; // Number of allocated bytes 
+    uint8_t alloc_mode; // Allocator used for the chunks
+    uint8_t layout; // Placement of the slices in the chunks
     tableau_slice_p* slices_x; // Slice representation pointers 
     tableau_slice_p* slices_z; // Slice representation pointers 
     tableau_slice_p phases; // Phase terms
@@ -88,6 +165,46 @@ struct tableau_t {
  */
 tableau_t* tableau_create(const size_t n_qubits);
 
+/*
+ * tableau_create_layout
+ * Constructor class for tableau with a given slice layout
+ * :: n_qubits : const size_t :: Number of qubits   
+ * :: layout : const enum tableau_layout_e :: Placement of the slices
+ */
+tableau_t* tableau_create_layout(const size_t n_qubits, const enum tableau_layout_e layout);
+
+/*
+ * tableau_set_layout_mode
+ * tableau_get_layout_mode
+ * Sets the layout used by tableau_create for subsequently created tableaus
+ * :: layout : const enum tableau_layout_e :: Placement of the slices
+ * Defaults to TABLEAU_LAYOUT_PLANAR
+ */
+void tableau_set_layout_mode(const enum tableau_layout_e layout);
+enum tableau_layout_e tableau_get_layout_mode();
+
+/*
+ * tableau_set_alloc_mode
+ * tableau_get_alloc_mode
+ * Sets the allocator used for the bitmaps of subsequently created tableaus
+ * :: mode : const enum tableau_alloc_mode_e :: Allocator 
+ * Defaults to TABLEAU_ALLOC_HEAP, the mapped allocators are opt in
+ * With any of the mapped allocators only the identity diagonal is written on creation
+ */
+void tableau_set_alloc_mode(const enum tableau_alloc_mode_e mode);
+enum tableau_alloc_mode_e tableau_get_alloc_mode();
+
+/*
+ * tableau_set_numa_policy
+ * tableau_get_numa_policy
+ * Sets the NUMA placement of the bitmaps of subsequently created tableaus
+ * :: policy : const enum tableau_numa_policy_e :: Placement 
+ * Defaults to TABLEAU_NUMA_AUTO
+ * Placement follows the threadpool that is running when the tableau is created
+ */
+void tableau_set_numa_policy(const enum tableau_numa_policy_e policy);
+enum tableau_numa_policy_e tableau_get_numa_policy();
+
 
 /*
  * tableau_destroy 
@@ -184,10 +301,7 @@ void tableau_transpose_naive(tableau_t* tab);
 
 /*
  * tableau_rowsum
- * tableau_rowsum_offset 
  * Performs a rowsum between two rows of stabilisers 
- * The offset version of the function starts
- * from an offset bit index 
  * :: tab : tableau_t const* :: Tableau object
  * :: ctrl : const size_t :: Control of the rowsum
  * :: targ : const size_t :: Target of the rowsum
@@ -196,10 +310,6 @@ void tableau_rowsum(
     tableau_t* tab,
     const size_t ctrl,
     const size_t targ);
-void tableau_rowsum_offset(tableau_t* tab,
-    const size_t ctrl,
-    const size_t targ,
-    const size_t offset);
 
 /*
  * tableau_slice_empty_x
@@ -259,4 +369,47 @@ void tableau_idx_swap_transverse(tableau_t* tab, const size_t i, const size_t j)
  */
 void tableau_set_n_qubits(tableau_t* tab, const size_t n_qubits);
 
+/*
+ * tableau_grow
+ * Grows the tableau to a larger number of qubits
+ * :: tab : tableau_t* :: The tableau
+ * :: n_qubits : const size_t :: The new number of qubits
+ * Acts in place on the tableau, the slices are re-strided into a new allocation 
+ * The new qubits are initialised to the identity
+ * Must be called in column major order and with no operations in flight on the tableau
+ */
+void tableau_grow(tableau_t* tab, const size_t n_qubits);
+
+/*
+ * tableau_compact
+ * Shrinks the tableau to a smaller number of qubits, re-striding the slices
+ * :: tab : tableau_t* :: The tableau
+ * :: n_qubits : const size_t :: The new number of qubits
+ * Acts in place on the tableau and its allocation, mapped pages past the compacted tableau are released 
+ * Unlike tableau_set_n_qubits the slices are moved to the stride of the new number of qubits
+ * The truncated rows and columns must not be entangled with the remaining qubits
+ * Must be called in column major order 
+ */
+void tableau_compact(tableau_t* tab, const size_t n_qubits);
+
+/*
+ * tableau_reset
+ * Restores the tableau to the identity
+ * :: tab : tableau_t* :: The tableau
+ * :: n_dirty : const size_t :: Number of qubits that may have been acted on 
+ * Only the leading rows of the leading slices are zeroed, the remainder must still hold the identity
+ * Must be called in column major order and with no operations in flight on the tableau
+ */
+void tableau_reset(tableau_t* tab, const size_t n_dirty);
+
+/*
+ * tableau_relayout
+ * Moves the slices of the tableau to a different layout
+ * :: tab : tableau_t* :: The tableau
+ * :: layout : const enum tableau_layout_e :: Placement of the slices
+ * Acts in place on the tableau, the slices are copied into a new allocation 
+ * Must be called in column major order and with no operations in flight on the tableau
+ */
+void tableau_relayout(tableau_t* tab, const enum tableau_layout_e layout);
+
 #endif 
@@ -0,0 +1,186 @@
+#ifndef TABLEAU_FUSED_OPERATIONS_H
+#define TABLEAU_FUSED_OPERATIONS_H
+
+#include "tableau.h"
+#include "instructions.h"
+
+/*
+ * Local Clifford parameters
+ * Each local Clifford acts on the x, z and phase bits of a row as:
+ *     x' = a.x ^ b.z
+ *     z' = c.x ^ d.z
+ *     r' = r ^ p.x ^ q.z ^ s.x.z
+ * The parameters are packed into a single byte so they may be passed to the fused kernels as compile time constants
+ */
+#define LOCAL_CLIFFORD_PARAMS(a, b, c, d, p, q, s) ((uint8_t)((a) | ((b) << 1) | ((c) << 2) | ((d) << 3) | ((p) << 4) | ((q) << 5) | ((s) << 6)))
+
+#define LOCAL_CLIFFORD_A(params) (((params) >> 0) & 1)
+#define LOCAL_CLIFFORD_B(params) (((params) >> 1) & 1)
+#define LOCAL_CLIFFORD_C(params) (((params) >> 2) & 1)
+#define LOCAL_CLIFFORD_D(params) (((params) >> 3) & 1)
+#define LOCAL_CLIFFORD_P(params) (((params) >> 4) & 1)
+#define LOCAL_CLIFFORD_Q(params) (((params) >> 5) & 1)
+#define LOCAL_CLIFFORD_S(params) (((params) >> 6) & 1)
+
+// True if the local Clifford leaves the x or z bits unchanged
+#define LOCAL_CLIFFORD_FIXES_X(params) (LOCAL_CLIFFORD_A(params) && !LOCAL_CLIFFORD_B(params))
+#define LOCAL_CLIFFORD_FIXES_Z(params) (!LOCAL_CLIFFORD_C(params) && LOCAL_CLIFFORD_D(params))
+
+#define LOCAL_CLIFFORD_PARAMS_I LOCAL_CLIFFORD_PARAMS(1, 0, 0, 1, 0, 0, 0)
+#define LOCAL_CLIFFORD_PARAMS_X LOCAL_CLIFFORD_PARAMS(1, 0, 0, 1, 0, 1, 0)
+#define LOCAL_CLIFFORD_PARAMS_Y LOCAL_CLIFFORD_PARAMS(1, 0, 0, 1, 1, 1, 0)
+#define LOCAL_CLIFFORD_PARAMS_Z LOCAL_CLIFFORD_PARAMS(1, 0, 0, 1, 1, 0, 0)
+#define LOCAL_CLIFFORD_PARAMS_H LOCAL_CLIFFORD_PARAMS(0, 1, 1, 0, 0, 0, 1)
+#define LOCAL_CLIFFORD_PARAMS_S LOCAL_CLIFFORD_PARAMS(1, 0, 1, 1, 0, 0, 1)
+#define LOCAL_CLIFFORD_PARAMS_R LOCAL_CLIFFORD_PARAMS(1, 0, 1, 1, 1, 0, 1)
+#define LOCAL_CLIFFORD_PARAMS_HX LOCAL_CLIFFORD_PARAMS(0, 1, 1, 0, 0, 1, 1)
+#define LOCAL_CLIFFORD_PARAMS_SX LOCAL_CLIFFORD_PARAMS(1, 0, 1, 1, 0, 1, 1)
+#define LOCAL_CLIFFORD_PARAMS_RX LOCAL_CLIFFORD_PARAMS(1, 0, 1, 1, 1, 1, 1)
+#define LOCAL_CLIFFORD_PARAMS_HY LOCAL_CLIFFORD_PARAMS(0, 1, 1, 0, 1, 1, 1)
+#define LOCAL_CLIFFORD_PARAMS_HZ LOCAL_CLIFFORD_PARAMS(0, 1, 1, 0, 1, 0, 1)
+#define LOCAL_CLIFFORD_PARAMS_SH LOCAL_CLIFFORD_PARAMS(0, 1, 1, 1, 0, 0, 0)
+#define LOCAL_CLIFFORD_PARAMS_RH LOCAL_CLIFFORD_PARAMS(0, 1, 1, 1, 0, 1, 0)
+#define LOCAL_CLIFFORD_PARAMS_HS LOCAL_CLIFFORD_PARAMS(1, 1, 1, 0, 1, 0, 0)
+#define LOCAL_CLIFFORD_PARAMS_HR LOCAL_CLIFFORD_PARAMS(1, 1, 1, 0, 0, 0, 0)
+#define LOCAL_CLIFFORD_PARAMS_HSX LOCAL_CLIFFORD_PARAMS(1, 1, 1, 0, 1, 1, 0)
+#define LOCAL_CLIFFORD_PARAMS_HRX LOCAL_CLIFFORD_PARAMS(1, 1, 1, 0, 0, 1, 0)
+#define LOCAL_CLIFFORD_PARAMS_SHY LOCAL_CLIFFORD_PARAMS(0, 1, 1, 1, 1, 1, 0)
+#define LOCAL_CLIFFORD_PARAMS_RHY LOCAL_CLIFFORD_PARAMS(0, 1, 1, 1, 1, 0, 0)
+#define LOCAL_CLIFFORD_PARAMS_HSH LOCAL_CLIFFORD_PARAMS(1, 1, 0, 1, 0, 1, 1)
+#define LOCAL_CLIFFORD_PARAMS_HRH LOCAL_CLIFFORD_PARAMS(1, 1, 0, 1, 0, 0, 1)
+#define LOCAL_CLIFFORD_PARAMS_RHS LOCAL_CLIFFORD_PARAMS(1, 1, 0, 1, 1, 1, 1)
+#define LOCAL_CLIFFORD_PARAMS_SHR LOCAL_CLIFFORD_PARAMS(1, 1, 0, 1, 1, 0, 1)
+
+/*
+ * Local Clifford lists
+ * Expands F(clifford, ...) for each local Clifford in opcode order
+ * Two copies are required as the preprocessor will not expand a macro within its own expansion
+ */
+#define FOREACH_LOCAL_CLIFFORD_CTRL(F, ...) \
+    F(I, __VA_ARGS__) \
+    F(X, __VA_ARGS__) \
+    F(Y, __VA_ARGS__) \
+    F(Z, __VA_ARGS__) \
+    F(H, __VA_ARGS__) \
+    F(S, __VA_ARGS__) \
+    F(R, __VA_ARGS__) \
+    F(HX, __VA_ARGS__) \
+    F(SX, __VA_ARGS__) \
+    F(RX, __VA_ARGS__) \
+    F(HY, __VA_ARGS__) \
+    F(HZ, __VA_ARGS__) \
+    F(SH, __VA_ARGS__) \
+    F(RH, __VA_ARGS__) \
+    F(HS, __VA_ARGS__) \
+    F(HR, __VA_ARGS__) \
+    F(HSX, __VA_ARGS__) \
+    F(HRX, __VA_ARGS__) \
+    F(SHY, __VA_ARGS__) \
+    F(RHY, __VA_ARGS__) \
+    F(HSH, __VA_ARGS__) \
+    F(HRH, __VA_ARGS__) \
+    F(RHS, __VA_ARGS__) \
+    F(SHR, __VA_ARGS__)
+
+#define FOREACH_LOCAL_CLIFFORD_TARG(F, ...) \
+    F(I, __VA_ARGS__) \
+    F(X, __VA_ARGS__) \
+    F(Y, __VA_ARGS__) \
+    F(Z, __VA_ARGS__) \
+    F(H, __VA_ARGS__) \
+    F(S, __VA_ARGS__) \
+    F(R, __VA_ARGS__) \
+    F(HX, __VA_ARGS__) \
+    F(SX, __VA_ARGS__) \
+    F(RX, __VA_ARGS__) \
+    F(HY, __VA_ARGS__) \
+    F(HZ, __VA_ARGS__) \
+    F(SH, __VA_ARGS__) \
+    F(RH, __VA_ARGS__) \
+    F(HS, __VA_ARGS__) \
+    F(HR, __VA_ARGS__) \
+    F(HSX, __VA_ARGS__) \
+    F(HRX, __VA_ARGS__) \
+    F(SHY, __VA_ARGS__) \
+    F(RHY, __VA_ARGS__) \
+    F(HSH, __VA_ARGS__) \
+    F(HRH, __VA_ARGS__) \
+    F(RHS, __VA_ARGS__) \
+    F(SHR, __VA_ARGS__)
+
+#define N_FUSED_OPERATIONS (N_NON_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS)
+
+/*
+ * FUSED_OPERATION_IDX
+ * Index of a fused kernel in the FUSED_OPERATIONS_RANGE table
+ * :: opcode : instruction_t :: Non-local Clifford opcode
+ * :: ctrl_clifford : instruction_t :: Local Clifford on the control qubit
+ * :: targ_clifford : instruction_t :: Local Clifford on the target qubit
+ */
+#define FUSED_OPERATION_IDX(opcode, ctrl_clifford, targ_clifford) ( \
+    ((opcode) & INSTRUCTION_OPERATOR_MASK) * N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS \
+    + ((ctrl_clifford) & INSTRUCTION_OPERATOR_MASK) * N_LOCAL_CLIFFORDS \
+    + ((targ_clifford) & INSTRUCTION_OPERATOR_MASK))
+
+/*
+ * tableau_fused_<ctrl clifford>_<targ clifford>_<gate>_range
+ * Fused kernels, these are implemented per architecture 
+ * Applies the local Clifford on each qubit followed by the non-local Clifford in a single pass over the slices
+ * :: tab : tableau_t* :: The tableau to operate on 
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * :: start : const size_t :: First byte of each slice to operate on
+ * :: stop : const size_t :: Terminating byte of each slice 
+ */
+#define TABLEAU_FUSED_KERNEL_NAME(ctrl_clifford, targ_clifford, gate) \
+    SIMD_TIER_NAME(tableau_fused_##ctrl_clifford##_##targ_clifford##_##gate##_range)
+
+#define TABLEAU_FUSED_KERNEL_DECL(ctrl_clifford, targ_clifford, gate) \
+void TABLEAU_FUSED_KERNEL_NAME(ctrl_clifford, targ_clifford, gate)( \
+    tableau_t* tab, \
+    const size_t ctrl, \
+    const size_t targ, \
+    const size_t start, \
+    const size_t stop);
+
+#define TABLEAU_FUSED_KERNEL_DECL_TARG(targ_clifford, ctrl_clifford, gate) TABLEAU_FUSED_KERNEL_DECL(ctrl_clifford, targ_clifford, gate)
+#define TABLEAU_FUSED_KERNEL_DECL_CTRL(ctrl_clifford, gate) FOREACH_LOCAL_CLIFFORD_TARG(TABLEAU_FUSED_KERNEL_DECL_TARG, ctrl_clifford, gate)
+
+FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_DECL_CTRL, CNOT)
+FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_DECL_CTRL, CZ)
+
+/*
+ * tableau_fused
+ * Applies the queued local Cliffords and a non-local Clifford in a single pass
+ * :: tab : tableau_t* :: The tableau to operate on 
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ * Equivalent to applying the local Cliffords and then the non-local Clifford
+ */
+void tableau_fused(
+    tableau_t* tab,
+    const size_t ctrl,
+    const size_t targ,
+    const instruction_t ctrl_clifford,
+    const instruction_t targ_clifford,
+    const instruction_t opcode);
+
+#define TABLEAU_FUSED_KERNEL_ENTRY(targ_clifford, ctrl_clifford, gate) TABLEAU_FUSED_KERNEL_NAME(ctrl_clifford, targ_clifford, gate),
+#define TABLEAU_FUSED_KERNEL_ENTRY_CTRL(ctrl_clifford, gate) FOREACH_LOCAL_CLIFFORD_TARG(TABLEAU_FUSED_KERNEL_ENTRY, ctrl_clifford, gate)
+
+// Initialiser for a table of fused kernels
+#define FUSED_OPERATIONS_RANGE_TABLE { \
+    FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_ENTRY_CTRL, CNOT) \
+    FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_ENTRY_CTRL, CZ) \
+}
+
+#ifdef TABLEAU_FUSED_OPERATIONS_SRC
+    void (*FUSED_OPERATIONS_RANGE[N_FUSED_OPERATIONS])(tableau_t*, const size_t ctrl, const size_t targ, const size_t start, const size_t stop) = FUSED_OPERATIONS_RANGE_TABLE;
+#else
+    extern void (*FUSED_OPERATIONS_RANGE[])(tableau_t*, const size_t ctrl, const size_t targ, const size_t start, const size_t stop);
+#endif
+
+#endif
@@ -98,6 +98,78 @@ void tableau_SHR(tableau_t* tab, const size_t targ);
 void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ);
 void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ);
 
+/*
+ * tableau_<clifford>_range
+ * Range limited gate kernels, these are implemented per architecture
+ * The full slice gates above wrap these kernels
+ * :: tab : tableau_t* :: The tableau to operate on 
+ * :: targ : const size_t :: The target qubit
+ * :: start : const size_t :: First byte of each slice to operate on
+ * :: stop : const size_t :: Terminating byte of each slice 
+ * Start and stop should be multiples of CACHE_SIZE, or stop should be the slice length
+ * As each row of the tableau is updated independently, disjoint ranges may be operated on concurrently 
+ */
+void tableau_I_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_X_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_Y_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_Z_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_H_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_S_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_R_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HX_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_SX_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_RX_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HY_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HZ_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_SH_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_RH_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HS_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HR_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HSX_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HRX_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_SHY_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_RHY_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HSH_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_HRH_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_RHS_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+void tableau_SHR_range(tableau_t* tab, const size_t targ, const size_t start, const size_t stop);
+
+void tableau_CNOT_range(tableau_t* tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop);
+void tableau_CZ_range(tableau_t* tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop);
+
+// Initialisers for tables of range limited kernels
+#define SINGLE_QUBIT_OPERATIONS_RANGE_TABLE { \
+    tableau_I_range, \
+    tableau_X_range, \
+    tableau_Y_range, \
+    tableau_Z_range, \
+    tableau_H_range, \
+    tableau_S_range, \
+    tableau_R_range, \
+    tableau_HX_range, \
+    tableau_SX_range, \
+    tableau_RX_range, \
+    tableau_HY_range, \
+    tableau_HZ_range, \
+    tableau_SH_range, \
+    tableau_RH_range, \
+    tableau_HS_range, \
+    tableau_HR_range, \
+    tableau_HSX_range, \
+    tableau_HRX_range, \
+    tableau_SHY_range, \
+    tableau_RHY_range, \
+    tableau_HSH_range, \
+    tableau_HRH_range, \
+    tableau_RHS_range, \
+    tableau_SHR_range, \
+}
+
+#define TWO_QUBIT_OPERATIONS_RANGE_TABLE { \
+    tableau_CNOT_range, \
+    tableau_CZ_range, \
+}
+
 #ifdef TABLEAU_OPERATIONS_SRC
 
   void (*SINGLE_QUBIT_OPERATIONS[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t targ) = {
@@ -131,9 +203,15 @@ void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ);
         tableau_CZ
 };
 
+  void (*SINGLE_QUBIT_OPERATIONS_RANGE[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t targ, const size_t start, const size_t stop) = SINGLE_QUBIT_OPERATIONS_RANGE_TABLE;
+
+  void (*TWO_QUBIT_OPERATIONS_RANGE[N_NON_LOCAL_CLIFFORDS])(tableau_t*, const size_t ctrl, const size_t targ, const size_t start, const size_t stop) = TWO_QUBIT_OPERATIONS_RANGE_TABLE;
+
 #else
     extern void (*SINGLE_QUBIT_OPERATIONS[])(tableau_t*, const size_t targ);
     extern void (*TWO_QUBIT_OPERATIONS[])(tableau_t*, const size_t ctrl, const size_t targ);
+    extern void (*SINGLE_QUBIT_OPERATIONS_RANGE[])(tableau_t*, const size_t targ, const size_t start, const size_t stop);
+    extern void (*TWO_QUBIT_OPERATIONS_RANGE[])(tableau_t*, const size_t ctrl, const size_t targ, const size_t start, const size_t stop);
 #endif
 
 
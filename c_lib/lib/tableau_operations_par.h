@@ -0,0 +1,80 @@
+#ifndef TABLEAU_OPERATIONS_PAR_H
+#define TABLEAU_OPERATIONS_PAR_H
+
+#include "tableau_operations.h"
+#include "threadpool.h"
+
+/*
+ * tableau_<clifford>_par
+ * Threadpool adaptors for the range limited gate kernels
+ * :: args : void* :: Pointer to a struct distributed_tableau_op
+ * Single qubit operations act on the ctrl qubit of the distributed operation
+ * These should be dispatched using threadpool_distribute_tableau_operation
+ */
+void tableau_I_par(void* args);
+void tableau_X_par(void* args);
+void tableau_Y_par(void* args);
+void tableau_Z_par(void* args);
+void tableau_H_par(void* args);
+void tableau_S_par(void* args);
+void tableau_R_par(void* args);
+void tableau_HX_par(void* args);
+void tableau_SX_par(void* args);
+void tableau_RX_par(void* args);
+void tableau_HY_par(void* args);
+void tableau_HZ_par(void* args);
+void tableau_SH_par(void* args);
+void tableau_RH_par(void* args);
+void tableau_HS_par(void* args);
+void tableau_HR_par(void* args);
+void tableau_HSX_par(void* args);
+void tableau_HRX_par(void* args);
+void tableau_SHY_par(void* args);
+void tableau_RHY_par(void* args);
+void tableau_HSH_par(void* args);
+void tableau_HRH_par(void* args);
+void tableau_RHS_par(void* args);
+void tableau_SHR_par(void* args);
+
+void tableau_CNOT_par(void* args);
+void tableau_CZ_par(void* args);
+
+#ifdef TABLEAU_OPERATIONS_PAR_SRC
+
+  void (*SINGLE_QUBIT_OPERATIONS_PAR[N_LOCAL_CLIFFORDS])(void*) = {
+        tableau_I_par,
+        tableau_X_par,
+        tableau_Y_par,
+        tableau_Z_par,
+        tableau_H_par,
+        tableau_S_par,
+        tableau_R_par,
+        tableau_HX_par,
+        tableau_SX_par,
+        tableau_RX_par,
+        tableau_HY_par,
+        tableau_HZ_par,
+        tableau_SH_par,
+        tableau_RH_par,
+        tableau_HS_par,
+        tableau_HR_par,
+        tableau_HSX_par,
+        tableau_HRX_par,
+        tableau_SHY_par,
+        tableau_RHY_par,
+        tableau_HSH_par,
+        tableau_HRH_par,
+        tableau_RHS_par,
+        tableau_SHR_par};
+
+    void (*TWO_QUBIT_OPERATIONS_PAR[N_NON_LOCAL_CLIFFORDS])(void*) = {
+        tableau_CNOT_par,
+        tableau_CZ_par
+};
+
+#else
+    extern void (*SINGLE_QUBIT_OPERATIONS_PAR[])(void*);
+    extern void (*TWO_QUBIT_OPERATIONS_PAR[])(void*);
+#endif
+
+#endif
@@ -6,20 +6,97 @@
 #include <unistd.h>
 #include <errno.h>
 
-#include "tableau.h" 
+#include "tableau.h"
+#include "instruction_table.h"
 #include "linked_list.h"
+#include "numa.h"
 
-#define N_WORKERS (2)
 #define NULL_TARG (~(0ull))  // Null target
 
+// Tableau operations on slices shorter than this are not distributed
+// Below this size the cost of dispatch exceeds the cost of the operation
+#ifndef THREADPOOL_MIN_SLICE_BYTES
+#define THREADPOOL_MIN_SLICE_BYTES (1024)
+#endif
+
+// Maximum number of gates in a batch, this is the lookahead window of the dispatcher
+#ifndef THREADPOOL_BATCH_WINDOW
+#define THREADPOOL_BATCH_WINDOW (256)
+#endif
+
+// Batches that touch fewer bytes than this are applied on the calling thread
+#ifndef THREADPOOL_MIN_BATCH_BYTES
+#define THREADPOOL_MIN_BATCH_BYTES (1 << 16)
+#endif
+
+/*
+ * threadpool_pinning_e
+ * Placement of the workers on CPUs
+ * THREADPOOL_PIN_AUTO : Workers are pinned if the process spans more than one NUMA node
+ * THREADPOOL_PIN_NEVER : Workers are left to the scheduler
+ * THREADPOOL_PIN_ALWAYS : Workers are pinned whenever there is a CPU for each worker
+ * Pinned workers are spread evenly over the nodes, consecutive workers share a node
+ */
+enum threadpool_pinning_e
+{
+    THREADPOOL_PIN_AUTO = 0,
+    THREADPOOL_PIN_NEVER = 1,
+    THREADPOOL_PIN_ALWAYS = 2
+};
+
+/*
+ * gate_batch_op
+ * A single gate in a batch
+ * The queued local Cliffords on each qubit are applied before the non-local gate
+ * If targ is NULL_TARG then only the local Clifford on ctrl is applied
+ */
+struct gate_batch_op
+{
+    size_t ctrl;
+    size_t targ;
+    instruction_t ctrl_clifford;
+    instruction_t targ_clifford;
+    instruction_t opcode;
+};
+
+/*
+ * gate_batch_t
+ * Batch of gates acting on disjoint qubits
+ * As the gates commute they are split between the workers, each worker accumulates 
+ * phase updates in its own buffer which are then reduced into the tableau
+ */
+struct gate_batch_t
+{
+    size_t n_ops;
+    struct gate_batch_op ops[THREADPOOL_BATCH_WINDOW];
+    size_t epoch; // Incremented each time the batch is flushed 
+    size_t n_dependent; // Length of the dependent qubits array
+    size_t* dependent_qubits; // Epoch of the last batch to include each qubit
+    size_t phase_len; // Length of each phase buffer
+    void** phases; // Phase buffer for each worker
+};
+
+/*
+ * threadpool_t
+ * Each worker owns an ordered job queue
+ * Distributed tableau operations always assign the same range of rows to the same worker
+ * As rows of the tableau are independent under Clifford operations, successive distributed
+ * operations do not require a barrier between them
+ * When the workers are pinned, each range of rows is also served from the worker's NUMA node
+ */
 struct threadpool_t {
     size_t n_workers;
-    size_t active_workers;
-    pthread_t workers[N_WORKERS]; 
-    struct linked_list_t* job_queue; 
-    pthread_mutex_t queue_lock;  
-    bool alive; // Set to false to kill workers 
-    __uint128_t dependent_qubits; // Tracks qubits under operation
+    size_t active_jobs; // Queued or running jobs
+    size_t next_worker; // Round robin target for undistributed tasks
+    pthread_t* workers;
+    struct linked_list_t** job_queues;
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_cond; // Signalled when jobs are queued
+    pthread_cond_t idle_cond; // Signalled when all jobs have completed
+    bool alive; // Set to false to kill workers
+    struct gate_batch_t batch; // Tracks qubits under operation
+    size_t* worker_nodes; // NUMA node of each worker, zero for unpinned workers
+    size_t n_nodes; // Number of NUMA nodes spanned by the workers
 };
 typedef struct threadpool_t threadpool_t;
 
@@ -28,7 +105,8 @@ typedef struct threadpool_t threadpool_t;
     bool THREADPOOL_INITIALISED = 0;
 #else
     extern threadpool_t THREADPOOL_g;
-#endif 
+    extern bool THREADPOOL_INITIALISED;
+#endif
 
 
 struct threadpool_job
@@ -37,50 +115,44 @@ struct threadpool_job
     void* args;
 };
 
-struct threadpool_arg
-{
-    size_t thread_id;
-    void* job;
-}; 
-
-struct threadpool_barrier_t
-{
-    pthread_barrier_t barrier;         
-    uint32_t thread_count;
-};
-
 struct distributed_tableau_op
 {
     tableau_t* tab;
     size_t ctrl;
-    size_t targ; 
-    size_t start;
-    size_t stop;
+    size_t targ;
+    size_t start; // First byte of each slice
+    size_t stop; // Terminating byte of each slice
+    void (*kernel)(tableau_t*, const size_t, const size_t, const size_t, const size_t); // Optional range limited kernel
 };
 
 /*
  * threadpool_worker
  * Threadpool worker function
- * :: args : void* ::
- * Polls the queue and pops items from it
- * Queue items should be function pointers and associated arguments  
- * Args are NULL
+ * :: args : void* :: Worker index
+ * Polls the worker's queue and pops items from it
+ * Queue items should be function pointers and associated arguments
  * Returns NULL
  */
 void* threadpool_worker(void* args);
 
 /*
+ * threadpool_add_task
  * Adds a job to the threadpool
+ * :: fn : void (*)(void*) :: Function to call
+ * :: args : void* :: Arguments to the function, owned by the caller
+ * Tasks are assigned to workers in a round robin fashion
  */
 void threadpool_add_task(void (*fn)(void*), void* args);
 
 /*
- * threadpool_distribute_tableau_operation_single
- * Distributes a tableau operation over the workers 
+ * threadpool_distribute_tableau_operation
+ * Distributes a tableau operation over the workers
  * :: tab : tableau_t* :: Tableau to operate over
- * :: fn : void* (*)(void*) :: Function to distriute
- * :: ctrl : const size_t :: First qubit 
+ * :: fn : void (*)(void*) :: Function to distribute, called with a struct distributed_tableau_op*
+ * :: ctrl : const size_t :: First qubit
  * :: targ : const size_t :: Second qubit, set to NULL_TARG to null
+ * Each worker is assigned a cache aligned range of bytes of each slice
+ * The slice length of the tableau must not change until the next barrier
  */
 void threadpool_distribute_tableau_operation(
     tableau_t* tab,
@@ -89,27 +161,124 @@ void threadpool_distribute_tableau_operation(
     const size_t targ);
 
 /*
- * threadpool_barrier 
- * Adds a task to the threadpool that is just a barrier
- * This forces threads to complete before the next task may resume 
- * :: 
+ * threadpool_distribute_tableau_kernel
+ * Distributes a range limited two qubit kernel over the workers
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: kernel : void (*)(tableau_t*, size_t, size_t, size_t, size_t) :: Range limited kernel 
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit
+ * The slice length of the tableau must not change until the next barrier
+ */
+void threadpool_distribute_tableau_kernel(
+    tableau_t* tab,
+    void (*kernel)(tableau_t*, const size_t, const size_t, const size_t, const size_t),
+    const size_t ctrl,
+    const size_t targ);
+
+/*
+ * threadpool_gate_batch_push
+ * Adds a gate to the current batch
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit, set to NULL_TARG to only apply the local Clifford on ctrl
+ * :: ctrl_clifford : const instruction_t :: Local Clifford queued on the first qubit 
+ * :: targ_clifford : const instruction_t :: Local Clifford queued on the second qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ * If the gate shares a qubit with the batch or the batch is full then the batch is flushed first
+ */
+void threadpool_gate_batch_push(
+    tableau_t* tab,
+    const size_t ctrl,
+    const size_t targ,
+    const instruction_t ctrl_clifford,
+    const instruction_t targ_clifford,
+    const instruction_t opcode);
+
+/*
+ * threadpool_gate_batch_flush
+ * Applies all gates in the current batch to the tableau
+ * :: tab : tableau_t* :: Tableau to operate over
+ * Small batches are applied on the calling thread, otherwise the gates are split between the workers
+ * Blocks until the batch has been applied
+ */
+void threadpool_gate_batch_flush(tableau_t* tab);
+
+/*
+ * threadpool_distributable
+ * Checks if operations on a tableau should be distributed
+ * :: tab : const tableau_t* :: Tableau to operate over
+ * Returns false if the threadpool is not running or the tableau is too small
+ */
+bool threadpool_distributable(const tableau_t* tab);
+
+/*
+ * threadpool_barrier
+ * Blocks until all queued tasks have completed
+ * This must be called before the tableau is accessed outside of the threadpool
  */
 void threadpool_barrier();
 
 /*
  * threadpool_join
+ * Completes all queued tasks and then stops the workers
  */
 void threadpool_join();
 
 /*
- * threadpool_join
+ * threadpool_destroy
+ * Joins the workers and frees the threadpool resources
  */
 void threadpool_destroy();
 
 /*
  * threadpool_init
+ * Starts the threadpool
+ * :: n_workers : const size_t :: Number of workers, zero uses the number of online cores
+ * Re-initialising a running threadpool joins the existing workers first
+ */
+void threadpool_init(const size_t n_workers);
+
+/*
+ * threadpool_set_pinning
+ * threadpool_get_pinning
+ * Sets the placement of the workers of subsequently started threadpools
+ * :: pinning : const enum threadpool_pinning_e :: Placement 
+ * Defaults to THREADPOOL_PIN_AUTO
+ */
+void threadpool_set_pinning(const enum threadpool_pinning_e pinning);
+enum threadpool_pinning_e threadpool_get_pinning();
+
+/*
+ * threadpool_get_n_nodes
+ * Returns the number of NUMA nodes spanned by the running workers, one if the workers are not pinned
  */
-void threadpool_init();
+size_t threadpool_get_n_nodes();
 
+/*
+ * threadpool_worker_range
+ * Range of bytes of each slice assigned to a worker by the distributed tableau operations
+ * :: slice_len : const size_t :: Length of each slice in bytes
+ * :: worker : const size_t :: Worker index
+ * :: start : size_t* :: Set to the first byte of the range
+ * :: stop : size_t* :: Set to the terminating byte of the range
+ * The range is empty if there are fewer cache lines than workers
+ */
+void threadpool_worker_range(const size_t slice_len, const size_t worker, size_t* start, size_t* stop);
+
+/*
+ * threadpool_detach_thread
+ * Marks the calling thread as detached from the threadpool
+ * :: detached : const bool :: Whether the thread is detached
+ * On a detached thread the threadpool reports no workers and barriers return immediately,
+ * so tableau operations on that thread are applied serially
+ * This allows several threads to each operate on their own tableau
+ */
+void threadpool_detach_thread(const bool detached);
+
+/*
+ * threadpool_get_n_workers
+ * Returns the number of running workers, zero if the threadpool is not initialised or the thread is detached
+ */
+size_t threadpool_get_n_workers();
 
 #endif
@@ -16,6 +16,16 @@
 
 #define WMAP_LOOKUP(widget, idx) (widget->q_map[idx])
 
+// Factor by which the tableau grows when a qubit is allocated beyond its capacity
+#ifndef WIDGET_GROWTH_FACTOR
+#define WIDGET_GROWTH_FACTOR (2)
+#endif
+
+// Number of released widgets retained for reuse by widget_pool_acquire
+#ifndef WIDGET_POOL_SIZE
+#define WIDGET_POOL_SIZE (4)
+#endif
+
 struct widget_t {
     size_t n_qubits;
     size_t n_initial_qubits;
@@ -41,6 +51,49 @@ typedef struct widget_t widget_t;
  */
 widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits);
 
+/*
+ * widget_reserve
+ * Grows the tableau to hold at least a number of qubits
+ * :: wid : widget_t* :: Widget 
+ * :: n_qubits : const size_t :: Number of qubits, must not exceed the maximum number of qubits 
+ * The tableau starts at the initial number of qubits and grows geometrically up to the maximum
+ * Must not be called with tableau operations in flight 
+ */
+void widget_reserve(widget_t* wid, const size_t n_qubits);
+
+
+/*
+ * widget_reset
+ * Restores a widget to the state of a newly created widget with the same initial and maximum qubits
+ * :: wid : widget_t* :: Widget 
+ * Only the qubits that the widget has allocated are cleared, the tableau keeps its capacity
+ * The Pauli tracker is replaced
+ * Must not be called with tableau operations in flight 
+ */
+void widget_reset(widget_t* wid);
+
+/*
+ * widget_pool_acquire
+ * Constructor for a widget that reuses a released widget with the same maximum qubits
+ * :: initial_qubits : const size_t :: Initial number of allocated qubits for the widget
+ * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated
+ * Falls back to widget_create if no such widget has been released
+ */
+widget_t* widget_pool_acquire(const size_t initial_qubits, const size_t max_qubits);
+
+/*
+ * widget_pool_release
+ * Returns a widget to the pool
+ * :: wid : widget_t* :: Widget, must not be used after release 
+ * The widget is destroyed if the pool already holds WIDGET_POOL_SIZE widgets
+ */
+void widget_pool_release(widget_t* wid);
+
+/*
+ * widget_pool_clear
+ * Destroys all widgets held by the pool
+ */
+void widget_pool_clear();
 
 /*
  * widget_get_clifford_from_table
@@ -65,6 +118,15 @@ void widget_destroy(widget_t* wid);
  */
 void widget_decompose(widget_t* wid);
 
+/*
+ * widget_decompose_m4ri
+ * Decomposes the stabiliser tableau into a graph state plus local Cliffords
+ * :: wid : widget_t* :: Widget to decompose
+ * Acts in place on the tableau
+ * Eliminates with tables of pivot row products, produces the same decomposition as widget_decompose
+ */
+void widget_decompose_m4ri(widget_t* wid);
+
 /*
  * widget_get_n_qubits
  * widget_get_n_initial_qubits
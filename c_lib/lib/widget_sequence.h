@@ -0,0 +1,156 @@
+#ifndef WIDGET_SEQUENCE_H
+#define WIDGET_SEQUENCE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "widget.h"
+#include "input_stream.h"
+#include "threadpool.h"
+#include "instruction_file.h"
+
+// Default number of widgets that may be compiled ahead of the consumer
+#ifndef WIDGET_SEQUENCE_WINDOW
+#define WIDGET_SEQUENCE_WINDOW (4)
+#endif
+
+/*
+ * widget_sequence_t
+ * Splits an instruction stream into widgets and compiles them concurrently
+ * Each widget teleports its inputs, consumes its block of instructions and is decomposed
+ * Compile threads are detached from the threadpool, each widget is compiled serially on one thread
+ * At most window widgets are held between compilation and the consumer,
+ * widgets are returned to the consumer in order
+ */
+struct widget_sequence_t
+{
+    instruction_stream_u* instructions; // Borrowed, must outlive the sequence
+    const uint8_t* packed; // Borrowed packed stream, used in place of instructions when set
+    size_t qubit_width;
+    size_t max_qubits;
+    size_t n_widgets;
+    size_t* starts; // First instruction of each widget, terminated by the stream length, byte offsets for packed streams
+    size_t window; // Number of slots
+    widget_t** slots; // Compiled widgets, indexed by widget modulo window
+    size_t next_compile; // Next widget to be claimed by a compile thread
+    size_t next_yield; // Next widget to be returned to the consumer
+    size_t n_threads;
+    pthread_t* threads;
+    pthread_mutex_t lock;
+    pthread_cond_t compiled_cond; // Signalled when a widget has been compiled
+    pthread_cond_t space_cond; // Signalled when a widget has been returned, or on shutdown
+    bool alive; // Set to false to stop the compile threads
+};
+typedef struct widget_sequence_t widget_sequence_t;
+
+/*
+ * widget_sequence_split
+ * Splits an instruction stream on an Rz budget
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: rz_threshold : const size_t :: Maximum number of Rz gates in each block
+ * :: starts : size_t* :: Optional, set to the first instruction of each block followed by n_instructions
+ * Each block other than the last holds exactly rz_threshold Rz gates, the next block starts at the next Rz gate
+ * Returns the number of blocks
+ */
+size_t widget_sequence_split(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t rz_threshold,
+    size_t* starts);
+
+/*
+ * widget_sequence_split_packed
+ * Splits a packed instruction stream on an Rz budget
+ * :: packed : const uint8_t* :: Packed instructions
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: rz_threshold : const size_t :: Maximum number of Rz gates in each block
+ * :: starts : size_t* :: Optional, set to the byte offset of each block followed by n_bytes
+ * Splits at the same instructions as widget_sequence_split
+ * Returns the number of blocks
+ */
+size_t widget_sequence_split_packed(
+    const uint8_t* packed,
+    const size_t n_bytes,
+    const size_t rz_threshold,
+    size_t* starts);
+
+/*
+ * widget_sequence_create
+ * Starts compiling a sequence of widgets
+ * :: instructions : instruction_stream_u* :: Array of instructions, must outlive the sequence
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: qubit_width : const size_t :: Number of initial qubits in each widget
+ * :: max_qubits : const size_t :: Maximum number of qubits in each widget
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer, zero uses WIDGET_SEQUENCE_WINDOW
+ * The stream is split such that each widget may allocate a qubit for each Rz gate
+ */
+widget_sequence_t* widget_sequence_create(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_threads,
+    const size_t window);
+
+/*
+ * widget_sequence_create_packed
+ * Starts compiling a sequence of widgets from a packed stream
+ * :: packed : const uint8_t* :: Packed instructions, must outlive the sequence
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: qubit_width : const size_t :: Number of initial qubits in each widget
+ * :: max_qubits : const size_t :: Maximum number of qubits in each widget
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer, zero uses WIDGET_SEQUENCE_WINDOW
+ */
+widget_sequence_t* widget_sequence_create_packed(
+    const uint8_t* packed,
+    const size_t n_bytes,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_threads,
+    const size_t window);
+
+/*
+ * widget_sequence_create_file
+ * Starts compiling a sequence of widgets from a mapped instruction file of either encoding
+ * :: file : const instruction_file_t* :: File, must outlive the sequence
+ * :: qubit_width : const size_t :: Number of initial qubits in each widget
+ * :: max_qubits : const size_t :: Maximum number of qubits in each widget
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer, zero uses WIDGET_SEQUENCE_WINDOW
+ */
+widget_sequence_t* widget_sequence_create_file(
+    const instruction_file_t* file,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_threads,
+    const size_t window);
+
+/*
+ * widget_sequence_get_n_widgets
+ * Returns the number of widgets in the sequence
+ * :: seq : const widget_sequence_t* :: Sequence
+ */
+size_t widget_sequence_get_n_widgets(const widget_sequence_t* seq);
+
+/*
+ * widget_sequence_next
+ * Returns the next widget in the sequence
+ * :: seq : widget_sequence_t* :: Sequence
+ * Blocks until the widget has been compiled
+ * The widget is owned by the caller and should be freed with widget_pool_release
+ * Returns NULL once every widget has been returned
+ */
+widget_t* widget_sequence_next(widget_sequence_t* seq);
+
+/*
+ * widget_sequence_destroy
+ * Stops the compile threads and frees the sequence
+ * :: seq : widget_sequence_t* :: Sequence
+ * Widgets that have not been returned are released
+ */
+void widget_sequence_destroy(widget_sequence_t* seq);
+
+#endif
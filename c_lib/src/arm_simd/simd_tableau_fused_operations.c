@@ -0,0 +1,143 @@
+#define INSTRUCTIONS_TABLE
+#define TABLEAU_FUSED_OPERATIONS_SRC
+
+#include "tableau_fused_operations.h"
+
+/*
+ * local_clifford_vec
+ * Applies a local Clifford to a lane of rows
+ * :: params : const uint8_t :: Local Clifford parameters, should be a compile time constant
+ * :: x : uint8x16_t* :: X bits of the qubit
+ * :: z : uint8x16_t* :: Z bits of the qubit
+ * :: r : uint8x16_t* :: Phase bits
+ * With constant parameters the branches are resolved at compile time
+ */
+static inline __attribute__((always_inline))
+void __inline_local_clifford_vec(
+    const uint8_t params,
+    uint8x16_t* x,
+    uint8x16_t* z,
+    uint8x16_t* r)
+{
+    const uint8x16_t x0 = *x;
+    const uint8x16_t z0 = *z;
+
+    if (LOCAL_CLIFFORD_P(params)) { *r = veorq_u8(*r, x0); }
+    if (LOCAL_CLIFFORD_Q(params)) { *r = veorq_u8(*r, z0); }
+    if (LOCAL_CLIFFORD_S(params)) { *r = veorq_u8(*r, vandq_u8(x0, z0)); }
+
+    if (LOCAL_CLIFFORD_A(params) && LOCAL_CLIFFORD_B(params)) { *x = veorq_u8(x0, z0); }
+    else if (LOCAL_CLIFFORD_B(params)) { *x = z0; }
+
+    if (LOCAL_CLIFFORD_C(params) && LOCAL_CLIFFORD_D(params)) { *z = veorq_u8(x0, z0); }
+    else if (LOCAL_CLIFFORD_C(params)) { *z = x0; }
+}
+
+/*
+ * tableau_fused_range
+ * Generic fused kernel
+ * :: tab : tableau_t* :: The tableau to operate on 
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * :: start : const size_t :: First byte of each slice to operate on
+ * :: stop : const size_t :: Terminating byte of each slice 
+ * :: ctrl_params : const uint8_t :: Local Clifford parameters for the control qubit
+ * :: targ_params : const uint8_t :: Local Clifford parameters for the target qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ * Each slice is loaded and stored at most once, slices that are not changed are not stored
+ */
+static inline __attribute__((always_inline))
+void __inline_tableau_fused_range(
+    tableau_t* restrict tab,
+    const size_t ctrl,
+    const size_t targ,
+    const size_t start,
+    const size_t stop,
+    const uint8_t ctrl_params,
+    const uint8_t targ_params,
+    const instruction_t opcode)
+{
+    const bool cnot = (_CNOT_ == opcode);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]); 
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]); 
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
+        uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
+        uint8x16_t targ_x = vld1q_u8(targ_slice_x + i);
+        uint8x16_t targ_z = vld1q_u8(targ_slice_z + i);
+        uint8x16_t r = vld1q_u8(slice_r + i);
+
+        __inline_local_clifford_vec(ctrl_params, &ctrl_x, &ctrl_z, &r);
+        __inline_local_clifford_vec(targ_params, &targ_x, &targ_z, &r);
+
+        if (cnot)
+        {
+            // See tableau_CNOT
+            r = veorq_u8(r,
+                vandq_u8(
+                    vmvnq_u8(veorq_u8(targ_x, ctrl_z)), 
+                    vandq_u8(ctrl_x, targ_z) 
+                )
+            );
+            targ_x = veorq_u8(ctrl_x, targ_x);
+            ctrl_z = veorq_u8(ctrl_z, targ_z);
+        }
+        else
+        {
+            // See tableau_CZ
+            uint8x16_t x_and_x = vandq_u8(ctrl_x, targ_x);
+            r = veorq_u8(r,
+                veorq_u8(
+                    vandq_u8(x_and_x, ctrl_z), 
+                    vandq_u8(x_and_x, targ_z) 
+                )
+            );
+            targ_z = veorq_u8(ctrl_x, targ_z);
+            ctrl_z = veorq_u8(ctrl_z, targ_x);
+        }
+
+        // Both gates fix the x bits of the control and update the z bits of the control
+        if (!LOCAL_CLIFFORD_FIXES_X(ctrl_params))
+        {
+            vst1q_u8(ctrl_slice_x + i, ctrl_x);
+        }
+        vst1q_u8(ctrl_slice_z + i, ctrl_z);
+
+        if (cnot || !LOCAL_CLIFFORD_FIXES_X(targ_params))
+        {
+            vst1q_u8(targ_slice_x + i, targ_x);
+        }
+        if (!cnot || !LOCAL_CLIFFORD_FIXES_Z(targ_params))
+        {
+            vst1q_u8(targ_slice_z + i, targ_z);
+        }
+        vst1q_u8(slice_r + i, r);
+    }
+}
+
+#define TABLEAU_FUSED_KERNEL(ctrl_clifford, targ_clifford, gate) \
+void TABLEAU_FUSED_KERNEL_NAME(ctrl_clifford, targ_clifford, gate)( \
+    tableau_t* restrict tab, \
+    const size_t ctrl, \
+    const size_t targ, \
+    const size_t start, \
+    const size_t stop) \
+{ \
+    __inline_tableau_fused_range( \
+        tab, ctrl, targ, start, stop, \
+        LOCAL_CLIFFORD_PARAMS_##ctrl_clifford, \
+        LOCAL_CLIFFORD_PARAMS_##targ_clifford, \
+        _##gate##_); \
+}
+
+#define TABLEAU_FUSED_KERNEL_TARG(targ_clifford, ctrl_clifford, gate) TABLEAU_FUSED_KERNEL(ctrl_clifford, targ_clifford, gate)
+#define TABLEAU_FUSED_KERNEL_CTRL(ctrl_clifford, gate) FOREACH_LOCAL_CLIFFORD_TARG(TABLEAU_FUSED_KERNEL_TARG, ctrl_clifford, gate)
+
+FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_CTRL, CNOT)
+FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_CTRL, CZ)
@@ -3,7 +3,7 @@
 
 #include "tableau_operations.h"
 
-void tableau_H(tableau_t* restrict tab, const size_t targ)
+void tableau_H_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * x -> z
@@ -14,7 +14,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);   
@@ -27,7 +27,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_S(tableau_t* restrict tab, const size_t targ)
+void tableau_S_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * x -> x  
@@ -38,7 +38,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -53,7 +53,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Z(tableau_t* restrict tab, const size_t targ)
+void tableau_Z_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
 /*
  * Doubled S gate
@@ -67,7 +67,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -81,7 +81,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_R(tableau_t* restrict tab, const size_t targ)
+void tableau_R_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Triple S gate
@@ -102,7 +102,7 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -119,12 +119,12 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_I(tableau_t* restrict tab, const size_t targ)
+void tableau_I_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     return;
 }
 
-void tableau_X(tableau_t* restrict tab, const size_t targ)
+void tableau_X_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
 /*
  * HZH Gate
@@ -148,7 +148,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t z = vld1q_u8(slice_z + i);
         uint8x16_t r = vld1q_u8(slice_r + i);
@@ -157,7 +157,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Y(tableau_t* restrict tab, const size_t targ)
+void tableau_Y_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Y = XZ
@@ -175,7 +175,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -189,7 +189,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HX(tableau_t* restrict tab, const size_t targ)
+void tableau_HX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -206,7 +206,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -222,7 +222,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SX(tableau_t* restrict tab, const size_t targ)
+void tableau_SX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -238,7 +238,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -256,7 +256,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_RX(tableau_t* restrict tab, const size_t targ)
+void tableau_RX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -273,7 +273,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -289,7 +289,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HZ(tableau_t* restrict tab, const size_t targ)
+void tableau_HZ_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Z : (r ^= x)
@@ -307,7 +307,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -325,7 +325,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_HY(tableau_t* restrict tab, const size_t targ)
+void tableau_HY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Y : r ^= x ^ z
@@ -343,7 +343,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -362,7 +362,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SH(tableau_t* restrict tab, const size_t targ)
+void tableau_SH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * H : (r ^= x.z; x <-> z) 
@@ -382,7 +382,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -396,7 +396,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RH(tableau_t* restrict tab, const size_t targ)
+void tableau_RH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -417,7 +417,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -430,7 +430,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_HS(tableau_t* restrict tab, const size_t targ)
+void tableau_HS_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -453,7 +453,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
      * x_2 = z_1 = z ^ x  
      *
      */
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -465,7 +465,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HR(tableau_t* restrict tab, const size_t targ)
+void tableau_HR_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -488,7 +488,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -498,7 +498,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HSX(tableau_t* restrict tab, const size_t targ)
+void tableau_HSX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -524,7 +524,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -540,7 +540,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRX(tableau_t* restrict tab, const size_t targ)
+void tableau_HRX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -565,7 +565,7 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -577,13 +577,13 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SHY(tableau_t* restrict tab, const size_t targ)
+void tableau_SHY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -595,13 +595,13 @@ void tableau_SHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_RHY(tableau_t* restrict tab, const size_t targ)
+void tableau_RHY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -613,14 +613,14 @@ void tableau_RHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HSH(tableau_t* restrict tab, const size_t targ)
+void tableau_HSH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
 
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -636,13 +636,13 @@ void tableau_HSH(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRH(tableau_t* restrict tab, const size_t targ)
+void tableau_HRH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -659,13 +659,13 @@ void tableau_HRH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RHS(tableau_t* restrict tab, const size_t targ)
+void tableau_RHS_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -682,13 +682,13 @@ void tableau_RHS(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SHR(tableau_t* restrict tab, const size_t targ)
+void tableau_SHR_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -704,7 +704,7 @@ void tableau_SHR(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void tableau_CNOT_range(tableau_t* restrict tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * CNOT a, b: ( 
@@ -720,7 +720,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
         uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
@@ -741,7 +741,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     }
 }
 
-void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void tableau_CZ_range(tableau_t* restrict tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop)
 {
     /* CZ = H_b CNOT H_b 
      * H : (r ^= x.z; x <-> z) 
@@ -785,7 +785,7 @@ void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
         uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
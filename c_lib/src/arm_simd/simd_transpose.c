@@ -550,79 +550,86 @@ void simd_transpose_2x16(uint8_t** src, uint8_t** targ)
 }
 
 
-void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+/*
+ * transpose_64x64_words
+ * Transposes a 64x64 bit block held in words
+ * :: rows : uint64_t* :: Rows of the block 
+ * Recursively swaps the off diagonal blocks of width 32, 16, 8, 4, 2 and 1
+ * Each round is a fixed pattern of word operations that the compiler vectorises
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_64x64_words(uint64_t rows[64])
 {
-     uint64_t src_block[64] = {0};
-     uint64_t targ_block[64] = {0};
-    
-     uint64_t* src_ptr[16];
-     uint64_t* targ_ptr[16] = {NULL};
+    uint64_t mask = 0x00000000ffffffffull;
 
-
-    for (size_t col = 0; col < 4; col++) 
+    #pragma GCC unroll 6
+    for (size_t width = 32; width > 0; width >>= 1, mask ^= (mask << width))
     {
-        for (size_t row = 0; row < 4; row++)  
+        #pragma GCC unroll 64
+        for (size_t i = 0; i < 64; i++)
         {
-            for (size_t i = 0; i < 16; i++)
+            if (!(i & width))
             {
-                targ_ptr[i] = (uint64_t*)(((uint16_t*)(targ_block + i + 16 * row)) + col);
-                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_a[i + 16 * col])) + row); 
+                const uint64_t t = ((rows[i] >> width) ^ rows[i + width]) & mask;
+                rows[i] ^= (t << width);
+                rows[i + width] ^= t;
             }
-            simd_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
         }
     }
+}
 
+/*
+ * simd_transpose_64x64
+ * Transposes two 64x64 bit blocks and exchanges them
+ * :: block_a : uint64_t** :: Rows of the first block
+ * :: block_b : uint64_t** :: Rows of the second block
+ */
+void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+{
+    uint64_t rows_a[64];
+    uint64_t rows_b[64];
 
-    for (size_t col = 0; col < 4; col++) 
+    #pragma GCC unroll 64
+    for (size_t i = 0; i < 64; i++)
     {
-        for (size_t row = 0; row < 4; row++)  
-        {
-            for (size_t i = 0; i < 16; i++)
-            {
-                targ_ptr[i] = (uint64_t*)(((uint16_t*)(src_block + i + 16 * row)) + col);
-                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_b[i + 16 * col])) + row); 
-            }
-            simd_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
-        }
+        rows_a[i] = *block_a[i];
+        rows_b[i] = *block_b[i];
     }
 
+    __inline_transpose_64x64_words(rows_a);
+    __inline_transpose_64x64_words(rows_b);
+
+    #pragma GCC unroll 64
     for (size_t i = 0; i < 64; i++)
     {
-        memcpy(block_a[i], src_block + i, 8); 
-        memcpy(block_b[i], targ_block + i, 8); 
-    } 
- 
+        *block_a[i] = rows_b[i];
+        *block_b[i] = rows_a[i];
+    }
     return;
 }
+
+/*
+ * simd_transpose_64x64_inplace
+ * Transposes a 64x64 bit block 
+ * :: block_a : uint64_t** :: Rows of the block
+ */
 void simd_transpose_64x64_inplace(uint64_t* block_a[64])
 {
-     uint64_t targ_block[64] = {0};
-    
-     uint64_t* restrict src_ptr[16];
-     uint64_t* restrict targ_ptr[16] = {NULL};
-
+    uint64_t rows[64];
 
-    #pragma GCC unroll 4
-    for (size_t col = 0; col < 4; col++) 
+    #pragma GCC unroll 64
+    for (size_t i = 0; i < 64; i++)
     {
-        #pragma GCC unroll 4
-        for (size_t row = 0; row < 4; row++)  
-        {
-
-            #pragma GCC unroll 16 
-            for (size_t i = 0; i < 16; i++)
-            {
-                targ_ptr[i] = (uint64_t*)(((uint16_t*)(targ_block + i + 16 * row)) + col);
-                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_a[i + 16 * col])) + row); 
-            }
-            simd_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);                     
-        }
+        rows[i] = *block_a[i];
     }
+
+    __inline_transpose_64x64_words(rows);
+
+    #pragma GCC unroll 64
     for (size_t i = 0; i < 64; i++)
     {
-        memcpy(block_a[i], targ_block + i, 8); 
-    } 
- 
+        *block_a[i] = rows[i];
+    }
     return;
 }
 
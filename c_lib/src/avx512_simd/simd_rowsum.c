@@ -0,0 +1,495 @@
+#include "simd_rowsum.h"
+
+#define MASK_0 (0x0101010101010101ull) 
+#define MASK_1 (0x0202020202020202ull) 
+#define MASK_2 (0x0404040404040404ull) 
+#define MASK_3 (0x0808080808080808ull) 
+#define MASK_4 (0x1010101010101010ull) 
+#define MASK_5 (0x2020202020202020ull) 
+#define MASK_6 (0x4040404040404040ull) 
+#define MASK_7 (0x8080808080808080ull) 
+
+#define POS_CTRL_X (0) 
+#define POS_CTRL_Z (1) 
+#define POS_TARG_X (2) 
+#define POS_TARG_Z (3) 
+
+#define NIL (0)
+#define PLS (1)
+#define MNS ((int16_t) -1) 
+
+#define NAIVE_LOOKUP_TABLE 0, 0, 0, 0, 0, 0, 1, 3, 0, 3, 0, 1, 0, 1, 3, 0
+
+#define ROWSUM_MASK MASK_0, MASK_0, MASK_0, MASK_0
+
+// Shuffle lookup table        00   01   10   11                             
+#define ROWSUM_SHUFFLE_MASK_00 NIL, NIL, NIL, NIL
+#define ROWSUM_SHUFFLE_MASK_01 NIL, NIL, PLS, MNS 
+#define ROWSUM_SHUFFLE_MASK_10 NIL, MNS, NIL, PLS 
+#define ROWSUM_SHUFFLE_MASK_11 NIL, PLS, MNS, NIL
+
+#define ROWSUM_SHUFFLE_SEQ ROWSUM_SHUFFLE_MASK_00, ROWSUM_SHUFFLE_MASK_01, ROWSUM_SHUFFLE_MASK_10, ROWSUM_SHUFFLE_MASK_11
+#define ROWSUM_SHUFFLE_MASK ROWSUM_SHUFFLE_SEQ, ROWSUM_SHUFFLE_SEQ 
+
+/*          Structure of naive implementation is:
+ *          if ((b_ctrl_x == 1) && (b_ctrl_z == 0))
+ *          {
+ *              acc += b_targ_z * (2 * b_targ_x - 1); 
+ *          }
+ *          else if ((b_ctrl_x == 0) && (b_ctrl_z == 1))
+ *          {
+ *              acc += b_targ_x * (1 - 2 * b_targ_z);
+ *          }
+ *          else if ((b_ctrl_x == 1) && (b_ctrl_z == 1))
+ *          {
+ *              acc += b_targ_z - b_targ_x;
+ *          }
+ */
+
+/*
+ * simd_rowsum 
+ * Performs a rowsum between two rows of stabilisers 
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: CHUNK_OBJ* :: Control X vec 
+ * :: ctrl_z :: CHUNK_OBJ* :: Control Z vec 
+ * :: targ_x :: CHUNK_OBJ* :: Target X vec 
+ * :: targ_z :: CHUNK_OBJ* :: Target Z vec 
+ * Returns the phase term 
+ */
+int8_t simd_rowsum(
+    const size_t n_bytes,
+    void* restrict ctrl_x, 
+    void* restrict ctrl_z, 
+    void* restrict targ_x, 
+    void* restrict targ_z 
+)
+{
+    __m512i mask = _mm512_set1_epi64(MASK_0); 
+    // The byte shuffle acts within each 128 bit lane
+    __m512i lookup = _mm512_broadcast_i32x4(_mm_setr_epi8(ROWSUM_SHUFFLE_SEQ)); 
+    __m512i accumulator = _mm512_setzero_si512(); 
+
+    for (size_t i = 0; i < n_bytes; i += ROWSUM_STRIDE)
+    {
+        const __mmask64 tail = AVX512_TAIL_MASK(n_bytes - i);
+
+        // Load vecs, bytes past the end of the chunk are zeroed and do not contribute to the phase 
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi8(tail, ctrl_x + i);
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi8(tail, ctrl_z + i);
+        __m512i v_targ_x = _mm512_maskz_loadu_epi8(tail, targ_x + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi8(tail, targ_z + i);
+
+        // Perform XOR operations
+        _mm512_mask_storeu_epi8(targ_x + i, tail, _mm512_xor_si512(v_ctrl_x, v_targ_x)); 
+        _mm512_mask_storeu_epi8(targ_z + i, tail, _mm512_xor_si512(v_ctrl_z, v_targ_z)); 
+
+        // Strictly required to unroll the shifts
+        // Without this pragma the variables are not 
+        // correctly treated as immediates and the code
+        // will fail to compile  
+        #pragma GCC unroll 8
+        for (uint8_t j = 0; j < 8; j++)
+        {   
+            __m512i lane = _mm512_and_si512(mask, _mm512_srli_epi16(v_ctrl_x, j)); 
+
+            // lane |= mask & (v >> j) << POS 
+            lane = _mm512_ternarylogic_epi64(
+                lane,
+                _mm512_slli_epi16(_mm512_srli_epi16(v_ctrl_z, j), POS_CTRL_Z), 
+                _mm512_slli_epi16(mask, POS_CTRL_Z),
+                TERNLOG_A_OR_BC
+            );
+            lane = _mm512_ternarylogic_epi64(
+                lane,
+                _mm512_slli_epi16(_mm512_srli_epi16(v_targ_x, j), POS_TARG_X), 
+                _mm512_slli_epi16(mask, POS_TARG_X),
+                TERNLOG_A_OR_BC
+            );
+            lane = _mm512_ternarylogic_epi64(
+                lane,
+                _mm512_slli_epi16(_mm512_srli_epi16(v_targ_z, j), POS_TARG_Z), 
+                _mm512_slli_epi16(mask, POS_TARG_Z),
+                TERNLOG_A_OR_BC
+            );
+
+            // Accumulator overflow is just a mod 4 operation
+            accumulator = _mm512_add_epi8(accumulator, _mm512_shuffle_epi8(lookup, lane));  
+        }
+    }  
+
+    // Load the accumulator back to regular memory
+    int8_t acc[64];  
+    _mm512_storeu_si512((void*)acc, accumulator);
+    for (size_t i = 1; i < 64; i++)
+    {
+        acc[0] += acc[i];
+    }
+    return acc[0];
+}
+
+
+/*
+ * simd_xor_rowsum 
+ * Performs a rowsum between two rows of stabilisers 
+ * This uses simd operations for the xor but not the phase accumulator
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: CHUNK_OBJ* :: Control X vec 
+ * :: ctrl_z :: CHUNK_OBJ* :: Control Z vec 
+ * :: targ_x :: CHUNK_OBJ* :: Target X vec 
+ * :: targ_z :: CHUNK_OBJ* :: Target Z vec 
+ * Returns the phase term 
+ */
+int8_t simd_xor_rowsum(
+    const size_t n_bytes,
+    void* restrict ctrl_x, 
+    void* restrict ctrl_z, 
+    void* restrict targ_x, 
+    void* restrict targ_z 
+)
+{
+    int16_t acc = 0;
+    for (size_t i = 0; i < n_bytes; i += ROWSUM_STRIDE)
+    {
+        const __mmask64 tail = AVX512_TAIL_MASK(n_bytes - i);
+        const size_t n_bits = (n_bytes - i < ROWSUM_STRIDE ? n_bytes - i : ROWSUM_STRIDE) * 8;
+
+        // Load vecs   
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi8(tail, ctrl_x + i);
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi8(tail, ctrl_z + i);
+        __m512i v_targ_x = _mm512_maskz_loadu_epi8(tail, targ_x + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi8(tail, targ_z + i);
+
+        for (size_t j = 0; j < n_bits; j++)
+        {
+            int8_t b_ctrl_x = __inline_slice_get_bit(ctrl_x, j + i * 8);
+            int8_t b_ctrl_z = __inline_slice_get_bit(ctrl_z, j + i * 8);
+            int8_t b_targ_x = __inline_slice_get_bit(targ_x, j + i * 8);
+            int8_t b_targ_z = __inline_slice_get_bit(targ_z, j + i * 8);
+
+            if ((b_ctrl_x == 1) && (b_ctrl_z == 0))
+            {
+                acc += b_targ_z * (2 * b_targ_x - 1); 
+            }
+            else if ((b_ctrl_x == 0) && (b_ctrl_z == 1))
+            {
+                acc += b_targ_x * (1 - 2 * b_targ_z);
+            }
+            else if ((b_ctrl_x == 1) && (b_ctrl_z == 1))
+            {
+                acc += b_targ_z - b_targ_x;
+            }
+        }   
+ 
+        // Perform XOR operations and store target values  
+        _mm512_mask_storeu_epi8(targ_x + i, tail, _mm512_xor_si512(v_ctrl_x, v_targ_x)); 
+        _mm512_mask_storeu_epi8(targ_z + i, tail, _mm512_xor_si512(v_ctrl_z, v_targ_z)); 
+
+        acc %= 4;
+    }  
+
+    return acc;
+}
+
+
+void simd_rowsum_xor_only(
+    const size_t n_bytes,
+    void* restrict ctrl_x, 
+    void* restrict ctrl_z, 
+    void* restrict targ_x, 
+    void* restrict targ_z 
+)
+{
+    for (size_t i = 0; i < n_bytes; i += ROWSUM_STRIDE)
+    {
+        const __mmask64 tail = AVX512_TAIL_MASK(n_bytes - i);
+
+        __m512i v_targ_x = _mm512_maskz_loadu_epi8(tail, targ_x + i);
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi8(tail, ctrl_x + i);
+        _mm512_mask_storeu_epi8(targ_x + i, tail, _mm512_xor_si512(v_ctrl_x, v_targ_x)); 
+
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi8(tail, ctrl_z + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi8(tail, targ_z + i);
+        _mm512_mask_storeu_epi8(targ_z + i, tail, _mm512_xor_si512(v_ctrl_z, v_targ_z)); 
+    }
+}
+
+
+/*
+ * rowsum_naive_lookup_table
+ * Naive lookup table implementation
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: void* :: Control X vec 
+ * :: ctrl_z :: void* :: Control Z vec 
+ * :: targ_x :: void* :: Target X vec 
+ * :: targ_z :: void* :: Target Z vec 
+ * Returns the phase term 
+ */
+int8_t rowsum_naive_lookup_table(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z)
+{
+
+    uint8_t lookup_table[16] = {
+        NAIVE_LOOKUP_TABLE
+    };
+
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < n_bytes * 8; i++) {
+
+        int idx = (
+              (((((uint8_t*)ctrl_x)[i / 8] >> (i % 8)) & 0x1) << 3)
+            | (((((uint8_t*)ctrl_z)[i / 8] >> (i % 8)) & 0x1) << 2)
+            | (((((uint8_t*)targ_x)[i / 8] >> (i % 8)) & 0x1) << 1)
+            | (((((uint8_t*)targ_z)[i / 8] >> (i % 8)) & 0x1) << 0)
+        );
+
+        sum += lookup_table[idx];
+    }
+
+    simd_rowsum_xor_only(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z);
+    return ((sum + 2) % 4 - 2);
+}
+
+
+int8_t rowsum_cnf(
+    const size_t n_bytes,
+    void* restrict ctrl_x, 
+    void* restrict ctrl_z, 
+    void* restrict targ_x, 
+    void* restrict targ_z) 
+{
+    uint64_t pos = 0;
+    uint64_t neg = 0;
+
+    for (size_t i = 0; i < n_bytes / sizeof(uint64_t); i++) {
+        uint64_t plus = 0;
+        uint64_t minus = 0;
+
+        plus = (~((uint64_t*)ctrl_x)[i] & ((uint64_t*)ctrl_z)[i] & ((uint64_t*)targ_x)[i] & ~((uint64_t*)targ_z)[i]) 
+                | (((uint64_t*)ctrl_x)[i] & ~((uint64_t*)ctrl_z)[i] & ((uint64_t*)targ_x)[i] & ((uint64_t*)targ_z)[i]) 
+                | (((uint64_t*)ctrl_x)[i] & ((uint64_t*)ctrl_z)[i] & ~((uint64_t*)targ_x)[i] & ((uint64_t*)targ_z)[i]);
+        pos += __builtin_popcountll(plus);
+
+        minus = (((uint64_t*)ctrl_x)[i] & ~((uint64_t*)ctrl_z)[i] & ~((uint64_t*)targ_x)[i] & ((uint64_t*)targ_z)[i]) 
+                | (~((uint64_t*)ctrl_x)[i] & ((uint64_t*)ctrl_z)[i] & ((uint64_t*)targ_x)[i] & ((uint64_t*)targ_z)[i]) 
+                | (((uint64_t*)ctrl_x)[i] & ((uint64_t*)ctrl_z)[i] & ((uint64_t*)targ_x)[i] & ~((uint64_t*)targ_z)[i]);
+        neg += __builtin_popcountll(minus);
+    }
+    simd_rowsum_xor_only(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z);
+    return ((((pos - neg) % 4) + 2) % 4) - 2;
+}
+
+/*
+ * rowsum_cnf_terms
+ * Evaluates the positive and negative phase contributions of a lane
+ * :: ctrl_x : __m512i :: Control X vec 
+ * :: ctrl_z : __m512i :: Control Z vec 
+ * :: targ_x : __m512i :: Target X vec 
+ * :: targ_z : __m512i :: Target Z vec 
+ * :: plus : __m512i* :: Set where the phase is incremented
+ * :: minus : __m512i* :: Set where the phase is decremented
+ * Each term is selected on the control X bit from two ternary logic operations over the remaining bits
+ */
+static inline __attribute__((always_inline))
+void __inline_rowsum_cnf_terms(
+    const __m512i ctrl_x,
+    const __m512i ctrl_z,
+    const __m512i targ_x,
+    const __m512i targ_z,
+    __m512i* plus,
+    __m512i* minus)
+{
+    // ctrl_x ? (targ_z & (ctrl_z ^ targ_x)) : (ctrl_z & targ_x & ~targ_z)
+    *plus = _mm512_ternarylogic_epi64(
+        ctrl_x, 
+        _mm512_ternarylogic_epi64(ctrl_z, targ_x, targ_z, TERNLOG_AXB_AND_C),
+        _mm512_ternarylogic_epi64(ctrl_z, targ_x, targ_z, TERNLOG_ABNC),
+        TERNLOG_SELECT
+    );
+
+    // ctrl_x ? (~(ctrl_z ^ targ_x) & (ctrl_z ^ targ_z)) : (ctrl_z & targ_x & targ_z)
+    *minus = _mm512_ternarylogic_epi64(
+        ctrl_x, 
+        _mm512_ternarylogic_epi64(ctrl_z, targ_x, targ_z, TERNLOG_AXNB_AND_AXC),
+        _mm512_ternarylogic_epi64(ctrl_z, targ_x, targ_z, TERNLOG_AND3),
+        TERNLOG_SELECT
+    );
+}
+
+/*
+ * simd_rowsum_cnf_popcnt
+ * Vectorised CNF implementation using popcnt 
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: void* :: Control X vec 
+ * :: ctrl_z :: void* :: Control Z vec 
+ * :: targ_x :: void* :: Target X vec 
+ * :: targ_z :: void* :: Target Z vec 
+ * Returns the phase term 
+ * Requires AVX512-VPOPCNTDQ
+ */
+__attribute__((target("avx512vpopcntdq")))
+int8_t simd_rowsum_cnf_popcnt(
+    const size_t n_bytes,
+    void *restrict ctrl_x,
+    void *restrict ctrl_z,
+    void *restrict targ_x,
+    void *restrict targ_z) 
+{
+    __m512i pos = _mm512_setzero_si512();
+    __m512i neg = _mm512_setzero_si512();
+
+    for (size_t i = 0; i < n_bytes; i += ROWSUM_STRIDE) {
+        const __mmask64 tail = AVX512_TAIL_MASK(n_bytes - i);
+
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi8(tail, ctrl_x + i);
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi8(tail, ctrl_z + i);
+        __m512i v_targ_x = _mm512_maskz_loadu_epi8(tail, targ_x + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi8(tail, targ_z + i);
+
+        __m512i plus;
+        __m512i minus;
+        __inline_rowsum_cnf_terms(v_ctrl_x, v_ctrl_z, v_targ_x, v_targ_z, &plus, &minus);
+
+        pos = _mm512_add_epi64(pos, _mm512_popcnt_epi64(plus));
+        neg = _mm512_add_epi64(neg, _mm512_popcnt_epi64(minus));
+    }
+
+    simd_rowsum_xor_only(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z);
+
+    const uint64_t total = _mm512_reduce_add_epi64(pos) - _mm512_reduce_add_epi64(neg);
+    return ((total % 4 + 2) % 4) - 2;
+}
+
+/*
+ * __inline_simd_rowsum_cnf
+ * Applies the rowsum and accumulates the phase contributions as bit sliced counters
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: void* :: Control X vec 
+ * :: ctrl_z :: void* :: Control Z vec 
+ * :: targ_x :: void* :: Target X vec 
+ * :: targ_z :: void* :: Target Z vec 
+ * :: pos : __m512i* :: Set to the low bit of the positive count of each lane
+ * :: neg : __m512i* :: Set to the low bit of the negative count of each lane
+ * :: acc : __m512i* :: Set to the carry of both counts of each lane
+ * The phase is the popcount of pos, less that of neg, plus twice that of acc
+ */
+static inline __attribute__((always_inline))
+void __inline_simd_rowsum_cnf(
+    const size_t n_bytes,
+    void *restrict ctrl_x,
+    void *restrict ctrl_z,
+    void *restrict targ_x,
+    void *restrict targ_z,
+    __m512i* pos,
+    __m512i* neg,
+    __m512i* acc)
+{
+    *pos = _mm512_setzero_si512();
+    *neg = _mm512_setzero_si512();
+    *acc = _mm512_setzero_si512();
+
+    for (size_t i = 0; i < n_bytes; i += ROWSUM_STRIDE) {
+        const __mmask64 tail = AVX512_TAIL_MASK(n_bytes - i);
+
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi8(tail, ctrl_x + i);
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi8(tail, ctrl_z + i);
+        __m512i v_targ_x = _mm512_maskz_loadu_epi8(tail, targ_x + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi8(tail, targ_z + i);
+
+        __m512i plus;
+        __m512i minus;
+        __inline_rowsum_cnf_terms(v_ctrl_x, v_ctrl_z, v_targ_x, v_targ_z, &plus, &minus);
+
+        // Perform XOR operations
+        _mm512_mask_storeu_epi8(targ_x + i, tail, _mm512_xor_si512(v_ctrl_x, v_targ_x)); 
+        _mm512_mask_storeu_epi8(targ_z + i, tail, _mm512_xor_si512(v_ctrl_z, v_targ_z)); 
+
+        *acc = _mm512_ternarylogic_epi64(*acc, *pos, plus, TERNLOG_A_XOR_BC);
+        *acc = _mm512_ternarylogic_epi64(*acc, *neg, minus, TERNLOG_A_XOR_BC);
+
+        *pos = _mm512_xor_si512(*pos, plus);
+        *neg = _mm512_xor_si512(*neg, minus);
+    }
+}
+
+/*
+ * __inline_popcnt_reduce
+ * Popcount of a vector using the scalar popcnt on each 64 bit lane
+ */
+static inline __attribute__((always_inline))
+uint64_t __inline_popcnt_reduce(const __m512i v)
+{
+    uint64_t lanes[8];
+    _mm512_storeu_si512((void*)lanes, v);
+    uint64_t total = 0;
+    for (size_t i = 0; i < 8; i++)
+    {
+        total += __builtin_popcountll(lanes[i]);
+    }
+    return total;
+}
+
+/*
+ * simd_rowsum_cnf
+ * Vectorised CNF rowsum
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: void* :: Control X vec 
+ * :: ctrl_z :: void* :: Control Z vec 
+ * :: targ_x :: void* :: Target X vec 
+ * :: targ_z :: void* :: Target Z vec 
+ * Returns the phase term 
+ * The counters are reduced with the scalar popcnt, see simd_rowsum_cnf_vpopcnt
+ */
+int8_t simd_rowsum_cnf(
+    const size_t n_bytes,
+    void *restrict ctrl_x,
+    void *restrict ctrl_z,
+    void *restrict targ_x,
+    void *restrict targ_z) 
+{
+    __m512i pos;
+    __m512i neg;
+    __m512i acc;
+    __inline_simd_rowsum_cnf(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z, &pos, &neg, &acc);
+
+    uint64_t total = __inline_popcnt_reduce(pos);
+    total -= __inline_popcnt_reduce(neg);
+    total += __inline_popcnt_reduce(acc) << 1;
+
+    return ((total + 2) % 4) - 2;
+}
+
+/*
+ * simd_rowsum_cnf_vpopcnt
+ * Vectorised CNF rowsum, reducing the counters with VPOPCNTQ
+ * :: n_bytes : size_t :: Length of the chunk 
+ * :: ctrl_x :: void* :: Control X vec 
+ * :: ctrl_z :: void* :: Control Z vec 
+ * :: targ_x :: void* :: Target X vec 
+ * :: targ_z :: void* :: Target Z vec 
+ * Returns the phase term 
+ * Requires AVX512-VPOPCNTDQ
+ */
+__attribute__((target("avx512vpopcntdq")))
+int8_t simd_rowsum_cnf_vpopcnt(
+    const size_t n_bytes,
+    void *restrict ctrl_x,
+    void *restrict ctrl_z,
+    void *restrict targ_x,
+    void *restrict targ_z) 
+{
+    __m512i pos;
+    __m512i neg;
+    __m512i acc;
+    __inline_simd_rowsum_cnf(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z, &pos, &neg, &acc);
+
+    uint64_t total = _mm512_reduce_add_epi64(_mm512_popcnt_epi64(pos));
+    total -= _mm512_reduce_add_epi64(_mm512_popcnt_epi64(neg));
+    total += _mm512_reduce_add_epi64(_mm512_popcnt_epi64(acc)) << 1;
+
+    return ((total + 2) % 4) - 2;
+}
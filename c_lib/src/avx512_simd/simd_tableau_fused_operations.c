@@ -0,0 +1,143 @@
+#define INSTRUCTIONS_TABLE
+#define TABLEAU_FUSED_OPERATIONS_SRC
+
+#include "tableau_fused_operations.h"
+
+// Truth table for r ^ p.x ^ q.z ^ s.x.z as _mm512_ternarylogic_epi64(r, x, z, imm)
+#define LOCAL_CLIFFORD_TERNLOG(params) ( \
+    0xf0 \
+    ^ (LOCAL_CLIFFORD_P(params) * 0xcc) \
+    ^ (LOCAL_CLIFFORD_Q(params) * 0xaa) \
+    ^ (LOCAL_CLIFFORD_S(params) * 0x88))
+
+/*
+ * local_clifford_vec
+ * Applies a local Clifford to a lane of rows
+ * :: params : const uint8_t :: Local Clifford parameters, should be a compile time constant
+ * :: x : __m512i* :: X bits of the qubit
+ * :: z : __m512i* :: Z bits of the qubit
+ * :: r : __m512i* :: Phase bits
+ * With constant parameters the branches are resolved at compile time
+ * The phase update is a single ternary logic operation
+ */
+static inline __attribute__((always_inline))
+void __inline_local_clifford_vec(
+    const uint8_t params,
+    __m512i* x,
+    __m512i* z,
+    __m512i* r)
+{
+    const __m512i x0 = *x;
+    const __m512i z0 = *z;
+
+    if (LOCAL_CLIFFORD_P(params) || LOCAL_CLIFFORD_Q(params) || LOCAL_CLIFFORD_S(params))
+    {
+        *r = _mm512_ternarylogic_epi64(*r, x0, z0, LOCAL_CLIFFORD_TERNLOG(params));
+    }
+
+    if (LOCAL_CLIFFORD_A(params) && LOCAL_CLIFFORD_B(params)) { *x = _mm512_xor_si512(x0, z0); }
+    else if (LOCAL_CLIFFORD_B(params)) { *x = z0; }
+
+    if (LOCAL_CLIFFORD_C(params) && LOCAL_CLIFFORD_D(params)) { *z = _mm512_xor_si512(x0, z0); }
+    else if (LOCAL_CLIFFORD_C(params)) { *z = x0; }
+}
+
+/*
+ * tableau_fused_range
+ * Generic fused kernel
+ * :: tab : tableau_t* :: The tableau to operate on 
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * :: start : const size_t :: First byte of each slice to operate on
+ * :: stop : const size_t :: Terminating byte of each slice 
+ * :: ctrl_params : const uint8_t :: Local Clifford parameters for the control qubit
+ * :: targ_params : const uint8_t :: Local Clifford parameters for the target qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ * Each slice is loaded and stored at most once, slices that are not changed are not stored
+ */
+static inline __attribute__((always_inline))
+void __inline_tableau_fused_range(
+    tableau_t* restrict tab,
+    const size_t ctrl,
+    const size_t targ,
+    const size_t start,
+    const size_t stop,
+    const uint8_t ctrl_params,
+    const uint8_t targ_params,
+    const instruction_t opcode)
+{
+    const bool cnot = (_CNOT_ == opcode);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]); 
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]); 
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        __inline_local_clifford_vec(ctrl_params, &ctrl_x, &ctrl_z, &r);
+        __inline_local_clifford_vec(targ_params, &targ_x, &targ_z, &r);
+
+        if (cnot)
+        {
+            // See tableau_CNOT
+            __m512i t = _mm512_ternarylogic_epi64(targ_x, ctrl_z, ctrl_x, TERNLOG_AXNB_AND_C);
+            r = _mm512_ternarylogic_epi64(r, t, targ_z, TERNLOG_A_XOR_BC);
+            targ_x = _mm512_xor_si512(ctrl_x, targ_x);
+            ctrl_z = _mm512_xor_si512(ctrl_z, targ_z);
+        }
+        else
+        {
+            // See tableau_CZ
+            __m512i t = _mm512_ternarylogic_epi64(ctrl_z, targ_z, ctrl_x, TERNLOG_AXB_AND_C);
+            r = _mm512_ternarylogic_epi64(r, t, targ_x, TERNLOG_A_XOR_BC);
+            targ_z = _mm512_xor_si512(ctrl_x, targ_z);
+            ctrl_z = _mm512_xor_si512(ctrl_z, targ_x);
+        }
+
+        // Both gates fix the x bits of the control and update the z bits of the control
+        if (!LOCAL_CLIFFORD_FIXES_X(ctrl_params))
+        {
+            _mm512_store_si512(ctrl_slice_x + i, ctrl_x);
+        }
+        _mm512_store_si512(ctrl_slice_z + i, ctrl_z);
+
+        if (cnot || !LOCAL_CLIFFORD_FIXES_X(targ_params))
+        {
+            _mm512_store_si512(targ_slice_x + i, targ_x);
+        }
+        if (!cnot || !LOCAL_CLIFFORD_FIXES_Z(targ_params))
+        {
+            _mm512_store_si512(targ_slice_z + i, targ_z);
+        }
+        _mm512_store_si512(slice_r + i, r);
+    }
+}
+
+#define TABLEAU_FUSED_KERNEL(ctrl_clifford, targ_clifford, gate) \
+void TABLEAU_FUSED_KERNEL_NAME(ctrl_clifford, targ_clifford, gate)( \
+    tableau_t* restrict tab, \
+    const size_t ctrl, \
+    const size_t targ, \
+    const size_t start, \
+    const size_t stop) \
+{ \
+    __inline_tableau_fused_range( \
+        tab, ctrl, targ, start, stop, \
+        LOCAL_CLIFFORD_PARAMS_##ctrl_clifford, \
+        LOCAL_CLIFFORD_PARAMS_##targ_clifford, \
+        _##gate##_); \
+}
+
+#define TABLEAU_FUSED_KERNEL_TARG(targ_clifford, ctrl_clifford, gate) TABLEAU_FUSED_KERNEL(ctrl_clifford, targ_clifford, gate)
+#define TABLEAU_FUSED_KERNEL_CTRL(ctrl_clifford, gate) FOREACH_LOCAL_CLIFFORD_TARG(TABLEAU_FUSED_KERNEL_TARG, ctrl_clifford, gate)
+
+FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_CTRL, CNOT)
+FOREACH_LOCAL_CLIFFORD_CTRL(TABLEAU_FUSED_KERNEL_CTRL, CZ)
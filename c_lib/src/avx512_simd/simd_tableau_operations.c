@@ -0,0 +1,773 @@
+#define INSTRUCTIONS_TABLE
+#define TABLEAU_OPERATIONS_SRC 
+
+#include "tableau_operations.h"
+
+void tableau_H_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * x -> z
+     * z -> x
+     * r -> r ^ x.z
+     */
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);   
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_BC));
+    }  
+}
+
+
+void tableau_S_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * x -> x  
+     * z -> z ^ x
+     * r -> r ^ x.z
+     */
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_BC)
+        );
+    }
+}
+
+void tableau_Z_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+/*
+ * Doubled S gate
+ * S: (r ^= x.z; z ^= x)
+ * r1 = r0 ^ (x.z0); z1 = z0 ^ x 
+ * r2 = r0 ^ (x.z0) ^ (x.(z0 ^ x)); z2 = z0 ^ x ^ x 
+ * r2 = r0 ^ x.(z0 ^ z0 ^ x); z2 = z0 
+ * r2 = r0 ^ x; z2 = z0 
+ */
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(
+            slice_r + i, 
+            _mm512_xor_si512(r, x)
+        );
+    }
+}
+
+
+void tableau_R_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * Triple S gate
+     * S : (r ^= x.z; z ^= x)
+     * r1 = r0 ^ (x.z0); z1 = z0 ^ x 
+     *
+     * r2 = r0 ^ (x.z0) ^ (x.(z0 ^ x)); z2 = z0 ^ x ^ x 
+     * r2 = r0 ^ x.(z0 ^ z0 ^ x); z2 = z0 
+     * r2 = r0 ^ x; z2 = z0 
+     *
+     * r3 = r0 ^ x ^ x.z2; z3 = z2 ^ x 
+     * r3 = r0 ^ x ^ x.z0; z3 = z0 ^ x 
+     *
+     * R : (r ^= x.~z; z ^= x)
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, z, x, TERNLOG_A_XOR_NBC)
+        );
+    }
+}
+
+
+void tableau_I_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    return;
+}
+
+void tableau_X_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+/*
+ * HZH Gate
+ * Flip X and Z, perform a Z, then flip X and Z again
+ * H : (r ^= x.z; x <-> z) 
+ * Z : (r ^= x)
+ * 
+ * H
+ * r_1 = r_0 ^ x0.z0; x1 = z0; z1 = x0  
+ * 
+ * Z
+ * r_2 = r_1 ^ x1; x2 = x1; z2 = z1  
+ * r_2 = r_0 ^ x0.z0 ^ z0; x2 = z0; z2 = x0  
+ *
+ * H
+ * r_3 = r_0 ^ x0.z0 ^ z0 ^ z2.x2; x3 = z2; z3 = x2  
+ * r_3 = r_0 ^ x0.z0 ^ z0 ^ z0.x0; x3 = x0; z3 = z0  
+ * r_3 = r_0 ^ z0;
+ *
+ */
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_r + i, _mm512_xor_si512(r, z));
+    }
+}
+
+void tableau_Y_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * Y = XZ
+     * Z : (r ^= x)
+     * X : (r ^= z)
+     *
+     * r_1 = r_0 ^ x 
+     *
+     * r_2 = r_0 ^ x ^ z 
+     *
+     * Y : r ^= x ^ z
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_XOR3)
+        );
+    }
+}
+
+void tableau_HX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * X : (r ^= z)
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * r_1 = r_0 ^ z 
+     *
+     * r_2 = r_0 ^ z ^ x.z 
+     * r_2 = r_0 ^ (~x & z) 
+     * Swap x and z
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_NBC)
+        );
+    }
+}
+
+void tableau_SX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * X : (r ^= z)
+     * S : (r ^= x.z; z ^= x)
+     *
+     * r_1 = r_0 ^ z 
+     *
+     * r_2 = r_0 ^ z ^ x.z 
+     * r_2 = r_0 ^ (~x & z) 
+     * z_2 = z_0 ^ x
+     */
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, x);
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_NBC)
+        );
+    }
+}
+
+
+
+void tableau_RX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * X : (r ^= z)
+     * R : (r ^= x.~z; z ^= x)
+     *
+     * r_1 = r_0 ^ z 
+     *
+     * r_2 = r_0 ^ z ^ x.~z 
+     * r_2 = r_0 ^ (z | x) 
+     * z_2 = z_0 ^ x
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, x);
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, z, x, TERNLOG_A_XOR_B_OR_C)
+        );
+    }
+}
+
+void tableau_HZ_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * Z : (r ^= x)
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * r_1 = r_0 ^ x 
+     *
+     * r_2 = r_0 ^ x ^ x.z 
+     * r_2 = r_0 ^ (x & ~z) 
+     * z_2 = x_0
+     * x_2 = z_0
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, z, x, TERNLOG_A_XOR_NBC)
+        );
+    }
+}
+
+
+
+void tableau_HY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * Y : r ^= x ^ z
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * r_1 = r_0 ^ x ^ z 
+     *
+     * r_2 = r_0 ^ x ^ z ^ x.z 
+     * r_2 = r_0 ^ (x | z) 
+     * z_2 = x_0
+     * x_2 = z_0
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, z, x, TERNLOG_A_XOR_B_OR_C)
+        );
+    }
+}
+
+
+void tableau_SH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * H : (r ^= x.z; x <-> z) 
+     * S : (r ^= x.z; z ^= x)
+     *
+     * r_1 = r_0 ^ x.z 
+     * z_1 = x_0
+     * x_1 = z_0
+     *
+     * r_2 = r_1 ^ x_1.z_1
+     * r_2 = r_0 ^ x_0.z_0 ^ z_0.x_0
+     * r_2 = r_0
+     * z_2 ^= x_2 -> x_0 ^= z_0
+     * 
+     */
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);   
+        __m512i z = _mm512_load_si512(slice_z + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(
+            slice_z + i, 
+            _mm512_xor_si512(x, z)
+        );
+    }
+}
+
+
+void tableau_RH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    /*
+     * H : (r ^= x.z; x <-> z) 
+     * R : (r ^= x.~z; z ^= x)
+     *
+     * r_1 = r_0 ^ x.z 
+     * z_1 = x_0
+     * x_1 = z_0
+     *
+     * r_2 = r_1 ^ x_1.~z_1
+     * r_2 = r_0 ^ x_0.z_0 ^ z_0.~x_0
+     * r_2 = r_0 ^ z_0
+     * z_2 ^= x_2 -> x_0 ^= z_0
+     *
+     */
+    // DONE
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);   
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, _mm512_xor_si512(r, z));
+    }  
+}
+
+
+void tableau_HS_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    /*
+     * S : (r ^= x.z; z ^= x)
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * x_1 = x
+     * z_1 = z_0 ^ x
+     * r_1 = r_0 ^ x.z 
+     *
+     * r_2 = r_1 ^ x.z_1
+     * r_2 = r_0 ^ x.z ^ x.(x ^ z) 
+     * r_2 = r_0 ^ x.z ^ x.~z
+     * r_2 = x ^ r_0
+     * 
+     * z_2 = x_1 = x
+     * x_2 = z_1 = z ^ x  
+     *
+     */
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);   
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, _mm512_xor_si512(r, x));
+    }  
+}
+
+void tableau_HR_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    /*
+     * R : (r ^= x.~z; z ^= x)
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * r_1 = r_0 ^ x.~z 
+     * z_1 = z_0 ^ x
+     *
+     * r_2 = r_1 ^ x.z_1
+     * r_2 = r_0 ^ x.~z_0 ^ x.(z_0 ^ x)  
+     * x = 0 -> r_0 ^ 0 ^ 0 
+     * x = 1 -> r_0 ^ ~z_0 ^ ~z_0   
+     * r_2 = r_0
+     *
+     * z_2 = x_1 = x
+     *
+     * x_2 = z_1 = z_0 ^ x_0
+     *
+     */
+    // DONE
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);   
+        __m512i z = _mm512_load_si512(slice_z + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, x);
+    }  
+}
+
+void tableau_HSX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * X : (r ^= z)
+     * S : (r ^= x.z; z ^= x)
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * r_1 = r_0 ^ z 
+     *
+     * r_2 = r_1 ^ x.z_0
+     * r_2 = r_0 ^ z_0 ^ x.z_0 
+     * r_2 = r_0 ^ ~x.z_0
+     * z_2 = z_0 ^ x 
+     *
+     * r_3 = r_2 ^ x_0.z_2 
+     * r_3 = r_0 ^ ~x_0.z_0 ^ x_0.(z_0 ^ x_0)
+     *
+     * r_3 = r_0 ^ x_0 ^ z_0
+     * x_3 = z_2 = x_0 ^ z_0 
+     * z_3 = x_2 = x_0
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, z, x, TERNLOG_XOR3)
+        );
+    }
+}
+
+void tableau_HRX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * X : (r ^= z)
+     * R : (r ^= x.~z; z ^= x)
+     * H : (r ^= x.z; x <-> z) 
+     *
+     * r_1 = r_0 ^ z 
+     *
+     * r_2 = r_1 ^ x.~z_0
+     * r_2 = r_0 ^ z_0 ^ x.~z_0 
+     * r_2 = r_0 ^ (x | z_0)
+     * z_2 = z_0 ^ x 
+     *
+     * r_3 = r_2 ^ x_0.z_2 
+     * r_3 = r_0 ^ ~x_0.z_0 ^ x_0.(z_0 ^ x_0)
+     * r_3 = r_0 ^ z
+     * x_3 = z_2 = x_0 ^ z_0 
+     * z_3 = x_2 = x_0
+     */
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, x);
+        _mm512_store_si512(slice_r + i, _mm512_xor_si512(r, z));
+    }
+}
+
+void tableau_SHY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(r, x, z, TERNLOG_XOR3));
+    }
+}
+
+void tableau_RHY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, z);
+        _mm512_store_si512(slice_z + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_r + i, _mm512_xor_si512(r, x));
+    }
+}
+
+void tableau_HSH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, z);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_NBC)
+        );
+    }
+}
+
+void tableau_HRH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, z);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_BC)
+        );
+    }
+}
+
+
+void tableau_RHS_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, z);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, x, z, TERNLOG_A_XOR_B_OR_C)
+        );
+    }
+}
+
+
+void tableau_SHR_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
+{
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i x = _mm512_load_si512(slice_x + i);
+        __m512i z = _mm512_load_si512(slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(slice_x + i, _mm512_xor_si512(x, z));
+        _mm512_store_si512(slice_z + i, z);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, z, x, TERNLOG_A_XOR_NBC)
+        );
+    }
+}
+
+void tableau_CNOT_range(tableau_t* restrict tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop)
+{
+    /*
+     * CNOT a, b: ( 
+     *     r ^= x_a & z_b & (1 ^ x_b ^ z_a);
+     *     x_b ^= x_a;
+     *     z_a ^= z_b) 
+     *
+     */ 
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]); 
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]); 
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(targ_slice_x + i, _mm512_xor_si512(ctrl_x, targ_x));
+        _mm512_store_si512(ctrl_slice_z + i, _mm512_xor_si512(ctrl_z, targ_z));
+        // r ^= targ_z & (ctrl_x & ~(targ_x ^ ctrl_z))
+        __m512i t = _mm512_ternarylogic_epi64(targ_x, ctrl_z, ctrl_x, TERNLOG_AXNB_AND_C);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, t, targ_z, TERNLOG_A_XOR_BC)
+        );
+    }
+}
+
+void tableau_CZ_range(tableau_t* restrict tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop)
+{
+    /* CZ = H_b CNOT H_b 
+     * H : (r ^= x.z; x <-> z) 
+     * CNOT a, b: ( 
+     *     r ^= x_a & z_b & ~(x_b ^ z_a);
+     *     x_b ^= x_a;
+     *     z_a ^= z_b) 
+     *
+     * H:
+     * r_1 = r_0 ^ x_b.z_b 
+     * x_a1 = x_a0
+     * x_b1 = z_b0 
+     * z_a1 = z_a0
+     * z_b1 = x_b0 
+     *
+     * CNOT:
+     * r_2 = r_1 ^ (x_a0 & z_b1 & ~(x_b1 ^ z_a0))
+     * r_2 = r_0 ^ (x_b0 & z.b0) ^ (x_a0 & x_b0 & ~(z_b0 ^ z_a0))
+     * x_a2 = x_a1
+     * x_a2 = x_a0 
+     * x_b2 = x_b1 ^ x_a1
+     * x_b2 = z_b0 ^ x_a0
+     * z_a2 = z_a1 ^ z_b1 
+     * z_a2 = z_a0 ^ x_b0 
+     * z_b2 = z_b1
+     * z_b2 = x_b0
+     *
+     * H: 
+     * r_3 = r_2 ^ (x_b2 & z_b2)  
+     * r_3 = r_0 ^ (x_b0 & z_b0) ^ (x_a0 & x_b0 & ~(z_b0 ^ z_a0)) ^ ((z_b0 ^ x_a0) & x_b0); 
+     * x_a3 = x_a2 = x_a0 
+     * x_b3 = z_b2 = x_b0 
+     * z_a3 = z_a2 = z_a0 ^ x_b0 
+     * z_b3 = x_b2 = z_b0 ^ x_a0 
+     *
+     */ 
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]); 
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]); 
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]); 
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
+    void* restrict slice_r = (void*)(tab->phases); 
+
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        _mm512_store_si512(targ_slice_z + i, _mm512_xor_si512(ctrl_x, targ_z));
+        _mm512_store_si512(ctrl_slice_z + i, _mm512_xor_si512(ctrl_z, targ_x));
+
+        // r ^= targ_x & (ctrl_x & (ctrl_z ^ targ_z))
+        __m512i t = _mm512_ternarylogic_epi64(ctrl_z, targ_z, ctrl_x, TERNLOG_AXB_AND_C);
+        _mm512_store_si512(slice_r + i, 
+            _mm512_ternarylogic_epi64(r, t, targ_x, TERNLOG_A_XOR_BC)
+        );
+    }
+}
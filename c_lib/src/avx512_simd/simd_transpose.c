@@ -0,0 +1,473 @@
+#include "simd_transpose.h"
+
+// Transposes two blocks
+static inline
+void __inline_simd_transpose_2x16(uint8_t** restrict src, uint8_t** restrict targ)
+{
+    __m256i msrc = _mm256_set_epi16(
+            *(uint16_t*)src[15],
+            *(uint16_t*)src[14],
+            *(uint16_t*)src[13],
+            *(uint16_t*)src[12],
+            *(uint16_t*)src[11],
+            *(uint16_t*)src[10],
+            *(uint16_t*)src[9],
+            *(uint16_t*)src[8],
+            *(uint16_t*)src[7],
+            *(uint16_t*)src[6],
+            *(uint16_t*)src[5],
+            *(uint16_t*)src[4],
+            *(uint16_t*)src[3],
+            *(uint16_t*)src[2],
+            *(uint16_t*)src[1],
+            *(uint16_t*)src[0]
+            );     
+
+    // Transpose high and low bytes
+    // This shuffle is within each 128 byte lane
+    // Better unrolling will skip this setr operation 
+    __m256i shuffle_mask = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15, 16, 18, 20, 22, 24, 26, 28, 30, 17, 19, 21, 23, 25, 27, 29, 31); 
+    msrc = _mm256_shuffle_epi8(msrc, shuffle_mask); 
+    
+    // Transpose between 128 bit lanes
+    msrc = _mm256_permute4x64_epi64(msrc, 0xd8);
+
+    // bmi2 operations act 3x faster on registers
+    register uint64_t a_tl = _mm_extract_epi64(__builtin_ia32_extract128i256(msrc, 0), 0);
+    register uint64_t a_tr = _mm_extract_epi64(__builtin_ia32_extract128i256(msrc, 1), 0);
+    register uint64_t a_bl = _mm_extract_epi64(__builtin_ia32_extract128i256(msrc, 0), 1);
+    register uint64_t a_br = _mm_extract_epi64(__builtin_ia32_extract128i256(msrc, 1), 1);
+
+    // Scopes to attempt to force register use 
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x0101010101010101ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x0101010101010101ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[0][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x0202020202020202ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x0202020202020202ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[1][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x0404040404040404ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x0404040404040404ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[2][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x0808080808080808ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x0808080808080808ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[3][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x1010101010101010ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x1010101010101010ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[4][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x2020202020202020ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x2020202020202020ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[5][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x4040404040404040ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x4040404040404040ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[6][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tl = _pext_u64(a_tl, 0x8080808080808080ull);
+            register uint64_t col_bl = _pext_u64(a_bl, 0x8080808080808080ull);
+            col_l = _pdep_u64(col_tl, 0x00000000000000ffull) | _pdep_u64(col_bl, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[7][0] |= (uint64_t)col_l;
+    }
+
+
+    
+    // Scope to permit register re-use 
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x0101010101010101ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x0101010101010101ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[8][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x0202020202020202ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x0202020202020202ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[9][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x0404040404040404ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x0404040404040404ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[10][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x0808080808080808ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x0808080808080808ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[11][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x1010101010101010ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x1010101010101010ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[12][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x2020202020202020ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x2020202020202020ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[13][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x4040404040404040ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x4040404040404040ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[14][0] |= (uint64_t)col_l;
+    }
+
+    {
+        register uint64_t col_l;
+        {
+            register uint64_t col_tr = _pext_u64(a_tr, 0x8080808080808080ull);
+            register uint64_t col_br = _pext_u64(a_br, 0x8080808080808080ull);
+            col_l = _pdep_u64(col_tr, 0x00000000000000ffull) | _pdep_u64(col_br, 0x000000000000ff00ull);
+        }
+        ((uint64_t**)targ)[15][0] |= (uint64_t)col_l;
+    }
+
+    return;
+}
+void simd_transpose_2x16(uint8_t** src, uint8_t** targ)
+{
+    __inline_simd_transpose_2x16(src, targ); 
+}
+
+
+/*
+ * transpose_swap_registers
+ * Exchanges the off diagonal width x width sub-blocks between two registers of rows
+ * :: lo : __m512i* :: Rows holding the upper sub-block 
+ * :: hi : __m512i* :: Rows width below lo, holding the lower sub-block
+ * :: width : const int :: Width of the sub-block, must be a compile time constant
+ * :: mask : const __m512i :: Low width bits of each 2 * width bits
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_swap_registers(
+    __m512i* lo,
+    __m512i* hi,
+    const int width,
+    const __m512i mask)
+{
+    __m512i t = _mm512_ternarylogic_epi64(_mm512_srli_epi64(*lo, width), *hi, mask, TERNLOG_AXB_AND_C);
+    *lo = _mm512_xor_si512(*lo, _mm512_slli_epi64(t, width));
+    *hi = _mm512_xor_si512(*hi, t);
+}
+
+/*
+ * transpose_swap_elements
+ * Exchanges the off diagonal width x width sub-blocks between the elements of a register of rows
+ * :: rows : __m512i :: Eight rows 
+ * :: partner : __m512i :: The same rows with each element exchanged for the element width away
+ * :: width : const int :: Width of the sub-block, must be a compile time constant
+ * :: mask : const __m512i :: Low width bits of each 2 * width bits
+ * :: hi : const __mmask8 :: Elements holding the lower sub-block
+ * Returns the updated rows
+ */
+static inline __attribute__((always_inline))
+__m512i __inline_transpose_swap_elements(
+    const __m512i rows,
+    const __m512i partner,
+    const int width,
+    const __m512i mask,
+    const __mmask8 hi)
+{
+    __m512i t_lo = _mm512_ternarylogic_epi64(_mm512_srli_epi64(rows, width), partner, mask, TERNLOG_AXB_AND_C);
+    __m512i t_hi = _mm512_ternarylogic_epi64(_mm512_srli_epi64(partner, width), rows, mask, TERNLOG_AXB_AND_C);
+    return _mm512_mask_blend_epi64(hi,
+        _mm512_xor_si512(rows, _mm512_slli_epi64(t_lo, width)),
+        _mm512_xor_si512(rows, t_hi)
+    );
+}
+
+/*
+ * transpose_64x64_registers
+ * Transposes a 64x64 bit block held in registers
+ * :: rows : __m512i* :: Row 8i + j of the block is element j of rows[i] 
+ * Recursively swaps the off diagonal blocks of width 32, 16, 8, 4, 2 and 1
+ * The first three rounds act between registers, the last three between elements of each register
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_64x64_registers(__m512i rows[8])
+{
+    const __m512i mask_32 = _mm512_set1_epi64(0x00000000ffffffffull);
+    const __m512i mask_16 = _mm512_set1_epi64(0x0000ffff0000ffffull);
+    const __m512i mask_8 = _mm512_set1_epi64(0x00ff00ff00ff00ffull);
+    const __m512i mask_4 = _mm512_set1_epi64(0x0f0f0f0f0f0f0f0full);
+    const __m512i mask_2 = _mm512_set1_epi64(0x3333333333333333ull);
+    const __m512i mask_1 = _mm512_set1_epi64(0x5555555555555555ull);
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        if (!(i & 4)) { __inline_transpose_swap_registers(rows + i, rows + i + 4, 32, mask_32); }
+    }
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        if (!(i & 2)) { __inline_transpose_swap_registers(rows + i, rows + i + 2, 16, mask_16); }
+    }
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        if (!(i & 1)) { __inline_transpose_swap_registers(rows + i, rows + i + 1, 8, mask_8); }
+    }
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        // Swap 256 bit halves, 128 bit pairs and then 64 bit elements
+        rows[i] = __inline_transpose_swap_elements(rows[i], _mm512_shuffle_i64x2(rows[i], rows[i], 0x4e), 4, mask_4, 0xf0);
+        rows[i] = __inline_transpose_swap_elements(rows[i], _mm512_permutex_epi64(rows[i], 0x4e), 2, mask_2, 0xcc);
+        rows[i] = __inline_transpose_swap_elements(rows[i], _mm512_shuffle_epi32(rows[i], 0x4e), 1, mask_1, 0xaa);
+    }
+}
+
+/*
+ * simd_transpose_64x64
+ * Transposes two 64x64 bit blocks and exchanges them
+ * :: block_a : uint64_t** :: Rows of the first block
+ * :: block_b : uint64_t** :: Rows of the second block
+ * Rows are gathered from the row pointers and scattered back once transposed
+ */
+void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+{
+    __m512i rows_a[8];
+    __m512i rows_b[8];
+    __m512i ptrs_a[8];
+    __m512i ptrs_b[8];
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        ptrs_a[i] = _mm512_loadu_si512((void*)(block_a + 8 * i));
+        ptrs_b[i] = _mm512_loadu_si512((void*)(block_b + 8 * i));
+        rows_a[i] = _mm512_i64gather_epi64(ptrs_a[i], NULL, 1);
+        rows_b[i] = _mm512_i64gather_epi64(ptrs_b[i], NULL, 1);
+    }
+
+    __inline_transpose_64x64_registers(rows_a);
+    __inline_transpose_64x64_registers(rows_b);
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        _mm512_i64scatter_epi64(NULL, ptrs_a[i], rows_b[i], 1);
+        _mm512_i64scatter_epi64(NULL, ptrs_b[i], rows_a[i], 1);
+    }
+    return;
+}
+
+/*
+ * simd_transpose_64x64_inplace
+ * Transposes a 64x64 bit block 
+ * :: block_a : uint64_t** :: Rows of the block
+ */
+void simd_transpose_64x64_inplace(uint64_t* block_a[64])
+{
+    __m512i rows[8];
+    __m512i ptrs[8];
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        ptrs[i] = _mm512_loadu_si512((void*)(block_a + 8 * i));
+        rows[i] = _mm512_i64gather_epi64(ptrs[i], NULL, 1);
+    }
+
+    __inline_transpose_64x64_registers(rows);
+
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        _mm512_i64scatter_epi64(NULL, ptrs[i], rows[i], 1);
+    }
+    return;
+}
+
+/*
+ * Scalar implementation of the simd transpose
+ * Used for regression testing
+ */
+static inline
+void __inline_chunk_transpose_2x16(uint8_t** restrict src, uint8_t** restrict targ)
+{
+    for (size_t row = 0; row < 16; row++)  
+    {
+        uint64_t dispersed_vals = 0;
+        for (size_t i = 0; i < 16; i++)  
+        {
+            dispersed_vals |= (!!(((uint16_t**)src)[i][0] & (1 << row))) << i; 
+        }
+        *((uint16_t*)(targ[row])) = dispersed_vals;
+    } 
+}
+void __attribute__((noinline))
+chunk_transpose_2x16(uint8_t** restrict src, uint8_t** restrict targ)
+{
+    __inline_chunk_transpose_2x16(src, targ); 
+}
+
+void __attribute__((noinline))
+chunk_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+{
+     uint64_t src_block[64] = {0};
+     uint64_t targ_block[64] = {0};
+    
+     uint64_t* src_ptr[16];
+     uint64_t* targ_ptr[16] = {NULL};
+
+    for (size_t col = 0; col < 4; col++) 
+    {
+        for (size_t row = 0; row < 4; row++)  
+        {
+            for (size_t i = 0; i < 16; i++)
+            {
+                targ_ptr[i] = (uint64_t*)(((uint16_t*)(targ_block + i + 16 * row)) + col);
+                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_a[i + 16 * col])) + row); 
+            }
+            chunk_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
+        }
+    }
+
+    for (size_t col = 0; col < 4; col++) 
+    {
+        for (size_t row = 0; row < 4; row++)  
+        {
+            #pragma GCC unroll 16
+            for (size_t i = 0; i < 16; i++)
+            {
+                targ_ptr[i] = (uint64_t*)(((uint16_t*)(src_block + i + 16 * row)) + col);
+                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_b[i + 16 * col])) + row); 
+            }
+            chunk_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
+        }
+    }
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        memcpy(block_a[i], src_block + i, 8); 
+        memcpy(block_b[i], targ_block + i, 8); 
+    } 
+ 
+    return;
+}
+
+
+static inline
+uint8_t __inline_get_bit(
+    uint64_t* slice,
+    const size_t index)
+{
+    uint64_t mask = 1ull << (index % 64);
+    return !!(slice[index / 64] & mask); 
+}
+
+void __inline_set_bit(
+    uint64_t* slice,
+    const size_t index,
+    const uint8_t value)
+{
+    slice[index / 64] &= ~(1ull << (index % 64)); 
+    slice[index / 64] |= (1ull & value) << (index % 64); 
+}
+
+void transpose_naive(uint64_t** restrict block, const size_t size)
+{
+
+    for (size_t i = 0; i < size; i++)
+    {
+        // Inner loop should run along the current orientation, and hence along the cache lines 
+        uint64_t* ptr = block[i]; 
+    
+        for (size_t j = i + 1; j < size; j++)
+        {
+            uint8_t val_a = __inline_get_bit(ptr, j); 
+            uint8_t val_b = __inline_get_bit(block[j], i); 
+
+            __inline_set_bit(ptr, j, val_b);
+            __inline_set_bit(block[j], i, val_a);
+        }    
+    }
+    return;
+}
+
+
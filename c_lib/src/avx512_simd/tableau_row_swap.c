@@ -0,0 +1,25 @@
+#include "rowswap.h"
+
+void simd_row_swap(
+    const size_t n_bytes,
+    void* restrict ctrl_x, 
+    void* restrict ctrl_z, 
+    void* restrict targ_x, 
+    void* restrict targ_z 
+)
+{
+    for (size_t i = 0; i < n_bytes; i += ROWSUM_STRIDE)
+    {
+        const __mmask64 mask = AVX512_TAIL_MASK(n_bytes - i);
+
+        __m512i v_targ_x = _mm512_maskz_loadu_epi8(mask, targ_x + i);
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi8(mask, ctrl_x + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi8(mask, targ_z + i);
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi8(mask, ctrl_z + i);
+
+        _mm512_mask_storeu_epi8(targ_x + i, mask, v_ctrl_x);
+        _mm512_mask_storeu_epi8(targ_z + i, mask, v_ctrl_z);
+        _mm512_mask_storeu_epi8(ctrl_x + i, mask, v_targ_x);
+        _mm512_mask_storeu_epi8(ctrl_z + i, mask, v_targ_z);
+    }
+}
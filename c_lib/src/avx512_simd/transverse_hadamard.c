@@ -0,0 +1,45 @@
+#include "transverse_hadamard.h"
+
+/*
+ * simd_tableau_transverse_hadamard
+ * Applies a hadamard when transposed 
+ * :: tab : tableau_t*  :: Tableau object
+ * :: c_que :  clifford_queue_t* :: Clifford queue 
+ * :: i : const size_t :: Index to target 
+ *
+ * The targeted word of each row is gathered eight rows at a time, 
+ * the exchanged bits are then scattered back 
+ */
+void simd_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
+{ 
+    const size_t stride = 64;
+    const size_t lanes = sizeof(__m512i) / sizeof(uint64_t);
+
+    // Aligned offset of the targeted word within each row 
+    const __m512i offset = _mm512_set1_epi64(targ / 64 * sizeof(uint64_t));
+    const __m512i bit = _mm512_set1_epi64(1ull << (targ % 64));
+
+    for (size_t i = 0; i < tab->n_qubits; i += stride)
+    {
+        uint64_t* bit_phase = (uint64_t*)(tab->phases) + i / stride; 
+        uint64_t phase = 0;
+
+        #pragma GCC unroll 8 
+        for (size_t j = 0; j < stride; j += lanes)
+        {
+            __m512i addr_x = _mm512_add_epi64(_mm512_loadu_si512((void*)(tab->slices_x + i + j)), offset);
+            __m512i addr_z = _mm512_add_epi64(_mm512_loadu_si512((void*)(tab->slices_z + i + j)), offset);
+
+            __m512i x = _mm512_i64gather_epi64(addr_x, NULL, 1);
+            __m512i z = _mm512_i64gather_epi64(addr_z, NULL, 1);
+
+            phase |= (uint64_t)_mm512_test_epi64_mask(_mm512_and_si512(x, z), bit) << j;
+
+            // Exchange the targeted bits 
+            _mm512_i64scatter_epi64(NULL, addr_x, _mm512_ternarylogic_epi64(bit, z, x, TERNLOG_SELECT), 1);
+            _mm512_i64scatter_epi64(NULL, addr_z, _mm512_ternarylogic_epi64(bit, x, z, TERNLOG_SELECT), 1);
+        }
+        *bit_phase ^= phase;
+    }
+    return;
+}
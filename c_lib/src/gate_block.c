@@ -0,0 +1,54 @@
+#include "gate_block.h"
+
+/*
+ * gate_block_push
+ * Adds a gate to the block, applying the block if it is full
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: block : gate_block_t* :: Block of buffered gates
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ : const size_t :: Target qubit
+ * :: ctrl_clifford : const instruction_t :: Local Clifford queued on the control qubit 
+ * :: targ_clifford : const instruction_t :: Local Clifford queued on the target qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ */
+void gate_block_push(
+    tableau_t* tab,
+    gate_block_t* block,
+    const size_t ctrl,
+    const size_t targ,
+    const instruction_t ctrl_clifford,
+    const instruction_t targ_clifford,
+    const instruction_t opcode)
+{
+    if (GATE_BLOCK_SIZE == block->n_ops)
+    {
+        gate_block_flush(tab, block);
+    }
+
+    struct gate_block_op* op = block->ops + block->n_ops;
+    op->ctrl = ctrl;
+    op->targ = targ;
+    op->kernel = FUSED_OPERATIONS_RANGE[FUSED_OPERATION_IDX(opcode, ctrl_clifford, targ_clifford)];
+    block->n_ops++;
+}
+
+/*
+ * gate_block_flush
+ * Applies all buffered gates to the tableau, one tile of rows at a time
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: block : gate_block_t* :: Block of buffered gates
+ * Empties the block 
+ */
+void gate_block_flush(tableau_t* tab, gate_block_t* block)
+{
+    // Rows are independent, so each tile may be carried through every gate in the block
+    for (size_t start = 0; start < tab->slice_len; start += GATE_BLOCK_TILE_BYTES)
+    {
+        const size_t stop = (start + GATE_BLOCK_TILE_BYTES < tab->slice_len) ? start + GATE_BLOCK_TILE_BYTES : tab->slice_len;
+        for (size_t i = 0; i < block->n_ops; i++)
+        {
+            block->ops[i].kernel(tab, block->ops[i].ctrl, block->ops[i].targ, start, stop);
+        }
+    }
+    block->n_ops = 0;
+}
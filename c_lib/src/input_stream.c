@@ -21,6 +21,30 @@ void __inline_local_clifford_gate(
     return;
 } 
 
+/*
+ * flush_local_clifford_par
+ * Distributes a queued local Clifford over the threadpool
+ * :: wid : widget_t* :: The widget
+ * :: targ : const size_t :: The qubit to flush
+ * Identity operations are not dispatched
+ */
+static inline
+void __inline_flush_local_clifford_par(
+    widget_t* wid,
+    const size_t targ)
+{
+    const instruction_t opcode = wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK;
+    if (opcode != (_I_ & INSTRUCTION_OPERATOR_MASK))
+    {
+        threadpool_distribute_tableau_operation(
+            wid->tableau,
+            SINGLE_QUBIT_OPERATIONS_PAR[opcode],
+            targ,
+            NULL_TARG);
+    }
+    wid->queue->table[targ] = _I_;
+}
+
 /*
  * apply_local_cliffords
  * Empties the local clifford table and applies the local cliffords
@@ -29,6 +53,18 @@ void __inline_local_clifford_gate(
  */
 void apply_local_cliffords(widget_t* wid)
 {
+    if (threadpool_distributable(wid->tableau))
+    {
+        apply_local_cliffords_par(wid);
+        return;
+    }
+
+    if (threadpool_get_n_workers() > 1)
+    {
+        apply_local_cliffords_batch(wid);
+        return;
+    }
+
     for (size_t i = 0; i < wid->n_qubits; i++)
     {
         SINGLE_QUBIT_OPERATIONS[wid->queue->table[i] & INSTRUCTION_OPERATOR_MASK](wid->tableau, i);
@@ -36,6 +72,40 @@ void apply_local_cliffords(widget_t* wid)
     }
 }
 
+/*
+ * apply_local_cliffords_par
+ * Empties the local clifford table and distributes the local cliffords over the threadpool
+ * :: wid : widget_t* :: The widget
+ * Acts in place over the tableau and the clifford table
+ */
+void apply_local_cliffords_par(widget_t* wid)
+{
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        __inline_flush_local_clifford_par(wid, i);
+    }
+    threadpool_barrier();
+}
+
+/*
+ * apply_local_cliffords_batch
+ * Empties the local clifford table, the local cliffords are split between the workers
+ * :: wid : widget_t* :: The widget
+ * Acts in place over the tableau and the clifford table
+ */
+void apply_local_cliffords_batch(widget_t* wid)
+{
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        if ((wid->queue->table[i] & INSTRUCTION_OPERATOR_MASK) != (_I_ & INSTRUCTION_OPERATOR_MASK))
+        {
+            threadpool_gate_batch_push(wid->tableau, i, NULL_TARG, wid->queue->table[i], _I_, _I_);
+        }
+        wid->queue->table[i] = _I_; 
+    }
+    threadpool_gate_batch_flush(wid->tableau);
+}
+
 /*
  * non_local_clifford_gate
  * Applies a non-local Clifford operation to the widget
@@ -53,14 +123,16 @@ void __inline_non_local_clifford_gate(
     size_t ctrl = wid->q_map[inst->ctrl]; 
     size_t targ = wid->q_map[inst->targ]; 
 
-    // Execute the queued cliffords 
-    // TODO : Merge these operations with CX/CZ gates to cut runtime to one third 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[ctrl] & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl);
+    // Execute the queued cliffords and the gate in a single pass
+    tableau_fused(
+        wid->tableau,
+        ctrl,
+        targ,
+        wid->queue->table[ctrl],
+        wid->queue->table[targ],
+        inst->opcode);
     wid->queue->table[ctrl] = _I_;
-
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK](wid->tableau, targ);
     wid->queue->table[targ] = _I_;
-    TWO_QUBIT_OPERATIONS[inst->opcode & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl, targ);
 
     // Pauli Correction Tracking
     PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ);
@@ -84,6 +156,7 @@ void __inline_rz_gate(
     
     // This could be handled with a better return
     assert(wid->n_qubits < wid->max_qubits);
+    widget_reserve(wid, wid->n_qubits + 1);
 
     const size_t ctrl = WMAP_LOOKUP(wid, inst->arg);
     const size_t targ = wid->n_qubits; 
@@ -91,18 +164,167 @@ void __inline_rz_gate(
     wid->queue->non_cliffords[ctrl] = inst->tag;
     wid->q_map[inst->arg] = wid->n_qubits;
 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[ctrl] & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl);
+    tableau_fused(
+        wid->tableau,
+        ctrl,
+        targ,
+        wid->queue->table[ctrl],
+        wid->queue->table[targ],
+        _CNOT_);
     wid->queue->table[ctrl] = _I_;
+    wid->queue->table[targ] = _I_;
+
+    // Propagate tracked Pauli corrections 
+    pauli_track_z(wid->pauli_tracker, ctrl, targ);
+
+    // Number of qubits increases by one
+    wid->n_qubits += 1;  
+
+    return;
+}
 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK](wid->tableau, targ);
+/*
+ * non_local_clifford_gate_par
+ * Distributes a non-local Clifford operation over the threadpool
+ * :: wid : widget_t* :: The widget
+ * :: inst : two_qubit_instruction* :: The non-local Clifford operation 
+ * Pauli tracking and table updates remain on the calling thread
+ */
+static inline
+void __inline_non_local_clifford_gate_par(
+    widget_t* wid,
+    struct two_qubit_instruction* inst)
+{
+    size_t ctrl = wid->q_map[inst->ctrl]; 
+    size_t targ = wid->q_map[inst->targ]; 
+
+    threadpool_distribute_tableau_kernel(
+        wid->tableau,
+        FUSED_OPERATIONS_RANGE[FUSED_OPERATION_IDX(inst->opcode, wid->queue->table[ctrl], wid->queue->table[targ])],
+        ctrl,
+        targ);
+    wid->queue->table[ctrl] = _I_;
     wid->queue->table[targ] = _I_;
 
-    tableau_CNOT(wid->tableau, ctrl, targ);
+    // Pauli Correction Tracking
+    PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ);
+
+    return;
+} 
+
+/*
+ * rz_gate_par
+ * Implements an rz gate as a terminating operation, distributing the tableau operations over the threadpool
+ * :: wid : widget_t* :: The widget in question 
+ * :: inst : rz_instruction* :: The rz instruction indicating an angle 
+ * Teleports an RZ operation, allocating a new qubit in the process
+ */
+static inline
+void __inline_rz_gate_par(
+    widget_t* wid,
+    struct rz_instruction* inst) 
+{
+    assert(wid->n_qubits < wid->max_qubits);
+
+    // Growing the tableau moves the slices under any queued operations
+    if (wid->n_qubits >= wid->tableau->n_qubits)
+    {
+        threadpool_barrier();
+        widget_reserve(wid, wid->n_qubits + 1);
+    }
+
+    const size_t ctrl = WMAP_LOOKUP(wid, inst->arg);
+    const size_t targ = wid->n_qubits; 
+
+    wid->queue->non_cliffords[ctrl] = inst->tag;
+    wid->q_map[inst->arg] = wid->n_qubits;
+
+    threadpool_distribute_tableau_kernel(
+        wid->tableau,
+        FUSED_OPERATIONS_RANGE[FUSED_OPERATION_IDX(_CNOT_, wid->queue->table[ctrl], wid->queue->table[targ])],
+        ctrl,
+        targ);
+    wid->queue->table[ctrl] = _I_;
+    wid->queue->table[targ] = _I_;
+
+    // Propagate tracked Pauli corrections 
+    pauli_track_z(wid->pauli_tracker, ctrl, targ);
+
+    wid->n_qubits += 1;  
+
+    return;
+}
+
+/*
+ * non_local_clifford_gate_batch
+ * Adds a non-local Clifford operation to the current batch of disjoint gates
+ * :: wid : widget_t* :: The widget
+ * :: inst : two_qubit_instruction* :: The non-local Clifford operation 
+ * The queued local Cliffords are captured by the batch, so later local Cliffords may continue to queue
+ */
+static inline
+void __inline_non_local_clifford_gate_batch(
+    widget_t* wid,
+    struct two_qubit_instruction* inst)
+{
+    size_t ctrl = wid->q_map[inst->ctrl]; 
+    size_t targ = wid->q_map[inst->targ]; 
+
+    threadpool_gate_batch_push(
+        wid->tableau,
+        ctrl,
+        targ,
+        wid->queue->table[ctrl],
+        wid->queue->table[targ],
+        inst->opcode);
+    wid->queue->table[ctrl] = _I_;
+    wid->queue->table[targ] = _I_;
+
+    // Pauli Correction Tracking
+    PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ);
+
+    return;
+} 
+
+/*
+ * rz_gate_batch
+ * Implements an rz gate as a terminating operation, adding the teleportation CNOT to the current batch
+ * :: wid : widget_t* :: The widget in question 
+ * :: inst : rz_instruction* :: The rz instruction indicating an angle 
+ * Teleports an RZ operation, allocating a new qubit in the process
+ */
+static inline
+void __inline_rz_gate_batch(
+    widget_t* wid,
+    struct rz_instruction* inst) 
+{
+    assert(wid->n_qubits < wid->max_qubits);
+
+    if (wid->n_qubits >= wid->tableau->n_qubits)
+    {
+        threadpool_gate_batch_flush(wid->tableau);
+        widget_reserve(wid, wid->n_qubits + 1);
+    }
+
+    const size_t ctrl = WMAP_LOOKUP(wid, inst->arg);
+    const size_t targ = wid->n_qubits; 
+
+    wid->queue->non_cliffords[ctrl] = inst->tag;
+    wid->q_map[inst->arg] = wid->n_qubits;
+
+    threadpool_gate_batch_push(
+        wid->tableau,
+        ctrl,
+        targ,
+        wid->queue->table[ctrl],
+        wid->queue->table[targ],
+        _CNOT_);
+    wid->queue->table[ctrl] = _I_;
+    wid->queue->table[targ] = _I_;
 
     // Propagate tracked Pauli corrections 
     pauli_track_z(wid->pauli_tracker, ctrl, targ);
 
-    // Number of qubits increases by one
     wid->n_qubits += 1;  
 
     return;
@@ -144,31 +366,215 @@ void __inline_conditional_instruction(
 }
 
 
+/*
+ * swap_gate
+ * Swaps two qubits by relabelling them in the qubit map
+ * :: wid : widget_t* :: The widget in question 
+ * :: inst : two_qubit_instruction* :: Swap gate 
+ * Queued local Cliffords, non-Clifford tags and tracked Pauli corrections are indexed by tableau qubit,
+ * so they follow the relabelled qubits without being touched
+ */
+static inline
+void __inline_swap_gate(
+    widget_t* wid,
+    struct two_qubit_instruction* inst) 
+{
+    const size_t ctrl = WMAP_LOOKUP(wid, inst->ctrl);
+    wid->q_map[inst->ctrl] = WMAP_LOOKUP(wid, inst->targ);
+    wid->q_map[inst->targ] = ctrl;
+    return;
+}
+
+
 // Table of indirections  
 void (*instruction_switch[N_INSTRUCTION_TYPES])(widget_t*, void*) = {
         (void (*)(widget_t*, void*))NULL, // 0x00
         (void (*)(widget_t*, void*))__inline_local_clifford_gate, // 0x01
         (void (*)(widget_t*, void*))__inline_non_local_clifford_gate, // 0x02
-        (void (*)(widget_t*, void*))NULL, // 0x03
+        (void (*)(widget_t*, void*))__inline_swap_gate, // 0x03
         (void (*)(widget_t*, void*))__inline_rz_gate, // 0x04
         (void (*)(widget_t*, void*))NULL, // 0x05
         (void (*)(widget_t*, void*))__inline_conditional_instruction, // 0x06
         (void (*)(widget_t*, void*))NULL, // 0x07
 };
 
+// Table of indirections for the threadpool dispatcher 
+void (*instruction_switch_par[N_INSTRUCTION_TYPES])(widget_t*, void*) = {
+        (void (*)(widget_t*, void*))NULL, // 0x00
+        (void (*)(widget_t*, void*))__inline_local_clifford_gate, // 0x01
+        (void (*)(widget_t*, void*))__inline_non_local_clifford_gate_par, // 0x02
+        (void (*)(widget_t*, void*))__inline_swap_gate, // 0x03
+        (void (*)(widget_t*, void*))__inline_rz_gate_par, // 0x04
+        (void (*)(widget_t*, void*))NULL, // 0x05
+        (void (*)(widget_t*, void*))__inline_conditional_instruction, // 0x06
+        (void (*)(widget_t*, void*))NULL, // 0x07
+};
+
+// Table of indirections for the batched dispatcher 
+void (*instruction_switch_batch[N_INSTRUCTION_TYPES])(widget_t*, void*) = {
+        (void (*)(widget_t*, void*))NULL, // 0x00
+        (void (*)(widget_t*, void*))__inline_local_clifford_gate, // 0x01
+        (void (*)(widget_t*, void*))__inline_non_local_clifford_gate_batch, // 0x02
+        (void (*)(widget_t*, void*))__inline_swap_gate, // 0x03
+        (void (*)(widget_t*, void*))__inline_rz_gate_batch, // 0x04
+        (void (*)(widget_t*, void*))NULL, // 0x05
+        (void (*)(widget_t*, void*))__inline_conditional_instruction, // 0x06
+        (void (*)(widget_t*, void*))NULL, // 0x07
+};
+
+/*
+ * parse_instruction_block_batch
+ * Parses a block of instructions, running gates on disjoint qubits concurrently
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * Consecutive gates are batched until a gate shares a qubit with the batch
+ * Local Cliffords and conditional operations do not touch the tableau and never close a batch
+ */
+void parse_instruction_block_batch(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        instruction_switch_batch[
+            INSTRUCTION_TYPE((instructions + i)->instruction) 
+            ](wid, instructions + i);
+    }
+    threadpool_gate_batch_flush(wid->tableau);
+    return;
+}
+
+/*
+ * parse_instruction_block_par
+ * Parses a block of instructions, distributing tableau operations over the threadpool 
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * Each worker operates on a fixed range of rows, blocks until all workers have completed
+ */
+void parse_instruction_block_par(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        instruction_switch_par[
+            INSTRUCTION_TYPE((instructions + i)->instruction) 
+            ](wid, instructions + i);
+    }
+    threadpool_barrier();
+    return;
+}
+
+/*
+ * parse_instruction_block_tiled
+ * Parses a block of instructions, buffering two qubit gates and applying them one tile of rows at a time
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * The queued local Cliffords are captured when a gate is buffered
+ * Local Cliffords and conditional operations do not touch the tableau and are handled immediately
+ */
+void parse_instruction_block_tiled(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    gate_block_t block;
+    block.n_ops = 0;
+
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        instruction_stream_u* inst = instructions + i;
+        switch (INSTRUCTION_TYPE(inst->instruction))
+        {
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+            {
+                const size_t ctrl = wid->q_map[inst->multi.ctrl]; 
+                const size_t targ = wid->q_map[inst->multi.targ]; 
+
+                gate_block_push(
+                    wid->tableau,
+                    &block,
+                    ctrl,
+                    targ,
+                    wid->queue->table[ctrl],
+                    wid->queue->table[targ],
+                    inst->multi.opcode);
+                wid->queue->table[ctrl] = _I_;
+                wid->queue->table[targ] = _I_;
+
+                PAULI_TRACKER_NON_LOCAL(inst->multi.opcode)(wid->pauli_tracker, ctrl, targ);
+                break;
+            }
+            case INSTRUCTION_TYPE(RZ_MASK):
+            {
+                assert(wid->n_qubits < wid->max_qubits);
+
+                if (wid->n_qubits >= wid->tableau->n_qubits)
+                {
+                    gate_block_flush(wid->tableau, &block);
+                    widget_reserve(wid, wid->n_qubits + 1);
+                }
+
+                const size_t ctrl = WMAP_LOOKUP(wid, inst->rz.arg);
+                const size_t targ = wid->n_qubits; 
+
+                wid->queue->non_cliffords[ctrl] = inst->rz.tag;
+                wid->q_map[inst->rz.arg] = wid->n_qubits;
+
+                gate_block_push(
+                    wid->tableau,
+                    &block,
+                    ctrl,
+                    targ,
+                    wid->queue->table[ctrl],
+                    wid->queue->table[targ],
+                    _CNOT_);
+                wid->queue->table[ctrl] = _I_;
+                wid->queue->table[targ] = _I_;
+
+                pauli_track_z(wid->pauli_tracker, ctrl, targ);
+                wid->n_qubits += 1;  
+                break;
+            }
+            default:
+                instruction_switch[INSTRUCTION_TYPE(inst->instruction)](wid, inst);
+                break;
+        }
+    }
+    gate_block_flush(wid->tableau, &block);
+    return;
+}
+
 /*
  * parse_instruction_block
  * Parses a block of instructions 
  * :: wid : widget_t* :: Current widget 
  * :: instructions : instruction_stream_u* :: Array of instructions 
  * :: n_instructions : const size_t :: Number of instructions in the stream 
- * This implementation may be replaced with a thread pool dispatcher
+ * Large tableaus are split between the workers by rows, otherwise gates on disjoint qubits are run concurrently
  */
 void parse_instruction_block(
     widget_t* wid,
     instruction_stream_u* instructions,
     const size_t n_instructions)
 {
+    if (threadpool_distributable(wid->tableau))
+    {
+        parse_instruction_block_par(wid, instructions, n_instructions);
+        return;
+    }
+
+    if (threadpool_get_n_workers() > 1)
+    {
+        parse_instruction_block_batch(wid, instructions, n_instructions);
+        return;
+    }
+
     #pragma GCC unroll 8
     for (size_t i = 0; i < n_instructions; i++)
     {
@@ -179,6 +585,51 @@ void parse_instruction_block(
     return;
 }
 
+/*
+ * parse_instruction_block_packed
+ * Parses a block of packed instructions
+ * :: wid : widget_t* :: Current widget 
+ * :: stream : const uint8_t* :: Packed instructions, see instruction_packed.h 
+ * :: n_bytes : const size_t :: Length of the packed stream 
+ * Decoding replaces the fixed stride walk of parse_instruction_block, each instruction is decoded into a local
+ * A truncated final instruction is not parsed
+ */
+size_t parse_instruction_block_packed(
+    widget_t* wid,
+    const uint8_t* stream,
+    const size_t n_bytes)
+{
+    const uint8_t* end = stream + n_bytes;
+    size_t n_instructions = 0;
+
+    // The distributed and batched parsers require whole blocks of instructions 
+    if (threadpool_get_n_workers() > 1)
+    {
+        instruction_stream_u block[INSTRUCTION_PACKED_DECODE_BLOCK];
+        size_t offset = 0;
+        size_t n_decoded = 0;
+        do
+        {
+            size_t n_read = 0;
+            n_decoded = instruction_unpack(stream + offset, n_bytes - offset, block, INSTRUCTION_PACKED_DECODE_BLOCK, &n_read);
+            parse_instruction_block(wid, block, n_decoded);
+            offset += n_read;
+            n_instructions += n_decoded;
+        } while (INSTRUCTION_PACKED_DECODE_BLOCK == n_decoded);
+        return n_instructions;
+    }
+
+    instruction_stream_u inst;
+    size_t len;
+    while (0 != (len = __inline_instruction_unpack(stream, end, &inst)))
+    {
+        instruction_switch[INSTRUCTION_TYPE(inst.instruction)](wid, &inst);
+        stream += len;
+        n_instructions++;
+    }
+    return n_instructions;
+}
+
 /*
  * teleport_input
  * Sets the widget up to accept teleported inputs
@@ -192,6 +643,7 @@ void teleport_input(widget_t* wid, size_t n_input_qubits)
 {
     // Check that we have sufficient memory for this operation
     assert(wid->max_qubits >= wid->n_initial_qubits + n_input_qubits);
+    widget_reserve(wid, wid->n_qubits + n_input_qubits);
 
     // Double the number of initial qubits 
     wid->n_qubits += n_input_qubits;
@@ -0,0 +1,443 @@
+#include "instruction_file.h"
+#include "input_stream.h"
+
+#include <assert.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * instruction_file_max_qubit
+ * Returns one more than the largest qubit index addressed by an instruction, zero for a NOP
+ * :: inst : const instruction_stream_u* :: Instruction
+ */
+static inline size_t instruction_file_max_qubit(const instruction_stream_u* inst)
+{
+    switch (INSTRUCTION_TYPE(inst->instruction))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            return (size_t)inst->single.arg + 1;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            return (size_t)inst->rz.arg + 1;
+        case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+        case INSTRUCTION_TYPE(QUBIT_PERMUTATION_MASK):
+        case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+        {
+            const size_t ctrl = inst->multi.ctrl;
+            const size_t targ = inst->multi.targ;
+            return ((ctrl > targ) ? ctrl : targ) + 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+
+/*
+ * instruction_file_writer_open
+ * Creates a binary instruction stream
+ * :: path : const char* :: Path of the file, any existing file is replaced
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the instructions
+ * Space for the header is reserved, the header is written on close
+ */
+instruction_file_writer_t* instruction_file_writer_open(
+    const char* path,
+    const enum instruction_file_encoding_e encoding)
+{
+    FILE* fp = fopen(path, "wb");
+    if (NULL == fp)
+    {
+        return NULL;
+    }
+
+    instruction_file_writer_t* writer = (instruction_file_writer_t*)malloc(sizeof(instruction_file_writer_t));
+    memset(&writer->header, 0, sizeof(instruction_file_header_t));
+    strncpy(writer->header.magic, INSTRUCTION_FILE_MAGIC, sizeof(writer->header.magic));
+    writer->header.version = INSTRUCTION_FILE_VERSION;
+    writer->header.instruction_bytes = sizeof(instruction_stream_u);
+    writer->header.encoding = encoding;
+    writer->fp = fp;
+    writer->buf = NULL;
+    writer->buf_bytes = 0;
+
+    if (1 != fwrite(&writer->header, sizeof(instruction_file_header_t), 1, fp))
+    {
+        fclose(fp);
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+
+/*
+ * instruction_file_writer_append
+ * Appends instructions to the stream
+ * :: writer : instruction_file_writer_t* :: Writer
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions to append
+ * Qubit and Rz counts are accumulated for the header
+ * Packed streams are encoded through a buffer that grows to the largest append
+ */
+bool instruction_file_writer_append(
+    instruction_file_writer_t* writer,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const size_t n_qubits = instruction_file_max_qubit(instructions + i);
+        writer->header.n_qubits = (n_qubits > writer->header.n_qubits) ? n_qubits : writer->header.n_qubits;
+        writer->header.n_rz += (INSTRUCTION_TYPE(instructions[i].instruction) == INSTRUCTION_TYPE(RZ_MASK));
+    }
+
+    size_t n_bytes = n_instructions * sizeof(instruction_stream_u);
+    const void* data = instructions;
+    if (INSTRUCTION_FILE_PACKED == writer->header.encoding)
+    {
+        const size_t bound = instruction_packed_bound(n_instructions);
+        if (bound > writer->buf_bytes)
+        {
+            free(writer->buf);
+            writer->buf = (uint8_t*)malloc(bound);
+            writer->buf_bytes = bound;
+        }
+        n_bytes = instruction_pack(instructions, n_instructions, writer->buf);
+        data = writer->buf;
+    }
+
+    if (n_bytes != fwrite(data, 1, n_bytes, writer->fp))
+    {
+        return false;
+    }
+    writer->header.n_instructions += n_instructions;
+    writer->header.n_bytes += n_bytes;
+    return true;
+}
+
+
+/*
+ * instruction_file_writer_close
+ * Writes the header and closes the stream
+ * :: writer : instruction_file_writer_t* :: Writer, freed by this call
+ */
+bool instruction_file_writer_close(instruction_file_writer_t* writer)
+{
+    bool written = (0 == fseek(writer->fp, 0, SEEK_SET))
+        && (1 == fwrite(&writer->header, sizeof(instruction_file_header_t), 1, writer->fp));
+    written = (0 == fclose(writer->fp)) && written;
+    free(writer->buf);
+    free(writer);
+    return written;
+}
+
+
+/*
+ * instruction_file_write
+ * Writes an array of instructions as a binary instruction stream
+ * :: path : const char* :: Path of the file, any existing file is replaced
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the instructions
+ */
+bool instruction_file_write(
+    const char* path,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const enum instruction_file_encoding_e encoding)
+{
+    instruction_file_writer_t* writer = instruction_file_writer_open(path, encoding);
+    if (NULL == writer)
+    {
+        return false;
+    }
+    const bool appended = instruction_file_writer_append(writer, instructions, n_instructions);
+    return instruction_file_writer_close(writer) && appended;
+}
+
+
+/*
+ * instruction_file_packed_valid
+ * Checks that a packed stream decodes to exactly n_instructions instructions
+ * :: data : const uint8_t* :: Packed stream
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: n_instructions : const size_t :: Number of instructions given by the header
+ * Truncated instructions and overlong operands both stop the decode early
+ */
+static bool instruction_file_packed_valid(const uint8_t* data, const size_t n_bytes, const size_t n_instructions)
+{
+    const uint8_t* end = data + n_bytes;
+    instruction_stream_u inst;
+    size_t n_decoded = 0;
+    size_t len;
+    while ((n_decoded < n_instructions) && (0 != (len = __inline_instruction_unpack(data, end, &inst))))
+    {
+        data += len;
+        n_decoded++;
+    }
+    return (n_instructions == n_decoded) && (end == data);
+}
+
+
+/*
+ * instruction_file_open
+ * Maps a binary instruction stream
+ * :: path : const char* :: Path of the file
+ * The mapping is read only, pages are read from the file as the stream is parsed
+ */
+instruction_file_t* instruction_file_open(const char* path)
+{
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat st;
+    if ((0 != fstat(fd, &st)) || ((size_t)st.st_size < sizeof(instruction_file_header_t)))
+    {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t map_bytes = st.st_size;
+    void* map = mmap(NULL, map_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping holds its own reference to the file
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return NULL;
+    }
+
+    const instruction_file_header_t* header = (const instruction_file_header_t*)map;
+    const size_t data_bytes = map_bytes - sizeof(instruction_file_header_t);
+    // The header is untrusted, the instruction count is bounded before it is multiplied
+    const bool fixed = (INSTRUCTION_FILE_FIXED == header->encoding)
+        && (header->n_instructions <= data_bytes / sizeof(instruction_stream_u))
+        && (header->n_bytes == header->n_instructions * sizeof(instruction_stream_u));
+    const bool packed = (INSTRUCTION_FILE_PACKED == header->encoding)
+        && (header->n_bytes >= header->n_instructions);
+    const bool valid = (0 == strncmp(header->magic, INSTRUCTION_FILE_MAGIC, sizeof(header->magic)))
+        && (INSTRUCTION_FILE_VERSION == header->version)
+        && (sizeof(instruction_stream_u) == header->instruction_bytes)
+        && (fixed || packed)
+        && (header->n_bytes <= data_bytes);
+    if (!valid)
+    {
+        munmap(map, map_bytes);
+        return NULL;
+    }
+
+    // Packed streams are decoded once up front, so a malformed body is rejected here rather than part way through a parse
+    if ((INSTRUCTION_FILE_PACKED == header->encoding)
+        && !instruction_file_packed_valid((uint8_t*)map + INSTRUCTION_FILE_HEADER_BYTES, header->n_bytes, header->n_instructions))
+    {
+        munmap(map, map_bytes);
+        return NULL;
+    }
+
+    #ifdef MADV_SEQUENTIAL
+    // Advisory only, streams are parsed front to back
+    madvise(map, map_bytes, MADV_SEQUENTIAL);
+    #endif
+
+    instruction_file_t* file = (instruction_file_t*)malloc(sizeof(instruction_file_t));
+    file->map = map;
+    file->map_bytes = map_bytes;
+    file->header = header;
+    file->data = (uint8_t*)map + INSTRUCTION_FILE_HEADER_BYTES;
+    file->cursor_instruction = 0;
+    file->cursor_byte = 0;
+    return file;
+}
+
+
+/*
+ * instruction_file_close
+ * Unmaps a binary instruction stream
+ * :: file : instruction_file_t* :: File, freed by this call
+ */
+void instruction_file_close(instruction_file_t* file)
+{
+    munmap(file->map, file->map_bytes);
+    free(file);
+}
+
+
+size_t instruction_file_get_n_instructions(const instruction_file_t* file)
+{
+    return file->header->n_instructions;
+}
+
+
+size_t instruction_file_get_n_qubits(const instruction_file_t* file)
+{
+    return file->header->n_qubits;
+}
+
+
+size_t instruction_file_get_n_rz(const instruction_file_t* file)
+{
+    return file->header->n_rz;
+}
+
+
+enum instruction_file_encoding_e instruction_file_get_encoding(const instruction_file_t* file)
+{
+    return (enum instruction_file_encoding_e)file->header->encoding;
+}
+
+
+size_t instruction_file_get_n_bytes(const instruction_file_t* file)
+{
+    return file->header->n_bytes;
+}
+
+
+const uint8_t* instruction_file_get_data(const instruction_file_t* file)
+{
+    return file->data;
+}
+
+
+const instruction_stream_u* instruction_file_get_instructions(const instruction_file_t* file)
+{
+    if (INSTRUCTION_FILE_FIXED != file->header->encoding)
+    {
+        return NULL;
+    }
+    return (const instruction_stream_u*)file->data;
+}
+
+
+/*
+ * instruction_file_release
+ * Drops the whole pages of the mapping between two offsets
+ * :: file : instruction_file_t* :: File
+ * :: released : uint8_t** :: Start of the pages that have not yet been dropped, advanced past any dropped pages
+ * :: consumed : const uint8_t* :: End of the data that has been parsed
+ * Dropped pages are read from the file again if they are revisited
+ */
+static void instruction_file_release(instruction_file_t* file, uint8_t** released, const uint8_t* consumed)
+{
+    #ifdef MADV_DONTNEED
+    const size_t page_bytes = sysconf(_SC_PAGESIZE);
+    uint8_t* base = (uint8_t*)file->map;
+    uint8_t* boundary = base + page_bytes * ((consumed - base) / page_bytes);
+    if (boundary > *released)
+    {
+        madvise(*released, boundary - *released, MADV_DONTNEED);
+        *released = boundary;
+    }
+    #endif
+}
+
+
+/*
+ * instruction_file_page_start
+ * Returns the start of the page holding an offset of the mapping
+ * :: file : const instruction_file_t* :: File
+ * :: ptr : const uint8_t* :: Address in the mapping
+ */
+static uint8_t* instruction_file_page_start(const instruction_file_t* file, const uint8_t* ptr)
+{
+    const size_t page_bytes = sysconf(_SC_PAGESIZE);
+    uint8_t* base = (uint8_t*)file->map;
+    return base + page_bytes * ((ptr - base) / page_bytes);
+}
+
+
+/*
+ * instruction_file_parse_packed
+ * Parses a range of a packed stream
+ * :: wid : widget_t* :: Widget
+ * :: file : instruction_file_t* :: File
+ * :: start : const size_t :: First instruction to parse
+ * :: n_instructions : const size_t :: Number of instructions to parse
+ * The cursor is left after the range, so consecutive ranges are not rescanned
+ * Returns false if the range could not be decoded, the cursor is reset
+ */
+static bool instruction_file_parse_packed(
+    widget_t* wid,
+    instruction_file_t* file,
+    const size_t start,
+    const size_t n_instructions)
+{
+    const size_t n_bytes = file->header->n_bytes;
+    if (start < file->cursor_instruction)
+    {
+        file->cursor_instruction = 0;
+        file->cursor_byte = 0;
+    }
+    file->cursor_byte += instruction_packed_skip(
+        file->data + file->cursor_byte,
+        n_bytes - file->cursor_byte,
+        start - file->cursor_instruction);
+    file->cursor_instruction = start;
+
+    uint8_t* released = instruction_file_page_start(file, file->data + file->cursor_byte);
+    size_t remaining = n_instructions;
+    while (remaining > 0)
+    {
+        const size_t n_chunk = (remaining < INSTRUCTION_FILE_CHUNK) ? remaining : INSTRUCTION_FILE_CHUNK;
+        const uint8_t* chunk = file->data + file->cursor_byte;
+        const size_t chunk_bytes = instruction_packed_skip(chunk, n_bytes - file->cursor_byte, n_chunk);
+
+        const size_t n_parsed = parse_instruction_block_packed(wid, chunk, chunk_bytes);
+        if (n_parsed != n_chunk)
+        {
+            file->cursor_instruction = 0;
+            file->cursor_byte = 0;
+            return false;
+        }
+
+        file->cursor_byte += chunk_bytes;
+        file->cursor_instruction += n_chunk;
+        remaining -= n_chunk;
+        instruction_file_release(file, &released, file->data + file->cursor_byte);
+    }
+    return true;
+}
+
+
+/*
+ * instruction_file_parse
+ * Parses a range of a mapped stream into a widget
+ * :: wid : widget_t* :: Widget
+ * :: file : instruction_file_t* :: File
+ * :: start : const size_t :: First instruction to parse
+ * :: n_instructions : const size_t :: Number of instructions to parse
+ * Pages behind each chunk are dropped, so resident memory does not grow with the length of the stream
+ * Dropped pages are read from the file again if they are revisited
+ * Returns false if a packed range could not be decoded, instructions before the failure have been parsed
+ */
+bool instruction_file_parse(
+    widget_t* wid,
+    instruction_file_t* file,
+    const size_t start,
+    const size_t n_instructions)
+{
+    assert(start + n_instructions <= file->header->n_instructions);
+
+    if (INSTRUCTION_FILE_PACKED == file->header->encoding)
+    {
+        return instruction_file_parse_packed(wid, file, start, n_instructions);
+    }
+
+    // Parsing only reads the instructions, the mapping is read only
+    instruction_stream_u* instructions = (instruction_stream_u*)file->data;
+    uint8_t* released = instruction_file_page_start(file, (uint8_t*)(instructions + start));
+    for (size_t i = start; i < start + n_instructions; i += INSTRUCTION_FILE_CHUNK)
+    {
+        const size_t remaining = start + n_instructions - i;
+        const size_t n_chunk = (remaining < INSTRUCTION_FILE_CHUNK) ? remaining : INSTRUCTION_FILE_CHUNK;
+        parse_instruction_block(wid, instructions + i, n_chunk);
+
+        // Only whole pages that have been completely consumed are dropped
+        instruction_file_release(file, &released, (uint8_t*)(instructions + i + n_chunk));
+    }
+    return true;
+}
@@ -0,0 +1,99 @@
+#include "instruction_packed.h"
+
+/*
+ * instruction_pack
+ * Packs an array of instructions
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: buf : uint8_t* :: Output buffer of at least instruction_packed_bound(n_instructions) bytes
+ */
+size_t instruction_pack(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    uint8_t* buf)
+{
+    size_t n_bytes = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const instruction_t opcode = instructions[i].instruction;
+        const uint8_t n_operands = INSTRUCTION_PACKED_OPERANDS[INSTRUCTION_TYPE(opcode)];
+
+        buf[n_bytes++] = opcode;
+        if (n_operands > 0)
+        {
+            n_bytes += __inline_instruction_pack_varint(instructions[i].multi.ctrl, buf + n_bytes);
+        }
+        if (n_operands > 1)
+        {
+            n_bytes += __inline_instruction_pack_varint(instructions[i].multi.targ, buf + n_bytes);
+        }
+    }
+    return n_bytes;
+}
+
+
+/*
+ * instruction_unpack
+ * Unpacks a packed stream
+ * :: buf : const uint8_t* :: Packed stream
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: instructions : instruction_stream_u* :: Output array
+ * :: max_instructions : const size_t :: Length of the output array
+ * :: n_read : size_t* :: Optional, set to the number of bytes consumed
+ * A truncated final instruction is not consumed
+ */
+size_t instruction_unpack(
+    const uint8_t* buf,
+    const size_t n_bytes,
+    instruction_stream_u* instructions,
+    const size_t max_instructions,
+    size_t* n_read)
+{
+    const uint8_t* end = buf + n_bytes;
+    size_t offset = 0;
+    size_t n_instructions = 0;
+    while (n_instructions < max_instructions)
+    {
+        const size_t len = __inline_instruction_unpack(buf + offset, end, instructions + n_instructions);
+        if (0 == len)
+        {
+            break;
+        }
+        offset += len;
+        n_instructions++;
+    }
+
+    if (NULL != n_read)
+    {
+        *n_read = offset;
+    }
+    return n_instructions;
+}
+
+
+/*
+ * instruction_packed_skip
+ * Finds the offset of an instruction in a packed stream
+ * :: buf : const uint8_t* :: Packed stream
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: n_instructions : const size_t :: Number of instructions to skip
+ * Only the continuation bits of the operands are read
+ */
+size_t instruction_packed_skip(
+    const uint8_t* buf,
+    const size_t n_bytes,
+    const size_t n_instructions)
+{
+    size_t offset = 0;
+    for (size_t i = 0; (i < n_instructions) && (offset < n_bytes); i++)
+    {
+        uint8_t n_operands = INSTRUCTION_PACKED_OPERANDS[INSTRUCTION_TYPE(buf[offset])];
+        offset++;
+        while ((n_operands > 0) && (offset < n_bytes))
+        {
+            n_operands -= (buf[offset] < 0x80);
+            offset++;
+        }
+    }
+    return (offset < n_bytes) ? offset : n_bytes;
+}
@@ -0,0 +1,338 @@
+#include "instruction_ring.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "input_stream.h"
+#include "instruction_packed.h"
+
+/*
+ * instruction_ring_backoff
+ * Waits on a full or empty ring
+ * :: n_polls : size_t* :: Number of polls since the ring last made progress
+ * Polls INSTRUCTION_RING_SPIN times before yielding the core to the other end of the ring
+ */
+static inline
+void instruction_ring_backoff(size_t* n_polls)
+{
+    if (*n_polls < INSTRUCTION_RING_SPIN)
+    {
+        (*n_polls)++;
+        return;
+    }
+    sched_yield();
+}
+
+
+/*
+ * instruction_ring_create
+ * Allocates a ring
+ * :: capacity : const size_t :: Minimum number of instructions held by the ring, rounded up to a power of two
+ */
+instruction_ring_t* instruction_ring_create(const size_t capacity)
+{
+    assert(capacity > 0);
+
+    size_t rounded = 1;
+    while (rounded < capacity)
+    {
+        rounded <<= 1;
+    }
+
+    instruction_ring_t* ring = NULL;
+    const int err = posix_memalign((void**)&ring, CACHE_SIZE, sizeof(instruction_ring_t));
+    assert(0 == err);
+    memset(ring, 0, sizeof(instruction_ring_t));
+
+    ring->buf = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * rounded);
+    assert(NULL != ring->buf);
+    ring->capacity = rounded;
+    ring->mask = rounded - 1;
+    return ring;
+}
+
+
+/*
+ * instruction_ring_destroy
+ * Frees a ring
+ * :: ring : instruction_ring_t* :: Ring, neither end may be in use
+ */
+void instruction_ring_destroy(instruction_ring_t* ring)
+{
+    free(ring->buf);
+    free(ring);
+}
+
+
+/*
+ * instruction_ring_get_capacity
+ * :: ring : const instruction_ring_t* :: Ring
+ */
+size_t instruction_ring_get_capacity(const instruction_ring_t* ring)
+{
+    return ring->capacity;
+}
+
+
+/*
+ * instruction_ring_try_push
+ * Pushes as many instructions as there is space for without waiting
+ * :: ring : instruction_ring_t* :: Ring
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions to push
+ * The instructions are written before head is released to the consumer
+ */
+size_t instruction_ring_try_push(
+    instruction_ring_t* ring,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    assert(!ring->closed);
+
+    const size_t head = ring->head;
+    const size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    const size_t space = ring->capacity - (head - tail);
+    const size_t n_push = (n_instructions < space) ? n_instructions : space;
+    if (0 == n_push)
+    {
+        return 0;
+    }
+
+    // The free space may wrap around the end of the buffer
+    const size_t offset = head & ring->mask;
+    const size_t n_first = (n_push < ring->capacity - offset) ? n_push : ring->capacity - offset;
+    memcpy(ring->buf + offset, instructions, sizeof(instruction_stream_u) * n_first);
+    memcpy(ring->buf, instructions + n_first, sizeof(instruction_stream_u) * (n_push - n_first));
+
+    __atomic_store_n(&ring->head, head + n_push, __ATOMIC_RELEASE);
+    return n_push;
+}
+
+
+/*
+ * instruction_ring_push
+ * Pushes instructions, waiting for the consumer to free space as needed
+ * :: ring : instruction_ring_t* :: Ring
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions to push
+ */
+void instruction_ring_push(
+    instruction_ring_t* ring,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    size_t n_pushed = 0;
+    size_t n_polls = 0;
+    while (n_pushed < n_instructions)
+    {
+        const size_t n_push = instruction_ring_try_push(ring, instructions + n_pushed, n_instructions - n_pushed);
+        if (n_push > 0)
+        {
+            n_pushed += n_push;
+            n_polls = 0;
+            continue;
+        }
+        instruction_ring_backoff(&n_polls);
+    }
+}
+
+
+/*
+ * instruction_ring_close
+ * Marks the end of the stream
+ * :: ring : instruction_ring_t* :: Ring
+ */
+void instruction_ring_close(instruction_ring_t* ring)
+{
+    __atomic_store_n(&ring->closed, true, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * instruction_ring_try_pop
+ * Copies out as many instructions as are available without waiting
+ * :: ring : instruction_ring_t* :: Ring
+ * :: instructions : instruction_stream_u* :: Output array
+ * :: max_instructions : const size_t :: Length of the output array
+ */
+size_t instruction_ring_try_pop(
+    instruction_ring_t* ring,
+    instruction_stream_u* instructions,
+    const size_t max_instructions)
+{
+    const size_t tail = ring->tail;
+    const size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    const size_t n_pop = (head - tail < max_instructions) ? head - tail : max_instructions;
+    if (0 == n_pop)
+    {
+        return 0;
+    }
+
+    const size_t offset = tail & ring->mask;
+    const size_t n_first = (n_pop < ring->capacity - offset) ? n_pop : ring->capacity - offset;
+    memcpy(instructions, ring->buf + offset, sizeof(instruction_stream_u) * n_first);
+    memcpy(instructions + n_first, ring->buf, sizeof(instruction_stream_u) * (n_pop - n_first));
+
+    __atomic_store_n(&ring->tail, tail + n_pop, __ATOMIC_RELEASE);
+    return n_pop;
+}
+
+
+/*
+ * parse_instruction_ring
+ * Parses instructions from a ring until it is closed and drained
+ * :: wid : widget_t* :: Widget
+ * :: ring : instruction_ring_t* :: Ring
+ * Slots are only released to the producer after they have been parsed
+ * The ring is checked for instructions again after it is seen to be closed,
+ * as the producer may push its final instructions between the two loads
+ */
+size_t parse_instruction_ring(widget_t* wid, instruction_ring_t* ring)
+{
+    size_t n_parsed = 0;
+    size_t n_polls = 0;
+    size_t tail = ring->tail;
+    for (;;)
+    {
+        const size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        if (head == tail)
+        {
+            if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE)
+                && (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail))
+            {
+                return n_parsed;
+            }
+            instruction_ring_backoff(&n_polls);
+            continue;
+        }
+        n_polls = 0;
+
+        // Parse the run up to the end of the buffer, the remainder is picked up on the next pass
+        const size_t offset = tail & ring->mask;
+        const size_t available = head - tail;
+        const size_t n_run = (available < ring->capacity - offset) ? available : ring->capacity - offset;
+        parse_instruction_block(wid, ring->buf + offset, n_run);
+
+        tail += n_run;
+        n_parsed += n_run;
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+}
+
+
+/*
+ * instruction_ring_read
+ * Body of a reader thread
+ * :: arg : void* :: instruction_ring_reader_t*
+ * Bytes left over from a partial instruction are carried to the front of the buffer for the next read
+ */
+static
+void* instruction_ring_read(void* arg)
+{
+    instruction_ring_reader_t* reader = (instruction_ring_reader_t*)arg;
+
+    // The reader never parses, so it should not count towards the threadpool
+    threadpool_detach_thread(true);
+
+    // Aligned for instruction_stream_u, as fixed streams are pushed straight from the buffer
+    uint8_t* buf = (uint8_t*)malloc(INSTRUCTION_RING_READ_BYTES);
+    assert(NULL != buf);
+
+    // Worst case of one byte per instruction
+    instruction_stream_u* unpacked = NULL;
+    if (INSTRUCTION_FILE_PACKED == reader->encoding)
+    {
+        unpacked = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * INSTRUCTION_RING_READ_BYTES);
+        assert(NULL != unpacked);
+    }
+
+    size_t n_buffered = 0;
+    reader->success = true;
+    for (;;)
+    {
+        const ssize_t n_read = read(reader->fd, buf + n_buffered, INSTRUCTION_RING_READ_BYTES - n_buffered);
+        if (n_read < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            reader->success = false;
+            break;
+        }
+        if (0 == n_read)
+        {
+            // Trailing bytes are a truncated instruction
+            reader->success = (0 == n_buffered);
+            break;
+        }
+        n_buffered += n_read;
+
+        size_t n_consumed = 0;
+        if (INSTRUCTION_FILE_PACKED == reader->encoding)
+        {
+            const size_t n_instructions = instruction_unpack(
+                buf, n_buffered, unpacked, INSTRUCTION_RING_READ_BYTES, &n_consumed);
+            instruction_ring_push(reader->ring, unpacked, n_instructions);
+        }
+        else
+        {
+            const size_t n_instructions = n_buffered / sizeof(instruction_stream_u);
+            instruction_ring_push(reader->ring, (instruction_stream_u*)buf, n_instructions);
+            n_consumed = n_instructions * sizeof(instruction_stream_u);
+        }
+
+        memmove(buf, buf + n_consumed, n_buffered - n_consumed);
+        n_buffered -= n_consumed;
+    }
+
+    instruction_ring_close(reader->ring);
+    free(unpacked);
+    free(buf);
+    return NULL;
+}
+
+
+/*
+ * instruction_ring_reader_start
+ * Starts a producer thread that reads a raw instruction stream from a file descriptor into a ring
+ * :: ring : instruction_ring_t* :: Ring, closed by the reader at the end of the stream
+ * :: fd : const int :: File descriptor of a file or pipe, read until end of file and not closed
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the stream
+ */
+instruction_ring_reader_t* instruction_ring_reader_start(
+    instruction_ring_t* ring,
+    const int fd,
+    const enum instruction_file_encoding_e encoding)
+{
+    instruction_ring_reader_t* reader = (instruction_ring_reader_t*)malloc(sizeof(instruction_ring_reader_t));
+    assert(NULL != reader);
+    reader->ring = ring;
+    reader->fd = fd;
+    reader->encoding = encoding;
+    reader->success = false;
+
+    if (0 != pthread_create(&reader->thread, NULL, instruction_ring_read, reader))
+    {
+        free(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+
+/*
+ * instruction_ring_reader_join
+ * Waits for a reader to reach the end of its stream
+ * :: reader : instruction_ring_reader_t* :: Reader, freed by this call
+ */
+bool instruction_ring_reader_join(instruction_ring_reader_t* reader)
+{
+    pthread_join(reader->thread, NULL);
+    const bool success = reader->success;
+    free(reader);
+    return success;
+}
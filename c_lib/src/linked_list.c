@@ -0,0 +1,110 @@
+#include "linked_list.h"
+
+/*
+ * linked_list_create
+ * Constructor for a linked list
+ * Returns a heap allocated empty list
+ */
+struct linked_list_t* linked_list_create()
+{
+    struct linked_list_t* ll = (struct linked_list_t*)malloc(sizeof(struct linked_list_t));
+    ll->n_elements = 0;
+    ll->n_reuse_elements = 0;
+    ll->head = NULL;
+    ll->tail = NULL;
+    ll->reuse_head = NULL;
+    return ll;
+}
+
+/*
+ * linked_list_destroy
+ * Destructor for a linked list
+ * :: ll : struct linked_list_t* :: List to free
+ * Frees all nodes, objects held by the list are not freed
+ */
+void linked_list_destroy(struct linked_list_t* ll)
+{
+    struct list_node_t* node = ll->head;
+    while (NULL != node)
+    {
+        struct list_node_t* next = node->next;
+        free(node);
+        node = next;
+    }
+
+    node = ll->reuse_head;
+    while (NULL != node)
+    {
+        struct list_node_t* next = node->next;
+        free(node);
+        node = next;
+    }
+    free(ll);
+}
+
+/*
+ * linked_list_push
+ * Pushes an object to the tail of the list
+ * :: ll : struct linked_list_t* :: The list
+ * :: obj : void* :: Object to push
+ */
+void linked_list_push(struct linked_list_t* ll, void* obj)
+{
+    struct list_node_t* node = ll->reuse_head;
+
+    // Pull a node from the reuse stack if one is available 
+    if (NULL != node)
+    {
+        ll->reuse_head = node->next;
+        ll->n_reuse_elements--;
+    }
+    else
+    {
+        node = (struct list_node_t*)malloc(sizeof(struct list_node_t));
+    }
+
+    node->next = NULL;
+    node->obj = obj;
+
+    if (NULL == ll->tail)
+    {
+        ll->head = node;
+    }
+    else
+    {
+        ll->tail->next = node;
+    }
+    ll->tail = node;
+    ll->n_elements++;
+}
+
+/*
+ * linked_list_pop
+ * Pops an object from the head of the list
+ * :: ll : struct linked_list_t* :: The list
+ * Returns NULL if the list is empty
+ */
+void* linked_list_pop(struct linked_list_t* ll)
+{
+    struct list_node_t* node = ll->head;
+    if (NULL == node)
+    {
+        return NULL;
+    }
+
+    ll->head = node->next;
+    if (NULL == ll->head)
+    {
+        ll->tail = NULL;
+    }
+    ll->n_elements--;
+
+    void* obj = node->obj;
+
+    // Retain the node for reuse
+    node->next = ll->reuse_head;
+    ll->reuse_head = node;
+    ll->n_reuse_elements++;
+
+    return obj;
+}
@@ -0,0 +1,212 @@
+// Required for the CPU affinity interface
+#define _GNU_SOURCE
+#include "numa.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+// Memory policy from linux/mempolicy.h, not all toolchains ship the header
+#define NUMA_MPOL_INTERLEAVE (3)
+
+static struct numa_topology_t NUMA_TOPOLOGY;
+static pthread_once_t NUMA_TOPOLOGY_ONCE = PTHREAD_ONCE_INIT;
+
+/*
+ * numa_parse_list
+ * Parses a sysfs list of the form "0-3,8,10-11" into a bitmask
+ * :: path : const char* :: File to read
+ * :: mask : uint64_t* :: Bitmask of NUMA_MAX_NODES or CPU_SETSIZE bits
+ * :: n_bits : const size_t :: Length of the bitmask
+ * Returns false if the file could not be read
+ */
+static bool numa_parse_list(const char* path, uint64_t* mask, const size_t n_bits)
+{
+    FILE* fp = fopen(path, "r");
+    if (NULL == fp)
+    {
+        return false;
+    }
+
+    unsigned long lo = 0;
+    unsigned long hi = 0;
+    int sep = 0;
+    while (1 == fscanf(fp, "%lu", &lo))
+    {
+        hi = lo;
+        sep = fgetc(fp);
+        if ('-' == sep)
+        {
+            if (1 != fscanf(fp, "%lu", &hi))
+            {
+                break;
+            }
+            sep = fgetc(fp);
+        }
+        for (unsigned long i = lo; (i <= hi) && (i < n_bits); i++)
+        {
+            mask[i / 64] |= 1ull << (i % 64);
+        }
+        if (',' != sep)
+        {
+            break;
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+/*
+ * numa_topology_init
+ * Reads the node of each CPU the process may run on
+ * Called once through NUMA_TOPOLOGY_ONCE
+ */
+static void numa_topology_init()
+{
+    NUMA_TOPOLOGY.n_nodes = 1;
+    NUMA_TOPOLOGY.n_cpus = 0;
+
+    #ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 != sched_getaffinity(0, sizeof(cpu_set_t), &allowed))
+    {
+        return;
+    }
+
+    const size_t n_allowed = CPU_COUNT(&allowed);
+    NUMA_TOPOLOGY.cpus = (size_t*)malloc(n_allowed * sizeof(size_t));
+    NUMA_TOPOLOGY.nodes = (size_t*)malloc(n_allowed * sizeof(size_t));
+
+    uint64_t node_mask[(NUMA_MAX_NODES + 63) / 64] = {0};
+    if (!numa_parse_list("/sys/devices/system/node/online", node_mask, NUMA_MAX_NODES))
+    {
+        node_mask[0] = 1;
+    }
+
+    // CPUs on each node in turn, then any CPUs that sysfs did not place on a node
+    size_t n_nodes = 0;
+    char path[64];
+    for (size_t node = 0; node < NUMA_MAX_NODES; node++)
+    {
+        if (0 == (node_mask[node / 64] & (1ull << (node % 64))))
+        {
+            continue;
+        }
+
+        uint64_t cpu_mask[CPU_SETSIZE / 64] = {0};
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", node);
+        numa_parse_list(path, cpu_mask, CPU_SETSIZE);
+
+        for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if ((cpu_mask[cpu / 64] & (1ull << (cpu % 64))) && CPU_ISSET(cpu, &allowed))
+            {
+                NUMA_TOPOLOGY.cpus[NUMA_TOPOLOGY.n_cpus] = cpu;
+                NUMA_TOPOLOGY.nodes[NUMA_TOPOLOGY.n_cpus] = node;
+                NUMA_TOPOLOGY.n_cpus++;
+                CPU_CLR(cpu, &allowed);
+            }
+        }
+        n_nodes++;
+    }
+
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            NUMA_TOPOLOGY.cpus[NUMA_TOPOLOGY.n_cpus] = cpu;
+            NUMA_TOPOLOGY.nodes[NUMA_TOPOLOGY.n_cpus] = 0;
+            NUMA_TOPOLOGY.n_cpus++;
+        }
+    }
+
+    NUMA_TOPOLOGY.n_nodes = (n_nodes > 0) ? n_nodes : 1;
+    #endif
+}
+
+/*
+ * numa_n_nodes
+ * Returns the number of online NUMA nodes, one on systems without NUMA
+ */
+size_t numa_n_nodes()
+{
+    pthread_once(&NUMA_TOPOLOGY_ONCE, numa_topology_init);
+    return NUMA_TOPOLOGY.n_nodes;
+}
+
+/*
+ * numa_worker_cpu
+ * Assigns a CPU to a worker
+ * :: worker : const size_t :: Worker index
+ * :: n_workers : const size_t :: Number of workers
+ * :: node : size_t* :: Set to the node of the CPU
+ * Returns NUMA_NO_CPU if there are more workers than CPUs
+ */
+size_t numa_worker_cpu(const size_t worker, const size_t n_workers, size_t* node)
+{
+    pthread_once(&NUMA_TOPOLOGY_ONCE, numa_topology_init);
+
+    *node = 0;
+    if ((n_workers > NUMA_TOPOLOGY.n_cpus) || (worker >= n_workers))
+    {
+        return NUMA_NO_CPU;
+    }
+
+    const size_t idx = (worker * NUMA_TOPOLOGY.n_cpus) / n_workers;
+    *node = NUMA_TOPOLOGY.nodes[idx];
+    return NUMA_TOPOLOGY.cpus[idx];
+}
+
+/*
+ * numa_pin_thread
+ * Pins a thread to a single CPU
+ * :: thread : pthread_t :: Thread to pin
+ * :: cpu : const size_t :: CPU id
+ * Returns false if the thread could not be pinned
+ */
+bool numa_pin_thread(pthread_t thread, const size_t cpu)
+{
+    #ifdef __linux__
+    if (cpu >= CPU_SETSIZE)
+    {
+        return false;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return 0 == pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpus);
+    #else
+    return false;
+    #endif
+}
+
+/*
+ * numa_interleave
+ * Interleaves the pages of a mapping over all online nodes
+ * :: addr : void* :: Page aligned start of the mapping
+ * :: n_bytes : const size_t :: Length of the mapping
+ * Advisory only, returns false if the policy was not applied
+ */
+bool numa_interleave(void* addr, const size_t n_bytes)
+{
+    #if defined(__linux__) && defined(SYS_mbind)
+    uint64_t node_mask[(NUMA_MAX_NODES + 63) / 64] = {0};
+    if (!numa_parse_list("/sys/devices/system/node/online", node_mask, NUMA_MAX_NODES))
+    {
+        return false;
+    }
+
+    // The kernel drops the last bit of the mask
+    const unsigned long max_node = NUMA_MAX_NODES + 1;
+    return 0 == syscall(SYS_mbind, addr, n_bytes, NUMA_MPOL_INTERLEAVE, node_mask, max_node, 0);
+    #else
+    return false;
+    #endif
+}
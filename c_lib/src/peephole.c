@@ -0,0 +1,380 @@
+#include "peephole.h"
+#include "input_stream.h"
+#include "rz_tag.h"
+
+#include <assert.h>
+#include <string.h>
+
+// Removed instructions are overwritten with identities, which are never added to a chain
+#define PEEPHOLE_REMOVED (_I_)
+
+/*
+ * peephole_t
+ * Chains of the optimised instructions of a block
+ */
+struct peephole_t
+{
+    instruction_stream_u* out; // Optimised instructions of the block
+    size_t n_out;
+    uint32_t* prev; // Previous instruction on the first and second operand of each optimised instruction
+    uint32_t* last; // Last instruction on each qubit
+    bool merge_rz;
+};
+typedef struct peephole_t peephole_t;
+
+// Inverses of the local Cliffords, LOCAL_CLIFFORD_LEFT(PEEPHOLE_LOCAL_INVERSE[c], c) is the identity
+static const instruction_t PEEPHOLE_LOCAL_INVERSE[N_LOCAL_CLIFFORDS] = {
+    _I_, _X_, _Y_, _Z_, _H_, _R_, _S_,
+    _HZ_, _SX_, _RX_, _HY_, _HX_, _HR_, _HS_, _RH_, _SH_, _RHY_, _SHY_, _HRX_, _HSX_, _HRH_, _HSH_, _RHS_, _SHR_
+};
+
+
+/*
+ * __inline_peephole_two_operands
+ * :: opcode : const instruction_t :: Opcode
+ * Returns true if the targ field of the instruction is a qubit
+ */
+static inline
+bool __inline_peephole_two_operands(const instruction_t opcode)
+{
+    const uint8_t type = INSTRUCTION_TYPE(opcode);
+    return (INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK) != type) && (INSTRUCTION_TYPE(RZ_MASK) != type);
+}
+
+/*
+ * __inline_peephole_link
+ * :: p : peephole_t* :: Chains
+ * :: idx : const uint32_t :: Optimised instruction
+ * :: qubit : const uint32_t :: Operand of the instruction
+ * Returns the link to the previous instruction on the qubit
+ */
+static inline
+uint32_t* __inline_peephole_link(peephole_t* p, const uint32_t idx, const uint32_t qubit)
+{
+    const size_t slot = (p->out[idx].multi.ctrl == qubit) ? 0 : 1;
+    return p->prev + 2 * idx + slot;
+}
+
+/*
+ * __inline_peephole_live
+ * Follows a link past removed instructions, the link is updated to skip them
+ * :: p : peephole_t* :: Chains
+ * :: link : uint32_t* :: Link on the chain of the qubit
+ * :: qubit : const uint32_t :: Qubit
+ * Returns the first instruction on the chain that has not been removed, or PEEPHOLE_NONE
+ */
+static inline
+uint32_t __inline_peephole_live(peephole_t* p, uint32_t* link, const uint32_t qubit)
+{
+    uint32_t idx = *link;
+    while ((PEEPHOLE_NONE != idx) && (PEEPHOLE_REMOVED == p->out[idx].instruction))
+    {
+        idx = *__inline_peephole_link(p, idx, qubit);
+    }
+    *link = idx;
+    return idx;
+}
+
+/*
+ * __inline_peephole_push
+ * Appends an instruction to the block and to the chains of its operands
+ * :: p : peephole_t* :: Chains
+ * :: inst : const instruction_stream_u* :: Instruction
+ */
+static inline
+void __inline_peephole_push(peephole_t* p, const instruction_stream_u* inst)
+{
+    const uint32_t idx = p->n_out++;
+    const uint32_t a = inst->multi.ctrl;
+    p->out[idx] = *inst;
+    p->prev[2 * idx] = p->last[a];
+    p->prev[2 * idx + 1] = PEEPHOLE_NONE;
+    p->last[a] = idx;
+
+    const uint32_t b = inst->multi.targ;
+    if (__inline_peephole_two_operands(inst->instruction) && (a != b))
+    {
+        p->prev[2 * idx + 1] = p->last[b];
+        p->last[b] = idx;
+    }
+}
+
+/*
+ * __inline_peephole_diagonal
+ * :: inst : const instruction_stream_u* :: Instruction acting on the qubit
+ * :: qubit : const uint32_t :: Qubit
+ * Returns true if the instruction commutes with Rz on the qubit
+ */
+static inline
+bool __inline_peephole_diagonal(const instruction_stream_u* inst, const uint32_t qubit)
+{
+    switch (inst->instruction)
+    {
+        case _Z_:
+        case _S_:
+        case _R_:
+        case _CZ_:
+            return true;
+        case _CNOT_:
+            return inst->multi.ctrl == qubit;
+        default:
+            return false;
+    }
+}
+
+
+/*
+ * peephole_local
+ * Matches a local Clifford
+ * :: p : peephole_t* :: Chains
+ * :: inst : const instruction_stream_u* :: Local Clifford
+ * Returns true if the instruction was absorbed
+ */
+static
+bool peephole_local(peephole_t* p, const instruction_stream_u* inst)
+{
+    const instruction_t opcode = inst->instruction;
+    const uint32_t qubit = inst->single.arg;
+    if (_I_ == opcode)
+    {
+        return true;
+    }
+
+    const uint32_t prior = __inline_peephole_live(p, p->last + qubit, qubit);
+    if (PEEPHOLE_NONE == prior)
+    {
+        return false;
+    }
+
+    // Inverse pair
+    if (PEEPHOLE_LOCAL_INVERSE[opcode & INSTRUCTION_OPERATOR_MASK] == p->out[prior].instruction)
+    {
+        p->out[prior].instruction = PEEPHOLE_REMOVED;
+        return true;
+    }
+
+    // H(b) CNOT(a, b) H(b) -> CZ(a, b)
+    if ((_H_ == opcode) && (_CNOT_ == p->out[prior].instruction) && (qubit == p->out[prior].multi.targ))
+    {
+        const uint32_t first = __inline_peephole_live(p, __inline_peephole_link(p, prior, qubit), qubit);
+        if ((PEEPHOLE_NONE != first) && (_H_ == p->out[first].instruction))
+        {
+            p->out[prior].instruction = _CZ_;
+            p->out[first].instruction = PEEPHOLE_REMOVED;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * peephole_two_qubit
+ * Matches a CNOT, CZ or SWAP
+ * :: p : peephole_t* :: Chains
+ * :: inst : const instruction_stream_u* :: Two qubit gate
+ * Returns true if the instruction was absorbed
+ */
+static
+bool peephole_two_qubit(peephole_t* p, const instruction_stream_u* inst)
+{
+    const uint32_t a = inst->multi.ctrl;
+    const uint32_t b = inst->multi.targ;
+    const uint32_t prior = __inline_peephole_live(p, p->last + a, a);
+    if ((PEEPHOLE_NONE == prior) || (prior != __inline_peephole_live(p, p->last + b, b)))
+    {
+        return false;
+    }
+
+    const instruction_stream_u* match = p->out + prior;
+    if (match->instruction != inst->instruction)
+    {
+        return false;
+    }
+    // CZ and SWAP are symmetric in their operands
+    if ((match->multi.ctrl != a) && (_CNOT_ == inst->instruction))
+    {
+        return false;
+    }
+
+    p->last[a] = *__inline_peephole_link(p, prior, a);
+    p->last[b] = *__inline_peephole_link(p, prior, b);
+    p->out[prior].instruction = PEEPHOLE_REMOVED;
+    return true;
+}
+
+/*
+ * peephole_rz
+ * Matches an Rz, merging it with an earlier Rz on the same qubit
+ * :: p : peephole_t* :: Chains
+ * :: inst : instruction_stream_u* :: Rz gate, rewritten to a local Clifford if its angle is a multiple of pi / 2
+ * Returns true if the instruction was absorbed
+ */
+static
+bool peephole_rz(peephole_t* p, instruction_stream_u* inst)
+{
+    const uint32_t qubit = inst->rz.arg;
+    const double angle = __inline_rz_tag_to_angle(inst->rz.tag);
+    instruction_t opcode = _I_;
+
+    uint32_t* link = p->last + qubit;
+    for (size_t i = 0; i < PEEPHOLE_WINDOW; i++)
+    {
+        const uint32_t prior = __inline_peephole_live(p, link, qubit);
+        if (PEEPHOLE_NONE == prior)
+        {
+            break;
+        }
+
+        instruction_stream_u* match = p->out + prior;
+        if (_RZ_ == match->instruction)
+        {
+            const double merged = __inline_rz_tag_to_angle(match->rz.tag) + angle;
+            if (__inline_rz_quarter_turn(merged, PEEPHOLE_CLIFFORD_EPS, &opcode))
+            {
+                // Identities are removed
+                match->instruction = opcode;
+                match->rz.tag = 0;
+            }
+            else
+            {
+                match->rz.tag = __inline_rz_angle_to_tag(merged);
+            }
+            return true;
+        }
+
+        if (!__inline_peephole_diagonal(match, qubit))
+        {
+            break;
+        }
+        link = __inline_peephole_link(p, prior, qubit);
+    }
+
+    if (__inline_rz_quarter_turn(angle, PEEPHOLE_CLIFFORD_EPS, &opcode))
+    {
+        inst->instruction = opcode;
+        inst->rz.tag = 0;
+        return peephole_local(p, inst);
+    }
+    return false;
+}
+
+
+/*
+ * peephole_optimise
+ * Optimises a block of instructions in place
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: merge_rz : const bool :: Merges Rz gates, tags must hold single precision angles
+ * The optimised instructions are compacted to the front of the array
+ * Returns the number of optimised instructions
+ */
+size_t peephole_optimise(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const bool merge_rz)
+{
+    if (0 == n_instructions)
+    {
+        return 0;
+    }
+
+    uint32_t max_qubit = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const instruction_stream_u* inst = instructions + i;
+        max_qubit = (inst->multi.ctrl > max_qubit) ? inst->multi.ctrl : max_qubit;
+        if (__inline_peephole_two_operands(inst->instruction) && (inst->multi.targ > max_qubit))
+        {
+            max_qubit = inst->multi.targ;
+        }
+    }
+
+    const size_t block = (n_instructions < PEEPHOLE_BLOCK) ? n_instructions : PEEPHOLE_BLOCK;
+    peephole_t p = {
+        .out = instructions,
+        .n_out = 0,
+        .prev = (uint32_t*)malloc(sizeof(uint32_t) * 2 * block),
+        .last = (uint32_t*)malloc(sizeof(uint32_t) * ((size_t)max_qubit + 1)),
+        .merge_rz = merge_rz
+    };
+    assert(NULL != p.prev);
+    assert(NULL != p.last);
+    // PEEPHOLE_NONE has every bit set
+    memset(p.last, 0xff, sizeof(uint32_t) * ((size_t)max_qubit + 1));
+
+    size_t n_out = 0;
+    for (size_t start = 0; start < n_instructions; start += block)
+    {
+        const size_t end = (start + block < n_instructions) ? start + block : n_instructions;
+        p.out = instructions + n_out;
+        p.n_out = 0;
+
+        for (size_t i = start; i < end; i++)
+        {
+            // The block is written behind the read position
+            instruction_stream_u inst = instructions[i];
+            bool absorbed = false;
+            switch (INSTRUCTION_TYPE(inst.instruction))
+            {
+                case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                    absorbed = peephole_local(&p, &inst);
+                    break;
+                case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                case INSTRUCTION_TYPE(QUBIT_PERMUTATION_MASK):
+                    absorbed = peephole_two_qubit(&p, &inst);
+                    break;
+                case INSTRUCTION_TYPE(RZ_MASK):
+                    absorbed = p.merge_rz && peephole_rz(&p, &inst);
+                    break;
+                default:
+                    break;
+            }
+            if (!absorbed)
+            {
+                __inline_peephole_push(&p, &inst);
+            }
+        }
+
+        // Clears the chains and drops removed instructions
+        size_t n_live = 0;
+        for (size_t i = 0; i < p.n_out; i++)
+        {
+            const instruction_stream_u* inst = p.out + i;
+            p.last[inst->multi.ctrl] = PEEPHOLE_NONE;
+            if (__inline_peephole_two_operands(inst->instruction))
+            {
+                p.last[inst->multi.targ] = PEEPHOLE_NONE;
+            }
+            if (PEEPHOLE_REMOVED != inst->instruction)
+            {
+                p.out[n_live++] = *inst;
+            }
+        }
+        n_out += n_live;
+    }
+
+    free(p.prev);
+    free(p.last);
+    return n_out;
+}
+
+
+/*
+ * parse_instruction_block_peephole
+ * Optimises a block of instructions in place and parses the optimised block
+ * :: wid : widget_t* :: Current widget
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: merge_rz : const bool :: Merges Rz gates, tags must hold single precision angles
+ * Returns the number of instructions parsed
+ */
+size_t parse_instruction_block_peephole(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const bool merge_rz)
+{
+    const size_t n_optimised = peephole_optimise(instructions, n_instructions, merge_rz);
+    parse_instruction_block(wid, instructions, n_optimised);
+    return n_optimised;
+}
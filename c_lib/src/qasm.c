@@ -0,0 +1,1162 @@
+#include "qasm.h"
+#include "input_stream.h"
+#include "rz_tag.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define QASM_PI (3.14159265358979323846)
+
+/*
+ * qasm_gate_kind_e
+ * Lowering applied to each gate
+ */
+enum qasm_gate_kind_e
+{
+    QASM_GATE_IDENTITY,
+    QASM_GATE_LOCAL, // Single local Clifford
+    QASM_GATE_TWO, // CNOT, CZ or SWAP
+    QASM_GATE_RZ, // Rz by the parameter
+    QASM_GATE_FIXED_RZ // Rz by a fixed angle
+};
+
+/*
+ * qasm_gate_t
+ * Entry of the gate table
+ */
+struct qasm_gate_t
+{
+    const char* name;
+    enum qasm_gate_kind_e kind;
+    instruction_t opcode;
+    instruction_t conditional_opcode; // Zero if the gate may not be classically conditioned
+    size_t n_params;
+    size_t n_operands;
+    double angle;
+};
+
+static const struct qasm_gate_t QASM_GATES[] = {
+    {"id", QASM_GATE_IDENTITY, _I_, _MEAS_, 0, 1, 0},
+    {"i", QASM_GATE_IDENTITY, _I_, _MEAS_, 0, 1, 0},
+    {"x", QASM_GATE_LOCAL, _X_, _MCX_, 0, 1, 0},
+    {"y", QASM_GATE_LOCAL, _Y_, _MCY_, 0, 1, 0},
+    {"z", QASM_GATE_LOCAL, _Z_, _MCZ_, 0, 1, 0},
+    {"h", QASM_GATE_LOCAL, _H_, 0, 0, 1, 0},
+    {"s", QASM_GATE_LOCAL, _S_, 0, 0, 1, 0},
+    {"sdg", QASM_GATE_LOCAL, _R_, 0, 0, 1, 0},
+    {"cx", QASM_GATE_TWO, _CNOT_, 0, 0, 2, 0},
+    {"CX", QASM_GATE_TWO, _CNOT_, 0, 0, 2, 0},
+    {"cnot", QASM_GATE_TWO, _CNOT_, 0, 0, 2, 0},
+    {"cz", QASM_GATE_TWO, _CZ_, 0, 0, 2, 0},
+    {"swap", QASM_GATE_TWO, _SWAP_, 0, 0, 2, 0},
+    {"rz", QASM_GATE_RZ, _RZ_, 0, 1, 1, 0},
+    {"p", QASM_GATE_RZ, _RZ_, 0, 1, 1, 0},
+    {"phase", QASM_GATE_RZ, _RZ_, 0, 1, 1, 0},
+    {"u1", QASM_GATE_RZ, _RZ_, 0, 1, 1, 0},
+    {"t", QASM_GATE_FIXED_RZ, _RZ_, 0, 0, 1, QASM_PI / 4},
+    {"tdg", QASM_GATE_FIXED_RZ, _RZ_, 0, 0, 1, -QASM_PI / 4},
+};
+#define QASM_N_GATES (sizeof(QASM_GATES) / sizeof(struct qasm_gate_t))
+
+
+/*
+ * qasm_fail
+ * Records the first error of a parser
+ * :: parser : qasm_parser_t* :: Parser
+ * :: fmt : const char* :: printf format of the description
+ * Returns false
+ */
+static
+bool qasm_fail(qasm_parser_t* parser, const char* fmt, ...)
+{
+    if (!parser->failed)
+    {
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(parser->error, QASM_ERROR_BYTES, fmt, args);
+        va_end(args);
+        parser->failed = true;
+    }
+    return false;
+}
+
+
+/*
+ * qasm_flush
+ * Passes the buffered instructions to the emitter
+ * :: parser : qasm_parser_t* :: Parser
+ */
+static
+bool qasm_flush(qasm_parser_t* parser)
+{
+    const size_t n_block = parser->n_block;
+    parser->n_block = 0;
+    if ((0 == n_block) || (NULL == parser->emit))
+    {
+        return true;
+    }
+    if (!parser->emit(parser->ctx, parser->block, n_block))
+    {
+        return qasm_fail(parser, "instructions could not be emitted");
+    }
+    return true;
+}
+
+
+/*
+ * qasm_emit
+ * Buffers an instruction
+ * :: parser : qasm_parser_t* :: Parser
+ * :: opcode : const instruction_t :: Opcode
+ * :: ctrl : const uint32_t :: First operand
+ * :: targ : const uint32_t :: Second operand, ignored by local Cliffords
+ */
+static inline
+bool qasm_emit(qasm_parser_t* parser, const instruction_t opcode, const uint32_t ctrl, const uint32_t targ)
+{
+    instruction_stream_u* inst = parser->block + parser->n_block;
+    inst->multi.opcode = opcode;
+    inst->multi.ctrl = ctrl;
+    inst->multi.targ = (INSTRUCTION_TYPE(opcode) == INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK)) ? 0 : targ;
+
+    parser->n_instructions++;
+    parser->n_rz += (INSTRUCTION_TYPE(opcode) == INSTRUCTION_TYPE(RZ_MASK));
+    parser->n_block++;
+    if (QASM_BLOCK_INSTRUCTIONS == parser->n_block)
+    {
+        return qasm_flush(parser);
+    }
+    return true;
+}
+
+
+/*
+ * qasm_emit_rz
+ * Buffers an Rz gate, lowering quarter turns to local Cliffords
+ * :: parser : qasm_parser_t* :: Parser
+ * :: qubit : const uint32_t :: Target qubit
+ * :: angle : const double :: Rotation in radians
+ */
+static
+bool qasm_emit_rz(qasm_parser_t* parser, const uint32_t qubit, const double angle)
+{
+    instruction_t opcode = _I_;
+    if (__inline_rz_quarter_turn(angle, QASM_CLIFFORD_EPS, &opcode))
+    {
+        return (_I_ == opcode) || qasm_emit(parser, opcode, qubit, 0);
+    }
+    return qasm_emit(parser, _RZ_, qubit, __inline_rz_angle_to_tag(angle));
+}
+
+
+static inline
+const char* qasm_skip_space(const char* p)
+{
+    while (isspace((unsigned char)*p))
+    {
+        p++;
+    }
+    return p;
+}
+
+
+/*
+ * qasm_identifier
+ * Reads an identifier
+ * :: p : const char** :: Cursor, advanced past the identifier
+ * :: name : char* :: Buffer of QASM_MAX_IDENTIFIER bytes
+ * Returns false if there is no identifier at the cursor
+ */
+static
+bool qasm_identifier(const char** p, char* name)
+{
+    const char* start = qasm_skip_space(*p);
+    const char* end = start;
+    if (!(isalpha((unsigned char)*end) || ('_' == *end)))
+    {
+        return false;
+    }
+    while (isalnum((unsigned char)*end) || ('_' == *end))
+    {
+        end++;
+    }
+    if (end - start >= QASM_MAX_IDENTIFIER)
+    {
+        return false;
+    }
+
+    memcpy(name, start, end - start);
+    name[end - start] = '\0';
+    *p = end;
+    return true;
+}
+
+
+/*
+ * qasm_integer
+ * Reads a non negative integer
+ * :: p : const char** :: Cursor, advanced past the integer
+ * :: value : size_t* :: Set to the integer
+ */
+static
+bool qasm_integer(const char** p, size_t* value)
+{
+    const char* cursor = qasm_skip_space(*p);
+    if (!isdigit((unsigned char)*cursor))
+    {
+        return false;
+    }
+    size_t acc = 0;
+    while (isdigit((unsigned char)*cursor))
+    {
+        acc = 10 * acc + (*cursor - '0');
+        cursor++;
+    }
+    *value = acc;
+    *p = cursor;
+    return true;
+}
+
+
+/*
+ * qasm_expect
+ * Reads a single character
+ * :: p : const char** :: Cursor, advanced past the character
+ * :: c : const char :: Expected character
+ */
+static inline
+bool qasm_expect(const char** p, const char c)
+{
+    const char* cursor = qasm_skip_space(*p);
+    if (c != *cursor)
+    {
+        return false;
+    }
+    *p = cursor + 1;
+    return true;
+}
+
+
+static inline
+bool qasm_at_end(const char* p)
+{
+    return '\0' == *qasm_skip_space(p);
+}
+
+
+static bool qasm_expression(qasm_parser_t* parser, const char** p, double* value);
+
+/*
+ * qasm_primary
+ * Reads a number, a constant or a parenthesised expression
+ * :: parser : qasm_parser_t* :: Parser, records non-finite values and division by zero
+ * :: p : const char** :: Cursor
+ * :: value : double* :: Set to the value
+ */
+static
+bool qasm_primary(qasm_parser_t* parser, const char** p, double* value)
+{
+    const char* cursor = qasm_skip_space(*p);
+    if ('(' == *cursor)
+    {
+        cursor++;
+        if (!qasm_expression(parser, &cursor, value) || !qasm_expect(&cursor, ')'))
+        {
+            return false;
+        }
+        *p = cursor;
+        return true;
+    }
+
+    if (isdigit((unsigned char)*cursor) || ('.' == *cursor))
+    {
+        char* end = NULL;
+        *value = strtod(cursor, &end);
+        if (end == cursor)
+        {
+            return false;
+        }
+        if (!__inline_rz_angle_finite(*value))
+        {
+            return qasm_fail(parser, "angle is not finite");
+        }
+        *p = end;
+        return true;
+    }
+
+    // UTF-8 pi and tau
+    if ((0xcf == (unsigned char)cursor[0]) && ((0x80 == (unsigned char)cursor[1]) || (0x84 == (unsigned char)cursor[1])))
+    {
+        *value = (0x80 == (unsigned char)cursor[1]) ? QASM_PI : 2 * QASM_PI;
+        *p = cursor + 2;
+        return true;
+    }
+
+    char name[QASM_MAX_IDENTIFIER];
+    if (!qasm_identifier(&cursor, name))
+    {
+        return false;
+    }
+    if (0 == strcmp(name, "pi"))
+    {
+        *value = QASM_PI;
+    }
+    else if (0 == strcmp(name, "tau"))
+    {
+        *value = 2 * QASM_PI;
+    }
+    else
+    {
+        return false;
+    }
+    *p = cursor;
+    return true;
+}
+
+
+/*
+ * qasm_unary
+ * Reads a signed primary
+ * :: parser : qasm_parser_t* :: Parser, records non-finite values and division by zero
+ * :: p : const char** :: Cursor
+ * :: value : double* :: Set to the value
+ */
+static
+bool qasm_unary(qasm_parser_t* parser, const char** p, double* value)
+{
+    const char* cursor = qasm_skip_space(*p);
+    if (('-' == *cursor) || ('+' == *cursor))
+    {
+        const double sign = ('-' == *cursor) ? -1.0 : 1.0;
+        cursor++;
+        if (!qasm_unary(parser, &cursor, value))
+        {
+            return false;
+        }
+        *value *= sign;
+        *p = cursor;
+        return true;
+    }
+    return qasm_primary(parser, p, value);
+}
+
+
+/*
+ * qasm_term
+ * Reads a product or quotient
+ * :: parser : qasm_parser_t* :: Parser, records non-finite values and division by zero
+ * :: p : const char** :: Cursor
+ * :: value : double* :: Set to the value
+ */
+static
+bool qasm_term(qasm_parser_t* parser, const char** p, double* value)
+{
+    if (!qasm_unary(parser, p, value))
+    {
+        return false;
+    }
+    for (;;)
+    {
+        const char* cursor = qasm_skip_space(*p);
+        if (('*' != *cursor) && ('/' != *cursor))
+        {
+            return true;
+        }
+        const char op = *cursor;
+        cursor++;
+        double rhs = 0;
+        if (!qasm_unary(parser, &cursor, &rhs))
+        {
+            return false;
+        }
+        if (('/' == op) && (0 == rhs))
+        {
+            return qasm_fail(parser, "division by zero in angle");
+        }
+        *value = ('*' == op) ? *value * rhs : *value / rhs;
+        if (!__inline_rz_angle_finite(*value))
+        {
+            return qasm_fail(parser, "angle is not finite");
+        }
+        *p = cursor;
+    }
+}
+
+
+/*
+ * qasm_expression
+ * Reads a sum or difference
+ * :: parser : qasm_parser_t* :: Parser, records non-finite values and division by zero
+ * :: p : const char** :: Cursor
+ * :: value : double* :: Set to the value
+ */
+static
+bool qasm_expression(qasm_parser_t* parser, const char** p, double* value)
+{
+    if (!qasm_term(parser, p, value))
+    {
+        return false;
+    }
+    for (;;)
+    {
+        const char* cursor = qasm_skip_space(*p);
+        if (('+' != *cursor) && ('-' != *cursor))
+        {
+            return true;
+        }
+        const char op = *cursor;
+        cursor++;
+        double rhs = 0;
+        if (!qasm_term(parser, &cursor, &rhs))
+        {
+            return false;
+        }
+        *value = ('+' == op) ? *value + rhs : *value - rhs;
+        if (!__inline_rz_angle_finite(*value))
+        {
+            return qasm_fail(parser, "angle is not finite");
+        }
+        *p = cursor;
+    }
+}
+
+
+/*
+ * qasm_find_register
+ * :: registers : qasm_register_t* :: Array of registers
+ * :: n_registers : const size_t :: Number of registers
+ * :: name : const char* :: Name of the register
+ * Returns NULL if the register has not been declared
+ */
+static
+qasm_register_t* qasm_find_register(qasm_register_t* registers, const size_t n_registers, const char* name)
+{
+    for (size_t i = 0; i < n_registers; i++)
+    {
+        if (0 == strcmp(registers[i].name, name))
+        {
+            return registers + i;
+        }
+    }
+    return NULL;
+}
+
+
+/*
+ * qasm_declare
+ * Declares a register
+ * :: parser : qasm_parser_t* :: Parser
+ * :: quantum : const bool :: Quantum or classical register
+ * :: name : const char* :: Name of the register
+ * :: width : const size_t :: Number of qubits or bits
+ */
+static
+bool qasm_declare(qasm_parser_t* parser, const bool quantum, const char* name, const size_t width)
+{
+    if ((NULL != qasm_find_register(parser->qregs, parser->n_qregs, name))
+        || (NULL != qasm_find_register(parser->cregs, parser->n_cregs, name)))
+    {
+        return qasm_fail(parser, "register %s is already declared", name);
+    }
+    if (0 == width)
+    {
+        return qasm_fail(parser, "register %s is empty", name);
+    }
+
+    qasm_register_t** registers = quantum ? &parser->qregs : &parser->cregs;
+    size_t* n_registers = quantum ? &parser->n_qregs : &parser->n_cregs;
+    size_t* n_total = quantum ? &parser->n_qubits : &parser->n_bits;
+    if (*n_total + width > QASM_UNMEASURED)
+    {
+        return qasm_fail(parser, "register %s is too wide", name);
+    }
+
+    *registers = (qasm_register_t*)realloc(*registers, sizeof(qasm_register_t) * (*n_registers + 1));
+    assert(NULL != *registers);
+    qasm_register_t* reg = *registers + *n_registers;
+    strcpy(reg->name, name);
+    reg->offset = *n_total;
+    reg->width = width;
+    (*n_registers)++;
+    *n_total += width;
+
+    if (!quantum)
+    {
+        parser->bit_qubits = (uint32_t*)realloc(parser->bit_qubits, sizeof(uint32_t) * parser->n_bits);
+        assert(NULL != parser->bit_qubits);
+        for (size_t i = reg->offset; i < parser->n_bits; i++)
+        {
+            parser->bit_qubits[i] = QASM_UNMEASURED;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * qasm_operand
+ * Reads a register or an indexed element of a register
+ * :: parser : qasm_parser_t* :: Parser
+ * :: p : const char** :: Cursor
+ * :: quantum : const bool :: Quantum or classical operand
+ * :: offset : size_t* :: Set to the first qubit or bit of the operand
+ * :: width : size_t* :: Set to the number of qubits or bits of the operand
+ */
+static
+bool qasm_operand(qasm_parser_t* parser, const char** p, const bool quantum, size_t* offset, size_t* width)
+{
+    char name[QASM_MAX_IDENTIFIER];
+    if (!qasm_identifier(p, name))
+    {
+        return qasm_fail(parser, "expected a %s operand", quantum ? "qubit" : "bit");
+    }
+
+    const qasm_register_t* reg = quantum
+        ? qasm_find_register(parser->qregs, parser->n_qregs, name)
+        : qasm_find_register(parser->cregs, parser->n_cregs, name);
+    if (NULL == reg)
+    {
+        return qasm_fail(parser, "%s is not a declared %s register", name, quantum ? "quantum" : "classical");
+    }
+
+    *offset = reg->offset;
+    *width = reg->width;
+    if (!qasm_expect(p, '['))
+    {
+        return true;
+    }
+
+    size_t idx = 0;
+    if (!qasm_integer(p, &idx) || !qasm_expect(p, ']'))
+    {
+        return qasm_fail(parser, "expected an index of %s", name);
+    }
+    if (idx >= reg->width)
+    {
+        return qasm_fail(parser, "index %zu is out of range of %s", idx, name);
+    }
+    *offset += idx;
+    *width = 1;
+    return true;
+}
+
+
+/*
+ * qasm_declaration
+ * Parses a register declaration
+ * :: parser : qasm_parser_t* :: Parser
+ * :: p : const char* :: Text following the keyword
+ * :: quantum : const bool :: Quantum or classical register
+ * :: sized_type : const bool :: OpenQASM 3 form, qubit[n] name, otherwise OpenQASM 2 form, qreg name[n]
+ */
+static
+bool qasm_declaration(qasm_parser_t* parser, const char* p, const bool quantum, const bool sized_type)
+{
+    char name[QASM_MAX_IDENTIFIER];
+    size_t width = 1;
+    if (sized_type)
+    {
+        if (qasm_expect(&p, '[') && !(qasm_integer(&p, &width) && qasm_expect(&p, ']')))
+        {
+            return qasm_fail(parser, "expected a register size");
+        }
+        if (!qasm_identifier(&p, name))
+        {
+            return qasm_fail(parser, "expected a register name");
+        }
+    }
+    else if (!qasm_identifier(&p, name) || !qasm_expect(&p, '[')
+        || !qasm_integer(&p, &width) || !qasm_expect(&p, ']'))
+    {
+        return qasm_fail(parser, "expected a register name and size");
+    }
+
+    if (!qasm_at_end(p))
+    {
+        return qasm_fail(parser, "unexpected text after declaration of %s", name);
+    }
+    return qasm_declare(parser, quantum, name, width);
+}
+
+
+/*
+ * qasm_measure
+ * Emits measurements and records the qubit measured into each bit
+ * :: parser : qasm_parser_t* :: Parser
+ * :: qubit_offset : const size_t :: First measured qubit
+ * :: qubit_width : const size_t :: Number of measured qubits
+ * :: bit_offset : const size_t :: First bit
+ * :: bit_width : const size_t :: Number of bits
+ */
+static
+bool qasm_measure(
+    qasm_parser_t* parser,
+    const size_t qubit_offset,
+    const size_t qubit_width,
+    const size_t bit_offset,
+    const size_t bit_width)
+{
+    if (qubit_width != bit_width)
+    {
+        return qasm_fail(parser, "measured qubits and bits differ in size");
+    }
+    for (size_t i = 0; i < qubit_width; i++)
+    {
+        const uint32_t qubit = qubit_offset + i;
+        parser->bit_qubits[bit_offset + i] = qubit;
+        if (!qasm_emit(parser, _MEAS_, qubit, qubit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * qasm_gate
+ * Parses and emits a gate
+ * :: parser : qasm_parser_t* :: Parser
+ * :: name : const char* :: Name of the gate
+ * :: p : const char* :: Text following the name
+ * :: condition : const uint32_t :: Measured qubit conditioning the gate, or QASM_UNMEASURED
+ * Operands that are whole registers are broadcast
+ */
+static
+bool qasm_gate(qasm_parser_t* parser, const char* name, const char* p, const uint32_t condition)
+{
+    const struct qasm_gate_t* gate = NULL;
+    for (size_t i = 0; i < QASM_N_GATES; i++)
+    {
+        if (0 == strcmp(QASM_GATES[i].name, name))
+        {
+            gate = QASM_GATES + i;
+            break;
+        }
+    }
+    if (NULL == gate)
+    {
+        return qasm_fail(parser, "unsupported gate %s", name);
+    }
+    if ((QASM_UNMEASURED != condition) && (0 == gate->conditional_opcode))
+    {
+        return qasm_fail(parser, "only Pauli gates may be classically conditioned, not %s", name);
+    }
+
+    double angle = gate->angle;
+    if (gate->n_params > 0)
+    {
+        if (!qasm_expect(&p, '(') || !qasm_expression(parser, &p, &angle) || !qasm_expect(&p, ')'))
+        {
+            return qasm_fail(parser, "expected an angle for %s", name);
+        }
+    }
+
+    size_t offsets[2] = {0, 0};
+    size_t widths[2] = {1, 1};
+    size_t n_broadcast = 1;
+    for (size_t i = 0; i < gate->n_operands; i++)
+    {
+        if ((i > 0) && !qasm_expect(&p, ','))
+        {
+            return qasm_fail(parser, "%s expects %zu operands", name, gate->n_operands);
+        }
+        if (!qasm_operand(parser, &p, true, offsets + i, widths + i))
+        {
+            return false;
+        }
+        if ((widths[i] > 1) && (n_broadcast > 1) && (widths[i] != n_broadcast))
+        {
+            return qasm_fail(parser, "registers of %s differ in size", name);
+        }
+        n_broadcast = (widths[i] > n_broadcast) ? widths[i] : n_broadcast;
+    }
+    if (!qasm_at_end(p))
+    {
+        return qasm_fail(parser, "unexpected text after %s", name);
+    }
+
+    for (size_t i = 0; i < n_broadcast; i++)
+    {
+        const uint32_t a = offsets[0] + ((widths[0] > 1) ? i : 0);
+        const uint32_t b = offsets[1] + ((widths[1] > 1) ? i : 0);
+        if ((gate->n_operands > 1) && (a == b))
+        {
+            return qasm_fail(parser, "%s acts on the same qubit twice", name);
+        }
+
+        bool emitted = true;
+        if (QASM_UNMEASURED != condition)
+        {
+            emitted = (QASM_GATE_IDENTITY == gate->kind) || qasm_emit(parser, gate->conditional_opcode, condition, a);
+        }
+        else
+        {
+            switch (gate->kind)
+            {
+                case QASM_GATE_IDENTITY:
+                    break;
+                case QASM_GATE_LOCAL:
+                    emitted = qasm_emit(parser, gate->opcode, a, 0);
+                    break;
+                case QASM_GATE_TWO:
+                    emitted = qasm_emit(parser, gate->opcode, a, b);
+                    break;
+                case QASM_GATE_RZ:
+                case QASM_GATE_FIXED_RZ:
+                    emitted = qasm_emit_rz(parser, a, angle);
+                    break;
+            }
+        }
+        if (!emitted)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*
+ * qasm_condition
+ * Parses the condition of an if statement
+ * :: parser : qasm_parser_t* :: Parser
+ * :: p : const char** :: Cursor, following the if keyword
+ * :: qubit : uint32_t* :: Set to the qubit measured into the tested bit
+ */
+static
+bool qasm_condition(qasm_parser_t* parser, const char** p, uint32_t* qubit)
+{
+    size_t bit = 0;
+    size_t width = 0;
+    if (!qasm_expect(p, '('))
+    {
+        return qasm_fail(parser, "expected a condition");
+    }
+    if (!qasm_operand(parser, p, false, &bit, &width))
+    {
+        return false;
+    }
+    if (1 != width)
+    {
+        return qasm_fail(parser, "conditions must test a single bit");
+    }
+
+    if (qasm_expect(p, '='))
+    {
+        char value[QASM_MAX_IDENTIFIER];
+        size_t integer = 0;
+        const bool is_one = qasm_expect(p, '=')
+            && (qasm_integer(p, &integer) ? (1 == integer) : (qasm_identifier(p, value) && (0 == strcmp(value, "true"))));
+        if (!is_one)
+        {
+            return qasm_fail(parser, "conditions must compare a bit to 1");
+        }
+    }
+    if (!qasm_expect(p, ')'))
+    {
+        return qasm_fail(parser, "expected ) after condition");
+    }
+
+    *qubit = parser->bit_qubits[bit];
+    if (QASM_UNMEASURED == *qubit)
+    {
+        return qasm_fail(parser, "condition tests a bit that has not been measured");
+    }
+    return true;
+}
+
+
+/*
+ * qasm_statement
+ * Parses a statement
+ * :: parser : qasm_parser_t* :: Parser
+ * :: text : const char* :: Text of the statement
+ * :: terminator : const char :: Character that ended the statement, one of ; { }
+ */
+static
+bool qasm_statement(qasm_parser_t* parser, const char* text, const char terminator)
+{
+    const char* p = qasm_skip_space(text);
+    if ('\0' == *p)
+    {
+        if ('}' == terminator)
+        {
+            if (0 == parser->depth)
+            {
+                return qasm_fail(parser, "unexpected }");
+            }
+            parser->depth--;
+            return true;
+        }
+        if ('{' == terminator)
+        {
+            return qasm_fail(parser, "blocks must follow an if statement");
+        }
+        return true;
+    }
+    if ('}' == terminator)
+    {
+        return qasm_fail(parser, "expected ; before }");
+    }
+
+    const uint32_t condition = (parser->depth > 0) ? parser->conditions[parser->depth - 1] : QASM_UNMEASURED;
+    const char* start = p;
+    char keyword[QASM_MAX_IDENTIFIER];
+    if (!qasm_identifier(&p, keyword))
+    {
+        return qasm_fail(parser, "expected a statement");
+    }
+
+    if (0 == strcmp(keyword, "if"))
+    {
+        uint32_t qubit = 0;
+        if (QASM_UNMEASURED != condition)
+        {
+            return qasm_fail(parser, "nested conditions are not supported");
+        }
+        if (!qasm_condition(parser, &p, &qubit))
+        {
+            return false;
+        }
+        if ('{' == terminator)
+        {
+            if (!qasm_at_end(p))
+            {
+                return qasm_fail(parser, "unexpected text before {");
+            }
+            if (QASM_MAX_DEPTH == parser->depth)
+            {
+                return qasm_fail(parser, "blocks are nested too deeply");
+            }
+            parser->conditions[parser->depth++] = qubit;
+            return true;
+        }
+        char name[QASM_MAX_IDENTIFIER];
+        if (!qasm_identifier(&p, name))
+        {
+            return qasm_fail(parser, "expected a gate after condition");
+        }
+        return qasm_gate(parser, name, p, qubit);
+    }
+
+    if ('{' == terminator)
+    {
+        return qasm_fail(parser, "%s blocks are not supported", keyword);
+    }
+
+    // Only gates may appear in a conditioned block
+    if (QASM_UNMEASURED != condition)
+    {
+        return qasm_gate(parser, keyword, p, condition);
+    }
+
+    if (0 == strcmp(keyword, "OPENQASM"))
+    {
+        size_t major = 0;
+        size_t minor = 0;
+        if (!qasm_integer(&p, &major) || (qasm_expect(&p, '.') && !qasm_integer(&p, &minor)) || !qasm_at_end(p))
+        {
+            return qasm_fail(parser, "expected a version number");
+        }
+        if ((2 != major) && (3 != major))
+        {
+            return qasm_fail(parser, "unsupported OpenQASM version %zu", major);
+        }
+        parser->version = major;
+        return true;
+    }
+    if ((0 == strcmp(keyword, "include")) || (0 == strcmp(keyword, "barrier")))
+    {
+        return true;
+    }
+    if ((0 == strcmp(keyword, "qreg")) || (0 == strcmp(keyword, "creg")))
+    {
+        return qasm_declaration(parser, p, 'q' == keyword[0], false);
+    }
+    if ((0 == strcmp(keyword, "qubit")) || (0 == strcmp(keyword, "bit")))
+    {
+        return qasm_declaration(parser, p, 'q' == keyword[0], true);
+    }
+
+    size_t qubit_offset = 0;
+    size_t qubit_width = 0;
+    size_t bit_offset = 0;
+    size_t bit_width = 0;
+    if (0 == strcmp(keyword, "measure"))
+    {
+        if (!qasm_operand(parser, &p, true, &qubit_offset, &qubit_width))
+        {
+            return false;
+        }
+        if (!qasm_expect(&p, '-') || ('>' != *p))
+        {
+            return qasm_fail(parser, "expected -> after measured qubits");
+        }
+        p++;
+        if (!qasm_operand(parser, &p, false, &bit_offset, &bit_width))
+        {
+            return false;
+        }
+        if (!qasm_at_end(p))
+        {
+            return qasm_fail(parser, "unexpected text after measurement");
+        }
+        return qasm_measure(parser, qubit_offset, qubit_width, bit_offset, bit_width);
+    }
+
+    // OpenQASM 3 measurement, bits = measure qubits
+    if (NULL != qasm_find_register(parser->cregs, parser->n_cregs, keyword))
+    {
+        char name[QASM_MAX_IDENTIFIER];
+        p = start;
+        if (!qasm_operand(parser, &p, false, &bit_offset, &bit_width))
+        {
+            return false;
+        }
+        if (!qasm_expect(&p, '=') || !qasm_identifier(&p, name) || (0 != strcmp(name, "measure")))
+        {
+            return qasm_fail(parser, "expected a measurement");
+        }
+        if (!qasm_operand(parser, &p, true, &qubit_offset, &qubit_width))
+        {
+            return false;
+        }
+        if (!qasm_at_end(p))
+        {
+            return qasm_fail(parser, "unexpected text after measurement");
+        }
+        return qasm_measure(parser, qubit_offset, qubit_width, bit_offset, bit_width);
+    }
+
+    return qasm_gate(parser, keyword, p, QASM_UNMEASURED);
+}
+
+
+/*
+ * qasm_parser_create
+ * Creates a parser
+ * :: emit : qasm_emit_t :: Consumer of parsed instructions, NULL only counts the instructions
+ * :: ctx : void* :: Passed to emit
+ */
+qasm_parser_t* qasm_parser_create(qasm_emit_t emit, void* ctx)
+{
+    qasm_parser_t* parser = (qasm_parser_t*)calloc(1, sizeof(qasm_parser_t));
+    assert(NULL != parser);
+    parser->emit = emit;
+    parser->ctx = ctx;
+    parser->line = 1;
+
+    parser->statement_capacity = 256;
+    parser->statement = (char*)malloc(parser->statement_capacity);
+    assert(NULL != parser->statement);
+    return parser;
+}
+
+
+/*
+ * qasm_parser_destroy
+ * Frees a parser
+ * :: parser : qasm_parser_t* :: Parser
+ */
+void qasm_parser_destroy(qasm_parser_t* parser)
+{
+    free(parser->statement);
+    free(parser->qregs);
+    free(parser->cregs);
+    free(parser->bit_qubits);
+    free(parser);
+}
+
+
+/*
+ * qasm_parser_feed
+ * Parses a piece of source text
+ * :: parser : qasm_parser_t* :: Parser
+ * :: text : const char* :: Source text, statements may be split across calls
+ * :: n_bytes : const size_t :: Length of the text
+ * Comments are stripped as the text is read, each statement is parsed when its terminator is reached
+ */
+bool qasm_parser_feed(qasm_parser_t* parser, const char* text, const size_t n_bytes)
+{
+    for (size_t i = 0; (i < n_bytes) && !parser->failed; i++)
+    {
+        const char c = text[i];
+        const char prev = parser->prev;
+        parser->prev = c;
+        if ('\n' == c)
+        {
+            parser->line++;
+        }
+
+        if (parser->line_comment)
+        {
+            parser->line_comment = ('\n' != c);
+            continue;
+        }
+        if (parser->block_comment)
+        {
+            if (('*' == prev) && ('/' == c))
+            {
+                parser->block_comment = false;
+                parser->prev = '\0';
+            }
+            continue;
+        }
+        if (('/' == prev) && (('/' == c) || ('*' == c)))
+        {
+            // Drop the opening slash from the statement
+            parser->statement_bytes--;
+            parser->line_comment = ('/' == c);
+            parser->block_comment = ('*' == c);
+            parser->prev = '\0';
+            continue;
+        }
+
+        if ((';' == c) || ('{' == c) || ('}' == c))
+        {
+            parser->statement[parser->statement_bytes] = '\0';
+            parser->statement_bytes = 0;
+            qasm_statement(parser, parser->statement, c);
+            continue;
+        }
+
+        // One byte is reserved for the terminator
+        if (parser->statement_bytes + 1 == parser->statement_capacity)
+        {
+            parser->statement_capacity *= 2;
+            parser->statement = (char*)realloc(parser->statement, parser->statement_capacity);
+            assert(NULL != parser->statement);
+        }
+        parser->statement[parser->statement_bytes++] = c;
+    }
+    return !parser->failed;
+}
+
+
+/*
+ * qasm_parser_finish
+ * Ends the source text and emits any buffered instructions
+ * :: parser : qasm_parser_t* :: Parser
+ */
+bool qasm_parser_finish(qasm_parser_t* parser)
+{
+    if (parser->failed)
+    {
+        return false;
+    }
+
+    parser->statement[parser->statement_bytes] = '\0';
+    if (!qasm_at_end(parser->statement))
+    {
+        return qasm_fail(parser, "expected ; at end of input");
+    }
+    if (parser->block_comment)
+    {
+        return qasm_fail(parser, "unterminated comment");
+    }
+    if (parser->depth > 0)
+    {
+        return qasm_fail(parser, "expected } at end of input");
+    }
+    return qasm_flush(parser);
+}
+
+
+/*
+ * qasm_parser_read_file
+ * Parses a source file and finishes the parser
+ * :: parser : qasm_parser_t* :: Parser
+ * :: path : const char* :: Path of the source file
+ */
+bool qasm_parser_read_file(qasm_parser_t* parser, const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (NULL == fp)
+    {
+        return qasm_fail(parser, "could not open %s", path);
+    }
+
+    char* buf = (char*)malloc(QASM_READ_BYTES);
+    assert(NULL != buf);
+    size_t n_read = 0;
+    bool parsed = true;
+    while (parsed && ((n_read = fread(buf, 1, QASM_READ_BYTES, fp)) > 0))
+    {
+        parsed = qasm_parser_feed(parser, buf, n_read);
+    }
+    if (parsed && ferror(fp))
+    {
+        parsed = qasm_fail(parser, "could not read %s", path);
+    }
+    free(buf);
+    fclose(fp);
+
+    return parsed && qasm_parser_finish(parser);
+}
+
+
+size_t qasm_parser_get_n_qubits(const qasm_parser_t* parser)
+{
+    return parser->n_qubits;
+}
+
+
+size_t qasm_parser_get_n_bits(const qasm_parser_t* parser)
+{
+    return parser->n_bits;
+}
+
+
+size_t qasm_parser_get_n_instructions(const qasm_parser_t* parser)
+{
+    return parser->n_instructions;
+}
+
+
+size_t qasm_parser_get_n_rz(const qasm_parser_t* parser)
+{
+    return parser->n_rz;
+}
+
+
+size_t qasm_parser_get_line(const qasm_parser_t* parser)
+{
+    return parser->line;
+}
+
+
+const char* qasm_parser_get_error(const qasm_parser_t* parser)
+{
+    return parser->failed ? parser->error : NULL;
+}
+
+
+/*
+ * qasm_emit_widget
+ * Emitter that parses each block into a widget
+ * :: ctx : void* :: widget_t*
+ * :: instructions : instruction_stream_u* :: Block of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the block
+ */
+bool qasm_emit_widget(void* ctx, instruction_stream_u* instructions, const size_t n_instructions)
+{
+    parse_instruction_block((widget_t*)ctx, instructions, n_instructions);
+    return true;
+}
+
+
+/*
+ * qasm_emit_instruction_file
+ * Emitter that appends each block to a binary instruction stream
+ * :: ctx : void* :: instruction_file_writer_t*
+ * :: instructions : instruction_stream_u* :: Block of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the block
+ */
+bool qasm_emit_instruction_file(void* ctx, instruction_stream_u* instructions, const size_t n_instructions)
+{
+    return instruction_file_writer_append((instruction_file_writer_t*)ctx, instructions, n_instructions);
+}
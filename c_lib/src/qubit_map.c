@@ -1,5 +1,7 @@
 #include "qubit_map.h"
 
+#include <string.h>
+
 /*
  * qubit_map_create 
  * Constructor for a qubit map object
@@ -27,3 +29,56 @@ void qubit_map_destroy(qubit_map_t* q_map)
 {
     free(q_map);    
 }
+
+
+/*
+ * qubit_permutation_swaps
+ * Lowers a permutation of qubits to swap instructions
+ * :: perm : const uint32_t* :: The state of qubit i is moved to qubit perm[i]
+ * :: n_qubits : const size_t :: Length of the permutation
+ * :: swaps : instruction_stream_u* :: Written with at most n_qubits - 1 swap instructions
+ * Each cycle of length k is lowered to k - 1 swaps, swaps only relabel the qubit map
+ * Returns the number of swaps written, or SIZE_MAX if perm is not a permutation
+ */
+size_t qubit_permutation_swaps(
+    const uint32_t* perm,
+    const size_t n_qubits,
+    instruction_stream_u* swaps)
+{
+    // Destination of the state currently held by each qubit
+    uint32_t* dest = (uint32_t*)malloc(sizeof(uint32_t) * (n_qubits + 1));
+    bool* seen = (bool*)calloc(n_qubits + 1, sizeof(bool));
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        if ((perm[i] >= n_qubits) || seen[perm[i]])
+        {
+            free(dest);
+            free(seen);
+            return SIZE_MAX;
+        }
+        seen[perm[i]] = true;
+        dest[i] = perm[i];
+    }
+
+    size_t n_swaps = 0;
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        // Each swap places the state held by i, i then holds the state from its destination
+        while (dest[i] != i)
+        {
+            const uint32_t j = dest[i];
+            memset(swaps + n_swaps, 0, sizeof(instruction_stream_u));
+            swaps[n_swaps].multi.opcode = _SWAP_;
+            swaps[n_swaps].multi.ctrl = i;
+            swaps[n_swaps].multi.targ = j;
+            n_swaps++;
+
+            dest[i] = dest[j];
+            dest[j] = j;
+        }
+    }
+
+    free(dest);
+    free(seen);
+    return n_swaps;
+}
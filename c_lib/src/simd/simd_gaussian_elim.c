@@ -39,6 +39,7 @@ void debug_print_chunk(uint64_t chunk)
 
 void zero_z_diagonal(widget_t* wid);
 void zero_phases(widget_t* wid);
+void m4ri_tableau_elim(widget_t* wid);
 
 /*
  * simd_widget_decompose
@@ -72,6 +73,31 @@ void simd_widget_decompose(widget_t* wid)
     return;
 }
 
+/*
+ * m4ri_widget_decompose
+ * Decomposes the stabiliser tableau into a graph state plus local Cliffords
+ * :: wid : widget_t* :: Widget to decompose
+ * Acts in place on the tableau
+ * Eliminates with tables of pivot row products in the manner of the method of four Russians 
+ */
+void m4ri_widget_decompose(widget_t* wid)
+{
+    tableau_remove_zero_X_columns(
+        wid->tableau,
+        wid->queue
+    );
+
+    tableau_transpose(wid->tableau);
+
+    m4ri_tableau_elim(wid);
+
+    zero_z_diagonal(wid);
+
+    zero_phases(wid);
+
+    return;
+}
+
 
 /*
  * naive_tableau_elim_upper
@@ -232,11 +258,10 @@ void decomp_local_elim_upper(
                 i, ctrl);
 
             ctrl_block[i] ^= ctrl_block[ctrl];
-            tableau_rowsum_offset(
+            tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + offset,
-                    offset);
+                    i + offset);
         }
     }
 
@@ -249,11 +274,10 @@ void decomp_local_elim_upper(
         {
             ctrl_block[i] ^= ctrl_block[ctrl];
 
-            tableau_rowsum_offset(
+            tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + offset,
-                    offset); 
+                    i + offset); 
         }
     }
 }
@@ -312,11 +336,10 @@ void decomp_local_elim_lower(
                 i, ctrl);
 
             ctrl_block[i] ^= ctrl_block[ctrl];
-            tableau_rowsum_offset(
+            tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + offset,
-                    offset);
+                    i + offset);
 
             ctrl = 63 - __builtin_clzll(mask & ctrl_block[i]);
 
@@ -420,11 +443,10 @@ size_t decomp_non_local_search_and_elim(
             {
 
                 // Rowsum to unset bit
-                tableau_rowsum_offset(
+                tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + j,
-                    offset); 
+                    i + j); 
                 
                 // Reload block
                 targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
@@ -483,46 +505,231 @@ size_t decomp_z_search(
 
 
 /*
- * Zeros block if previous elements are set 
- * This search is non-local, it begins on the tile subsequent to the diagonal 
- * TODO: comment header
+ * decomp_col_elim_tile
+ * Zeros the pivot columns of a tile of rows
+ * :: wid : widget_t* :: Widget object
+ * :: slices : void* :: Pointer to the first X slice
+ * :: slice_len_bytes : const size_t :: Length of each slice
+ * :: offset : const size_t :: Index of the pivot tile, the pivot tile must be diagonal
+ * :: tile : const size_t :: Index of the first row of the tile
+ * Only the rows of the tile are written, the pivot rows are read
  */
 static inline
-void decomp_col_elim_upper(
+void decomp_col_elim_tile(
     widget_t* wid,
     void* slices,
     const size_t slice_len_bytes,
-    const size_t offset
+    const size_t offset,
+    const size_t tile
     )
 {
-    for (size_t i = offset + 64; i < wid->tableau->n_qubits; i += 64) 
+    uint64_t targ_block[64];
+    uint64_t ctrl;
+
+    decomp_load_block(targ_block, slices, slice_len_bytes, offset, tile);
+
+    #pragma GCC unroll 8 
+    for (size_t j = 0; j < 64; j++)
     {
-        uint64_t targ_block[64];
-        uint64_t ctrl;
-    
-        decomp_load_block(targ_block, slices, slice_len_bytes, offset, i);
+        // While not all bits unset
+        // TODO: merge this line with the ctzll call, odd infinite loop earlier
+        while (targ_block[j])
+        {
+            ctrl = __builtin_ctzll(targ_block[j]);
 
-        #pragma GCC unroll 8 
-        for (size_t j = 0; j < 64; j++)
+            // Rowsum to unset bit
+            tableau_rowsum(
+                wid->tableau,
+                ctrl + offset,
+                tile + j); 
+            
+            targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, tile + j); 
+        }
+    }
+}
+
+/*
+ * decomp_m4ri_table_t
+ * Table of every product of the pivot rows of one strip of a pivot tile
+ * Row v of the table is the product of the pivot rows selected by the bits of v
+ */
+struct decomp_m4ri_table_t
+{
+    size_t n_bytes; // Length of each row
+    uint8_t* slices_x;
+    uint8_t* slices_z;
+    uint8_t* phases;
+};
+
+static inline
+uint8_t __inline_decomp_m4ri_phase(const uint8_t ctrl_phase, const uint8_t targ_phase, const int8_t phase)
+{
+    // https://arxiv.org/pdf/quant-ph/0406196 Page 4
+    return ((((ctrl_phase << 1) + (targ_phase << 1) + phase) % 4) >> 1) & 1;
+}
+
+/*
+ * decomp_m4ri_build
+ * Builds the table for one strip of a pivot tile
+ * :: tab : tableau_t* :: Tableau object
+ * :: table : struct decomp_m4ri_table_t* :: Table to fill
+ * :: offset : const size_t :: Index of the pivot tile
+ * :: strip : const size_t :: Index of the strip within the pivot tile
+ * Rows are visited in Gray code order so each row costs a single rowsum
+ * As the stabilisers commute the order of the products does not affect the phase
+ */
+static inline
+void decomp_m4ri_build(
+    tableau_t* tab,
+    struct decomp_m4ri_table_t* table,
+    const size_t offset,
+    const size_t strip)
+{
+    const size_t n_bytes = table->n_bytes;
+
+    memset(table->slices_x, 0, n_bytes);
+    memset(table->slices_z, 0, n_bytes);
+    table->phases[0] = 0;
+
+    for (size_t i = 1; i < M4RI_TABLE_ROWS; i++)
+    {
+        const size_t code = i ^ (i >> 1);
+        const size_t prev = (i - 1) ^ ((i - 1) >> 1);
+        const size_t pivot = offset + strip * M4RI_STRIP_BITS + __builtin_ctzll(code ^ prev);
+
+        uint8_t* row_x = table->slices_x + code * n_bytes;
+        uint8_t* row_z = table->slices_z + code * n_bytes;
+        memcpy(row_x, table->slices_x + prev * n_bytes, n_bytes);
+        memcpy(row_z, table->slices_z + prev * n_bytes, n_bytes);
+
+        const int8_t phase = simd_rowsum_cnf(
+            n_bytes,
+            tab->slices_x[pivot],
+            tab->slices_z[pivot],
+            row_x,
+            row_z);
+
+        table->phases[code] = __inline_decomp_m4ri_phase(
+            __inline_slice_get_bit(tab->phases, pivot),
+            table->phases[prev],
+            phase);
+    }
+}
+
+/*
+ * decomp_m4ri_profitable
+ * Finds the strips of a pivot tile for which building a table saves rowsums
+ * :: wid : widget_t* :: Widget object
+ * :: slices : void* :: Pointer to the first X slice
+ * :: slice_len_bytes : const size_t :: Length of each slice
+ * :: offset : const size_t :: Index of the pivot tile
+ * Returns a mask with one bit per strip
+ * Building a table costs one rowsum per table row, applying it saves all but one rowsum per row
+ */
+static inline
+uint64_t decomp_m4ri_profitable(
+    widget_t* wid,
+    void* slices,
+    const size_t slice_len_bytes,
+    const size_t offset)
+{
+    size_t saved[64 / M4RI_STRIP_BITS] = {0};
+    for (size_t i = 0; i < wid->tableau->n_qubits; i += 64)
+    {
+        if (i == offset)
         {
-            // While not all bits unset
+            continue;
+        }
 
-            while (targ_block[j])
+        for (size_t j = 0; j < 64; j++)
+        {
+            const uint64_t chunk = GET_CHUNK(slices, slice_len_bytes, offset, i + j);
+            if (0 == chunk)
             {
-                ctrl = __builtin_ctzll(targ_block[j]);
+                continue;
+            }
 
-                // Rowsum to unset bit
-                tableau_rowsum_offset(
-                    wid->tableau,
-                    ctrl + offset,
-                    i + j,
-                    offset); 
-                
-                targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
+            for (size_t strip = 0; strip < 64 / M4RI_STRIP_BITS; strip++)
+            {
+                const uint64_t idx = (chunk >> (strip * M4RI_STRIP_BITS)) & (M4RI_TABLE_ROWS - 1);
+                saved[strip] += __builtin_popcountll(idx) - (0 != idx);
             }
         }
     }
 
+    uint64_t strips = 0;
+    for (size_t strip = 0; strip < 64 / M4RI_STRIP_BITS; strip++)
+    {
+        strips |= (uint64_t)(saved[strip] >= M4RI_TABLE_ROWS) << strip;
+    }
+    return strips;
+}
+
+/*
+ * decomp_m4ri_apply_tile
+ * Zeros the columns of one strip of the pivot tile from a tile of rows
+ * :: wid : widget_t* :: Widget object
+ * :: slices : void* :: Pointer to the first X slice
+ * :: slice_len_bytes : const size_t :: Length of each slice
+ * :: table : struct decomp_m4ri_table_t* :: Table for the strip
+ * :: offset : const size_t :: Index of the pivot tile
+ * :: strip : const size_t :: Index of the strip within the pivot tile
+ * :: tile : const size_t :: Index of the first row of the tile
+ * Each row takes a single rowsum with the table row selected by its bits in the strip
+ */
+static inline
+void decomp_m4ri_apply_tile(
+    widget_t* wid,
+    void* slices,
+    const size_t slice_len_bytes,
+    struct decomp_m4ri_table_t* table,
+    const size_t offset,
+    const size_t strip,
+    const size_t tile)
+{
+    tableau_t* tab = wid->tableau;
+    const size_t n_bytes = table->n_bytes;
+
+    for (size_t j = 0; j < 64; j++)
+    {
+        const size_t idx = (GET_CHUNK(slices, slice_len_bytes, offset, tile + j) >> (strip * M4RI_STRIP_BITS))
+            & (M4RI_TABLE_ROWS - 1);
+
+        if (idx)
+        {
+            const int8_t phase = simd_rowsum_cnf(
+                n_bytes,
+                table->slices_x + idx * n_bytes,
+                table->slices_z + idx * n_bytes,
+                tab->slices_x[tile + j],
+                tab->slices_z[tile + j]);
+
+            __inline_slice_set_bit(
+                tab->phases,
+                tile + j,
+                __inline_decomp_m4ri_phase(table->phases[idx], __inline_slice_get_bit(tab->phases, tile + j), phase));
+        }
+    }
+}
+
+/*
+ * Zeros block if previous elements are set 
+ * This search is non-local, it begins on the tile subsequent to the diagonal 
+ * TODO: comment header
+ */
+static inline
+void decomp_col_elim_upper(
+    widget_t* wid,
+    void* slices,
+    const size_t slice_len_bytes,
+    const size_t offset
+    )
+{
+    for (size_t i = offset + 64; i < wid->tableau->n_qubits; i += 64) 
+    {
+        decomp_col_elim_tile(wid, slices, slice_len_bytes, offset, i);
+    }
+
     return;
 }
 
@@ -537,36 +744,100 @@ void decomp_col_elim_lower(
 {
     for (size_t i = 0; i < offset; i += 64) 
     {
-        uint64_t targ_block[64];
-        uint64_t ctrl;
-        
-        decomp_load_block(targ_block, slices, slice_len_bytes, offset, i);
+        decomp_col_elim_tile(wid, slices, slice_len_bytes, offset, i);
+    }
 
-        #pragma GCC unroll 8 
-        for (size_t j = 0; j < 64; j++)
+    return;
+}
+
+/*
+ * decomp_col_elim_args
+ * Arguments for a worker eliminating the pivot columns of a set of tiles 
+ * Each worker takes every n_workers-th tile starting from its first tile 
+ */
+struct decomp_col_elim_args
+{
+    widget_t* wid;
+    void* slices;
+    size_t slice_len_bytes;
+    size_t offset;
+    size_t first_tile;
+    size_t n_workers;
+    struct decomp_m4ri_table_t* table; // Set to apply one strip of the table rather than eliminate
+    size_t strip;
+};
+
+static
+void decomp_col_elim_worker(void* args)
+{
+    struct decomp_col_elim_args* op = (struct decomp_col_elim_args*)args;
+    for (size_t i = op->first_tile * 64; i < op->wid->tableau->n_qubits; i += op->n_workers * 64)
+    {
+        if (i == op->offset)
         {
-            // While not all bits unset
-            // TODO: merge this line with the ctzll call, odd infinite loop earlier
-            while (targ_block[j])
-            {
-                ctrl = __builtin_ctzll(targ_block[j]);
+            continue;
+        }
 
-                // Rowsum to unset bit
-                tableau_rowsum_offset(
-                    wid->tableau,
-                    ctrl + offset,
-                    i + j,
-                    offset); 
-                
-                targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
-            }
+        if (NULL != op->table)
+        {
+            decomp_m4ri_apply_tile(op->wid, op->slices, op->slice_len_bytes, op->table, op->offset, op->strip, i);
+        }
+        else
+        {
+            decomp_col_elim_tile(op->wid, op->slices, op->slice_len_bytes, op->offset, i);
         }
     }
+}
 
-    return;
+/*
+ * decomp_col_elim_par
+ * Zeros the pivot columns of every other tile, distributing the tiles over the threadpool
+ * :: wid : widget_t* :: Widget object
+ * :: slices : void* :: Pointer to the first X slice
+ * :: slice_len_bytes : const size_t :: Length of each slice
+ * :: offset : const size_t :: Index of the pivot tile, the pivot tile must be diagonal
+ * :: table : struct decomp_m4ri_table_t* :: Table to apply, if NULL the tiles are eliminated one pivot at a time
+ * :: strip : const size_t :: Strip of the table 
+ * :: args : struct decomp_col_elim_args* :: Argument buffer with one element per worker
+ * Tiles are interleaved between the workers as the cost of each rowsum depends on the offset 
+ * Blocks until all tiles have been eliminated
+ */
+static inline
+void decomp_col_elim_par(
+    widget_t* wid,
+    void* slices,
+    const size_t slice_len_bytes,
+    const size_t offset,
+    struct decomp_m4ri_table_t* table,
+    const size_t strip,
+    struct decomp_col_elim_args* args
+    )
+{
+    const size_t n_workers = THREADPOOL_g.n_workers;
+    for (size_t i = 0; i < n_workers; i++)
+    {
+        args[i].wid = wid;
+        args[i].slices = slices;
+        args[i].slice_len_bytes = slice_len_bytes;
+        args[i].offset = offset;
+        args[i].first_tile = i;
+        args[i].n_workers = n_workers;
+        args[i].table = table;
+        args[i].strip = strip;
+        threadpool_add_task(decomp_col_elim_worker, args + i);
+    }
+    threadpool_barrier();
 }
 
-void simd_tableau_elim(widget_t* wid)
+/*
+ * __inline_tableau_elim
+ * Reduces the X tableau to the identity
+ * :: wid : widget_t* :: Widget object
+ * :: m4ri : const bool :: Eliminates the pivot columns from the other tiles using tables of pivot row products
+ * Pivots are found one 64 column tile at a time, the pivot columns are then eliminated from every other tile 
+ */
+static inline
+void __inline_tableau_elim(widget_t* wid, const bool m4ri)
 {
 
     tableau_t* tab = wid->tableau;
@@ -578,6 +849,28 @@ void simd_tableau_elim(widget_t* wid)
     uint8_t* slices_z = (void*)(tab->slices_z[0]);
     
     uint64_t ctrl_block[64] = {0};
+
+    const bool distributed = (threadpool_get_n_workers() > 1)
+        && (tab->n_qubits >= DECOMP_PAR_MIN_QUBITS);
+    struct decomp_col_elim_args* par_args = NULL;
+    if (distributed)
+    {
+        par_args = (struct decomp_col_elim_args*)malloc(THREADPOOL_g.n_workers * sizeof(struct decomp_col_elim_args));
+    }
+
+    struct decomp_m4ri_table_t table;
+    table.n_bytes = slice_len_bytes;
+    table.slices_x = NULL;
+    table.slices_z = NULL;
+    table.phases = NULL;
+    if (m4ri)
+    {
+        int err_code = posix_memalign((void**)&table.slices_x, CACHE_SIZE, M4RI_TABLE_ROWS * slice_len_bytes);
+        assert(0 == err_code);
+        err_code = posix_memalign((void**)&table.slices_z, CACHE_SIZE, M4RI_TABLE_ROWS * slice_len_bytes);
+        assert(0 == err_code);
+        table.phases = (uint8_t*)malloc(M4RI_TABLE_ROWS);
+    }
     
     // Stride through the tableau in chunks of 64 elements
     const size_t end_stride = tab->n_qubits - (tab->n_qubits % 64); 
@@ -670,7 +963,6 @@ void simd_tableau_elim(widget_t* wid)
 
                 if (1 == __inline_slice_get_bit(tab->slices_z[offset + j], offset + j))
                 {
-                    // TODO: This operation is quite slow
                     simd_tableau_transverse_hadamard(tab, offset + j);
                     clifford_queue_local_clifford_right(wid->queue, _H_, offset + j);
                 
@@ -722,9 +1014,51 @@ void simd_tableau_elim(widget_t* wid)
             64,
             ctrl_block); 
 
-        decomp_col_elim_upper(wid, slices, slice_len_bytes, offset);
-        decomp_col_elim_lower(wid, slices, slice_len_bytes, offset);
+        // Rows outside of the pivot tile are independent given the pivot tile
+        // Padded pivot tiles are left to the single pivot elimination 
+        if (m4ri && (offset + 64 <= tab->n_qubits))
+        {
+            // Sparse strips are left to the single pivot elimination
+            const uint64_t strips = decomp_m4ri_profitable(wid, slices, slice_len_bytes, offset);
+            for (size_t strip = 0; strip < 64 / M4RI_STRIP_BITS; strip++)
+            {
+                if (0 == ((strips >> strip) & 1))
+                {
+                    continue;
+                }
+
+                decomp_m4ri_build(tab, &table, offset, strip);
+                if (distributed)
+                {
+                    decomp_col_elim_par(wid, slices, slice_len_bytes, offset, &table, strip, par_args);
+                    continue;
+                }
+
+                for (size_t i = 0; i < tab->n_qubits; i += 64)
+                {
+                    if (i != offset)
+                    {
+                        decomp_m4ri_apply_tile(wid, slices, slice_len_bytes, &table, offset, strip, i);
+                    }
+                }
+            }
+        }
+
+        // Clears any pivot columns that remain 
+        if (distributed)
+        {
+            decomp_col_elim_par(wid, slices, slice_len_bytes, offset, NULL, 0, par_args);
+        }
+        else
+        {
+            decomp_col_elim_upper(wid, slices, slice_len_bytes, offset);
+            decomp_col_elim_lower(wid, slices, slice_len_bytes, offset);
+        }
     }
+    free(par_args);
+    free(table.slices_x);
+    free(table.slices_z);
+    free(table.phases);
 
 
     // TODO: Debug info
@@ -739,6 +1073,16 @@ void simd_tableau_elim(widget_t* wid)
     return;
 }
 
+void simd_tableau_elim(widget_t* wid)
+{
+    __inline_tableau_elim(wid, false);
+}
+
+void m4ri_tableau_elim(widget_t* wid)
+{
+    __inline_tableau_elim(wid, true);
+}
+
 /*
  *
  */
@@ -1005,7 +1349,7 @@ void simd_tableau_X_diag_col_upper(tableau_t* tab, const size_t idx)
             if (dst[chunk])
             {
                 DPRINT(DEBUG_3, "Slice XOR Upper: %lu %lu\n", idx, j + chunk);
-                tableau_rowsum_offset(tab, idx, j + chunk, j);
+                tableau_rowsum(tab, idx, j + chunk);
             }
         }
 
@@ -1016,7 +1360,7 @@ void simd_tableau_X_diag_col_upper(tableau_t* tab, const size_t idx)
     {
         if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
         {
-            tableau_rowsum_offset(tab, idx, j, j);
+            tableau_rowsum(tab, idx, j);
         }
     }
     return;
@@ -1032,7 +1376,7 @@ void simd_tableau_X_diag_col_lower(tableau_t* tab, const size_t idx)
         if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
         {
             DPRINT(DEBUG_3, "Slice XOR Lower: %lu %lu\n", idx, j);
-            tableau_rowsum_offset(tab, idx, j, j);
+            tableau_rowsum(tab, idx, j);
         }
     }
     return;
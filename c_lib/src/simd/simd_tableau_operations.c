@@ -3,7 +3,7 @@
 
 #include "tableau_operations.h"
 
-void tableau_H(tableau_t* restrict tab, const size_t targ)
+void tableau_H_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * x -> z
@@ -14,7 +14,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += sizeof(__m256i))
+    for (size_t i = start; i < stop; i += sizeof(__m256i))
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -27,7 +27,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_S(tableau_t* restrict tab, const size_t targ)
+void tableau_S_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * x -> x  
@@ -38,7 +38,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -53,7 +53,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Z(tableau_t* restrict tab, const size_t targ)
+void tableau_Z_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
 /*
  * Doubled S gate
@@ -67,7 +67,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -81,7 +81,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_R(tableau_t* restrict tab, const size_t targ)
+void tableau_R_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Triple S gate
@@ -102,7 +102,7 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -119,12 +119,12 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_I(tableau_t* restrict tab, const size_t targ)
+void tableau_I_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     return;
 }
 
-void tableau_X(tableau_t* restrict tab, const size_t targ)
+void tableau_X_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
 /*
  * HZH Gate
@@ -148,7 +148,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i z = _mm256_load_si256(slice_z + i);
         __m256i r = _mm256_load_si256(slice_r + i);
@@ -157,7 +157,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Y(tableau_t* restrict tab, const size_t targ)
+void tableau_Y_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Y = XZ
@@ -175,7 +175,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -189,7 +189,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HX(tableau_t* restrict tab, const size_t targ)
+void tableau_HX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -206,7 +206,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -222,7 +222,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SX(tableau_t* restrict tab, const size_t targ)
+void tableau_SX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -238,7 +238,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -256,7 +256,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_RX(tableau_t* restrict tab, const size_t targ)
+void tableau_RX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -273,7 +273,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -289,7 +289,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HZ(tableau_t* restrict tab, const size_t targ)
+void tableau_HZ_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Z : (r ^= x)
@@ -307,7 +307,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -325,7 +325,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_HY(tableau_t* restrict tab, const size_t targ)
+void tableau_HY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * Y : r ^= x ^ z
@@ -343,7 +343,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -360,7 +360,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SH(tableau_t* restrict tab, const size_t targ)
+void tableau_SH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * H : (r ^= x.z; x <-> z) 
@@ -380,7 +380,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -394,7 +394,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RH(tableau_t* restrict tab, const size_t targ)
+void tableau_RH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -415,7 +415,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -428,7 +428,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_HS(tableau_t* restrict tab, const size_t targ)
+void tableau_HS_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -451,7 +451,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
      * x_2 = z_1 = z ^ x  
      *
      */
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -463,7 +463,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HR(tableau_t* restrict tab, const size_t targ)
+void tableau_HR_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -486,7 +486,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -496,7 +496,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HSX(tableau_t* restrict tab, const size_t targ)
+void tableau_HSX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -522,7 +522,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -538,7 +538,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRX(tableau_t* restrict tab, const size_t targ)
+void tableau_HRX_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * X : (r ^= z)
@@ -563,7 +563,7 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -575,13 +575,13 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SHY(tableau_t* restrict tab, const size_t targ)
+void tableau_SHY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -593,13 +593,13 @@ void tableau_SHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_RHY(tableau_t* restrict tab, const size_t targ)
+void tableau_RHY_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -611,14 +611,14 @@ void tableau_RHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HSH(tableau_t* restrict tab, const size_t targ)
+void tableau_HSH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
 
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -634,13 +634,13 @@ void tableau_HSH(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRH(tableau_t* restrict tab, const size_t targ)
+void tableau_HRH_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -657,13 +657,13 @@ void tableau_HRH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RHS(tableau_t* restrict tab, const size_t targ)
+void tableau_RHS_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -680,13 +680,13 @@ void tableau_RHS(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SHR(tableau_t* restrict tab, const size_t targ)
+void tableau_SHR_range(tableau_t* restrict tab, const size_t targ, const size_t start, const size_t stop)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -702,7 +702,7 @@ void tableau_SHR(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void tableau_CNOT_range(tableau_t* restrict tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop)
 {
     /*
      * CNOT a, b: ( 
@@ -718,7 +718,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i ctrl_x = _mm256_load_si256(ctrl_slice_x + i);
         __m256i ctrl_z = _mm256_load_si256(ctrl_slice_z + i);
@@ -739,7 +739,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     }
 }
 
-void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void tableau_CZ_range(tableau_t* restrict tab, const size_t ctrl, const size_t targ, const size_t start, const size_t stop)
 {
     /* CZ = H_b CNOT H_b 
      * H : (r ^= x.z; x <-> z) 
@@ -783,7 +783,7 @@ void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = start; i < stop; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i ctrl_x = _mm256_load_si256(ctrl_slice_x + i);
         __m256i ctrl_z = _mm256_load_si256(ctrl_slice_z + i);
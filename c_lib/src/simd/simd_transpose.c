@@ -210,79 +210,173 @@ void simd_transpose_2x16(uint8_t** src, uint8_t** targ)
 }
 
 
-void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+/*
+ * transpose_swap_registers
+ * Exchanges the off diagonal width x width sub-blocks between two registers of rows
+ * :: lo : __m256i* :: Rows holding the upper sub-block 
+ * :: hi : __m256i* :: Rows width below lo, holding the lower sub-block
+ * :: width : const int :: Width of the sub-block, must be a compile time constant
+ * :: mask : const __m256i :: Low width bits of each 2 * width bits
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_swap_registers(
+    __m256i* lo,
+    __m256i* hi,
+    const int width,
+    const __m256i mask)
 {
-     uint64_t src_block[64] = {0};
-     uint64_t targ_block[64] = {0};
-    
-     uint64_t* src_ptr[16];
-     uint64_t* targ_ptr[16] = {NULL};
+    __m256i t = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi64(*lo, width), *hi), mask);
+    *lo = _mm256_xor_si256(*lo, _mm256_slli_epi64(t, width));
+    *hi = _mm256_xor_si256(*hi, t);
+}
 
+/*
+ * transpose_swap_elements
+ * Exchanges the off diagonal width x width sub-blocks between the elements of a register of rows
+ * :: rows : __m256i :: Four rows 
+ * :: partner : __m256i :: The same rows with each element exchanged for the element width away
+ * :: width : const int :: Width of the sub-block, must be a compile time constant
+ * :: mask : const __m256i :: Low width bits of each 2 * width bits
+ * :: hi : const int :: 32 bit blend mask of the elements holding the lower sub-block
+ * Returns the updated rows
+ */
+static inline __attribute__((always_inline))
+__m256i __inline_transpose_swap_elements(
+    const __m256i rows,
+    const __m256i partner,
+    const int width,
+    const __m256i mask,
+    const int hi)
+{
+    __m256i t_lo = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi64(rows, width), partner), mask);
+    __m256i t_hi = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi64(partner, width), rows), mask);
+    return _mm256_blend_epi32(
+        _mm256_xor_si256(rows, _mm256_slli_epi64(t_lo, width)),
+        _mm256_xor_si256(rows, t_hi),
+        hi
+    );
+}
 
-    for (size_t col = 0; col < 4; col++) 
+/*
+ * transpose_64x64_registers
+ * Transposes a 64x64 bit block held in registers
+ * :: rows : __m256i* :: Row 4i + j of the block is element j of rows[i] 
+ * Recursively swaps the off diagonal blocks of width 32, 16, 8, 4, 2 and 1
+ * The first four rounds act between registers, the last two between elements of each register
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_64x64_registers(__m256i rows[16])
+{
+    const __m256i mask_32 = _mm256_set1_epi64x(0x00000000ffffffffull);
+    const __m256i mask_16 = _mm256_set1_epi64x(0x0000ffff0000ffffull);
+    const __m256i mask_8 = _mm256_set1_epi64x(0x00ff00ff00ff00ffull);
+    const __m256i mask_4 = _mm256_set1_epi64x(0x0f0f0f0f0f0f0f0full);
+    const __m256i mask_2 = _mm256_set1_epi64x(0x3333333333333333ull);
+    const __m256i mask_1 = _mm256_set1_epi64x(0x5555555555555555ull);
+
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
     {
-        for (size_t row = 0; row < 4; row++)  
-        {
-            for (size_t i = 0; i < 16; i++)
-            {
-                targ_ptr[i] = (uint64_t*)(((uint16_t*)(targ_block + i + 16 * row)) + col);
-                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_a[i + 16 * col])) + row); 
-            }
-            simd_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
-        }
+        if (!(i & 8)) { __inline_transpose_swap_registers(rows + i, rows + i + 8, 32, mask_32); }
     }
 
-
-    for (size_t col = 0; col < 4; col++) 
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
     {
-        for (size_t row = 0; row < 4; row++)  
-        {
-            for (size_t i = 0; i < 16; i++)
-            {
-                targ_ptr[i] = (uint64_t*)(((uint16_t*)(src_block + i + 16 * row)) + col);
-                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_b[i + 16 * col])) + row); 
-            }
-            simd_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
-        }
+        if (!(i & 4)) { __inline_transpose_swap_registers(rows + i, rows + i + 4, 16, mask_16); }
     }
 
-    for (size_t i = 0; i < 64; i++)
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
     {
-        memcpy(block_a[i], src_block + i, 8); 
-        memcpy(block_b[i], targ_block + i, 8); 
-    } 
- 
-    return;
-}
-void simd_transpose_64x64_inplace(uint64_t* block_a[64])
-{
-     uint64_t targ_block[64] = {0};
-    
-     uint64_t* restrict src_ptr[16];
-     uint64_t* restrict targ_ptr[16] = {NULL};
+        if (!(i & 2)) { __inline_transpose_swap_registers(rows + i, rows + i + 2, 8, mask_8); }
+    }
 
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
+    {
+        if (!(i & 1)) { __inline_transpose_swap_registers(rows + i, rows + i + 1, 4, mask_4); }
+    }
 
-    #pragma GCC unroll 4
-    for (size_t col = 0; col < 4; col++) 
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
     {
-        #pragma GCC unroll 4
-        for (size_t row = 0; row < 4; row++)  
-        {
+        // Swap 128 bit halves and then 64 bit elements
+        rows[i] = __inline_transpose_swap_elements(rows[i], _mm256_permute4x64_epi64(rows[i], 0x4e), 2, mask_2, 0xf0);
+        rows[i] = __inline_transpose_swap_elements(rows[i], _mm256_permute4x64_epi64(rows[i], 0xb1), 1, mask_1, 0xcc);
+    }
+}
 
-            #pragma GCC unroll 16 
-            for (size_t i = 0; i < 16; i++)
-            {
-                targ_ptr[i] = (uint64_t*)(((uint16_t*)(targ_block + i + 16 * row)) + col);
-                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_a[i + 16 * col])) + row); 
-            }
-            simd_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);                     
-        }
+/*
+ * transpose_load_block
+ * Loads a 64x64 bit block into registers
+ * :: rows : __m256i* :: Registers to load into 
+ * :: block : uint64_t** :: Rows of the block 
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_load_block(__m256i rows[16], uint64_t* restrict block[64])
+{
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
+    {
+        rows[i] = _mm256_set_epi64x(*block[4 * i + 3], *block[4 * i + 2], *block[4 * i + 1], *block[4 * i]);
     }
-    for (size_t i = 0; i < 64; i++)
+}
+
+/*
+ * transpose_store_block
+ * Stores a 64x64 bit block from registers
+ * :: rows : __m256i* :: Registers to store 
+ * :: block : uint64_t** :: Rows of the block 
+ */
+static inline __attribute__((always_inline))
+void __inline_transpose_store_block(__m256i rows[16], uint64_t* restrict block[64])
+{
+    #pragma GCC unroll 16
+    for (size_t i = 0; i < 16; i++)
     {
-        memcpy(block_a[i], targ_block + i, 8); 
-    } 
- 
+        *block[4 * i] = _mm256_extract_epi64(rows[i], 0);
+        *block[4 * i + 1] = _mm256_extract_epi64(rows[i], 1);
+        *block[4 * i + 2] = _mm256_extract_epi64(rows[i], 2);
+        *block[4 * i + 3] = _mm256_extract_epi64(rows[i], 3);
+    }
+}
+
+/*
+ * simd_transpose_64x64
+ * Transposes two 64x64 bit blocks and exchanges them
+ * :: block_a : uint64_t** :: Rows of the first block
+ * :: block_b : uint64_t** :: Rows of the second block
+ * Both blocks are transposed in registers, no intermediate buffers are written
+ */
+void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+{
+    __m256i rows_a[16];
+    __m256i rows_b[16];
+
+    __inline_transpose_load_block(rows_a, block_a);
+    __inline_transpose_load_block(rows_b, block_b);
+
+    __inline_transpose_64x64_registers(rows_a);
+    __inline_transpose_64x64_registers(rows_b);
+
+    __inline_transpose_store_block(rows_b, block_a);
+    __inline_transpose_store_block(rows_a, block_b);
+    return;
+}
+
+/*
+ * simd_transpose_64x64_inplace
+ * Transposes a 64x64 bit block 
+ * :: block_a : uint64_t** :: Rows of the block
+ */
+void simd_transpose_64x64_inplace(uint64_t* block_a[64])
+{
+    __m256i rows[16];
+
+    __inline_transpose_load_block(rows, block_a);
+    __inline_transpose_64x64_registers(rows);
+    __inline_transpose_store_block(rows, block_a);
     return;
 }
 
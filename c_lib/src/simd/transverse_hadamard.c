@@ -7,53 +7,57 @@
  * :: c_que :  clifford_queue_t* :: Clifford queue 
  * :: i : const size_t :: Index to target 
  *
+ * Rows are processed in tiles of 64, the targeted word of each row is gathered four rows at a time
+ * The exchange and the phase update are performed on the whole word, 
+ * and the phase of each tile is updated once  
  */
 void simd_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
 { 
     const size_t stride = 64;
-    uint8_t bit_x[64] = {0};
-    uint8_t bit_z[64] = {0};
-    uint64_t* bit_phase;
-  
-    // Number of bytes between transverseally adjacent bytes  
-    const size_t row_bytes = tab->slice_len;
-    const size_t offset = targ / 64 * 8; // Aligned offset load  
-
-    // TODO Vectorise this
-    // Use the strided load to do this faster
-    // Unfortunately scatter operations are avx512 :(
-
-    // Gathers 8 values
-    //__m256i gathered = _mm256_i32gather_epi64(
-    //    base_address
-    //    __m128i vindex,
-    //    1
-    //); 
-
-    // TODO SIMD this by chunks
-    // Otherwise we're trying to pipeline this
+    const size_t lanes = sizeof(__m256i) / sizeof(uint64_t);
+
+    // Aligned offset of the targeted word within each row 
+    const __m256i offset = _mm256_set1_epi64x(targ / 64 * sizeof(uint64_t));
+    const __m256i bit = _mm256_set1_epi64x(1ull << (targ % 64));
+
     for (size_t i = 0; i < tab->n_qubits; i += stride)
     {
-        bit_phase = (uint64_t*)(tab->phases) + i / stride; 
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
-        {
-            bit_z[j] = __inline_slice_get_bit(tab->slices_z[i + j], targ); 
-            bit_x[j] = __inline_slice_get_bit(tab->slices_x[i + j], targ); 
-        }
+        uint64_t* bit_phase = (uint64_t*)(tab->phases) + i / stride; 
+        uint64_t phase = 0;
 
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
-        {
-            *bit_phase ^= ((uint64_t)bit_z[j] & (uint64_t)bit_x[j]) << j;
-        }
-       
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
+        #pragma GCC unroll 16 
+        for (size_t j = 0; j < stride; j += lanes)
         {
-            __inline_slice_set_bit(tab->slices_z[i + j], targ, bit_x[j]); 
-            __inline_slice_set_bit(tab->slices_x[i + j], targ, bit_z[j]); 
+            __m256i addr_x = _mm256_add_epi64(_mm256_loadu_si256((void*)(tab->slices_x + i + j)), offset);
+            __m256i addr_z = _mm256_add_epi64(_mm256_loadu_si256((void*)(tab->slices_z + i + j)), offset);
+
+            __m256i x = _mm256_i64gather_epi64(NULL, addr_x, 1);
+            __m256i z = _mm256_i64gather_epi64(NULL, addr_z, 1);
+
+            // Phase is set where both targeted bits are set
+            __m256i xz = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_and_si256(x, z), bit), bit);
+            phase |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(xz)) << j;
+
+            // Exchange the targeted bits 
+            __m256i swap = _mm256_and_si256(_mm256_xor_si256(x, z), bit);
+            uint64_t words_x[4]; 
+            uint64_t words_z[4]; 
+            uint64_t* ptrs_x[4]; 
+            uint64_t* ptrs_z[4]; 
+            _mm256_storeu_si256((__m256i*)words_x, _mm256_xor_si256(x, swap));
+            _mm256_storeu_si256((__m256i*)words_z, _mm256_xor_si256(z, swap));
+            _mm256_storeu_si256((__m256i*)ptrs_x, addr_x);
+            _mm256_storeu_si256((__m256i*)ptrs_z, addr_z);
+
+            // AVX2 has no scatter 
+            #pragma GCC unroll 4 
+            for (size_t k = 0; k < lanes; k++)
+            {
+                *ptrs_x[k] = words_x[k];
+                *ptrs_z[k] = words_z[k];
+            }
         }
+        *bit_phase ^= phase;
     }
     return;
 }
@@ -0,0 +1,196 @@
+#define SIMD_DISPATCH_SRC
+#include "simd_dispatch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "simd_transpose.h"
+#include "simd_gaussian_elimination.h"
+
+/*
+ * Kernel tables for the baseline instruction set
+ * The live tables are overwritten when another set of kernels is bound,
+ * so the baseline kernels are also kept here
+ */
+static void (*BASE_SINGLE_QUBIT_OPERATIONS_RANGE[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t, const size_t, const size_t) = SINGLE_QUBIT_OPERATIONS_RANGE_TABLE;
+static void (*BASE_TWO_QUBIT_OPERATIONS_RANGE[N_NON_LOCAL_CLIFFORDS])(tableau_t*, const size_t, const size_t, const size_t, const size_t) = TWO_QUBIT_OPERATIONS_RANGE_TABLE;
+static void (*BASE_FUSED_OPERATIONS_RANGE[N_FUSED_OPERATIONS])(tableau_t*, const size_t, const size_t, const size_t, const size_t) = FUSED_OPERATIONS_RANGE_TABLE;
+
+#ifdef __x86_64__
+
+// AVX-512 kernels, see simd_tier.h
+extern void (*SINGLE_QUBIT_OPERATIONS_RANGE_avx512[])(tableau_t*, const size_t, const size_t, const size_t);
+extern void (*TWO_QUBIT_OPERATIONS_RANGE_avx512[])(tableau_t*, const size_t, const size_t, const size_t, const size_t);
+extern void (*FUSED_OPERATIONS_RANGE_avx512[])(tableau_t*, const size_t, const size_t, const size_t, const size_t);
+extern __typeof__(simd_rowsum_cnf) simd_rowsum_cnf_avx512;
+extern __typeof__(simd_rowsum_cnf) simd_rowsum_cnf_vpopcnt_avx512;
+extern __typeof__(simd_transpose_64x64) simd_transpose_64x64_avx512;
+extern __typeof__(simd_transpose_64x64_inplace) simd_transpose_64x64_inplace_avx512;
+extern __typeof__(simd_widget_decompose) simd_widget_decompose_avx512;
+extern __typeof__(m4ri_widget_decompose) m4ri_widget_decompose_avx512;
+
+// The host checks run before the baseline instruction set is known to be supported,
+// so they are compiled without the AVX2 flags passed to the rest of the library
+#define SIMD_HOST_CHECK __attribute__((target("no-avx,no-bmi2,no-lzcnt")))
+
+SIMD_HOST_CHECK
+static bool simd_supports_avx2(void)
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2")
+        && __builtin_cpu_supports("bmi2");
+}
+
+SIMD_HOST_CHECK
+static bool simd_supports_avx512(void)
+{
+    __builtin_cpu_init();
+    return simd_supports_avx2()
+        && __builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512vl");
+}
+
+SIMD_HOST_CHECK
+static bool simd_supports_avx512vpopcntdq(void)
+{
+    __builtin_cpu_init();
+    return simd_supports_avx512()
+        && __builtin_cpu_supports("avx512vpopcntdq");
+}
+
+// Ordered from narrowest to widest
+static const struct simd_dispatch_t SIMD_TIERS[] = {
+    {
+        .name = "avx2",
+        .supported = simd_supports_avx2,
+        .single_qubit_range = BASE_SINGLE_QUBIT_OPERATIONS_RANGE,
+        .two_qubit_range = BASE_TWO_QUBIT_OPERATIONS_RANGE,
+        .fused_range = BASE_FUSED_OPERATIONS_RANGE,
+        .rowsum = simd_rowsum_cnf,
+        .transpose_64x64 = simd_transpose_64x64,
+        .transpose_64x64_inplace = simd_transpose_64x64_inplace,
+        .widget_decompose = simd_widget_decompose,
+        .widget_decompose_m4ri = m4ri_widget_decompose
+    },
+    {
+        .name = "avx512",
+        .supported = simd_supports_avx512,
+        .single_qubit_range = SINGLE_QUBIT_OPERATIONS_RANGE_avx512,
+        .two_qubit_range = TWO_QUBIT_OPERATIONS_RANGE_avx512,
+        .fused_range = FUSED_OPERATIONS_RANGE_avx512,
+        .rowsum = simd_rowsum_cnf_avx512,
+        .transpose_64x64 = simd_transpose_64x64_avx512,
+        .transpose_64x64_inplace = simd_transpose_64x64_inplace_avx512,
+        .widget_decompose = simd_widget_decompose_avx512,
+        .widget_decompose_m4ri = m4ri_widget_decompose_avx512
+    },
+    {
+        // Differs from the avx512 tier only in the rowsum, whose counters are reduced with VPOPCNTQ
+        .name = "avx512vpopcntdq",
+        .supported = simd_supports_avx512vpopcntdq,
+        .single_qubit_range = SINGLE_QUBIT_OPERATIONS_RANGE_avx512,
+        .two_qubit_range = TWO_QUBIT_OPERATIONS_RANGE_avx512,
+        .fused_range = FUSED_OPERATIONS_RANGE_avx512,
+        .rowsum = simd_rowsum_cnf_vpopcnt_avx512,
+        .transpose_64x64 = simd_transpose_64x64_avx512,
+        .transpose_64x64_inplace = simd_transpose_64x64_inplace_avx512,
+        .widget_decompose = simd_widget_decompose_avx512,
+        .widget_decompose_m4ri = m4ri_widget_decompose_avx512
+    }
+};
+
+#else
+
+#define SIMD_HOST_CHECK
+
+static bool simd_supports_neon(void)
+{
+    return true;
+}
+
+static const struct simd_dispatch_t SIMD_TIERS[] = {
+    {
+        .name = "neon",
+        .supported = simd_supports_neon,
+        .single_qubit_range = BASE_SINGLE_QUBIT_OPERATIONS_RANGE,
+        .two_qubit_range = BASE_TWO_QUBIT_OPERATIONS_RANGE,
+        .fused_range = BASE_FUSED_OPERATIONS_RANGE,
+        .rowsum = simd_rowsum_cnf,
+        .transpose_64x64 = simd_transpose_64x64,
+        .transpose_64x64_inplace = simd_transpose_64x64_inplace,
+        .widget_decompose = simd_widget_decompose,
+        .widget_decompose_m4ri = m4ri_widget_decompose
+    }
+};
+
+#endif
+
+#define N_SIMD_TIERS (sizeof(SIMD_TIERS) / sizeof(struct simd_dispatch_t))
+
+
+/*
+ * simd_dispatch_bind
+ * Binds a set of kernels
+ * :: tier : const struct simd_dispatch_t* :: Kernels to bind
+ */
+static void simd_dispatch_bind(const struct simd_dispatch_t* tier)
+{
+    memcpy(SINGLE_QUBIT_OPERATIONS_RANGE, tier->single_qubit_range, sizeof(BASE_SINGLE_QUBIT_OPERATIONS_RANGE));
+    memcpy(TWO_QUBIT_OPERATIONS_RANGE, tier->two_qubit_range, sizeof(BASE_TWO_QUBIT_OPERATIONS_RANGE));
+    memcpy(FUSED_OPERATIONS_RANGE, tier->fused_range, sizeof(BASE_FUSED_OPERATIONS_RANGE));
+    SIMD_DISPATCH_g = *tier;
+}
+
+
+bool simd_dispatch_select(const char* name)
+{
+    for (size_t i = 0; i < N_SIMD_TIERS; i++)
+    {
+        if (0 == strcmp(SIMD_TIERS[i].name, name))
+        {
+            if (!SIMD_TIERS[i].supported())
+            {
+                return false;
+            }
+            simd_dispatch_bind(SIMD_TIERS + i);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+SIMD_HOST_CHECK
+__attribute__((constructor))
+void simd_dispatch_init()
+{
+    // The library is compiled for the baseline instruction set, any later call would fault
+    if (!SIMD_TIERS[0].supported())
+    {
+        fprintf(stderr, "cabaliser: this CPU does not support %s, which the library requires\n", SIMD_TIERS[0].name);
+        exit(EXIT_FAILURE);
+    }
+
+    const char* requested = getenv("CABALISER_SIMD");
+    if (NULL != requested && simd_dispatch_select(requested))
+    {
+        return;
+    }
+
+    for (size_t i = N_SIMD_TIERS; i > 0; i--)
+    {
+        if (SIMD_TIERS[i - 1].supported())
+        {
+            simd_dispatch_bind(SIMD_TIERS + i - 1);
+            return;
+        }
+    }
+}
+
+
+const char* simd_dispatch_name()
+{
+    return SIMD_DISPATCH_g.name;
+}
@@ -1,4 +1,9 @@
 #include "tableau.h"
+#include "simd_dispatch.h"
+#include "threadpool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
 
 /*
  * slice_set_bit
@@ -48,13 +53,180 @@ size_t tableau_get_slice_len(tableau_t* tab) {
     return tab->slice_len;
 }
 
+static enum tableau_alloc_mode_e TABLEAU_ALLOC_MODE = TABLEAU_ALLOC_HEAP;
+
+void tableau_set_alloc_mode(const enum tableau_alloc_mode_e mode)
+{
+    TABLEAU_ALLOC_MODE = mode;
+}
+
+enum tableau_alloc_mode_e tableau_get_alloc_mode()
+{
+    return TABLEAU_ALLOC_MODE;
+}
+
+/*
+ * tableau_alloc_chunks
+ * Allocates a zeroed bitmap
+ * :: tab : tableau_t* :: Tableau, the chunks, chunks_bytes and alloc_mode fields are set
+ * :: n_bytes : const size_t :: Size of the bitmap
+ * Mapped pages are zeroed by the kernel, so they are not touched here 
+ */
+static void tableau_alloc_chunks(tableau_t* tab, const size_t n_bytes)
+{
+    enum tableau_alloc_mode_e mode = TABLEAU_ALLOC_MODE;
+    if (n_bytes < TABLEAU_MMAP_MIN_BYTES)
+    {
+        mode = TABLEAU_ALLOC_HEAP;
+    }
+
+    tab->chunks = NULL;
+    tab->chunks_bytes = n_bytes;
+
+    #ifdef MAP_HUGETLB
+    if (TABLEAU_ALLOC_HUGETLB == mode)
+    {
+        const size_t huge_bytes = TABLEAU_HUGE_PAGE_BYTES * ((n_bytes + TABLEAU_HUGE_PAGE_BYTES - 1) / TABLEAU_HUGE_PAGE_BYTES); 
+        void* map = mmap(NULL, huge_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (MAP_FAILED != map)
+        {
+            tab->chunks = map;
+            tab->chunks_bytes = huge_bytes;
+            tab->alloc_mode = TABLEAU_ALLOC_HUGETLB;
+            return;
+        }
+        DPRINT(DEBUG_1, "\tNo huge pages available, falling back to transparent huge pages\n");
+    }
+    #endif
+
+    if (TABLEAU_ALLOC_HEAP != mode)
+    {
+        void* map = mmap(NULL, n_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        assert(MAP_FAILED != map);
+
+        #ifdef MADV_HUGEPAGE
+        if (TABLEAU_ALLOC_MMAP != mode)
+        {
+            // Advisory only, the mapping is valid regardless
+            madvise(map, n_bytes, MADV_HUGEPAGE);
+        }
+        #endif
+
+        tab->chunks = map;
+        tab->alloc_mode = (TABLEAU_ALLOC_MMAP == mode) ? TABLEAU_ALLOC_MMAP : TABLEAU_ALLOC_THP;
+        return;
+    }
+
+    int err_code = posix_memalign(&tab->chunks, CACHE_SIZE, n_bytes); 
+    assert(0 == err_code);
+
+    // Set map to all zeros
+    memset(tab->chunks, 0x00, n_bytes);
+    tab->alloc_mode = TABLEAU_ALLOC_HEAP;
+}
+
+static enum tableau_numa_policy_e TABLEAU_NUMA_POLICY = TABLEAU_NUMA_AUTO;
+
+void tableau_set_numa_policy(const enum tableau_numa_policy_e policy)
+{
+    TABLEAU_NUMA_POLICY = policy;
+}
+
+enum tableau_numa_policy_e tableau_get_numa_policy()
+{
+    return TABLEAU_NUMA_POLICY;
+}
+
+/*
+ * tableau_first_touch_worker
+ * Writes one byte of each page in a worker's range of each slice
+ * :: args : void* :: struct distributed_tableau_op*
+ * The bitmap is zeroed by the kernel, so writing a zero leaves it unchanged
+ * The page is then placed on the node of the worker 
+ */
+static void tableau_first_touch_worker(void* args)
+{
+    const struct distributed_tableau_op* op = (struct distributed_tableau_op*)args;
+    const tableau_t* tab = op->tab;
+    const uintptr_t page_bytes = (uintptr_t)sysconf(_SC_PAGESIZE);
+
+    const size_t n_ptrs = tab->n_qubits + !!(tab->n_qubits % CACHE_SIZE) * (CACHE_SIZE - (tab->n_qubits % CACHE_SIZE)); 
+    for (size_t i = 0; i < 2 * n_ptrs; i++)
+    {
+        uintptr_t addr = (uintptr_t)tab->chunks + i * tab->slice_len + op->start; 
+        const uintptr_t stop = (uintptr_t)tab->chunks + i * tab->slice_len + op->stop;
+        while (addr < stop)
+        {
+            *(volatile uint8_t*)addr = 0;
+            addr = (addr / page_bytes + 1) * page_bytes;
+        }
+    }
+}
+
+/*
+ * tableau_numa_place
+ * Applies the NUMA policy to a newly mapped bitmap
+ * :: tab : tableau_t* :: Tableau, the bitmap must not have been written
+ * With transparent huge pages a page spans the rows of several workers,
+ * and is placed on the node of whichever worker writes it first 
+ */
+static void tableau_numa_place(tableau_t* tab)
+{
+    if (TABLEAU_ALLOC_HEAP == tab->alloc_mode)
+    {
+        return;
+    }
+
+    enum tableau_numa_policy_e policy = TABLEAU_NUMA_POLICY;
+    if (TABLEAU_NUMA_AUTO == policy)
+    {
+        policy = ((threadpool_get_n_nodes() > 1) && threadpool_distributable(tab)) ? TABLEAU_NUMA_FIRST_TOUCH : TABLEAU_NUMA_LOCAL;
+    }
+
+    if (TABLEAU_NUMA_INTERLEAVE == policy)
+    {
+        if (!numa_interleave(tab->chunks, tab->chunks_bytes))
+        {
+            DPRINT(DEBUG_1, "\tCould not interleave the tableau\n");
+        }
+    }
+    else if ((TABLEAU_NUMA_FIRST_TOUCH == policy) && (threadpool_get_n_workers() > 0))
+    {
+        threadpool_distribute_tableau_operation(tab, tableau_first_touch_worker, NULL_TARG, NULL_TARG);
+        threadpool_barrier();
+    }
+}
+
+static enum tableau_layout_e TABLEAU_LAYOUT_MODE = TABLEAU_LAYOUT_PLANAR;
+
+void tableau_set_layout_mode(const enum tableau_layout_e layout)
+{
+    TABLEAU_LAYOUT_MODE = layout;
+}
+
+enum tableau_layout_e tableau_get_layout_mode()
+{
+    return TABLEAU_LAYOUT_MODE;
+}
+
 /*
  * tableau_create 
  * Constructor class for tableau  
  * :: n_qubits :: Number of qubits   
- * Acts in place and frees all attributes associated with the tableau object
+ * Uses the layout set by tableau_set_layout_mode
  */
 tableau_t* tableau_create(const size_t n_qubits)
+{
+    return tableau_create_layout(n_qubits, TABLEAU_LAYOUT_MODE);
+}
+
+/*
+ * tableau_create_layout
+ * Constructor class for tableau with a given slice layout
+ * :: n_qubits : const size_t :: Number of qubits   
+ * :: layout : const enum tableau_layout_e :: Placement of the slices
+ */
+tableau_t* tableau_create_layout(const size_t n_qubits, const enum tableau_layout_e layout)
 {
     DPRINT(DEBUG_1, "Allocating %zu qubit tableau\n", n_qubits);
 
@@ -65,15 +237,12 @@ tableau_t* tableau_create(const size_t n_qubits)
     const size_t tableau_half_bytes = slice_len_bytes * n_ptrs;
     const size_t tableau_bytes = tableau_half_bytes * 2; 
 
-    // Construct memaligned bitmap
-    void* tableau_bitmap = NULL;
-
-    int err_code = posix_memalign(&tableau_bitmap, CACHE_SIZE, tableau_bytes); 
-    assert(0 == err_code);
+    // Create the tableau struct and assign variables   
+    tableau_t* tab = malloc(sizeof(tableau_t)); 
 
-    // Set map to all zeros
-    // TODO: fast memset
-    memset(tableau_bitmap, 0x00, tableau_bytes);
+    // Construct zeroed bitmap
+    tableau_alloc_chunks(tab, tableau_bytes);
+    void* tableau_bitmap = tab->chunks;
     DPRINT(DEBUG_2, "\tAllocated %ld bytes for tableau\n", tableau_bytes);
     DPRINT(DEBUG_2, "\tSlices contain %zu bytes\n", slice_len_bytes);
     
@@ -82,37 +251,36 @@ tableau_t* tableau_create(const size_t n_qubits)
     void* slice_ptrs_x = malloc(sizeof(void*) * n_ptrs); 
 
     void* phases = NULL;
-    err_code = posix_memalign(&phases, CACHE_SIZE, slice_len_bytes);
-    // TODO: fast memset
+    int err_code = posix_memalign(&phases, CACHE_SIZE, slice_len_bytes);
+    assert(0 == err_code);
     memset(phases, 0x00, slice_len_bytes);
 
-    // Create the tableau struct and assign variables   
-    tableau_t* tab = malloc(sizeof(tableau_t)); 
     tab->n_qubits = n_qubits;
     tab->slice_len = slice_len_bytes;
-    tab->chunks = tableau_bitmap; 
     tab->slices_x = slice_ptrs_x;
     tab->slices_z = slice_ptrs_z;
     tab->orientation = COL_MAJOR;
     tab->phases = phases;
+    tab->layout = layout;
+
+    // Placement happens before the identity is written
+    tableau_numa_place(tab);
 
     // Construct start of X and Z segments 
+    const size_t stride = TABLEAU_SLICE_STRIDE(tab);
     void* x_start = tableau_bitmap; 
-    void* z_start = (uint8_t*)tableau_bitmap + tableau_half_bytes;
+    void* z_start = (uint8_t*)tableau_bitmap + ((TABLEAU_LAYOUT_INTERLEAVED == layout) ? slice_len_bytes : tableau_half_bytes);
 
     // TODO: eliminate this and just use pointer arithmetic
     for (size_t i = 0; i < n_ptrs; i++)
     {   
-        uint8_t* ptr_z = z_start + (i * slice_len_bytes);
-        uint8_t* ptr_x = x_start + (i * slice_len_bytes);
+        uint8_t* ptr_z = z_start + (i * stride);
+        uint8_t* ptr_x = x_start + (i * stride);
 
         tab->slices_z[i] = (tableau_slice_p)ptr_z; 
         // One write per cache line entry, should be collision free 
         slice_set_bit(tab->slices_z[i], i, 1); 
         tab->slices_x[i] = (tableau_slice_p)ptr_x; 
-
-        // TODO: Remove
-        assert(tab->slices_x[i][0] == 0ull);
     }
     return tab;
 }
@@ -132,6 +300,154 @@ void tableau_set_n_qubits(tableau_t* tab, const size_t n_qubits)
 }
 
 
+/*
+ * tableau_free_members
+ * Frees the allocations owned by a tableau, but not the tableau itself
+ * :: tab : tableau_t* :: Tableau
+ */
+static void tableau_free_members(tableau_t* tab)
+{
+    free(tab->slices_x);
+    free(tab->slices_z);
+    if (TABLEAU_ALLOC_HEAP == tab->alloc_mode)
+    {
+        free(tab->chunks);
+    }
+    else
+    {
+        munmap(tab->chunks, tab->chunks_bytes);
+    }
+    free(tab->phases);
+}
+
+
+void tableau_grow(tableau_t* tab, const size_t n_qubits)
+{
+    assert(COL_MAJOR == tab->orientation);
+    assert(n_qubits >= tab->n_qubits);
+
+    DPRINT(DEBUG_1, "Growing %zu qubit tableau to %zu qubits\n", tab->n_qubits, n_qubits);
+
+    tableau_t* grown = tableau_create_layout(n_qubits, tab->layout);
+
+    // Existing rows keep their offsets, the new rows of each slice remain zero
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        memcpy(grown->slices_x[i], tab->slices_x[i], tab->slice_len);
+        memcpy(grown->slices_z[i], tab->slices_z[i], tab->slice_len);
+    }
+    memcpy(grown->phases, tab->phases, tab->slice_len);
+
+    tableau_free_members(tab);
+    *tab = *grown;
+    free(grown);
+}
+
+
+void tableau_compact(tableau_t* tab, const size_t n_qubits)
+{
+    assert(COL_MAJOR == tab->orientation);
+    assert(n_qubits <= tab->n_qubits);
+
+    const size_t slice_len_bytes = SLICE_LEN_BYTES(n_qubits, CACHE_SIZE); 
+    const size_t n_ptrs = n_qubits + !!(n_qubits % CACHE_SIZE) * (CACHE_SIZE - (n_qubits % CACHE_SIZE)); 
+    const size_t tableau_half_bytes = slice_len_bytes * n_ptrs;
+
+    DPRINT(DEBUG_1, "Compacting %zu qubit tableau to %zu qubits\n", tab->n_qubits, n_qubits);
+
+    const bool interleaved = (TABLEAU_LAYOUT_INTERLEAVED == tab->layout);
+    const size_t stride = slice_len_bytes * (1 + interleaved);
+    uint8_t* x_start = (uint8_t*)tab->chunks; 
+    uint8_t* z_start = x_start + (interleaved ? slice_len_bytes : tableau_half_bytes);
+
+    // Each slice moves towards the start of the allocation
+    // so moving in order never overwrites a slice that has yet to move
+    // In the planar layout every X slice must move before the first Z slice
+    for (size_t i = 0; i < n_ptrs; i++)
+    {
+        memmove(x_start + i * stride, tab->slices_x[i], slice_len_bytes);
+        tab->slices_x[i] = (tableau_slice_p)(x_start + i * stride);
+        if (interleaved)
+        {
+            memmove(z_start + i * stride, tab->slices_z[i], slice_len_bytes);
+            tab->slices_z[i] = (tableau_slice_p)(z_start + i * stride);
+        }
+    }
+    for (size_t i = 0; (i < n_ptrs) && !interleaved; i++)
+    {
+        memmove(z_start + i * stride, tab->slices_z[i], slice_len_bytes);
+        tab->slices_z[i] = (tableau_slice_p)(z_start + i * stride);
+    }
+
+    // Release whole pages past the compacted tableau
+    if (TABLEAU_ALLOC_HEAP != tab->alloc_mode)
+    {
+        const size_t page_bytes = (TABLEAU_ALLOC_HUGETLB == tab->alloc_mode) ? TABLEAU_HUGE_PAGE_BYTES : (size_t)sysconf(_SC_PAGESIZE);
+        const size_t mapped_bytes = page_bytes * ((2 * tableau_half_bytes + page_bytes - 1) / page_bytes);
+        if (mapped_bytes < tab->chunks_bytes)
+        {
+            munmap((uint8_t*)tab->chunks + mapped_bytes, tab->chunks_bytes - mapped_bytes);
+            tab->chunks_bytes = mapped_bytes;
+        }
+    }
+
+    tab->n_qubits = n_qubits;
+    tab->slice_len = slice_len_bytes;
+}
+
+
+/*
+ * tableau_reset
+ * Restores the tableau to the identity
+ * :: tab : tableau_t* :: The tableau
+ * :: n_dirty : const size_t :: Number of qubits that may have been acted on 
+ * Gates on the leading qubits never touch the rows of the trailing qubits,
+ * which remain as the identity
+ */
+void tableau_reset(tableau_t* tab, const size_t n_dirty)
+{
+    assert(COL_MAJOR == tab->orientation);
+    assert(n_dirty <= tab->n_qubits);
+
+    const size_t dirty_bytes = SLICE_LEN_BYTES(n_dirty, CACHE_SIZE);
+    for (size_t i = 0; i < n_dirty; i++)
+    {
+        memset(tab->slices_x[i], 0x00, dirty_bytes);
+        memset(tab->slices_z[i], 0x00, dirty_bytes);
+        __inline_slice_set_bit(tab->slices_z[i], i, 1);
+    }
+    memset(tab->phases, 0x00, tab->slice_len);
+}
+
+/*
+ * tableau_relayout
+ * Moves the slices of the tableau to a different layout
+ * :: tab : tableau_t* :: The tableau
+ * :: layout : const enum tableau_layout_e :: Placement of the slices
+ * Acts in place on the tableau, the slices are copied into a new allocation 
+ */
+void tableau_relayout(tableau_t* tab, const enum tableau_layout_e layout)
+{
+    assert(COL_MAJOR == tab->orientation);
+    if (layout == tab->layout)
+    {
+        return;
+    }
+
+    tableau_t* moved = tableau_create_layout(tab->n_qubits, layout);
+
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        memcpy(moved->slices_x[i], tab->slices_x[i], tab->slice_len);
+        memcpy(moved->slices_z[i], tab->slices_z[i], tab->slice_len);
+    }
+    memcpy(moved->phases, tab->phases, tab->slice_len);
+
+    tableau_free_members(tab);
+    *tab = *moved;
+    free(moved);
+}
+
 /*
  * tableau_destroy 
  * Destructor class for tableau  
@@ -142,10 +458,7 @@ void tableau_destroy(tableau_t* tab)
 {
     DPRINT(DEBUG_1, "Freeing %ld qubit tableau\n", tab->n_qubits);
 
-    free(tab->slices_x);
-    free(tab->slices_z);
-    free(tab->chunks);
-    free(tab->phases);
+    tableau_free_members(tab);
     free(tab);
     return;
 }
@@ -226,6 +539,115 @@ void tableau_col_elim_X(tableau_t const* tab, const size_t idx)
     }   
 }
 
+/*
+ * transpose_tile_args
+ * Arguments for transposing a set of pairs of super-tiles 
+ */
+struct transpose_tile_args
+{
+    uint64_t** slices;
+    size_t n_blocks; // Number of 64x64 blocks along each side
+    size_t first_pair;
+    size_t n_workers;
+};
+
+/*
+ * __inline_transpose_block
+ * Transposes the blocks at (col, row) and (row, col) and exchanges them
+ * :: slices : uint64_t** :: Slices of the tableau
+ * :: col : const size_t :: Block column index 
+ * :: row : const size_t :: Block row index 
+ */
+static inline
+void __inline_transpose_block(uint64_t** slices, const size_t col, const size_t row)
+{
+    uint64_t* src_ptr[64];
+    uint64_t* targ_ptr[64];
+
+    if (col == row)
+    {
+        #pragma GCC unroll 64
+        for (size_t i = 0; i < 64; i++)
+        {
+            src_ptr[i] = slices[i + (64 * col)] + col;
+        }
+        SIMD_DISPATCH_g.transpose_64x64_inplace(src_ptr);
+        return;
+    }
+
+    // Break this up to improve stride detection
+    #pragma GCC unroll 64
+    for (size_t i = 0; i < 64; i++)
+    {
+        src_ptr[i] = slices[i + (64 * col)] + row;
+    }
+
+    #pragma GCC unroll 64
+    for (size_t i = 0; i < 64; i++)
+    {
+       targ_ptr[i] = slices[i + (64 * row)] + col;            
+    }
+    
+    SIMD_DISPATCH_g.transpose_64x64(src_ptr, targ_ptr);
+}
+
+/*
+ * __inline_transpose_tile_pair
+ * Transposes the blocks shared by two super-tiles
+ * :: slices : uint64_t** :: Slices of the tableau
+ * :: n_blocks : const size_t :: Number of 64x64 blocks along each side
+ * :: tile_col : const size_t :: Index of the first super-tile 
+ * :: tile_row : const size_t :: Index of the second super-tile, not less than tile_col 
+ * Each pair of super-tiles touches TRANSPOSE_TILE_BLOCKS^2 blocks above and below the diagonal 
+ * so the working set of each pair stays resident in the L2 cache
+ */
+static inline
+void __inline_transpose_tile_pair(
+    uint64_t** slices,
+    const size_t n_blocks,
+    const size_t tile_col,
+    const size_t tile_row)
+{
+    const size_t col_end = ((tile_col + 1) * TRANSPOSE_TILE_BLOCKS < n_blocks) ? (tile_col + 1) * TRANSPOSE_TILE_BLOCKS : n_blocks; 
+    const size_t row_end = ((tile_row + 1) * TRANSPOSE_TILE_BLOCKS < n_blocks) ? (tile_row + 1) * TRANSPOSE_TILE_BLOCKS : n_blocks; 
+
+    for (size_t col = tile_col * TRANSPOSE_TILE_BLOCKS; col < col_end; col++)
+    {
+        // On the diagonal super-tile only the blocks on or below the diagonal are visited
+        const size_t row_start = (tile_col == tile_row) ? col : tile_row * TRANSPOSE_TILE_BLOCKS;
+        for (size_t row = row_start; row < row_end; row++)
+        {
+            __inline_transpose_block(slices, col, row);
+        }
+    }
+}
+
+/*
+ * transpose_tile_worker
+ * Transposes every n_workers-th pair of super-tiles
+ * :: args : struct transpose_tile_args* :: Arguments
+ * Distinct pairs of super-tiles share no blocks, so pairs may be transposed concurrently 
+ */
+static
+void transpose_tile_worker(void* args)
+{
+    struct transpose_tile_args* op = (struct transpose_tile_args*)args;
+    const size_t n_tiles = (op->n_blocks + TRANSPOSE_TILE_BLOCKS - 1) / TRANSPOSE_TILE_BLOCKS;
+
+    size_t pair = 0;
+    for (size_t tile_col = 0; tile_col < n_tiles; tile_col++)
+    {
+        for (size_t tile_row = tile_col; tile_row < n_tiles; tile_row++, pair++)
+        {
+            if (op->first_pair == pair % op->n_workers)
+            {
+                __inline_transpose_tile_pair(op->slices, op->n_blocks, tile_col, tile_row);
+            }
+        }
+    }
+}
+
+
 /*
  * tableau_transpose
  * Transposes the tableau
@@ -248,39 +670,33 @@ void tableau_transpose_slices(tableau_t* tab, uint64_t** slices)
     const size_t chunk_elements =  tab->n_qubits / (8 * sizeof(uint64_t)); 
     const size_t remainder_elements = tab->n_qubits % 64; 
 
+    const bool distributed = (threadpool_get_n_workers() > 1)
+        && (tab->n_qubits >= TRANSPOSE_PAR_MIN_QUBITS);
 
-    uint64_t* src_ptr[64] = {NULL};
-    uint64_t* targ_ptr[64] = {NULL};
- 
-    for (size_t col = 0; col < chunk_elements; col++) 
+    if (distributed)
     {
-        for (size_t row = col + 1; row < chunk_elements; row++) 
+        const size_t n_workers = THREADPOOL_g.n_workers;
+        struct transpose_tile_args* args = (struct transpose_tile_args*)malloc(n_workers * sizeof(struct transpose_tile_args));
+        for (size_t i = 0; i < n_workers; i++)
         {
-            // Break this up to improve stride detection
-            #pragma GCC unroll 64
-            for (size_t i = 0; i < 64; i++)
-            {
-                src_ptr[i] = slices[i + (64 * col)] + row;
-            }
-
-            #pragma GCC unroll 64
-            for (size_t i = 0; i < 64; i++)
-            {
-               targ_ptr[i] = slices[i + (64 * row)] + col;            
-            }
-            
-            simd_transpose_64x64(src_ptr, targ_ptr);
+            args[i].slices = slices;
+            args[i].n_blocks = chunk_elements;
+            args[i].first_pair = i;
+            args[i].n_workers = n_workers;
+            threadpool_add_task(transpose_tile_worker, args + i);
         }
+        threadpool_barrier();
+        free(args);
     }
-
-    // Inplace diagonal
-    for (size_t col = 0; col < chunk_elements; col++)
+    else
     {
-        for (size_t i = 0; i < 64; i++)
-        {
-            src_ptr[i] = slices[i + (64 * col)] + col;
-        }
-        simd_transpose_64x64_inplace(src_ptr);
+        struct transpose_tile_args args = {
+            .slices = slices,
+            .n_blocks = chunk_elements,
+            .first_pair = 0,
+            .n_workers = 1
+        };
+        transpose_tile_worker(&args);
     }
 
     // Doing the remainder naively
@@ -574,7 +990,7 @@ void tableau_rowsum(tableau_t* tab, const size_t ctrl, const size_t targ)
     void* slice_ctrl_z = tab->slices_z[ctrl];
     void* slice_targ_z = tab->slices_z[targ];
 
-    int8_t phase = simd_rowsum_cnf(
+    int8_t phase = SIMD_DISPATCH_g.rowsum(
         tab->slice_len,
         slice_ctrl_x,
         slice_ctrl_z,
@@ -590,41 +1006,3 @@ void tableau_rowsum(tableau_t* tab, const size_t ctrl, const size_t targ)
     slice_set_bit(tab->phases, targ, phase);
 }
 
-
-/*
- * Calculates the rowsum starting from an offset 
- * :: tab : tableau_t* :: Tableau object
- * :: ctrl : const size_t :: Control qubit
- * :: targ : const size_t :: Target qubit
- * :: offset : const size_t :: Offset qubit index 
- */
-static inline
-void __inline_tableau_rowsum_offset(tableau_t* tab, const size_t ctrl, const size_t targ, const size_t offset)
-{
-    const size_t offset_bytes = (offset / 256) * 8; 
-
-    tableau_slice* slice_ctrl_x = (tableau_slice*)((void*)(tab->slices_x[ctrl]) + offset_bytes); 
-    tableau_slice* slice_ctrl_z = (tableau_slice*)((void*)(tab->slices_z[ctrl]) + offset_bytes); 
-    tableau_slice* slice_targ_x = (tableau_slice*)((void*)(tab->slices_x[targ]) + offset_bytes); 
-    tableau_slice* slice_targ_z = (tableau_slice*)((void*)(tab->slices_z[targ]) + offset_bytes); 
-
-    int8_t phase = simd_rowsum_cnf(
-        tab->slice_len - offset_bytes,
-        slice_ctrl_x,
-        slice_ctrl_z,
-        slice_targ_x,
-        slice_targ_z);
-
-    // Inlining will remove this as a blocking load
-    int8_t c_phase = slice_get_bit(tab->phases, ctrl) << 1;
-    int8_t t_phase = slice_get_bit(tab->phases, targ) << 1;
-
-    // https://arxiv.org/pdf/quant-ph/0406196 Page 4
-    phase = ((c_phase + t_phase + phase) % 4) >> 1;
-
-    slice_set_bit(tab->phases, targ, phase);
-}
-void tableau_rowsum_offset(tableau_t* tab, const size_t ctrl, const size_t targ, const size_t offset)
-{
-    __inline_tableau_rowsum_offset(tab, ctrl, targ, offset);
-}
@@ -0,0 +1,71 @@
+#include "tableau_operations.h"
+#include "tableau_fused_operations.h"
+
+/*
+ * Full slice gate wrappers
+ * The architecture specific kernels operate over a range of bytes in each slice
+ * These wrappers apply the kernel over the entire slice
+ * Kernels are called through the kernel tables, which are bound at load time by simd_dispatch.c
+ */
+#define TABLEAU_SINGLE_QUBIT_GATE(gate) \
+void tableau_##gate(tableau_t* tab, const size_t targ) \
+{ \
+    SINGLE_QUBIT_OPERATIONS_RANGE[_##gate##_ & INSTRUCTION_OPERATOR_MASK](tab, targ, 0, tab->slice_len); \
+}
+
+#define TABLEAU_TWO_QUBIT_GATE(gate) \
+void tableau_##gate(tableau_t* tab, const size_t ctrl, const size_t targ) \
+{ \
+    TWO_QUBIT_OPERATIONS_RANGE[_##gate##_ & INSTRUCTION_OPERATOR_MASK](tab, ctrl, targ, 0, tab->slice_len); \
+}
+
+TABLEAU_SINGLE_QUBIT_GATE(I)
+TABLEAU_SINGLE_QUBIT_GATE(X)
+TABLEAU_SINGLE_QUBIT_GATE(Y)
+TABLEAU_SINGLE_QUBIT_GATE(Z)
+TABLEAU_SINGLE_QUBIT_GATE(H)
+TABLEAU_SINGLE_QUBIT_GATE(S)
+TABLEAU_SINGLE_QUBIT_GATE(R)
+TABLEAU_SINGLE_QUBIT_GATE(HX)
+TABLEAU_SINGLE_QUBIT_GATE(SX)
+TABLEAU_SINGLE_QUBIT_GATE(RX)
+TABLEAU_SINGLE_QUBIT_GATE(HY)
+TABLEAU_SINGLE_QUBIT_GATE(HZ)
+TABLEAU_SINGLE_QUBIT_GATE(SH)
+TABLEAU_SINGLE_QUBIT_GATE(RH)
+TABLEAU_SINGLE_QUBIT_GATE(HS)
+TABLEAU_SINGLE_QUBIT_GATE(HR)
+TABLEAU_SINGLE_QUBIT_GATE(HSX)
+TABLEAU_SINGLE_QUBIT_GATE(HRX)
+TABLEAU_SINGLE_QUBIT_GATE(SHY)
+TABLEAU_SINGLE_QUBIT_GATE(RHY)
+TABLEAU_SINGLE_QUBIT_GATE(HSH)
+TABLEAU_SINGLE_QUBIT_GATE(HRH)
+TABLEAU_SINGLE_QUBIT_GATE(RHS)
+TABLEAU_SINGLE_QUBIT_GATE(SHR)
+
+TABLEAU_TWO_QUBIT_GATE(CNOT)
+TABLEAU_TWO_QUBIT_GATE(CZ)
+
+/*
+ * tableau_fused
+ * Applies the queued local Cliffords and a non-local Clifford in a single pass
+ * :: tab : tableau_t* :: The tableau to operate on 
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ * Equivalent to applying the local Cliffords and then the non-local Clifford
+ */
+void tableau_fused(
+    tableau_t* tab,
+    const size_t ctrl,
+    const size_t targ,
+    const instruction_t ctrl_clifford,
+    const instruction_t targ_clifford,
+    const instruction_t opcode)
+{
+    FUSED_OPERATIONS_RANGE[FUSED_OPERATION_IDX(opcode, ctrl_clifford, targ_clifford)](
+        tab, ctrl, targ, 0, tab->slice_len);
+}
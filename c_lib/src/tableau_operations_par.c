@@ -0,0 +1,48 @@
+#define TABLEAU_OPERATIONS_PAR_SRC
+#include "tableau_operations_par.h"
+
+/*
+ * Threadpool adaptors
+ * Unpacks a distributed operation and applies the range limited kernel
+ */
+#define TABLEAU_SINGLE_QUBIT_GATE_PAR(gate) \
+void tableau_##gate##_par(void* args) \
+{ \
+    struct distributed_tableau_op* op = (struct distributed_tableau_op*)args; \
+    SINGLE_QUBIT_OPERATIONS_RANGE[_##gate##_ & INSTRUCTION_OPERATOR_MASK](op->tab, op->ctrl, op->start, op->stop); \
+}
+
+#define TABLEAU_TWO_QUBIT_GATE_PAR(gate) \
+void tableau_##gate##_par(void* args) \
+{ \
+    struct distributed_tableau_op* op = (struct distributed_tableau_op*)args; \
+    TWO_QUBIT_OPERATIONS_RANGE[_##gate##_ & INSTRUCTION_OPERATOR_MASK](op->tab, op->ctrl, op->targ, op->start, op->stop); \
+}
+
+TABLEAU_SINGLE_QUBIT_GATE_PAR(I)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(X)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(Y)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(Z)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(H)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(S)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(R)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HX)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(SX)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(RX)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HY)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HZ)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(SH)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(RH)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HS)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HR)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HSX)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HRX)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(SHY)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(RHY)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HSH)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(HRH)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(RHS)
+TABLEAU_SINGLE_QUBIT_GATE_PAR(SHR)
+
+TABLEAU_TWO_QUBIT_GATE_PAR(CNOT)
+TABLEAU_TWO_QUBIT_GATE_PAR(CZ)
@@ -0,0 +1,631 @@
+#define THREADPOOL_SRC
+#include "threadpool.h"
+#include "tableau_operations.h"
+#include "tableau_fused_operations.h"
+
+/*
+ * distributed_tableau_job
+ * Single allocation for a distributed job and its arguments
+ * The job is freed by the worker once it has run
+ */
+struct distributed_tableau_job
+{
+    struct threadpool_job job;
+    struct distributed_tableau_op op;
+};
+
+/*
+ * gate_batch_job
+ * Single allocation for a slice of a gate batch
+ * The view shares the slices of the tableau, but has its own phase buffer
+ */
+struct gate_batch_job
+{
+    struct threadpool_job job;
+    tableau_t view;
+    size_t start; // First op in the batch
+    size_t stop; // Terminating op in the batch
+};
+
+static enum threadpool_pinning_e THREADPOOL_PINNING = THREADPOOL_PIN_AUTO;
+
+// Set on threads that must not submit work to the threadpool
+static __thread bool THREADPOOL_DETACHED = false;
+
+void threadpool_detach_thread(const bool detached)
+{
+    THREADPOOL_DETACHED = detached;
+}
+
+void threadpool_set_pinning(const enum threadpool_pinning_e pinning)
+{
+    THREADPOOL_PINNING = pinning;
+}
+
+enum threadpool_pinning_e threadpool_get_pinning()
+{
+    return THREADPOOL_PINNING;
+}
+
+/*
+ * threadpool_worker
+ * Threadpool worker function
+ * :: args : void* :: Worker index
+ * Polls the worker's queue and pops items from it
+ * Queue items should be function pointers and associated arguments
+ * Returns NULL
+ */
+void* threadpool_worker(void* args)
+{
+    const size_t thread_id = (size_t)args;
+    struct linked_list_t* queue = THREADPOOL_g.job_queues[thread_id];
+
+    pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+    for (;;)
+    {
+        while ((0 == queue->n_elements) && THREADPOOL_g.alive)
+        {
+            pthread_cond_wait(&THREADPOOL_g.queue_cond, &THREADPOOL_g.queue_lock);
+        }
+
+        // Queue is drained and the pool is shutting down
+        if (0 == queue->n_elements)
+        {
+            break;
+        }
+
+        struct threadpool_job* job = linked_list_pop(queue);
+        pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+
+        job->fn(job->args);
+        free(job);
+
+        pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+        THREADPOOL_g.active_jobs--;
+        if (0 == THREADPOOL_g.active_jobs)
+        {
+            pthread_cond_broadcast(&THREADPOOL_g.idle_cond);
+        }
+    }
+    pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+
+    return NULL;
+}
+
+/*
+ * threadpool_pin_workers
+ * Pins each worker to a CPU according to the pinning mode
+ * Sets the node of each worker and the number of nodes spanned by the workers
+ * If any worker cannot be pinned the workers are treated as unpinned
+ */
+static void threadpool_pin_workers()
+{
+    const size_t workers = THREADPOOL_g.n_workers;
+    THREADPOOL_g.worker_nodes = (size_t*)calloc(workers, sizeof(size_t));
+    THREADPOOL_g.n_nodes = 1;
+
+    if ((THREADPOOL_PIN_NEVER == THREADPOOL_PINNING)
+        || ((THREADPOOL_PIN_AUTO == THREADPOOL_PINNING) && (numa_n_nodes() < 2)))
+    {
+        return;
+    }
+
+    size_t n_nodes = 1;
+    for (size_t i = 0; i < workers; i++)
+    {
+        size_t node = 0;
+        const size_t cpu = numa_worker_cpu(i, workers, &node);
+        if ((NUMA_NO_CPU == cpu) || !numa_pin_thread(THREADPOOL_g.workers[i], cpu))
+        {
+            memset(THREADPOOL_g.worker_nodes, 0x00, workers * sizeof(size_t));
+            return;
+        }
+
+        // Workers on the same node are consecutive
+        n_nodes += (i > 0) && (node != THREADPOOL_g.worker_nodes[i - 1]);
+        THREADPOOL_g.worker_nodes[i] = node;
+    }
+    THREADPOOL_g.n_nodes = n_nodes;
+}
+
+/*
+ * threadpool_init
+ * Starts the threadpool
+ * :: n_workers : const size_t :: Number of workers, zero uses the number of online cores
+ * Re-initialising a running threadpool joins the existing workers first
+ */
+void threadpool_init(const size_t n_workers)
+{
+    if (THREADPOOL_INITIALISED)
+    {
+        threadpool_destroy();
+    }
+
+    size_t workers = n_workers;
+    if (0 == workers)
+    {
+        long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (n_cores > 0) ? (size_t)n_cores : 1;
+    }
+
+    THREADPOOL_g.n_workers = workers;
+    THREADPOOL_g.active_jobs = 0;
+    THREADPOOL_g.next_worker = 0;
+    THREADPOOL_g.alive = true;
+    memset(&THREADPOOL_g.batch, 0x00, sizeof(struct gate_batch_t));
+
+    pthread_mutex_init(&THREADPOOL_g.queue_lock, NULL);
+    pthread_cond_init(&THREADPOOL_g.queue_cond, NULL);
+    pthread_cond_init(&THREADPOOL_g.idle_cond, NULL);
+
+    THREADPOOL_g.job_queues = (struct linked_list_t**)malloc(workers * sizeof(struct linked_list_t*));
+    THREADPOOL_g.workers = (pthread_t*)malloc(workers * sizeof(pthread_t));
+
+    for (size_t i = 0; i < workers; i++)
+    {
+        THREADPOOL_g.job_queues[i] = linked_list_create();
+    }
+
+    for (size_t i = 0; i < workers; i++)
+    {
+        int err_code = pthread_create(THREADPOOL_g.workers + i, NULL, threadpool_worker, (void*)i);
+        assert(0 == err_code);
+    }
+
+    threadpool_pin_workers();
+
+    THREADPOOL_INITIALISED = true;
+    return;
+}
+
+/*
+ * threadpool_get_n_nodes
+ * Returns the number of NUMA nodes spanned by the running workers, one if the workers are not pinned
+ */
+size_t threadpool_get_n_nodes()
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        return 1;
+    }
+    return THREADPOOL_g.n_nodes;
+}
+
+/*
+ * threadpool_worker_range
+ * Range of bytes of each slice assigned to a worker by the distributed tableau operations
+ * :: slice_len : const size_t :: Length of each slice in bytes
+ * :: worker : const size_t :: Worker index
+ * :: start : size_t* :: Set to the first byte of the range
+ * :: stop : size_t* :: Set to the terminating byte of the range
+ * The first workers pick up the remaining cache lines
+ */
+void threadpool_worker_range(const size_t slice_len, const size_t worker, size_t* start, size_t* stop)
+{
+    const size_t n_workers = THREADPOOL_g.n_workers;
+    const size_t n_lines = slice_len / CACHE_SIZE;
+    const size_t lines_per_worker = n_lines / n_workers;
+    const size_t remainder = n_lines % n_workers;
+
+    *start = CACHE_SIZE * (worker * lines_per_worker + ((worker < remainder) ? worker : remainder));
+    *stop = *start + CACHE_SIZE * (lines_per_worker + (worker < remainder));
+}
+
+/*
+ * threadpool_get_n_workers
+ * Returns the number of running workers, zero if the threadpool is not initialised or the thread is detached
+ */
+size_t threadpool_get_n_workers()
+{
+    if (!THREADPOOL_INITIALISED || THREADPOOL_DETACHED)
+    {
+        return 0;
+    }
+    return THREADPOOL_g.n_workers;
+}
+
+/*
+ * threadpool_add_task
+ * Adds a job to the threadpool
+ * :: fn : void (*)(void*) :: Function to call
+ * :: args : void* :: Arguments to the function, owned by the caller
+ * Tasks are assigned to workers in a round robin fashion
+ */
+void threadpool_add_task(void (*fn)(void*), void* args)
+{
+    assert(THREADPOOL_INITIALISED);
+
+    struct threadpool_job* job = (struct threadpool_job*)malloc(sizeof(struct threadpool_job));
+    job->fn = fn;
+    job->args = args;
+
+    pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+    linked_list_push(THREADPOOL_g.job_queues[THREADPOOL_g.next_worker], job);
+    THREADPOOL_g.next_worker = (THREADPOOL_g.next_worker + 1) % THREADPOOL_g.n_workers;
+    THREADPOOL_g.active_jobs++;
+    pthread_cond_broadcast(&THREADPOOL_g.queue_cond);
+    pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+}
+
+/*
+ * distribute_tableau_operation
+ * Splits a tableau operation into cache aligned row ranges and queues one job per worker
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: fn : void (*)(void*) :: Job function, called with a struct distributed_tableau_op*
+ * :: kernel : void (*)(tableau_t*, size_t, size_t, size_t, size_t) :: Optional range limited kernel 
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit
+ */
+static inline
+void __inline_distribute_tableau_operation(
+    tableau_t* tab,
+    void (*fn)(void*),
+    void (*kernel)(tableau_t*, const size_t, const size_t, const size_t, const size_t),
+    const size_t ctrl,
+    const size_t targ)
+{
+    assert(THREADPOOL_INITIALISED);
+
+    const size_t n_workers = THREADPOOL_g.n_workers;
+
+    pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+
+    for (size_t i = 0; i < n_workers; i++)
+    {
+        size_t start = 0;
+        size_t stop = 0;
+        threadpool_worker_range(tab->slice_len, i, &start, &stop);
+        if (start == stop)
+        {
+            break;
+        }
+
+        struct distributed_tableau_job* dist_job = (struct distributed_tableau_job*)malloc(
+            sizeof(struct distributed_tableau_job));
+        dist_job->op.tab = tab;
+        dist_job->op.ctrl = ctrl;
+        dist_job->op.targ = targ;
+        dist_job->op.kernel = kernel;
+        dist_job->op.start = start;
+        dist_job->op.stop = stop;
+        dist_job->job.fn = fn;
+        dist_job->job.args = &(dist_job->op);
+
+        linked_list_push(THREADPOOL_g.job_queues[i], &(dist_job->job));
+        THREADPOOL_g.active_jobs++;
+    }
+
+    pthread_cond_broadcast(&THREADPOOL_g.queue_cond);
+    pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+}
+
+/*
+ * threadpool_distribute_tableau_operation
+ * Distributes a tableau operation over the workers
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: fn : void (*)(void*) :: Function to distribute, called with a struct distributed_tableau_op*
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit, set to NULL_TARG to null
+ * Each worker is assigned a cache aligned range of bytes of each slice
+ * The slice length of the tableau must not change until the next barrier
+ */
+void threadpool_distribute_tableau_operation(
+    tableau_t* tab,
+    void (*fn)(void*),
+    const size_t ctrl,
+    const size_t targ)
+{
+    __inline_distribute_tableau_operation(tab, fn, NULL, ctrl, targ);
+}
+
+/*
+ * distributed_kernel_worker 
+ * Unpacks a distributed operation and applies its range limited kernel
+ * :: args : void* :: Pointer to a struct distributed_tableau_op
+ */
+static
+void distributed_kernel_worker(void* args)
+{
+    struct distributed_tableau_op* op = (struct distributed_tableau_op*)args;
+    op->kernel(op->tab, op->ctrl, op->targ, op->start, op->stop);
+}
+
+/*
+ * threadpool_distribute_tableau_kernel
+ * Distributes a range limited two qubit kernel over the workers
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: kernel : void (*)(tableau_t*, size_t, size_t, size_t, size_t) :: Range limited kernel 
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit
+ * The slice length of the tableau must not change until the next barrier
+ */
+void threadpool_distribute_tableau_kernel(
+    tableau_t* tab,
+    void (*kernel)(tableau_t*, const size_t, const size_t, const size_t, const size_t),
+    const size_t ctrl,
+    const size_t targ)
+{
+    __inline_distribute_tableau_operation(tab, distributed_kernel_worker, kernel, ctrl, targ);
+}
+
+/*
+ * gate_batch_apply
+ * Applies a range of operations from the batch
+ * :: tab : tableau_t* :: Tableau or tableau view to operate over
+ * :: start : const size_t :: First op in the batch
+ * :: stop : const size_t :: Terminating op in the batch
+ */
+static inline
+void __inline_gate_batch_apply(tableau_t* tab, const size_t start, const size_t stop)
+{
+    const struct gate_batch_op* ops = THREADPOOL_g.batch.ops;
+    for (size_t i = start; i < stop; i++)
+    {
+        if (NULL_TARG == ops[i].targ)
+        {
+            SINGLE_QUBIT_OPERATIONS[ops[i].ctrl_clifford & INSTRUCTION_OPERATOR_MASK](tab, ops[i].ctrl);
+            continue;
+        }
+        tableau_fused(tab, ops[i].ctrl, ops[i].targ, ops[i].ctrl_clifford, ops[i].targ_clifford, ops[i].opcode);
+    }
+}
+
+/*
+ * gate_batch_worker 
+ * Applies a slice of the batch using the worker's phase buffer
+ * :: args : void* :: Pointer to a struct gate_batch_job
+ */
+static
+void gate_batch_worker(void* args)
+{
+    struct gate_batch_job* job = (struct gate_batch_job*)args;
+    memset(job->view.phases, 0x00, job->view.slice_len);
+    __inline_gate_batch_apply(&(job->view), job->start, job->stop);
+}
+
+/*
+ * gate_batch_dependent 
+ * Checks if a qubit is already in the current batch
+ * :: qubit : const size_t :: Qubit to check
+ * Returns true if the qubit is already in the batch
+ */
+static inline
+bool __inline_gate_batch_dependent(const size_t qubit)
+{
+    struct gate_batch_t* batch = &THREADPOOL_g.batch;
+    if (qubit >= batch->n_dependent)
+    {
+        const size_t n_dependent = 2 * qubit + CACHE_SIZE;
+        batch->dependent_qubits = (size_t*)realloc(batch->dependent_qubits, n_dependent * sizeof(size_t));
+        for (size_t i = batch->n_dependent; i < n_dependent; i++)
+        {
+            // Epochs start at one, so this never matches
+            batch->dependent_qubits[i] = 0;
+        }
+        batch->n_dependent = n_dependent;
+    }
+    return batch->dependent_qubits[qubit] == batch->epoch + 1;
+}
+
+/*
+ * threadpool_gate_batch_push
+ * Adds a gate to the current batch
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit, set to NULL_TARG to only apply the local Clifford on ctrl
+ * :: ctrl_clifford : const instruction_t :: Local Clifford queued on the first qubit 
+ * :: targ_clifford : const instruction_t :: Local Clifford queued on the second qubit
+ * :: opcode : const instruction_t :: Non-local Clifford opcode
+ * If the gate shares a qubit with the batch or the batch is full then the batch is flushed first
+ */
+void threadpool_gate_batch_push(
+    tableau_t* tab,
+    const size_t ctrl,
+    const size_t targ,
+    const instruction_t ctrl_clifford,
+    const instruction_t targ_clifford,
+    const instruction_t opcode)
+{
+    struct gate_batch_t* batch = &THREADPOOL_g.batch;
+
+    bool dependent = __inline_gate_batch_dependent(ctrl);
+    if (NULL_TARG != targ)
+    {
+        dependent |= __inline_gate_batch_dependent(targ);
+    }
+
+    if (dependent || (THREADPOOL_BATCH_WINDOW == batch->n_ops))
+    {
+        threadpool_gate_batch_flush(tab);
+    }
+
+    batch->dependent_qubits[ctrl] = batch->epoch + 1;
+    if (NULL_TARG != targ)
+    {
+        batch->dependent_qubits[targ] = batch->epoch + 1;
+    }
+
+    struct gate_batch_op* op = batch->ops + batch->n_ops;
+    op->ctrl = ctrl;
+    op->targ = targ;
+    op->ctrl_clifford = ctrl_clifford;
+    op->targ_clifford = targ_clifford;
+    op->opcode = opcode;
+    batch->n_ops++;
+}
+
+/*
+ * threadpool_gate_batch_flush
+ * Applies all gates in the current batch to the tableau
+ * :: tab : tableau_t* :: Tableau to operate over
+ * Small batches are applied on the calling thread, otherwise the gates are split between the workers
+ * Blocks until the batch has been applied
+ */
+void threadpool_gate_batch_flush(tableau_t* tab)
+{
+    struct gate_batch_t* batch = &THREADPOOL_g.batch;
+    const size_t n_ops = batch->n_ops;
+
+    batch->n_ops = 0;
+    batch->epoch++;
+
+    if (0 == n_ops)
+    {
+        return;
+    }
+
+    const size_t n_workers = threadpool_get_n_workers();
+    if ((n_workers < 2) || (n_ops < 2) || (n_ops * tab->slice_len < THREADPOOL_MIN_BATCH_BYTES))
+    {
+        __inline_gate_batch_apply(tab, 0, n_ops);
+        return;
+    }
+
+    // Phase buffers are only reallocated when the tableau grows
+    if (batch->phase_len < tab->slice_len)
+    {
+        if (NULL == batch->phases)
+        {
+            batch->phases = (void**)calloc(n_workers, sizeof(void*));
+        }
+        for (size_t i = 0; i < n_workers; i++)
+        {
+            free(batch->phases[i]);
+            int err_code = posix_memalign(batch->phases + i, CACHE_SIZE, tab->slice_len);
+            assert(0 == err_code);
+        }
+        batch->phase_len = tab->slice_len;
+    }
+
+    const size_t n_jobs = (n_ops < n_workers) ? n_ops : n_workers;
+    const size_t ops_per_job = n_ops / n_jobs;
+    const size_t remainder = n_ops % n_jobs;
+
+    pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+    size_t start = 0;
+    for (size_t i = 0; i < n_jobs; i++)
+    {
+        const size_t stop = start + ops_per_job + (i < remainder);
+
+        struct gate_batch_job* batch_job = (struct gate_batch_job*)malloc(sizeof(struct gate_batch_job));
+        batch_job->view = *tab;
+        batch_job->view.phases = batch->phases[i];
+        batch_job->start = start;
+        batch_job->stop = stop;
+        batch_job->job.fn = gate_batch_worker;
+        batch_job->job.args = batch_job;
+
+        linked_list_push(THREADPOOL_g.job_queues[i], &(batch_job->job));
+        THREADPOOL_g.active_jobs++;
+        start = stop;
+    }
+    pthread_cond_broadcast(&THREADPOOL_g.queue_cond);
+    pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+
+    threadpool_barrier();
+
+    // Gates in the batch act on disjoint qubits, so their phase updates commute
+    for (size_t i = 0; i < n_jobs; i++)
+    {
+        uint64_t* phases = (uint64_t*)batch->phases[i];
+        for (size_t j = 0; j < tab->slice_len / sizeof(uint64_t); j++)
+        {
+            tab->phases[j] ^= phases[j];
+        }
+    }
+}
+
+/*
+ * threadpool_distributable
+ * Checks if operations on a tableau should be distributed
+ * :: tab : const tableau_t* :: Tableau to operate over
+ * Returns false if the threadpool is not running or the tableau is too small
+ */
+bool threadpool_distributable(const tableau_t* tab)
+{
+    return (threadpool_get_n_workers() > 1)
+        && (tab->slice_len >= THREADPOOL_MIN_SLICE_BYTES);
+}
+
+/*
+ * threadpool_barrier
+ * Blocks until all queued tasks have completed
+ * This must be called before the tableau is accessed outside of the threadpool
+ */
+void threadpool_barrier()
+{
+    if (!THREADPOOL_INITIALISED || THREADPOOL_DETACHED)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+    while (THREADPOOL_g.active_jobs > 0)
+    {
+        pthread_cond_wait(&THREADPOOL_g.idle_cond, &THREADPOOL_g.queue_lock);
+    }
+    pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+}
+
+/*
+ * threadpool_join
+ * Completes all queued tasks and then stops the workers
+ */
+void threadpool_join()
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&THREADPOOL_g.queue_lock);
+    THREADPOOL_g.alive = false;
+    pthread_cond_broadcast(&THREADPOOL_g.queue_cond);
+    pthread_mutex_unlock(&THREADPOOL_g.queue_lock);
+
+    // Workers drain their queues before exiting
+    for (size_t i = 0; i < THREADPOOL_g.n_workers; i++)
+    {
+        pthread_join(THREADPOOL_g.workers[i], NULL);
+    }
+}
+
+/*
+ * threadpool_destroy
+ * Joins the workers and frees the threadpool resources
+ */
+void threadpool_destroy()
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        return;
+    }
+
+    threadpool_join();
+
+    for (size_t i = 0; i < THREADPOOL_g.n_workers; i++)
+    {
+        linked_list_destroy(THREADPOOL_g.job_queues[i]);
+    }
+    free(THREADPOOL_g.job_queues);
+    free(THREADPOOL_g.workers);
+    free(THREADPOOL_g.worker_nodes);
+
+    free(THREADPOOL_g.batch.dependent_qubits);
+    if (NULL != THREADPOOL_g.batch.phases)
+    {
+        for (size_t i = 0; i < THREADPOOL_g.n_workers; i++)
+        {
+            free(THREADPOOL_g.batch.phases[i]);
+        }
+        free(THREADPOOL_g.batch.phases);
+    }
+    memset(&THREADPOOL_g.batch, 0x00, sizeof(struct gate_batch_t));
+
+    pthread_cond_destroy(&THREADPOOL_g.queue_cond);
+    pthread_cond_destroy(&THREADPOOL_g.idle_cond);
+    pthread_mutex_destroy(&THREADPOOL_g.queue_lock);
+
+    THREADPOOL_g.n_workers = 0;
+    THREADPOOL_INITIALISED = false;
+}
@@ -1,10 +1,12 @@
 #include "widget.h"
+#include "simd_dispatch.h"
 
 /*
  * widget_create
  * Constructor for widget object
  * :: initial_qubits : const size_t :: Initial number of qubits that are allocated 
  * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated 
+ * The tableau is sized to the initial qubits and grows as qubits are allocated 
  */
 widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits)
 {
@@ -12,17 +14,155 @@ widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits)
     const size_t aligned_max_qubits = max_qubits + (
             !!(max_qubits % 64)) * (64 - (max_qubits % 64)); 
 
+    size_t capacity = initial_qubits + (!!(initial_qubits % 64)) * (64 - (initial_qubits % 64)); 
+    capacity = (capacity < 64) ? 64 : capacity;
+    capacity = (capacity > aligned_max_qubits) ? aligned_max_qubits : capacity;
+
     widget_t* wid = (widget_t*)malloc(sizeof(widget_t));  
     wid->n_initial_qubits = initial_qubits;
     wid->n_qubits = initial_qubits;
     wid->max_qubits = max_qubits; 
-    wid->tableau = tableau_create(aligned_max_qubits);
+    wid->tableau = tableau_create(capacity);
     wid->queue = clifford_queue_create(aligned_max_qubits);
     wid->q_map = qubit_map_create(initial_qubits, max_qubits); 
     wid->pauli_tracker = pauli_tracker_create(max_qubits);
     return wid;
 }
 
+/*
+ * widget_reserve
+ * Grows the tableau to hold at least a number of qubits
+ * :: wid : widget_t* :: Widget 
+ * :: n_qubits : const size_t :: Number of qubits, must not exceed the maximum number of qubits 
+ * The tableau grows by at least WIDGET_GROWTH_FACTOR, up to the maximum number of qubits 
+ */
+void widget_reserve(widget_t* wid, const size_t n_qubits)
+{
+    const size_t capacity = wid->tableau->n_qubits;
+    if (n_qubits <= capacity)
+    {
+        return;
+    }
+    assert(n_qubits <= wid->max_qubits);
+
+    const size_t aligned_max_qubits = wid->max_qubits + (
+            !!(wid->max_qubits % 64)) * (64 - (wid->max_qubits % 64)); 
+
+    size_t grown = WIDGET_GROWTH_FACTOR * capacity;
+    grown = (grown < n_qubits) ? n_qubits : grown; 
+    grown += (!!(grown % 64)) * (64 - (grown % 64));
+    grown = (grown > aligned_max_qubits) ? aligned_max_qubits : grown;
+
+    tableau_grow(wid->tableau, grown);
+}
+
+/*
+ * widget_reset
+ * Restores a widget to the state of a newly created widget with the same initial and maximum qubits
+ * :: wid : widget_t* :: Widget 
+ * Gates only act on allocated qubits, so only these are cleared
+ * Decomposition also acts on the qubits up to the next multiple of 64
+ */
+void widget_reset(widget_t* wid)
+{
+    size_t n_dirty = wid->n_qubits + (!!(wid->n_qubits % 64)) * (64 - (wid->n_qubits % 64)); 
+    n_dirty = (n_dirty < 64) ? 64 : n_dirty;
+    n_dirty = (n_dirty > wid->tableau->n_qubits) ? wid->tableau->n_qubits : n_dirty;
+
+    tableau_reset(wid->tableau, n_dirty);
+    memset(wid->queue->table, _I_, n_dirty);
+    memset(wid->queue->non_cliffords, 0x00, n_dirty * sizeof(non_clifford_tag_t));
+
+    for (size_t i = 0; i < wid->n_initial_qubits; i++)
+    {
+        wid->q_map[i] = i;
+    }
+
+    // The tracker does not expose a reset
+    pauli_tracker_destroy(wid->pauli_tracker);
+    wid->pauli_tracker = pauli_tracker_create(wid->max_qubits);
+
+    wid->n_qubits = wid->n_initial_qubits;
+}
+
+static widget_t* WIDGET_POOL[WIDGET_POOL_SIZE];
+static size_t WIDGET_POOL_N_WIDGETS = 0;
+static pthread_mutex_t WIDGET_POOL_LOCK = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * widget_pool_acquire
+ * Constructor for a widget that reuses a released widget with the same maximum qubits
+ * :: initial_qubits : const size_t :: Initial number of allocated qubits for the widget
+ * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated
+ * The most recently released widget is preferred
+ */
+widget_t* widget_pool_acquire(const size_t initial_qubits, const size_t max_qubits)
+{
+    widget_t* wid = NULL;
+
+    pthread_mutex_lock(&WIDGET_POOL_LOCK);
+    for (size_t i = WIDGET_POOL_N_WIDGETS; i > 0; i--)
+    {
+        if (max_qubits == WIDGET_POOL[i - 1]->max_qubits)
+        {
+            wid = WIDGET_POOL[i - 1];
+            WIDGET_POOL[i - 1] = WIDGET_POOL[--WIDGET_POOL_N_WIDGETS];
+            break;
+        }
+    }
+    pthread_mutex_unlock(&WIDGET_POOL_LOCK);
+
+    if (NULL == wid)
+    {
+        return widget_create(initial_qubits, max_qubits);
+    }
+
+    DPRINT(DEBUG_1, "Reusing widget with %zu qubits\n", wid->n_qubits);
+
+    // The map is reset over the new initial qubits
+    wid->n_initial_qubits = initial_qubits;
+    widget_reset(wid);
+    widget_reserve(wid, initial_qubits);
+    return wid;
+}
+
+/*
+ * widget_pool_release
+ * Returns a widget to the pool
+ * :: wid : widget_t* :: Widget, must not be used after release 
+ * The widget is cleared when it is next acquired
+ */
+void widget_pool_release(widget_t* wid)
+{
+    pthread_mutex_lock(&WIDGET_POOL_LOCK);
+    if (WIDGET_POOL_N_WIDGETS < WIDGET_POOL_SIZE)
+    {
+        WIDGET_POOL[WIDGET_POOL_N_WIDGETS++] = wid;
+        wid = NULL;
+    }
+    pthread_mutex_unlock(&WIDGET_POOL_LOCK);
+
+    if (NULL != wid)
+    {
+        widget_destroy(wid);
+    }
+}
+
+/*
+ * widget_pool_clear
+ * Destroys all widgets held by the pool
+ */
+void widget_pool_clear()
+{
+    pthread_mutex_lock(&WIDGET_POOL_LOCK);
+    for (size_t i = 0; i < WIDGET_POOL_N_WIDGETS; i++)
+    {
+        widget_destroy(WIDGET_POOL[i]);
+    }
+    WIDGET_POOL_N_WIDGETS = 0;
+    pthread_mutex_unlock(&WIDGET_POOL_LOCK);
+}
+
 uint8_t widget_get_clifford_from_table(widget_t* wid, size_t i) {
     return wid->queue->table[i];
 }
@@ -126,15 +266,49 @@ size_t* widget_get_io_map(const widget_t* wid)
     return map; 
 }
 
+/*
+ * widget_compact
+ * Re-strides the tableau to the allocated qubits
+ * :: wid : widget_t* :: Widget 
+ * Qubits past the allocated qubits have never been acted on, so they may be dropped 
+ * Interleaved tableaus are also moved to the planar layout required by the decomposition
+ */
+static inline
+void __inline_widget_compact(widget_t* wid)
+{
+    size_t n_qubits = wid->n_qubits + (!!(wid->n_qubits % 64)) * (64 - (wid->n_qubits % 64)); 
+    n_qubits = (n_qubits < 64) ? 64 : n_qubits;
+
+    if (n_qubits < wid->tableau->n_qubits)
+    {
+        tableau_compact(wid->tableau, n_qubits);
+    }
+    tableau_relayout(wid->tableau, TABLEAU_LAYOUT_PLANAR);
+}
+
 /*
  * widget_decompose
  * Decomposes the stabiliser tableau into a graph state plus local Cliffords 
  * :: wid : widget_t* :: Widget to decompose 
  * Acts in place on the tableau 
+ * The tableau is first compacted to the allocated qubits
  */
 void widget_decompose(widget_t* wid)
 {
-    simd_widget_decompose(wid);
+    __inline_widget_compact(wid);
+    SIMD_DISPATCH_g.widget_decompose(wid);
+}
+
+/*
+ * widget_decompose_m4ri
+ * Decomposes the stabiliser tableau into a graph state plus local Cliffords 
+ * :: wid : widget_t* :: Widget to decompose 
+ * Acts in place on the tableau 
+ */
+void widget_decompose_m4ri(widget_t* wid)
+{
+    __inline_widget_compact(wid);
+    SIMD_DISPATCH_g.widget_decompose_m4ri(wid);
 }
 
 void __widget_decompose(widget_t* wid)
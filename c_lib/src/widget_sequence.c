@@ -0,0 +1,398 @@
+#include "widget_sequence.h"
+
+#include <assert.h>
+#include <unistd.h>
+
+/*
+ * widget_sequence_split
+ * Splits an instruction stream on an Rz budget
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: rz_threshold : const size_t :: Maximum number of Rz gates in each block
+ * :: starts : size_t* :: Optional, set to the first instruction of each block followed by n_instructions
+ * Returns the number of blocks, called without starts to size the array
+ */
+size_t widget_sequence_split(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t rz_threshold,
+    size_t* starts)
+{
+    assert(rz_threshold > 0);
+
+    size_t n_blocks = 1;
+    size_t n_rz = 0;
+    if (NULL != starts)
+    {
+        starts[0] = 0;
+    }
+
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        if (INSTRUCTION_TYPE(instructions[i].instruction) != INSTRUCTION_TYPE(RZ_MASK))
+        {
+            continue;
+        }
+
+        // This Rz gate would exceed the budget of the current block
+        if (n_rz == rz_threshold)
+        {
+            if (NULL != starts)
+            {
+                starts[n_blocks] = i;
+            }
+            n_blocks++;
+            n_rz = 0;
+        }
+        n_rz++;
+    }
+
+    if (NULL != starts)
+    {
+        starts[n_blocks] = n_instructions;
+    }
+    return n_blocks;
+}
+
+
+/*
+ * widget_sequence_split_packed
+ * Splits a packed instruction stream on an Rz budget
+ * :: packed : const uint8_t* :: Packed instructions
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: rz_threshold : const size_t :: Maximum number of Rz gates in each block
+ * :: starts : size_t* :: Optional, set to the byte offset of each block followed by n_bytes
+ * Returns the number of blocks, called without starts to size the array
+ */
+size_t widget_sequence_split_packed(
+    const uint8_t* packed,
+    const size_t n_bytes,
+    const size_t rz_threshold,
+    size_t* starts)
+{
+    assert(rz_threshold > 0);
+
+    size_t n_blocks = 1;
+    size_t n_rz = 0;
+    if (NULL != starts)
+    {
+        starts[0] = 0;
+    }
+
+    size_t offset = 0;
+    while (offset < n_bytes)
+    {
+        const size_t len = instruction_packed_skip(packed + offset, n_bytes - offset, 1);
+        if (INSTRUCTION_TYPE(packed[offset]) == INSTRUCTION_TYPE(RZ_MASK))
+        {
+            if (n_rz == rz_threshold)
+            {
+                if (NULL != starts)
+                {
+                    starts[n_blocks] = offset;
+                }
+                n_blocks++;
+                n_rz = 0;
+            }
+            n_rz++;
+        }
+        offset += len;
+    }
+
+    if (NULL != starts)
+    {
+        starts[n_blocks] = n_bytes;
+    }
+    return n_blocks;
+}
+
+
+/*
+ * widget_sequence_compile
+ * Compile thread, claims widgets in order until the sequence is exhausted or destroyed
+ * :: arg : void* :: Sequence
+ * Blocks while the window is full, so at most window widgets are held at once
+ */
+static void* widget_sequence_compile(void* arg)
+{
+    widget_sequence_t* seq = (widget_sequence_t*)arg;
+
+    // Each widget is compiled serially, the threadpool is left to the consumer
+    threadpool_detach_thread(true);
+
+    for (;;)
+    {
+        pthread_mutex_lock(&seq->lock);
+        while (seq->alive
+            && (seq->next_compile < seq->n_widgets)
+            && (seq->next_compile >= seq->next_yield + seq->window))
+        {
+            pthread_cond_wait(&seq->space_cond, &seq->lock);
+        }
+
+        if (!seq->alive || (seq->next_compile >= seq->n_widgets))
+        {
+            pthread_mutex_unlock(&seq->lock);
+            break;
+        }
+
+        const size_t idx = seq->next_compile;
+        seq->next_compile++;
+        pthread_mutex_unlock(&seq->lock);
+
+        widget_t* wid = widget_pool_acquire(seq->qubit_width, seq->max_qubits);
+        teleport_input(wid, seq->qubit_width);
+        if (NULL != seq->packed)
+        {
+            parse_instruction_block_packed(
+                wid,
+                seq->packed + seq->starts[idx],
+                seq->starts[idx + 1] - seq->starts[idx]);
+        }
+        else
+        {
+            parse_instruction_block(
+                wid,
+                seq->instructions + seq->starts[idx],
+                seq->starts[idx + 1] - seq->starts[idx]);
+        }
+        widget_decompose(wid);
+
+        pthread_mutex_lock(&seq->lock);
+        seq->slots[idx % seq->window] = wid;
+        pthread_cond_broadcast(&seq->compiled_cond);
+        pthread_mutex_unlock(&seq->lock);
+    }
+
+    return NULL;
+}
+
+
+/*
+ * widget_sequence_start
+ * Sizes the window and starts the compile threads
+ * :: seq : widget_sequence_t* :: Sequence, with the stream already split
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer
+ */
+static void widget_sequence_start(
+    widget_sequence_t* seq,
+    const size_t n_threads,
+    const size_t window)
+{
+    seq->window = (window > 0) ? window : WIDGET_SEQUENCE_WINDOW;
+    seq->slots = (widget_t**)calloc(seq->window, sizeof(widget_t*));
+    seq->next_compile = 0;
+    seq->next_yield = 0;
+
+    // More threads than slots or widgets would never be able to claim work
+    size_t threads = n_threads;
+    if (0 == threads)
+    {
+        const long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (n_cores > 0) ? (size_t)n_cores : 1;
+    }
+    threads = (threads < seq->window) ? threads : seq->window;
+    threads = (threads < seq->n_widgets) ? threads : seq->n_widgets;
+    seq->n_threads = (threads > 0) ? threads : 1;
+
+    pthread_mutex_init(&seq->lock, NULL);
+    pthread_cond_init(&seq->compiled_cond, NULL);
+    pthread_cond_init(&seq->space_cond, NULL);
+    seq->alive = true;
+
+    seq->threads = (pthread_t*)malloc(seq->n_threads * sizeof(pthread_t));
+    for (size_t i = 0; i < seq->n_threads; i++)
+    {
+        const int err = pthread_create(seq->threads + i, NULL, widget_sequence_compile, seq);
+        assert(0 == err);
+    }
+}
+
+
+/*
+ * widget_sequence_create
+ * Starts compiling a sequence of widgets
+ * :: instructions : instruction_stream_u* :: Array of instructions, must outlive the sequence
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * :: qubit_width : const size_t :: Number of initial qubits in each widget
+ * :: max_qubits : const size_t :: Maximum number of qubits in each widget
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer
+ */
+widget_sequence_t* widget_sequence_create(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_threads,
+    const size_t window)
+{
+    assert(max_qubits > 2 * qubit_width);
+
+    widget_sequence_t* seq = (widget_sequence_t*)malloc(sizeof(widget_sequence_t));
+    seq->instructions = instructions;
+    seq->packed = NULL;
+    seq->qubit_width = qubit_width;
+    seq->max_qubits = max_qubits;
+
+    const size_t rz_threshold = max_qubits - 2 * qubit_width;
+    seq->n_widgets = widget_sequence_split(instructions, n_instructions, rz_threshold, NULL);
+    seq->starts = (size_t*)malloc((seq->n_widgets + 1) * sizeof(size_t));
+    widget_sequence_split(instructions, n_instructions, rz_threshold, seq->starts);
+
+    widget_sequence_start(seq, n_threads, window);
+    return seq;
+}
+
+
+/*
+ * widget_sequence_create_packed
+ * Starts compiling a sequence of widgets from a packed stream
+ * :: packed : const uint8_t* :: Packed instructions, must outlive the sequence
+ * :: n_bytes : const size_t :: Length of the packed stream
+ * :: qubit_width : const size_t :: Number of initial qubits in each widget
+ * :: max_qubits : const size_t :: Maximum number of qubits in each widget
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer
+ */
+widget_sequence_t* widget_sequence_create_packed(
+    const uint8_t* packed,
+    const size_t n_bytes,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_threads,
+    const size_t window)
+{
+    assert(max_qubits > 2 * qubit_width);
+
+    widget_sequence_t* seq = (widget_sequence_t*)malloc(sizeof(widget_sequence_t));
+    seq->instructions = NULL;
+    seq->packed = packed;
+    seq->qubit_width = qubit_width;
+    seq->max_qubits = max_qubits;
+
+    const size_t rz_threshold = max_qubits - 2 * qubit_width;
+    seq->n_widgets = widget_sequence_split_packed(packed, n_bytes, rz_threshold, NULL);
+    seq->starts = (size_t*)malloc((seq->n_widgets + 1) * sizeof(size_t));
+    widget_sequence_split_packed(packed, n_bytes, rz_threshold, seq->starts);
+
+    widget_sequence_start(seq, n_threads, window);
+    return seq;
+}
+
+
+/*
+ * widget_sequence_create_file
+ * Starts compiling a sequence of widgets from a mapped instruction file of either encoding
+ * :: file : const instruction_file_t* :: File, must outlive the sequence
+ * :: qubit_width : const size_t :: Number of initial qubits in each widget
+ * :: max_qubits : const size_t :: Maximum number of qubits in each widget
+ * :: n_threads : const size_t :: Number of compile threads, zero uses the number of online cores
+ * :: window : const size_t :: Maximum number of compiled widgets held for the consumer
+ */
+widget_sequence_t* widget_sequence_create_file(
+    const instruction_file_t* file,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_threads,
+    const size_t window)
+{
+    if (INSTRUCTION_FILE_PACKED == instruction_file_get_encoding(file))
+    {
+        return widget_sequence_create_packed(
+            instruction_file_get_data(file),
+            instruction_file_get_n_bytes(file),
+            qubit_width,
+            max_qubits,
+            n_threads,
+            window);
+    }
+
+    // Widgets only read the instructions, the mapping is read only
+    return widget_sequence_create(
+        (instruction_stream_u*)instruction_file_get_instructions(file),
+        instruction_file_get_n_instructions(file),
+        qubit_width,
+        max_qubits,
+        n_threads,
+        window);
+}
+
+
+/*
+ * widget_sequence_get_n_widgets
+ * Returns the number of widgets in the sequence
+ * :: seq : const widget_sequence_t* :: Sequence
+ */
+size_t widget_sequence_get_n_widgets(const widget_sequence_t* seq)
+{
+    return seq->n_widgets;
+}
+
+
+/*
+ * widget_sequence_next
+ * Returns the next widget in the sequence, blocking until it has been compiled
+ * :: seq : widget_sequence_t* :: Sequence
+ * Returns NULL once every widget has been returned
+ */
+widget_t* widget_sequence_next(widget_sequence_t* seq)
+{
+    pthread_mutex_lock(&seq->lock);
+    if (seq->next_yield >= seq->n_widgets)
+    {
+        pthread_mutex_unlock(&seq->lock);
+        return NULL;
+    }
+
+    const size_t slot = seq->next_yield % seq->window;
+    while (NULL == seq->slots[slot])
+    {
+        pthread_cond_wait(&seq->compiled_cond, &seq->lock);
+    }
+
+    widget_t* wid = seq->slots[slot];
+    seq->slots[slot] = NULL;
+    seq->next_yield++;
+    pthread_cond_broadcast(&seq->space_cond);
+    pthread_mutex_unlock(&seq->lock);
+
+    return wid;
+}
+
+
+/*
+ * widget_sequence_destroy
+ * Stops the compile threads and frees the sequence
+ * :: seq : widget_sequence_t* :: Sequence
+ */
+void widget_sequence_destroy(widget_sequence_t* seq)
+{
+    pthread_mutex_lock(&seq->lock);
+    seq->alive = false;
+    pthread_cond_broadcast(&seq->space_cond);
+    pthread_mutex_unlock(&seq->lock);
+
+    // Widgets already claimed are completed before the threads exit
+    for (size_t i = 0; i < seq->n_threads; i++)
+    {
+        pthread_join(seq->threads[i], NULL);
+    }
+
+    for (size_t i = 0; i < seq->window; i++)
+    {
+        if (NULL != seq->slots[i])
+        {
+            widget_pool_release(seq->slots[i]);
+        }
+    }
+
+    pthread_cond_destroy(&seq->compiled_cond);
+    pthread_cond_destroy(&seq->space_cond);
+    pthread_mutex_destroy(&seq->lock);
+    free(seq->threads);
+    free(seq->slots);
+    free(seq->starts);
+    free(seq);
+}
@@ -2,7 +2,9 @@
 #define TEST_TABLEAU_H
 
 #include "tableau.h"
+#include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 /*
  * Creates a random bitmatrix
@@ -47,6 +49,23 @@ tableau_t* tableau_copy(tableau_t* const tab)
     return tab_cpy;
 }
 
+/*
+ * assert_tableau_equal
+ * Compares the slices and phases of two tableaus byte for byte
+ * :: tab_a : tableau_t* :: First tableau
+ * :: tab_b : tableau_t* :: Second tableau
+ */
+void assert_tableau_equal(tableau_t* tab_a, tableau_t* tab_b)
+{
+    assert(tab_a->slice_len == tab_b->slice_len);
+    for (size_t i = 0; i < tab_a->n_qubits; i++)
+    {
+        assert(0 == memcmp(tab_a->slices_x[i], tab_b->slices_x[i], tab_a->slice_len));
+        assert(0 == memcmp(tab_a->slices_z[i], tab_b->slices_z[i], tab_a->slice_len));
+    }
+    assert(0 == memcmp(tab_a->phases, tab_b->phases, tab_a->slice_len));
+}
+
 void test_tableau_print(uint64_t** arr_a, const size_t n_channels, const size_t x_offset, const size_t y_offset_bytes, const size_t y_offset_bits)
 {
     for (size_t i = 0; i < n_channels; i++)
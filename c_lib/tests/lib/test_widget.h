@@ -0,0 +1,84 @@
+#ifndef TEST_WIDGET_H
+#define TEST_WIDGET_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "instruction_table.h"
+#include "widget.h"
+
+/*
+ * random_stream_mix
+ * Random stream of local Cliffords, two qubit gates and Rz gates
+ * :: n_qubits : const size_t :: Number of qubits, at least two
+ * :: n_gates : const size_t :: Number of gates
+ * :: rz_period : const size_t :: On average one gate in rz_period is an Rz gate,
+ *  the rest are split evenly between two qubit gates and local Cliffords
+ * :: swaps : const bool :: Half of the two qubit gates are swaps
+ * Rz tags are the index of the gate
+ */
+instruction_stream_u* random_stream_mix(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const size_t rz_period,
+    const bool swaps)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)calloc(n_gates, sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        if (0 == rand() % rz_period)
+        {
+            inst[i].rz.opcode = _RZ_;
+            inst[i].rz.arg = ctrl;
+            inst[i].rz.tag = i;
+        }
+        else if (rand() % 2)
+        {
+            inst[i].multi.opcode = (swaps && (rand() % 2)) ? _SWAP_ : ((rand() % 2) ? _CNOT_ : _CZ_);
+            inst[i].multi.ctrl = ctrl;
+            inst[i].multi.targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        }
+        else
+        {
+            inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % 7);
+            inst[i].single.arg = ctrl;
+        }
+    }
+    return inst;
+}
+
+/*
+ * random_stream
+ * Random stream of local Cliffords, two qubit gates and Rz gates in equal proportion
+ * :: n_qubits : const size_t :: Number of qubits, at least two
+ * :: n_gates : const size_t :: Number of gates
+ */
+instruction_stream_u* random_stream(const size_t n_qubits, const size_t n_gates)
+{
+    return random_stream_mix(n_qubits, n_gates, 3, false);
+}
+
+/*
+ * assert_widget_equal
+ * Compares the tableaus, phases, queued local Cliffords and non-Clifford tags of two widgets
+ * The qubit maps are not compared
+ */
+void assert_widget_equal(widget_t* wid_a, widget_t* wid_b)
+{
+    assert(wid_a->n_qubits == wid_b->n_qubits);
+    for (size_t i = 0; i < wid_a->n_qubits; i++)
+    {
+        for (size_t j = 0; j < wid_a->n_qubits; j++)
+        {
+            assert(slice_get_bit(wid_a->tableau->slices_x[i], j) == slice_get_bit(wid_b->tableau->slices_x[i], j));
+            assert(slice_get_bit(wid_a->tableau->slices_z[i], j) == slice_get_bit(wid_b->tableau->slices_z[i], j));
+        }
+        assert(slice_get_bit(wid_a->tableau->phases, i) == slice_get_bit(wid_b->tableau->phases, i));
+        assert(wid_a->queue->table[i] == wid_b->queue->table[i]);
+        assert(wid_a->queue->non_cliffords[i] == wid_b->queue->non_cliffords[i]);
+    }
+}
+
+#endif
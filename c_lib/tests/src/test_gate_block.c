@@ -0,0 +1,106 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "gate_block.h"
+#include "instructions.h"
+
+#include "test_tableau.h"
+
+/*
+ * test_gate_block
+ * Applying a block one tile at a time should match applying each gate in turn
+ */
+void test_gate_block(const size_t n_qubits, const size_t n_gates)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_block = tableau_copy(tab);
+    gate_block_t block;
+    block.n_ops = 0;
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        const instruction_t ctrl_clifford = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORDS);
+        const instruction_t targ_clifford = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORDS);
+        const instruction_t opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORDS);
+
+        tableau_fused(tab, ctrl, targ, ctrl_clifford, targ_clifford, opcode);
+        gate_block_push(tab_block, &block, ctrl, targ, ctrl_clifford, targ_clifford, opcode);
+    }
+    gate_block_flush(tab_block, &block);
+    assert(0 == block.n_ops);
+
+    assert_tableau_equal(tab, tab_block);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_block);
+}
+
+/*
+ * test_parse_instruction_block_tiled
+ * Compares the tiled parser against the serial parser
+ */
+void test_parse_instruction_block_tiled(const size_t n_qubits, const size_t n_gates)
+{
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits);
+    widget_t* wid_tiled = widget_create(n_qubits, 2 * n_qubits);
+
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        switch (rand() % 4)
+        {
+            case 0:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = i;
+                break;
+            case 1:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+        }
+    }
+
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(wid);
+
+    parse_instruction_block_tiled(wid_tiled, inst, n_gates);
+    apply_local_cliffords(wid_tiled);
+
+    assert(wid->n_qubits == wid_tiled->n_qubits);
+    assert_tableau_equal(wid->tableau, wid_tiled->tableau);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(wid->q_map[i] == wid_tiled->q_map[i]);
+        assert(wid->queue->non_cliffords[i] == wid_tiled->queue->non_cliffords[i]);
+    }
+
+    free(inst);
+    widget_destroy(wid);
+    widget_destroy(wid_tiled);
+}
+
+int main()
+{
+    srand(0);
+
+    // Includes tableaus with slices both shorter and longer than a tile
+    for (size_t n_qubits = 64; n_qubits <= 32 * GATE_BLOCK_TILE_BYTES; n_qubits *= 4)
+    {
+        test_gate_block(n_qubits, 3 * GATE_BLOCK_SIZE + 7);
+        test_parse_instruction_block_tiled(n_qubits, 2 * n_qubits);
+    }
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "instruction_file.h"
+
+#include "test_widget.h"
+
+/*
+ * random_stream_counted
+ * Random stream of local Cliffords, two qubit gates and occasional Rz gates
+ * :: n_rz : size_t* :: Set to the number of Rz gates in the stream
+ * :: n_qubits_used : size_t* :: Set to one more than the largest qubit index in the stream
+ */
+instruction_stream_u* random_stream_counted(const size_t n_qubits, const size_t n_gates, size_t* n_rz, size_t* n_qubits_used)
+{
+    instruction_stream_u* inst = random_stream_mix(n_qubits, n_gates, 64, false);
+    *n_rz = 0;
+    *n_qubits_used = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        size_t max_qubit = inst[i].multi.ctrl;
+        if (INSTRUCTION_TYPE(RZ_MASK) == INSTRUCTION_TYPE(inst[i].instruction))
+        {
+            (*n_rz)++;
+        }
+        else if ((INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK) == INSTRUCTION_TYPE(inst[i].instruction)) && (inst[i].multi.targ > max_qubit))
+        {
+            max_qubit = inst[i].multi.targ;
+        }
+        *n_qubits_used = (max_qubit + 1 > *n_qubits_used) ? max_qubit + 1 : *n_qubits_used;
+    }
+    return inst;
+}
+
+/*
+ * assert_stream_equal
+ * Compares the instructions of a file against an array
+ */
+void assert_stream_equal(instruction_file_t* file, instruction_stream_u* inst, const size_t n_gates)
+{
+    if (INSTRUCTION_FILE_FIXED == instruction_file_get_encoding(file))
+    {
+        assert(n_gates * sizeof(instruction_stream_u) == instruction_file_get_n_bytes(file));
+        assert(0 == memcmp(inst, instruction_file_get_instructions(file), n_gates * sizeof(instruction_stream_u)));
+        return;
+    }
+
+    assert(NULL == instruction_file_get_instructions(file));
+    instruction_stream_u* unpacked = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * (n_gates + 1));
+    size_t n_read = 0;
+    assert(n_gates == instruction_unpack(
+        instruction_file_get_data(file), instruction_file_get_n_bytes(file), unpacked, n_gates + 1, &n_read));
+    assert(n_read == instruction_file_get_n_bytes(file));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        assert(inst[i].multi.opcode == unpacked[i].multi.opcode);
+        assert(inst[i].multi.ctrl == unpacked[i].multi.ctrl);
+        assert((LOCAL_CLIFFORD_MASK == (inst[i].instruction & INSTRUCTION_TYPE_MASK)) || (inst[i].multi.targ == unpacked[i].multi.targ));
+    }
+    free(unpacked);
+}
+
+/*
+ * test_instruction_file
+ * Writes a stream in pieces, maps it, and compares parsing the mapping against parsing the array
+ * :: n_pieces : const size_t :: Number of appends used to write the stream
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding of the stream
+ */
+void test_instruction_file(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const size_t n_pieces,
+    const enum instruction_file_encoding_e encoding)
+{
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    size_t n_rz = 0;
+    size_t n_qubits_used = 0;
+    instruction_stream_u* inst = random_stream_counted(n_qubits, n_gates, &n_rz, &n_qubits_used);
+
+    instruction_file_writer_t* writer = instruction_file_writer_open(path, encoding);
+    assert(NULL != writer);
+    for (size_t i = 0; i < n_pieces; i++)
+    {
+        const size_t start = (i * n_gates) / n_pieces;
+        const size_t stop = ((i + 1) * n_gates) / n_pieces;
+        assert(instruction_file_writer_append(writer, inst + start, stop - start));
+    }
+    assert(instruction_file_writer_close(writer));
+
+    instruction_file_t* file = instruction_file_open(path);
+    assert(NULL != file);
+    assert(n_gates == instruction_file_get_n_instructions(file));
+    assert(n_rz == instruction_file_get_n_rz(file));
+    assert(n_qubits_used == instruction_file_get_n_qubits(file));
+    assert(encoding == instruction_file_get_encoding(file));
+    assert_stream_equal(file, inst, n_gates);
+
+    const size_t max_qubits = 2 * n_qubits + n_rz;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_file = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_file, n_qubits);
+
+    // Parsed in three ranges, the last rewinds the stream
+    const size_t split = n_gates / 3;
+    parse_instruction_block(wid, inst, split);
+    parse_instruction_block(wid, inst + 2 * split, n_gates - 2 * split);
+    parse_instruction_block(wid, inst + split, split);
+    assert(instruction_file_parse(wid_file, file, 0, split));
+    assert(instruction_file_parse(wid_file, file, 2 * split, n_gates - 2 * split));
+    assert(instruction_file_parse(wid_file, file, split, split));
+
+    // Pages that were released are read back from the file
+    assert_stream_equal(file, inst, n_gates);
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_file);
+    assert_widget_equal(wid, wid_file);
+
+    widget_destroy(wid);
+    widget_destroy(wid_file);
+    instruction_file_close(file);
+    free(inst);
+    unlink(path);
+}
+
+/*
+ * test_instruction_file_invalid
+ * Files that are not streams, or are truncated, are not mapped
+ */
+void test_instruction_file_invalid()
+{
+    assert(NULL == instruction_file_open("/tmp/test_instruction_file_does_not_exist"));
+
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    // Empty file
+    assert(NULL == instruction_file_open(path));
+
+    // Truncated stream
+    size_t n_rz = 0;
+    size_t n_qubits_used = 0;
+    instruction_stream_u* inst = random_stream_counted(8, 128, &n_rz, &n_qubits_used);
+    assert(instruction_file_write(path, inst, 128, INSTRUCTION_FILE_FIXED));
+    assert(0 == truncate(path, INSTRUCTION_FILE_HEADER_BYTES + 127 * sizeof(instruction_stream_u)));
+    assert(NULL == instruction_file_open(path));
+
+    // Truncated packed stream
+    assert(instruction_file_write(path, inst, 128, INSTRUCTION_FILE_PACKED));
+    instruction_file_t* file = instruction_file_open(path);
+    const size_t n_bytes = instruction_file_get_n_bytes(file);
+    instruction_file_close(file);
+    assert(0 == truncate(path, INSTRUCTION_FILE_HEADER_BYTES + n_bytes - 1));
+    assert(NULL == instruction_file_open(path));
+
+    // Packed stream whose last operand runs past the end of the body
+    assert(instruction_file_write(path, inst, 128, INSTRUCTION_FILE_PACKED));
+    FILE* fp = fopen(path, "r+b");
+    fseek(fp, INSTRUCTION_FILE_HEADER_BYTES + n_bytes - 1, SEEK_SET);
+    fputc(0x80, fp);
+    fclose(fp);
+    assert(NULL == instruction_file_open(path));
+
+    // Packed stream holding more instructions than its header
+    assert(instruction_file_write(path, inst, 128, INSTRUCTION_FILE_PACKED));
+    const uint64_t n_short = 127;
+    fp = fopen(path, "r+b");
+    fseek(fp, offsetof(instruction_file_header_t, n_instructions), SEEK_SET);
+    fwrite(&n_short, sizeof(n_short), 1, fp);
+    fclose(fp);
+    assert(NULL == instruction_file_open(path));
+
+    // Bad magic
+    assert(instruction_file_write(path, inst, 128, INSTRUCTION_FILE_FIXED));
+    fp = fopen(path, "r+b");
+    fputc('X', fp);
+    fclose(fp);
+    assert(NULL == instruction_file_open(path));
+
+    // Instruction count whose length in bytes wraps around to the length of the stream
+    assert(instruction_file_write(path, inst, 128, INSTRUCTION_FILE_FIXED));
+    const uint64_t n_wrapped = 128 + (1ull << 62);
+    assert(128 * sizeof(instruction_stream_u) == n_wrapped * sizeof(instruction_stream_u));
+    fp = fopen(path, "r+b");
+    fseek(fp, offsetof(instruction_file_header_t, n_instructions), SEEK_SET);
+    fwrite(&n_wrapped, sizeof(n_wrapped), 1, fp);
+    fclose(fp);
+    assert(NULL == instruction_file_open(path));
+
+    free(inst);
+    unlink(path);
+}
+
+int main()
+{
+    assert(INSTRUCTION_FILE_HEADER_BYTES == sizeof(instruction_file_header_t));
+
+    for (uint8_t encoding = INSTRUCTION_FILE_FIXED; encoding <= INSTRUCTION_FILE_PACKED; encoding++)
+    {
+        test_instruction_file(8, 0, 1, encoding);
+        test_instruction_file(8, 1000, 1, encoding);
+        test_instruction_file(64, 4 * INSTRUCTION_FILE_CHUNK + 17, 1, encoding);
+        test_instruction_file(300, 3 * INSTRUCTION_FILE_CHUNK, 7, encoding);
+    }
+    test_instruction_file_invalid();
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "instruction_packed.h"
+#include "threadpool.h"
+
+#include "test_widget.h"
+
+void assert_instruction_equal(const instruction_stream_u* a, const instruction_stream_u* b)
+{
+    assert(a->multi.opcode == b->multi.opcode);
+    assert(a->multi.ctrl == b->multi.ctrl);
+    assert(a->multi.targ == b->multi.targ);
+}
+
+/*
+ * test_varint
+ * Round trips varints across each length
+ */
+void test_varint()
+{
+    const uint32_t values[] = {0, 1, 127, 128, 16383, 16384, (1u << 21) - 1, 1u << 21, (1u << 28) - 1, 1u << 28, 0xffffffff};
+    uint8_t buf[8];
+    for (size_t i = 0; i < sizeof(values) / sizeof(uint32_t); i++)
+    {
+        const size_t n_bytes = __inline_instruction_pack_varint(values[i], buf);
+        assert(n_bytes <= 5);
+
+        uint32_t value = 0;
+        assert(n_bytes == __inline_instruction_unpack_varint(buf, buf + n_bytes, &value));
+        assert(values[i] == value);
+
+        // Truncated varints are not decoded
+        assert(0 == __inline_instruction_unpack_varint(buf, buf + n_bytes - 1, &value));
+    }
+}
+
+/*
+ * test_pack
+ * Round trips a stream, and checks the packed size and the skip offsets
+ */
+void test_pack(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+    uint8_t* buf = (uint8_t*)malloc(instruction_packed_bound(n_gates) + 1);
+
+    // Tags span the full range of the varints
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        if (_RZ_ == inst[i].instruction)
+        {
+            inst[i].rz.tag = rand();
+        }
+    }
+
+    const size_t n_bytes = instruction_pack(inst, n_gates, buf);
+    assert(n_bytes <= instruction_packed_bound(n_gates));
+    assert(n_bytes >= 2 * n_gates);
+
+    instruction_stream_u* unpacked = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * (n_gates + 1));
+    size_t n_read = 0;
+    assert(n_gates == instruction_unpack(buf, n_bytes, unpacked, n_gates + 1, &n_read));
+    assert(n_bytes == n_read);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        assert_instruction_equal(inst + i, unpacked + i);
+    }
+
+    // Skipping and partial unpacking agree
+    for (size_t j = 0; j < 16; j++)
+    {
+        const size_t skip = (n_gates > 0) ? rand() % n_gates : 0;
+        const size_t offset = instruction_packed_skip(buf, n_bytes, skip);
+        assert(instruction_unpack(buf, n_bytes, unpacked, skip, &n_read) == skip);
+        assert(offset == n_read);
+    }
+    assert(n_bytes == instruction_packed_skip(buf, n_bytes, n_gates + 1));
+
+    // A truncated final instruction is not consumed
+    if (n_gates > 0)
+    {
+        const size_t last = instruction_packed_skip(buf, n_bytes, n_gates - 1);
+        assert(n_gates - 1 == instruction_unpack(buf, n_bytes - 1, unpacked, n_gates + 1, &n_read));
+        assert(last == n_read);
+    }
+
+    free(unpacked);
+    free(buf);
+    free(inst);
+}
+
+/*
+ * test_parse_packed
+ * Compares parsing a packed stream against parsing the fixed stream
+ * :: n_workers : const size_t :: Threadpool workers, zero leaves the threadpool uninitialised
+ */
+void test_parse_packed(const size_t n_qubits, const size_t n_gates, const size_t n_workers)
+{
+    if (n_workers > 0)
+    {
+        threadpool_init(n_workers);
+    }
+
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+    uint8_t* buf = (uint8_t*)malloc(instruction_packed_bound(n_gates));
+    const size_t n_bytes = instruction_pack(inst, n_gates, buf);
+
+    const size_t max_qubits = 2 * n_qubits + n_gates;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_packed = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_packed, n_qubits);
+
+    parse_instruction_block(wid, inst, n_gates);
+    assert(n_gates == parse_instruction_block_packed(wid_packed, buf, n_bytes));
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_packed);
+    assert_widget_equal(wid, wid_packed);
+
+    widget_decompose(wid);
+    widget_decompose(wid_packed);
+    assert_widget_equal(wid, wid_packed);
+
+    widget_destroy(wid);
+    widget_destroy(wid_packed);
+    free(buf);
+    free(inst);
+
+    if (n_workers > 0)
+    {
+        threadpool_destroy();
+    }
+}
+
+int main()
+{
+    test_varint();
+
+    test_pack(8, 0);
+    test_pack(8, 1000);
+    test_pack(1 << 10, 1 << 14);
+    test_pack(1 << 20, 1 << 14);
+
+    test_parse_packed(16, 256, 0);
+    test_parse_packed(200, 2 * INSTRUCTION_PACKED_DECODE_BLOCK + 3, 0);
+    test_parse_packed(200, 2 * INSTRUCTION_PACKED_DECODE_BLOCK + 3, 3);
+    test_parse_packed(200, INSTRUCTION_PACKED_DECODE_BLOCK, 4);
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "instruction_packed.h"
+#include "instruction_ring.h"
+#include "threadpool.h"
+
+#include "test_widget.h"
+
+/*
+ * test_ring_push_pop
+ * Single threaded pushes and pops that wrap around the end of the ring
+ */
+void test_ring_push_pop()
+{
+    instruction_ring_t* ring = instruction_ring_create(5);
+    assert(8 == instruction_ring_get_capacity(ring));
+
+    instruction_stream_u* inst = random_stream(4, 64);
+    instruction_stream_u out[8];
+
+    // Pushes stop when the ring is full
+    assert(8 == instruction_ring_try_push(ring, inst, 10));
+    assert(0 == instruction_ring_try_push(ring, inst + 8, 2));
+    assert(3 == instruction_ring_try_pop(ring, out, 3));
+    assert(0 == memcmp(out, inst, sizeof(instruction_stream_u) * 3));
+
+    // Runs of pushes and pops across the end of the buffer
+    size_t n_pushed = 8;
+    size_t n_popped = 3;
+    while (n_popped < 64)
+    {
+        n_pushed += instruction_ring_try_push(ring, inst + n_pushed, (n_pushed < 59) ? 5 : 64 - n_pushed);
+        const size_t n_pop = instruction_ring_try_pop(ring, out, 1 + rand() % 8);
+        assert(0 == memcmp(out, inst + n_popped, sizeof(instruction_stream_u) * n_pop));
+        n_popped += n_pop;
+        assert(n_popped <= n_pushed);
+    }
+    assert(0 == instruction_ring_try_pop(ring, out, 8));
+
+    free(inst);
+    instruction_ring_destroy(ring);
+}
+
+struct producer_args_t
+{
+    instruction_ring_t* ring;
+    instruction_stream_u* inst;
+    size_t n_gates;
+};
+
+/*
+ * produce
+ * Pushes a stream in random batch sizes and closes the ring
+ */
+void* produce(void* arg)
+{
+    struct producer_args_t* args = (struct producer_args_t*)arg;
+    size_t n_pushed = 0;
+    while (n_pushed < args->n_gates)
+    {
+        size_t n_push = 1 + rand() % 300;
+        n_push = (n_push < args->n_gates - n_pushed) ? n_push : args->n_gates - n_pushed;
+        instruction_ring_push(args->ring, args->inst + n_pushed, n_push);
+        n_pushed += n_push;
+    }
+    instruction_ring_close(args->ring);
+    return NULL;
+}
+
+/*
+ * test_parse_ring
+ * Compares parsing from a ring filled by a producer thread against parsing the stream directly
+ * :: capacity : const size_t :: Capacity of the ring, smaller than the stream to force wrapping
+ * :: n_workers : const size_t :: Threadpool workers, zero leaves the threadpool uninitialised
+ */
+void test_parse_ring(const size_t n_qubits, const size_t n_gates, const size_t capacity, const size_t n_workers)
+{
+    if (n_workers > 0)
+    {
+        threadpool_init(n_workers);
+    }
+
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+    const size_t max_qubits = 2 * n_qubits + n_gates;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_ring = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_ring, n_qubits);
+
+    parse_instruction_block(wid, inst, n_gates);
+
+    instruction_ring_t* ring = instruction_ring_create(capacity);
+    struct producer_args_t args = {ring, inst, n_gates};
+    pthread_t producer;
+    assert(0 == pthread_create(&producer, NULL, produce, &args));
+    assert(n_gates == parse_instruction_ring(wid_ring, ring));
+    pthread_join(producer, NULL);
+    instruction_ring_destroy(ring);
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_ring);
+    assert_widget_equal(wid, wid_ring);
+
+    widget_destroy(wid);
+    widget_destroy(wid_ring);
+    free(inst);
+
+    if (n_workers > 0)
+    {
+        threadpool_destroy();
+    }
+}
+
+struct pipe_writer_args_t
+{
+    int fd;
+    const uint8_t* buf;
+    size_t n_bytes;
+};
+
+/*
+ * write_pipe
+ * Writes a buffer to a pipe in uneven pieces and closes it
+ */
+void* write_pipe(void* arg)
+{
+    struct pipe_writer_args_t* args = (struct pipe_writer_args_t*)arg;
+    size_t n_written = 0;
+    while (n_written < args->n_bytes)
+    {
+        size_t n_write = 1 + rand() % 1000;
+        n_write = (n_write < args->n_bytes - n_written) ? n_write : args->n_bytes - n_written;
+        const ssize_t res = write(args->fd, args->buf + n_written, n_write);
+        assert(res > 0);
+        n_written += res;
+    }
+    close(args->fd);
+    return NULL;
+}
+
+/*
+ * test_ring_reader
+ * Streams a raw instruction stream through a pipe into a widget
+ * :: encoding : const enum instruction_file_encoding_e :: Encoding written to the pipe
+ * :: truncate : const bool :: Drops the final byte of the stream
+ */
+void test_ring_reader(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const enum instruction_file_encoding_e encoding,
+    const bool truncate)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+
+    uint8_t* buf = (uint8_t*)inst;
+    size_t n_bytes = sizeof(instruction_stream_u) * n_gates;
+    if (INSTRUCTION_FILE_PACKED == encoding)
+    {
+        buf = (uint8_t*)malloc(instruction_packed_bound(n_gates));
+        n_bytes = instruction_pack(inst, n_gates, buf);
+    }
+
+    const size_t max_qubits = 2 * n_qubits + n_gates;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_ring = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_ring, n_qubits);
+
+    // A truncated final instruction is never pushed
+    const size_t n_expected = truncate ? n_gates - 1 : n_gates;
+    parse_instruction_block(wid, inst, n_expected);
+
+    int fds[2];
+    assert(0 == pipe(fds));
+    struct pipe_writer_args_t args = {fds[1], buf, truncate ? n_bytes - 1 : n_bytes};
+    pthread_t writer;
+    assert(0 == pthread_create(&writer, NULL, write_pipe, &args));
+
+    instruction_ring_t* ring = instruction_ring_create(256);
+    instruction_ring_reader_t* reader = instruction_ring_reader_start(ring, fds[0], encoding);
+    assert(NULL != reader);
+    assert(n_expected == parse_instruction_ring(wid_ring, ring));
+    assert(!truncate == instruction_ring_reader_join(reader));
+    pthread_join(writer, NULL);
+    close(fds[0]);
+    instruction_ring_destroy(ring);
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_ring);
+    assert_widget_equal(wid, wid_ring);
+
+    widget_destroy(wid);
+    widget_destroy(wid_ring);
+    if (INSTRUCTION_FILE_PACKED == encoding)
+    {
+        free(buf);
+    }
+    free(inst);
+}
+
+int main()
+{
+    test_ring_push_pop();
+
+    test_parse_ring(16, 0, 8, 0);
+    test_parse_ring(16, 1000, 8, 0);
+    test_parse_ring(100, 10000, 1000, 0);
+    test_parse_ring(100, 10000, 64, 3);
+
+    test_ring_reader(32, 5000, INSTRUCTION_FILE_FIXED, false);
+    test_ring_reader(32, 5000, INSTRUCTION_FILE_PACKED, false);
+    test_ring_reader(200, 20000, INSTRUCTION_FILE_PACKED, false);
+    test_ring_reader(32, 100, INSTRUCTION_FILE_FIXED, true);
+    test_ring_reader(32, 100, INSTRUCTION_FILE_PACKED, true);
+    return 0;
+}
@@ -0,0 +1,498 @@
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "peephole.h"
+#include "rz_tag.h"
+
+#include "test_widget.h"
+
+#define PI (3.14159265358979323846)
+
+/*
+ * random_redundant_stream
+ * Random stream over few qubits and few gates, so that cancelling patterns are common
+ * Local Cliffords are drawn from all 24, including the composite Cliffords
+ * Two qubit gates include swaps
+ * :: rz : const bool :: Includes Rz gates, with tags of single precision multiples of pi / 8
+ * :: conditionals : const bool :: Includes occasional measurements and conditional Paulis, which act as barriers
+ */
+instruction_stream_u* random_redundant_stream(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const bool rz,
+    const bool conditionals)
+{
+    static const instruction_t two_qubit[3] = {_CNOT_, _CZ_, _SWAP_};
+    static const instruction_t conditional_ops[4] = {_MEAS_, _MCX_, _MCY_, _MCZ_};
+    instruction_stream_u* inst = (instruction_stream_u*)calloc(n_gates, sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        if (conditionals && (0 == rand() % 64))
+        {
+            inst[i].cond.opcode = conditional_ops[rand() % 4];
+            inst[i].cond.ctrl = ctrl;
+            inst[i].cond.targ = (_MEAS_ == inst[i].cond.opcode) ? ctrl : targ;
+            continue;
+        }
+
+        switch (rand() % (rz ? 3 : 2))
+        {
+            case 0:
+                inst[i].multi.opcode = two_qubit[rand() % 3];
+                inst[i].multi.ctrl = ctrl;
+                inst[i].multi.targ = targ;
+                break;
+            case 1:
+                // Gate Cliffords are drawn as often as composites, so that H CNOT H patterns are common
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | ((rand() % 2) ? (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS) : (rand() % N_LOCAL_CLIFFORDS));
+                inst[i].single.arg = ctrl;
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = ctrl;
+                inst[i].rz.tag = __inline_rz_angle_to_tag((1 + rand() % 15) * PI / 8);
+                break;
+        }
+    }
+    return inst;
+}
+
+/*
+ * stream helpers
+ */
+void local(instruction_stream_u* inst, const instruction_t opcode, const uint32_t arg)
+{
+    memset(inst, 0, sizeof(instruction_stream_u));
+    inst->single.opcode = opcode;
+    inst->single.arg = arg;
+}
+
+void two(instruction_stream_u* inst, const instruction_t opcode, const uint32_t ctrl, const uint32_t targ)
+{
+    memset(inst, 0, sizeof(instruction_stream_u));
+    inst->multi.opcode = opcode;
+    inst->multi.ctrl = ctrl;
+    inst->multi.targ = targ;
+}
+
+void rz(instruction_stream_u* inst, const uint32_t arg, const double angle)
+{
+    memset(inst, 0, sizeof(instruction_stream_u));
+    inst->rz.opcode = _RZ_;
+    inst->rz.arg = arg;
+    inst->rz.tag = __inline_rz_angle_to_tag(angle);
+}
+
+/*
+ * test_patterns
+ * Checks the optimised stream of each pattern
+ */
+void test_patterns()
+{
+    instruction_stream_u inst[8];
+
+    // Adjacent pairs cancel, including nested pairs
+    two(inst, _CNOT_, 0, 1);
+    two(inst + 1, _CZ_, 0, 1);
+    two(inst + 2, _CZ_, 1, 0);
+    two(inst + 3, _CNOT_, 0, 1);
+    assert(0 == peephole_optimise(inst, 4, false));
+
+    // Gates on other qubits do not block cancellation
+    two(inst, _CNOT_, 0, 1);
+    local(inst + 1, _H_, 2);
+    two(inst + 2, _CZ_, 2, 3);
+    two(inst + 3, _CNOT_, 0, 1);
+    assert(2 == peephole_optimise(inst, 4, false));
+    assert(_H_ == inst[0].instruction);
+    assert(_CZ_ == inst[1].instruction);
+
+    // Reversed CNOTs and intervening gates on an operand block cancellation
+    two(inst, _CNOT_, 0, 1);
+    two(inst + 1, _CNOT_, 1, 0);
+    local(inst + 2, _H_, 0);
+    two(inst + 3, _CNOT_, 1, 0);
+    assert(4 == peephole_optimise(inst, 4, false));
+
+    // Inverse local Cliffords and identities
+    local(inst, _S_, 0);
+    local(inst + 1, _I_, 0);
+    local(inst + 2, _R_, 0);
+    two(inst + 3, _CZ_, 0, 1);
+    local(inst + 4, _X_, 0);
+    local(inst + 5, _X_, 0);
+    two(inst + 6, _CZ_, 0, 1);
+    assert(0 == peephole_optimise(inst, 7, false));
+
+    // H(b) CNOT(a, b) H(b) -> CZ(a, b)
+    local(inst, _H_, 1);
+    local(inst + 1, _S_, 0);
+    two(inst + 2, _CNOT_, 0, 1);
+    local(inst + 3, _H_, 1);
+    assert(2 == peephole_optimise(inst, 4, false));
+    assert(_S_ == inst[0].instruction);
+    assert(_CZ_ == inst[1].instruction);
+    assert((0 == inst[1].multi.ctrl) && (1 == inst[1].multi.targ));
+
+    // Hadamards on the control are not rewritten
+    local(inst, _H_, 0);
+    two(inst + 1, _CNOT_, 0, 1);
+    local(inst + 2, _H_, 0);
+    assert(3 == peephole_optimise(inst, 3, false));
+
+    // Rz gates are untouched unless merging is enabled
+    rz(inst, 0, PI / 4);
+    rz(inst + 1, 0, PI / 4);
+    assert(2 == peephole_optimise(inst, 2, false));
+
+    // Rz merges through diagonal gates, and lowers to a local Clifford
+    rz(inst, 0, PI / 4);
+    two(inst + 1, _CZ_, 1, 0);
+    two(inst + 2, _CNOT_, 0, 2);
+    local(inst + 3, _Z_, 0);
+    rz(inst + 4, 0, PI / 4);
+    assert(4 == peephole_optimise(inst, 5, true));
+    assert(_S_ == inst[0].instruction);
+    assert(0 == inst[0].single.arg);
+
+    // Merged angles that are not quarter turns remain Rz
+    rz(inst, 0, 0.1);
+    rz(inst + 1, 0, 0.2);
+    assert(1 == peephole_optimise(inst, 2, true));
+    assert(_RZ_ == inst[0].instruction);
+    assert((float)__inline_rz_tag_to_angle(inst[0].rz.tag) == (float)((double)(float)0.1 + (double)(float)0.2));
+
+    // Opposite angles cancel, quarter turn Rz gates are lowered
+    rz(inst, 0, 0.3);
+    rz(inst + 1, 0, -0.3);
+    rz(inst + 2, 1, PI);
+    assert(1 == peephole_optimise(inst, 3, true));
+    assert(_Z_ == inst[0].instruction);
+    assert(1 == inst[0].single.arg);
+
+    // Rz does not merge through a CNOT target or a Hadamard
+    rz(inst, 0, 0.1);
+    two(inst + 1, _CNOT_, 1, 0);
+    rz(inst + 2, 0, 0.1);
+    local(inst + 3, _H_, 0);
+    rz(inst + 4, 0, 0.1);
+    assert(5 == peephole_optimise(inst, 5, true));
+
+    // Measurements are barriers
+    two(inst, _CNOT_, 0, 1);
+    two(inst + 1, _MEAS_, 0, 0);
+    two(inst + 2, _CNOT_, 0, 1);
+    assert(3 == peephole_optimise(inst, 3, false));
+}
+
+/*
+ * test_local_inverses
+ * Each pair of local Cliffords cancels exactly when its product is the identity
+ * Covers the composite local Cliffords, which are parsed through the full local Clifford map
+ */
+void test_local_inverses()
+{
+    instruction_stream_u inst[2];
+    for (instruction_t i = 0; i < N_LOCAL_CLIFFORDS; i++)
+    {
+        for (instruction_t j = 0; j < N_LOCAL_CLIFFORDS; j++)
+        {
+            const instruction_t first = LOCAL_CLIFFORD_MASK | i;
+            const instruction_t second = LOCAL_CLIFFORD_MASK | j;
+            local(inst, first, 0);
+            local(inst + 1, second, 0);
+
+            const size_t n_expected = (_I_ == LOCAL_CLIFFORD_LEFT(second, first)) ? 0 : (_I_ != first) + (_I_ != second);
+            assert(n_expected == peephole_optimise(inst, 2, false));
+        }
+    }
+}
+
+/*
+ * test_equivalence
+ * Compares a widget built from an optimised Clifford stream against one built from the original stream
+ * Tableau operations are exact, so the widgets are identical once local Cliffords have been applied
+ */
+void test_equivalence(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = random_redundant_stream(n_qubits, n_gates, false, true);
+    instruction_stream_u* optimised = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    memcpy(optimised, inst, sizeof(instruction_stream_u) * n_gates);
+
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits);
+    widget_t* wid_opt = widget_create(n_qubits, 2 * n_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_opt, n_qubits);
+
+    parse_instruction_block(wid, inst, n_gates);
+    const size_t n_optimised = parse_instruction_block_peephole(wid_opt, optimised, n_gates, false);
+    assert(n_optimised < n_gates);
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_opt);
+    assert_widget_equal(wid, wid_opt);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(wid->q_map[i] == wid_opt->q_map[i]);
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_opt);
+    free(inst);
+    free(optimised);
+}
+
+/*
+ * test_rz_budget
+ * Merging never increases the number of Rz gates, and the merged stream still parses
+ */
+void test_rz_budget(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = random_redundant_stream(n_qubits, n_gates, true, true);
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        n_rz += (_RZ_ == inst[i].instruction);
+    }
+
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits + n_rz);
+    teleport_input(wid, n_qubits);
+    const size_t n_optimised = parse_instruction_block_peephole(wid, inst, n_gates, true);
+
+    size_t n_rz_optimised = 0;
+    for (size_t i = 0; i < n_optimised; i++)
+    {
+        n_rz_optimised += (_RZ_ == inst[i].instruction);
+        // Tags are never quarter turns
+        instruction_t opcode;
+        assert((_RZ_ != inst[i].instruction)
+            || !__inline_rz_quarter_turn(__inline_rz_tag_to_angle(inst[i].rz.tag), PEEPHOLE_CLIFFORD_EPS, &opcode));
+    }
+    assert(n_rz_optimised < n_rz);
+    assert(wid->n_qubits == 2 * n_qubits + n_rz_optimised);
+
+    widget_destroy(wid);
+    free(inst);
+}
+
+/*
+ * Unitary simulation of Clifford and Rz streams over a few qubits
+ * Rz(theta) is diag(1, e^(i theta)), so that Rz(pi / 2) is S
+ * Angles must be multiples of pi / 8, as are the angles of random_redundant_stream and their sums
+ * Composite local Clifford names are products of gates, the rightmost gate is applied first
+ */
+static const char* LOCAL_CLIFFORD_NAMES[N_LOCAL_CLIFFORDS] = {
+    "I", "X", "Y", "Z", "H", "S", "R",
+    "HX", "SX", "RX", "HY", "HZ", "SH", "RH", "HS", "HR", "HSX", "HRX", "SHY", "RHY", "HSH", "HRH", "RHS", "SHR"
+};
+
+typedef struct { double re; double im; } amp_t;
+
+static inline
+amp_t amp_mul(const amp_t a, const amp_t b)
+{
+    return (amp_t){a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+}
+
+static inline
+amp_t amp_add(const amp_t a, const amp_t b)
+{
+    return (amp_t){a.re + b.re, a.im + b.im};
+}
+
+/*
+ * sim_eighth_turn
+ * :: angle : const double :: Angle within single precision of a multiple of pi / 8
+ * Returns e^(i angle)
+ */
+amp_t sim_eighth_turn(const double angle)
+{
+    const double turns = angle / (PI / 8);
+    const long k = (long)(turns + ((turns < 0) ? -0.5 : 0.5));
+    assert(fabs(turns - k) < 1e-4);
+
+    // e^(i pi / 8)
+    const amp_t w = {0.92387953251128674, 0.38268343236508977};
+    amp_t phase = {1, 0};
+    for (long i = 0; i < ((k % 16) + 16) % 16; i++)
+    {
+        phase = amp_mul(phase, w);
+    }
+    return phase;
+}
+
+/*
+ * sim_single
+ * Applies a single qubit gate to each column of a unitary
+ * :: u : amp_t* :: Unitary of dim columns of dim amplitudes
+ * :: m : const amp_t[4] :: Gate, row major
+ */
+void sim_single(amp_t* u, const size_t n_qubits, const size_t qubit, const amp_t m[4])
+{
+    const size_t dim = 1ull << n_qubits;
+    for (size_t idx = 0; idx < dim * dim; idx++)
+    {
+        if (idx & (1ull << qubit))
+        {
+            continue;
+        }
+        const amp_t a = u[idx];
+        const amp_t b = u[idx | (1ull << qubit)];
+        u[idx] = amp_add(amp_mul(m[0], a), amp_mul(m[1], b));
+        u[idx | (1ull << qubit)] = amp_add(amp_mul(m[2], a), amp_mul(m[3], b));
+    }
+}
+
+/*
+ * sim_local
+ * Applies a local Clifford by its gate decomposition
+ */
+void sim_local(amp_t* u, const size_t n_qubits, const size_t qubit, const instruction_t opcode)
+{
+    const double h = 1 / sqrt(2);
+    const char* name = LOCAL_CLIFFORD_NAMES[opcode & INSTRUCTION_OPERATOR_MASK];
+    for (size_t i = strlen(name); i > 0; i--)
+    {
+        amp_t m[4] = {{1, 0}, {0, 0}, {0, 0}, {1, 0}};
+        switch (name[i - 1])
+        {
+            case 'X': m[0].re = 0; m[1].re = 1; m[2].re = 1; m[3].re = 0; break;
+            case 'Y': m[0].re = 0; m[1].im = -1; m[2].im = 1; m[3].re = 0; break;
+            case 'Z': m[3].re = -1; break;
+            case 'H': m[0].re = h; m[1].re = h; m[2].re = h; m[3].re = -h; break;
+            case 'S': m[3].re = 0; m[3].im = 1; break;
+            case 'R': m[3].re = 0; m[3].im = -1; break;
+            default: break;
+        }
+        sim_single(u, n_qubits, qubit, m);
+    }
+}
+
+/*
+ * sim_stream
+ * Builds the unitary of a stream of local Cliffords, CNOT, CZ, SWAP and Rz gates
+ * :: u : amp_t* :: Set to the unitary
+ */
+void sim_stream(amp_t* u, const size_t n_qubits, const instruction_stream_u* inst, const size_t n_gates)
+{
+    const size_t dim = 1ull << n_qubits;
+    memset(u, 0, sizeof(amp_t) * dim * dim);
+    for (size_t i = 0; i < dim; i++)
+    {
+        u[i * dim + i].re = 1;
+    }
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t a = inst[i].multi.ctrl;
+        const size_t b = inst[i].multi.targ;
+        if (INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK) == INSTRUCTION_TYPE(inst[i].instruction))
+        {
+            sim_local(u, n_qubits, a, inst[i].instruction);
+            continue;
+        }
+        if (_RZ_ == inst[i].instruction)
+        {
+            const amp_t m[4] = {{1, 0}, {0, 0}, {0, 0}, sim_eighth_turn(__inline_rz_tag_to_angle(inst[i].rz.tag))};
+            sim_single(u, n_qubits, a, m);
+            continue;
+        }
+
+        for (size_t idx = 0; idx < dim * dim; idx++)
+        {
+            const bool bit_a = idx & (1ull << a);
+            const bool bit_b = idx & (1ull << b);
+            size_t partner = idx;
+            switch (inst[i].instruction)
+            {
+                case _CNOT_:
+                    partner = (bit_a && !bit_b) ? (idx | (1ull << b)) : idx;
+                    break;
+                case _CZ_:
+                    u[idx].re *= (bit_a && bit_b) ? -1 : 1;
+                    u[idx].im *= (bit_a && bit_b) ? -1 : 1;
+                    break;
+                case _SWAP_:
+                    partner = (bit_a && !bit_b) ? (idx ^ (1ull << a) ^ (1ull << b)) : idx;
+                    break;
+                default:
+                    assert(false);
+            }
+            const amp_t tmp = u[idx];
+            u[idx] = u[partner];
+            u[partner] = tmp;
+        }
+    }
+}
+
+/*
+ * test_rz_reference
+ * Compares the unitaries of a stream and its optimised stream with Rz merging
+ * Merged angles, Rz gates lowered to local Cliffords and merges through non diagonal gates all change the unitary
+ * Merged tags must also stay within single precision of the exact sum
+ */
+void test_rz_reference(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = random_redundant_stream(n_qubits, n_gates, true, false);
+    instruction_stream_u* optimised = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    memcpy(optimised, inst, sizeof(instruction_stream_u) * n_gates);
+    const size_t n_optimised = peephole_optimise(optimised, n_gates, true);
+
+    size_t n_rz = 0;
+    size_t n_rz_optimised = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        n_rz += (_RZ_ == inst[i].instruction);
+        n_rz_optimised += (i < n_optimised) && (_RZ_ == optimised[i].instruction);
+    }
+    assert(n_rz_optimised < n_rz);
+
+    const size_t dim = 1ull << n_qubits;
+    amp_t* u = (amp_t*)malloc(sizeof(amp_t) * dim * dim);
+    amp_t* u_opt = (amp_t*)malloc(sizeof(amp_t) * dim * dim);
+    sim_stream(u, n_qubits, inst, n_gates);
+    sim_stream(u_opt, n_qubits, optimised, n_optimised);
+
+    // Equal up to a global phase
+    amp_t overlap = {0, 0};
+    for (size_t i = 0; i < dim * dim; i++)
+    {
+        overlap = amp_add(overlap, amp_mul((amp_t){u[i].re, -u[i].im}, u_opt[i]));
+    }
+    assert(fabs(sqrt(overlap.re * overlap.re + overlap.im * overlap.im) / dim - 1) < 1e-9);
+
+    free(u);
+    free(u_opt);
+    free(inst);
+    free(optimised);
+}
+
+int main()
+{
+    test_patterns();
+    test_local_inverses();
+
+    srand(0);
+    for (size_t i = 0; i < 16; i++)
+    {
+        test_equivalence(2 + i % 4, 2000);
+    }
+    // Spans several peephole blocks
+    test_equivalence(6, 3 * PEEPHOLE_BLOCK + 17);
+
+    test_rz_budget(4, 5000);
+    for (size_t i = 0; i < 8; i++)
+    {
+        test_rz_reference(2 + i % 3, 500);
+    }
+    return 0;
+}
@@ -0,0 +1,376 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "instruction_file.h"
+#include "qasm.h"
+#include "rz_tag.h"
+
+/*
+ * collector_t
+ * Emitter context that copies out every instruction
+ */
+struct collector_t
+{
+    instruction_stream_u* instructions;
+    size_t n_instructions;
+    size_t n_blocks;
+};
+
+bool collect(void* ctx, instruction_stream_u* instructions, const size_t n_instructions)
+{
+    struct collector_t* collector = (struct collector_t*)ctx;
+    collector->instructions = (instruction_stream_u*)realloc(
+        collector->instructions,
+        sizeof(instruction_stream_u) * (collector->n_instructions + n_instructions));
+    memcpy(collector->instructions + collector->n_instructions, instructions, sizeof(instruction_stream_u) * n_instructions);
+    collector->n_instructions += n_instructions;
+    collector->n_blocks++;
+    return true;
+}
+
+bool reject(void* ctx, instruction_stream_u* instructions, const size_t n_instructions)
+{
+    return false;
+}
+
+uint32_t angle_tag(const float angle)
+{
+    uint32_t tag = 0;
+    memcpy(&tag, &angle, sizeof(tag));
+    return tag;
+}
+
+void assert_instruction(const instruction_stream_u* inst, const instruction_t opcode, const uint32_t ctrl, const uint32_t targ)
+{
+    assert(opcode == inst->multi.opcode);
+    assert(ctrl == inst->multi.ctrl);
+    assert(targ == inst->multi.targ);
+}
+
+/*
+ * parse
+ * Parses text in pieces of piece_bytes
+ * Returns the parser, finished
+ */
+qasm_parser_t* parse(const char* text, struct collector_t* collector, const size_t piece_bytes)
+{
+    qasm_parser_t* parser = qasm_parser_create(collect, collector);
+    const size_t n_bytes = strlen(text);
+    for (size_t i = 0; i < n_bytes; i += piece_bytes)
+    {
+        const size_t n = (piece_bytes < n_bytes - i) ? piece_bytes : n_bytes - i;
+        if (!qasm_parser_feed(parser, text + i, n))
+        {
+            return parser;
+        }
+    }
+    qasm_parser_finish(parser);
+    return parser;
+}
+
+static const char* QASM2_SOURCE =
+    "OPENQASM 2.0;\n"
+    "include \"qelib1.inc\";\n"
+    "// Registers are allocated in order\n"
+    "qreg a[2];\n"
+    "qreg b[2];\n"
+    "creg c[2];\n"
+    "h a[0]; s a[1]; sdg b[0]; x b[1]; y a[0]; z a[1]; id a[0];\n"
+    "cx a[0], b[1];\n"
+    "CX a[1],b[0];\n"
+    "cz a[0], a[1];\n"
+    "swap a[0], b[0];\n"
+    "rz(pi/2) a[0];\n"
+    "rz(-pi / 2) a[1];\n"
+    "u1(pi) b[0];\n"
+    "rz(2*pi) b[1];\n"
+    "t a[0]; tdg a[1];\n"
+    "rz(0.1) b[0]; /* block\n comment; */ p(-(0.5 + 0.25)) b[1];\n"
+    "barrier a, b;\n"
+    "h b;\n"
+    "cx a, b;\n"
+    "measure a[0] -> c[0];\n"
+    "measure b -> c;\n"
+    "if (c[0] == 1) x a[1];\n";
+
+/*
+ * test_qasm2
+ * Checks the lowering of each supported statement
+ */
+void test_qasm2(const size_t piece_bytes)
+{
+    struct collector_t collector = {NULL, 0, 0};
+    qasm_parser_t* parser = parse(QASM2_SOURCE, &collector, piece_bytes);
+    assert(NULL == qasm_parser_get_error(parser));
+    assert(4 == qasm_parser_get_n_qubits(parser));
+    assert(2 == qasm_parser_get_n_bits(parser));
+    assert(collector.n_instructions == qasm_parser_get_n_instructions(parser));
+
+    const instruction_stream_u* inst = collector.instructions;
+    assert_instruction(inst++, _H_, 0, 0);
+    assert_instruction(inst++, _S_, 1, 0);
+    assert_instruction(inst++, _R_, 2, 0);
+    assert_instruction(inst++, _X_, 3, 0);
+    assert_instruction(inst++, _Y_, 0, 0);
+    assert_instruction(inst++, _Z_, 1, 0);
+    assert_instruction(inst++, _CNOT_, 0, 3);
+    assert_instruction(inst++, _CNOT_, 1, 2);
+    assert_instruction(inst++, _CZ_, 0, 1);
+    assert_instruction(inst++, _SWAP_, 0, 2);
+
+    // Quarter turns are lowered to local Cliffords, full turns are dropped
+    assert_instruction(inst++, _S_, 0, 0);
+    assert_instruction(inst++, _R_, 1, 0);
+    assert_instruction(inst++, _Z_, 2, 0);
+
+    assert_instruction(inst++, _RZ_, 0, angle_tag(3.14159265358979323846 / 4));
+    assert_instruction(inst++, _RZ_, 1, angle_tag(-3.14159265358979323846 / 4));
+    assert_instruction(inst++, _RZ_, 2, angle_tag(0.1));
+    assert_instruction(inst++, _RZ_, 3, angle_tag(-0.75));
+    assert(4 == qasm_parser_get_n_rz(parser));
+
+    // Broadcasts
+    assert_instruction(inst++, _H_, 2, 0);
+    assert_instruction(inst++, _H_, 3, 0);
+    assert_instruction(inst++, _CNOT_, 0, 2);
+    assert_instruction(inst++, _CNOT_, 1, 3);
+
+    assert_instruction(inst++, _MEAS_, 0, 0);
+    assert_instruction(inst++, _MEAS_, 2, 2);
+    assert_instruction(inst++, _MEAS_, 3, 3);
+
+    // c[0] was last measured from b[0]
+    assert_instruction(inst++, _MCX_, 2, 1);
+    assert(inst == collector.instructions + collector.n_instructions);
+
+    qasm_parser_destroy(parser);
+    free(collector.instructions);
+}
+
+/*
+ * test_qasm3
+ * OpenQASM 3 declarations, measurements and conditioned blocks
+ */
+void test_qasm3()
+{
+    const char* source =
+        "OPENQASM 3;\n"
+        "include \"stdgates.inc\";\n"
+        "qubit[3] q;\n"
+        "qubit r;\n"
+        "bit[2] c;\n"
+        "bit d;\n"
+        "h q[0];\n"
+        "cnot q[0], r;\n"
+        "c[1] = measure q[0];\n"
+        "d = measure r;\n"
+        "if (c[1]) { x q[1]; z q[2]; }\n"
+        "if (d == true) y q[2];\n"
+        "phase(pi / 4) q[1];\n";
+
+    struct collector_t collector = {NULL, 0, 0};
+    qasm_parser_t* parser = parse(source, &collector, 7);
+    assert(NULL == qasm_parser_get_error(parser));
+    assert(4 == qasm_parser_get_n_qubits(parser));
+    assert(3 == qasm_parser_get_n_bits(parser));
+    assert(8 == collector.n_instructions);
+
+    const instruction_stream_u* inst = collector.instructions;
+    assert_instruction(inst++, _H_, 0, 0);
+    assert_instruction(inst++, _CNOT_, 0, 3);
+    assert_instruction(inst++, _MEAS_, 0, 0);
+    assert_instruction(inst++, _MEAS_, 3, 3);
+    assert_instruction(inst++, _MCX_, 0, 1);
+    assert_instruction(inst++, _MCZ_, 0, 2);
+    assert_instruction(inst++, _MCY_, 3, 2);
+    assert_instruction(inst++, _RZ_, 1, angle_tag(3.14159265358979323846 / 4));
+
+    qasm_parser_destroy(parser);
+    free(collector.instructions);
+}
+
+/*
+ * test_errors
+ * Each source fails to parse
+ */
+void test_errors()
+{
+    const char* sources[] = {
+        "OPENQASM 4.0;",
+        "qreg q[2]; ccx q[0], q[1], q[0];",
+        "qreg q[2]; cx q[0], q[2];",
+        "qreg q[2]; cx q[0], q[0];",
+        "qreg q[2]; h r[0];",
+        "qreg q[2]; qreg q[1];",
+        "qreg q[2]; creg c[1]; if (c[0] == 1) x q[0];",
+        "qreg q[2]; creg c[1]; measure q[0] -> c[0]; if (c[0] == 1) h q[1];",
+        "qreg q[2]; creg c[1]; measure q[0] -> c[0]; if (c[0] == 0) x q[1];",
+        "qreg q[2]; creg c[1]; measure q[0] -> c[0]; if (c[0]) { x q[1];",
+        "qreg q[2]; h q[0]",
+        "qreg q[2]; }",
+        "gate g a { h a; }",
+        "qreg q[2]; rz(theta) q[0];",
+        "qreg q[3]; qreg r[2]; cx q, r;",
+        "qreg q[2]; /* unterminated",
+        "qreg q[2]; rz(pi/0) q[0];",
+        "qreg q[2]; rz(1e400) q[0];",
+        "qreg q[2]; rz(1/(1/0)) q[0];",
+        "qreg q[2]; rz(1e300*1e300) q[0];",
+    };
+    for (size_t i = 0; i < sizeof(sources) / sizeof(const char*); i++)
+    {
+        struct collector_t collector = {NULL, 0, 0};
+        qasm_parser_t* parser = parse(sources[i], &collector, 1000);
+        assert(NULL != qasm_parser_get_error(parser));
+        assert(!qasm_parser_finish(parser));
+        qasm_parser_destroy(parser);
+        free(collector.instructions);
+    }
+
+    // Failures of the emitter stop the parser
+    qasm_parser_t* parser = qasm_parser_create(reject, NULL);
+    assert(qasm_parser_feed(parser, "qreg q[1]; h q[0];", 18));
+    assert(!qasm_parser_finish(parser));
+    qasm_parser_destroy(parser);
+
+    // Error lines count from one
+    parser = qasm_parser_create(NULL, NULL);
+    assert(!qasm_parser_feed(parser, "qreg q[1];\n\nfoo q[0];\n", 22));
+    assert(3 == qasm_parser_get_line(parser));
+    qasm_parser_destroy(parser);
+
+    // Division by zero and non-finite angles are reported on their line
+    parser = qasm_parser_create(NULL, NULL);
+    assert(!qasm_parser_feed(parser, "qreg q[1];\nrz(pi/0) q[0];\n", 26));
+    assert(2 == qasm_parser_get_line(parser));
+    assert(NULL != strstr(qasm_parser_get_error(parser), "division by zero"));
+    qasm_parser_destroy(parser);
+
+    parser = qasm_parser_create(NULL, NULL);
+    assert(!qasm_parser_feed(parser, "qreg q[1];\nh q[0];\nrz(1e400) q[0];\n", 35));
+    assert(3 == qasm_parser_get_line(parser));
+    assert(NULL != strstr(qasm_parser_get_error(parser), "not finite"));
+    qasm_parser_destroy(parser);
+
+    // Non-finite angles are never lowered to local Cliffords
+    instruction_t opcode = _I_;
+    assert(!__inline_rz_quarter_turn(INFINITY, QASM_CLIFFORD_EPS, &opcode));
+    assert(!__inline_rz_quarter_turn(NAN, QASM_CLIFFORD_EPS, &opcode));
+    assert(!__inline_rz_quarter_turn(1e300, QASM_CLIFFORD_EPS, &opcode));
+}
+
+/*
+ * test_blocks
+ * Long sources are emitted in blocks, and match parsing the collected stream into a widget
+ */
+void test_blocks(const size_t n_qubits, const size_t n_gates)
+{
+    const size_t line_bytes = 64;
+    char* source = (char*)malloc(line_bytes * (n_gates + 2));
+    size_t n_bytes = sprintf(source, "OPENQASM 2.0;\nqreg q[%zu];\n", n_qubits);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        switch (rand() % 4)
+        {
+            case 0:
+                n_bytes += sprintf(source + n_bytes, "rz(%f) q[%zu];\n", (double)(rand() % 1000) / 100 + 0.001, ctrl);
+                break;
+            case 1:
+                n_bytes += sprintf(source + n_bytes, "cx q[%zu], q[%zu];\n", ctrl, targ);
+                break;
+            case 2:
+                n_bytes += sprintf(source + n_bytes, "h q[%zu];\n", ctrl);
+                break;
+            default:
+                n_bytes += sprintf(source + n_bytes, "cz q[%zu],q[%zu]; s q[%zu];\n", ctrl, targ, targ);
+                break;
+        }
+    }
+
+    struct collector_t collector = {NULL, 0, 0};
+    qasm_parser_t* parser = parse(source, &collector, 4093);
+    assert(NULL == qasm_parser_get_error(parser));
+    assert(collector.n_blocks == (collector.n_instructions + QASM_BLOCK_INSTRUCTIONS - 1) / QASM_BLOCK_INSTRUCTIONS);
+
+    // Emitting straight into a widget matches parsing the collected stream
+    const size_t max_qubits = 2 * n_qubits + qasm_parser_get_n_rz(parser);
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_qasm = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_qasm, n_qubits);
+    parse_instruction_block(wid, collector.instructions, collector.n_instructions);
+
+    // Through a file
+    char path[] = "/tmp/test_qasm_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(n_bytes == (size_t)write(fd, source, n_bytes));
+    close(fd);
+
+    qasm_parser_t* widget_parser = qasm_parser_create(qasm_emit_widget, wid_qasm);
+    assert(qasm_parser_read_file(widget_parser, path));
+    assert(qasm_parser_get_n_instructions(widget_parser) == collector.n_instructions);
+    qasm_parser_destroy(widget_parser);
+
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_qasm->queue->table[i]);
+        assert(wid->queue->non_cliffords[i] == wid_qasm->queue->non_cliffords[i]);
+        for (size_t j = 0; j < wid->n_qubits; j++)
+        {
+            assert(slice_get_bit(wid->tableau->slices_x[i], j) == slice_get_bit(wid_qasm->tableau->slices_x[i], j));
+            assert(slice_get_bit(wid->tableau->slices_z[i], j) == slice_get_bit(wid_qasm->tableau->slices_z[i], j));
+        }
+    }
+
+    // Into an instruction file
+    char out_path[] = "/tmp/test_qasm_XXXXXX";
+    close(mkstemp(out_path));
+    instruction_file_writer_t* writer = instruction_file_writer_open(out_path, INSTRUCTION_FILE_PACKED);
+    qasm_parser_t* file_parser = qasm_parser_create(qasm_emit_instruction_file, writer);
+    assert(qasm_parser_read_file(file_parser, path));
+    assert(instruction_file_writer_close(writer));
+    instruction_file_t* file = instruction_file_open(out_path);
+    assert(NULL != file);
+    assert(collector.n_instructions == instruction_file_get_n_instructions(file));
+    assert(qasm_parser_get_n_rz(file_parser) == instruction_file_get_n_rz(file));
+    instruction_file_close(file);
+    qasm_parser_destroy(file_parser);
+
+    // Missing files fail
+    qasm_parser_t* missing = qasm_parser_create(NULL, NULL);
+    unlink(path);
+    unlink(out_path);
+    assert(!qasm_parser_read_file(missing, path));
+    assert(NULL != qasm_parser_get_error(missing));
+    qasm_parser_destroy(missing);
+
+    widget_destroy(wid);
+    widget_destroy(wid_qasm);
+    qasm_parser_destroy(parser);
+    free(collector.instructions);
+    free(source);
+}
+
+int main()
+{
+    test_qasm2(1);
+    test_qasm2(5);
+    test_qasm2(1 << 12);
+    test_qasm3();
+    test_errors();
+    test_blocks(8, 100);
+    test_blocks(100, 3 * QASM_BLOCK_INSTRUCTIONS + 17);
+    return 0;
+}
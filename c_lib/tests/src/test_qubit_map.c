@@ -0,0 +1,203 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "instruction_packed.h"
+#include "qubit_map.h"
+#include "threadpool.h"
+
+#include "test_widget.h"
+
+/*
+ * relabel_stream
+ * Removes the swaps from a stream by renaming the qubits of the instructions that follow them
+ * :: labels : uint32_t* :: Set to the qubit holding the state of each qubit at the end of the stream
+ * Returns the number of instructions left in the stream
+ */
+size_t relabel_stream(instruction_stream_u* inst, const size_t n_gates, uint32_t* labels, const size_t n_qubits)
+{
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        labels[i] = i;
+    }
+
+    size_t n_out = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        instruction_stream_u* curr = inst + i;
+        if (_SWAP_ == curr->instruction)
+        {
+            const uint32_t tmp = labels[curr->multi.ctrl];
+            labels[curr->multi.ctrl] = labels[curr->multi.targ];
+            labels[curr->multi.targ] = tmp;
+            continue;
+        }
+
+        inst[n_out] = *curr;
+        inst[n_out].multi.ctrl = labels[curr->multi.ctrl];
+        if (INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK) == INSTRUCTION_TYPE(curr->instruction))
+        {
+            inst[n_out].multi.targ = labels[curr->multi.targ];
+        }
+        n_out++;
+    }
+    return n_out;
+}
+
+/*
+ * test_swap
+ * A stream with swaps produces the same widget as the stream with its later instructions relabelled,
+ * the swaps are only visible in the qubit map
+ * :: packed : const bool :: Parses the packed encoding of the stream with swaps
+ * :: n_workers : const size_t :: Threadpool workers, zero leaves the threadpool uninitialised
+ */
+void test_swap(const size_t n_qubits, const size_t n_gates, const bool packed, const size_t n_workers)
+{
+    if (n_workers > 0)
+    {
+        threadpool_init(n_workers);
+    }
+
+    instruction_stream_u* inst = random_stream_mix(n_qubits, n_gates, 4, true);
+    instruction_stream_u* relabelled = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    memcpy(relabelled, inst, sizeof(instruction_stream_u) * n_gates);
+    uint32_t* labels = (uint32_t*)malloc(sizeof(uint32_t) * n_qubits);
+    const size_t n_relabelled = relabel_stream(relabelled, n_gates, labels, n_qubits);
+
+    const size_t max_qubits = 2 * n_qubits + n_gates;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_relabelled = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_relabelled, n_qubits);
+
+    if (packed)
+    {
+        uint8_t* buf = (uint8_t*)malloc(instruction_packed_bound(n_gates));
+        const size_t n_bytes = instruction_pack(inst, n_gates, buf);
+        assert(n_gates == parse_instruction_block_packed(wid, buf, n_bytes));
+        free(buf);
+    }
+    else
+    {
+        parse_instruction_block(wid, inst, n_gates);
+    }
+    parse_instruction_block(wid_relabelled, relabelled, n_relabelled);
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_relabelled);
+    assert_widget_equal(wid, wid_relabelled);
+
+    // The state of qubit i is held by labels[i] in the relabelled widget
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(wid->q_map[i] == wid_relabelled->q_map[labels[i]]);
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_relabelled);
+    free(inst);
+    free(relabelled);
+    free(labels);
+
+    if (n_workers > 0)
+    {
+        threadpool_destroy();
+    }
+}
+
+/*
+ * test_permutation_swaps
+ * Applies the swaps of a random permutation to a list of labels
+ */
+void test_permutation_swaps(const size_t n_qubits)
+{
+    uint32_t* perm = (uint32_t*)malloc(sizeof(uint32_t) * n_qubits);
+    uint32_t* labels = (uint32_t*)malloc(sizeof(uint32_t) * n_qubits);
+    instruction_stream_u* swaps = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_qubits);
+
+    // Fisher-Yates shuffle
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        perm[i] = i;
+    }
+    for (size_t i = n_qubits - 1; i > 0; i--)
+    {
+        const size_t j = rand() % (i + 1);
+        const uint32_t tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+
+    // Each cycle saves one swap
+    size_t n_cycles = 0;
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        labels[i] = 0;
+    }
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        if (0 == labels[i])
+        {
+            n_cycles++;
+            for (uint32_t j = i; 0 == labels[j]; j = perm[j])
+            {
+                labels[j] = 1;
+            }
+        }
+    }
+
+    const size_t n_swaps = qubit_permutation_swaps(perm, n_qubits, swaps);
+    assert(n_qubits - n_cycles == n_swaps);
+
+    // labels[j] is the qubit whose state is held by j
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        labels[i] = i;
+    }
+    for (size_t i = 0; i < n_swaps; i++)
+    {
+        assert(_SWAP_ == swaps[i].instruction);
+        const uint32_t tmp = labels[swaps[i].multi.ctrl];
+        labels[swaps[i].multi.ctrl] = labels[swaps[i].multi.targ];
+        labels[swaps[i].multi.targ] = tmp;
+    }
+    for (uint32_t i = 0; i < n_qubits; i++)
+    {
+        assert(i == labels[perm[i]]);
+    }
+
+    // Repeated and out of range entries are rejected
+    if (n_qubits > 1)
+    {
+        perm[0] = perm[1];
+        assert(SIZE_MAX == qubit_permutation_swaps(perm, n_qubits, swaps));
+        perm[0] = n_qubits;
+        assert(SIZE_MAX == qubit_permutation_swaps(perm, n_qubits, swaps));
+    }
+
+    free(perm);
+    free(labels);
+    free(swaps);
+}
+
+int main()
+{
+    srand(0);
+    test_swap(8, 1000, false, 0);
+    test_swap(64, 10000, false, 0);
+    test_swap(64, 10000, true, 0);
+    test_swap(64, 10000, false, 4);
+    test_swap(600, 4000, false, 4);
+
+    for (size_t n_qubits = 1; n_qubits < 200; n_qubits += 7)
+    {
+        test_permutation_swaps(n_qubits);
+    }
+    assert(0 == qubit_permutation_swaps(NULL, 0, NULL));
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include <assert.h>
+#include <stdio.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "tableau_fused_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "simd_dispatch.h"
+
+#include "test_tableau.h"
+
+#ifdef __x86_64__
+#define BASE_TIER "avx2"
+const char* TIERS[] = {"avx2", "avx512", "avx512vpopcntdq"};
+#else
+#define BASE_TIER "neon"
+const char* TIERS[] = {"neon"};
+#endif
+#define N_TIERS (sizeof(TIERS) / sizeof(const char*))
+
+/*
+ * test_gates
+ * Compares the gate kernels of a tier against the baseline kernels
+ */
+void test_gates(const char* tier, const size_t n_qubits)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_tier = tableau_copy(tab);
+
+    for (instruction_t opcode = 0; opcode < N_NON_LOCAL_CLIFFORDS; opcode++)
+    {
+        for (instruction_t clifford = 0; clifford < N_LOCAL_CLIFFORDS; clifford++)
+        {
+            const size_t ctrl = rand() % n_qubits;
+            const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+            const instruction_t targ_clifford = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORDS);
+
+            assert(simd_dispatch_select(BASE_TIER));
+            SINGLE_QUBIT_OPERATIONS[clifford](tab, ctrl);
+            TWO_QUBIT_OPERATIONS[opcode](tab, ctrl, targ);
+            tableau_fused(tab, targ, ctrl, LOCAL_CLIFFORD_MASK | clifford, targ_clifford, NON_LOCAL_CLIFFORD_MASK | opcode);
+
+            assert(simd_dispatch_select(tier));
+            SINGLE_QUBIT_OPERATIONS[clifford](tab_tier, ctrl);
+            TWO_QUBIT_OPERATIONS[opcode](tab_tier, ctrl, targ);
+            tableau_fused(tab_tier, targ, ctrl, LOCAL_CLIFFORD_MASK | clifford, targ_clifford, NON_LOCAL_CLIFFORD_MASK | opcode);
+
+            assert_tableau_equal(tab, tab_tier);
+        }
+    }
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_tier);
+}
+
+/*
+ * test_rowsum
+ * Compares the rowsum kernel of a tier against the baseline kernel
+ * The rowsum acts in place on the target, so each kernel operates on its own tableau
+ */
+void test_rowsum(const char* tier, const size_t n_qubits)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_tier = tableau_copy(tab);
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+
+        assert(simd_dispatch_select(BASE_TIER));
+        const int8_t phase = SIMD_DISPATCH_g.rowsum(
+            tab->slice_len,
+            tab->slices_x[ctrl],
+            tab->slices_z[ctrl],
+            tab->slices_x[targ],
+            tab->slices_z[targ]);
+
+        assert(simd_dispatch_select(tier));
+        const int8_t phase_tier = SIMD_DISPATCH_g.rowsum(
+            tab_tier->slice_len,
+            tab_tier->slices_x[ctrl],
+            tab_tier->slices_z[ctrl],
+            tab_tier->slices_x[targ],
+            tab_tier->slices_z[targ]);
+
+        assert(phase == phase_tier);
+    }
+    assert_tableau_equal(tab, tab_tier);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_tier);
+}
+
+/*
+ * test_transpose
+ * Compares the transpose kernels of a tier against the baseline kernels
+ */
+void test_transpose(const char* tier, const size_t n_qubits)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_tier = tableau_copy(tab);
+
+    assert(simd_dispatch_select(BASE_TIER));
+    tableau_transpose(tab);
+
+    assert(simd_dispatch_select(tier));
+    tableau_transpose(tab_tier);
+
+    assert_tableau_equal(tab, tab_tier);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_tier);
+}
+
+widget_t* random_widget(const size_t n_qubits, const size_t n_gates, const unsigned int seed)
+{
+    srand(seed);
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits);
+    teleport_input(wid, n_qubits);
+
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        if (rand() % 2)
+        {
+            // Input streams only contain the I, X, Y, Z, H, S and R local Cliffords
+            inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % 7);
+            inst[i].single.arg = ctrl;
+        }
+        else
+        {
+            inst[i].multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+            inst[i].multi.ctrl = ctrl;
+            inst[i].multi.targ = targ;
+        }
+    }
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(wid);
+
+    free(inst);
+    return wid;
+}
+
+/*
+ * test_decompose
+ * Compares the decomposition of a tier against the baseline decomposition
+ */
+void test_decompose(const char* tier, const size_t n_qubits)
+{
+    const unsigned int seed = rand();
+
+    assert(simd_dispatch_select(BASE_TIER));
+    widget_t* wid = random_widget(n_qubits, 2 * n_qubits, seed);
+    widget_decompose(wid);
+
+    assert(simd_dispatch_select(tier));
+    widget_t* wid_tier = random_widget(n_qubits, 2 * n_qubits, seed);
+    widget_decompose(wid_tier);
+
+    assert(wid->n_qubits == wid_tier->n_qubits);
+    assert_tableau_equal(wid->tableau, wid_tier->tableau);
+    assert(0 == memcmp(wid->queue->table, wid_tier->queue->table, wid->n_qubits * sizeof(instruction_t)));
+
+    widget_destroy(wid);
+    widget_destroy(wid_tier);
+}
+
+/*
+ * test_decompose_m4ri
+ * Compares the M4RI decomposition of a tier against the pivot decomposition
+ */
+void test_decompose_m4ri(const char* tier, const size_t n_qubits)
+{
+    const unsigned int seed = rand();
+
+    assert(simd_dispatch_select(tier));
+    widget_t* wid = random_widget(n_qubits, 2 * n_qubits, seed);
+    widget_decompose(wid);
+
+    widget_t* wid_m4ri = random_widget(n_qubits, 2 * n_qubits, seed);
+    widget_decompose_m4ri(wid_m4ri);
+
+    assert(wid->n_qubits == wid_m4ri->n_qubits);
+    assert_tableau_equal(wid->tableau, wid_m4ri->tableau);
+    assert(0 == memcmp(wid->queue->table, wid_m4ri->queue->table, wid->n_qubits * sizeof(instruction_t)));
+
+    widget_destroy(wid);
+    widget_destroy(wid_m4ri);
+}
+
+int main()
+{
+    // The widest supported tier is bound on load
+    assert(NULL != simd_dispatch_name());
+    assert(!simd_dispatch_select("unknown"));
+
+    for (size_t i = 0; i < N_TIERS; i++)
+    {
+        if (!simd_dispatch_select(TIERS[i]))
+        {
+            fprintf(stderr, "Skipping %s, not supported by this host\n", TIERS[i]);
+            continue;
+        }
+        assert(0 == strcmp(TIERS[i], simd_dispatch_name()));
+
+        for (size_t n_qubits = 64; n_qubits <= 1024; n_qubits += 320)
+        {
+            test_gates(TIERS[i], n_qubits);
+            test_rowsum(TIERS[i], n_qubits);
+            test_transpose(TIERS[i], n_qubits);
+        }
+
+        for (size_t n_qubits = 64; n_qubits <= 256; n_qubits += 64)
+        {
+            test_decompose(TIERS[i], n_qubits);
+        }
+
+        // Includes widgets that end part way through a tile
+        for (size_t n_qubits = 80; n_qubits <= 400; n_qubits += 80)
+        {
+            test_decompose_m4ri(TIERS[i], n_qubits);
+        }
+    }
+
+    return 0;
+}
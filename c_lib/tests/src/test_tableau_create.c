@@ -37,9 +37,94 @@ void test_tableau_create(const size_t n_qubits)
     tableau_destroy(tab);
 }
 
+/*
+ * test_tableau_alloc_mode
+ * Creates a tableau with each allocator
+ * :: n_qubits : const size_t :: Number of qubits, tableaus below TABLEAU_MMAP_MIN_BYTES are always on the heap
+ */
+void test_tableau_alloc_mode(const size_t n_qubits)
+{
+    const enum tableau_alloc_mode_e default_mode = tableau_get_alloc_mode();
+
+    for (uint8_t mode = TABLEAU_ALLOC_HEAP; mode <= TABLEAU_ALLOC_HUGETLB; mode++)
+    {
+        tableau_set_alloc_mode(mode);
+        test_tableau_create(n_qubits);
+
+        tableau_t* tab = tableau_create(n_qubits);
+        if (tab->chunks_bytes < TABLEAU_MMAP_MIN_BYTES)
+        {
+            assert(TABLEAU_ALLOC_HEAP == tab->alloc_mode);
+        }
+        else if (TABLEAU_ALLOC_HUGETLB == mode)
+        {
+            // Falls back when no huge pages are reserved
+            assert((TABLEAU_ALLOC_HUGETLB == tab->alloc_mode) || (TABLEAU_ALLOC_THP == tab->alloc_mode));
+        }
+        else
+        {
+            assert(mode == tab->alloc_mode);
+        }
+
+        // The whole bitmap is writable
+        memset(tab->chunks, 0xff, tab->chunks_bytes);
+        tableau_destroy(tab);
+    }
+
+    tableau_set_alloc_mode(default_mode);
+}
+
+/*
+ * test_tableau_layout
+ * Creates an interleaved tableau and moves it between layouts
+ * :: n_qubits : const size_t :: Number of qubits
+ */
+void test_tableau_layout(const size_t n_qubits)
+{
+    tableau_set_layout_mode(TABLEAU_LAYOUT_INTERLEAVED);
+    test_tableau_create(n_qubits);
+    tableau_set_layout_mode(TABLEAU_LAYOUT_PLANAR);
+
+    tableau_t* tab = tableau_create_layout(n_qubits, TABLEAU_LAYOUT_INTERLEAVED);
+    assert(TABLEAU_LAYOUT_INTERLEAVED == tab->layout);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        // Z directly follows X
+        assert((uint8_t*)tab->slices_z[i] == (uint8_t*)tab->slices_x[i] + tab->slice_len);
+        assert((void*)tab->slices_x[i] == SLICE_X_IDX(tab, i));
+        assert((void*)tab->slices_z[i] == SLICE_Z_IDX(tab, i));
+
+        for (size_t j = 0; j < n_qubits; j++)
+        {
+            slice_set_bit(tab->slices_x[i], j, (i * 7 + j * 3) % 5 == 0);
+        }
+        slice_set_bit(tab->phases, i, i % 3 == 0);
+    }
+
+    // Round trip through the planar layout
+    for (size_t k = 0; k < 2; k++)
+    {
+        tableau_relayout(tab, k ? TABLEAU_LAYOUT_INTERLEAVED : TABLEAU_LAYOUT_PLANAR);
+        assert((k ? TABLEAU_LAYOUT_INTERLEAVED : TABLEAU_LAYOUT_PLANAR) == tab->layout);
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            assert((void*)tab->slices_x[i] == SLICE_X_IDX(tab, i));
+            for (size_t j = 0; j < n_qubits; j++)
+            {
+                assert(slice_get_bit(tab->slices_x[i], j) == ((i * 7 + j * 3) % 5 == 0));
+                assert(slice_get_bit(tab->slices_z[i], j) == (i == j));
+            }
+            assert(slice_get_bit(tab->phases, i) == (i % 3 == 0));
+        }
+    }
+    tableau_destroy(tab);
+}
 
 int main()
 {
+    // Mapped allocators are opt in
+    assert(TABLEAU_ALLOC_HEAP == tableau_get_alloc_mode());
+
     // Test for small tableaus
     // These all fit in a single cache line chunk 
     for (size_t n_qubits = 1;
@@ -60,5 +145,12 @@ int main()
         test_tableau_create(n_qubits);
     }
 
+    // Either side of the heap allocation threshold
+    test_tableau_alloc_mode(CACHE_SIZE_BITS);
+    test_tableau_alloc_mode(CACHE_SIZE_BITS * 12);
+
+    test_tableau_layout(100);
+    test_tableau_layout(CACHE_SIZE_BITS * 3);
+
     return 0;    
 }
@@ -440,11 +440,47 @@ void test_widget_hadamard_decomp(void)
 }
 
 
+/*
+ * test_widget_decomp_symmetric
+ * Decomposes a random widget and checks the result is a graph state
+ * X should be the identity and Z should be symmetric
+ * Widgets over 256 qubits cover rowsums whose control lies past the first 256 columns
+ * :: n_qubits : const size_t :: Number of qubits
+ */
+void test_widget_decomp_symmetric(const size_t n_qubits)
+{
+    widget_t* wid = widget_create_from_stream(
+        n_qubits,
+        4 * n_qubits,
+        create_instruction_stream);
+
+    apply_local_cliffords(wid);
+    widget_decompose(wid);
+
+    tableau_t* tab = wid->tableau;
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        for (size_t j = 0; j < n_qubits; j++)
+        {
+            assert((i == j) == __inline_slice_get_bit(tab->slices_x[i], j));
+            assert(__inline_slice_get_bit(tab->slices_z[i], j) == __inline_slice_get_bit(tab->slices_z[j], i));
+        }
+    }
+
+    widget_destroy(wid);
+}
+
 
 int main()
 {
     test_widget_hadamard_decomp();
 
+    srand(0);
+    for (size_t i = 64; i <= 1024; i += 192)
+    {
+        test_widget_decomp_symmetric(i);
+    }
+
     // GHZ 
     for (size_t i = 64; i <=128 ; i += 64)
     {
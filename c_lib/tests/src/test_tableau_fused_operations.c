@@ -0,0 +1,87 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "tableau_fused_operations.h"
+#include "instructions.h"
+
+#include "test_tableau.h"
+
+/*
+ * test_fused
+ * Compares each fused kernel against the local Cliffords followed by the non-local Clifford
+ */
+void test_fused(const size_t n_qubits)
+{
+    for (instruction_t opcode = 0; opcode < N_NON_LOCAL_CLIFFORDS; opcode++)
+    {
+        for (instruction_t ctrl_clifford = 0; ctrl_clifford < N_LOCAL_CLIFFORDS; ctrl_clifford++)
+        {
+            for (instruction_t targ_clifford = 0; targ_clifford < N_LOCAL_CLIFFORDS; targ_clifford++)
+            {
+                const size_t ctrl = rand() % n_qubits;
+                const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+
+                tableau_t* tab = tableau_random_create(n_qubits);
+                tableau_t* tab_fused = tableau_copy(tab);
+
+                SINGLE_QUBIT_OPERATIONS[ctrl_clifford](tab, ctrl);
+                SINGLE_QUBIT_OPERATIONS[targ_clifford](tab, targ);
+                TWO_QUBIT_OPERATIONS[opcode](tab, ctrl, targ);
+
+                tableau_fused(
+                    tab_fused,
+                    ctrl,
+                    targ,
+                    LOCAL_CLIFFORD_MASK | ctrl_clifford,
+                    LOCAL_CLIFFORD_MASK | targ_clifford,
+                    NON_LOCAL_CLIFFORD_MASK | opcode);
+
+                assert_tableau_equal(tab, tab_fused);
+
+                tableau_destroy(tab);
+                tableau_destroy(tab_fused);
+            }
+        }
+    }
+}
+
+/*
+ * test_fused_range
+ * Fused kernels should not touch bytes outside of their range
+ */
+void test_fused_range(const size_t n_qubits)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_fused = tableau_copy(tab);
+
+    const size_t start = CACHE_SIZE;
+    const size_t stop = tab->slice_len - CACHE_SIZE;
+
+    SINGLE_QUBIT_OPERATIONS_RANGE[_H_ & INSTRUCTION_OPERATOR_MASK](tab, 0, start, stop);
+    SINGLE_QUBIT_OPERATIONS_RANGE[_S_ & INSTRUCTION_OPERATOR_MASK](tab, 1, start, stop);
+    TWO_QUBIT_OPERATIONS_RANGE[_CNOT_ & INSTRUCTION_OPERATOR_MASK](tab, 0, 1, start, stop);
+
+    FUSED_OPERATIONS_RANGE[FUSED_OPERATION_IDX(_CNOT_, _H_, _S_)](tab_fused, 0, 1, start, stop);
+
+    assert_tableau_equal(tab, tab_fused);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_fused);
+}
+
+int main()
+{
+    srand(0);
+
+    for (size_t n_qubits = 64; n_qubits <= 256; n_qubits += 64)
+    {
+        test_fused(n_qubits);
+    }
+
+    test_fused_range(1024);
+
+    return 0;
+}
@@ -0,0 +1,375 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "threadpool.h"
+#include "tableau_operations.h"
+#include "tableau_operations_par.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "simd_gaussian_elimination.h"
+
+#include "test_tableau.h"
+
+// Smallest tableau that the input stream will distribute
+#define N_QUBITS_DISTRIBUTABLE (THREADPOOL_MIN_SLICE_BYTES * 8)
+
+void increment(void* args)
+{
+    *(size_t*)args += 1;
+}
+
+void test_add_task(const size_t n_workers, const size_t n_tasks)
+{
+    threadpool_init(n_workers);
+
+    size_t* counters = (size_t*)calloc(n_tasks, sizeof(size_t));
+    for (size_t i = 0; i < n_tasks; i++)
+    {
+        threadpool_add_task(increment, counters + i);
+    }
+    threadpool_barrier();
+
+    for (size_t i = 0; i < n_tasks; i++)
+    {
+        assert(1 == counters[i]);
+    }
+
+    free(counters);
+    threadpool_destroy();
+}
+
+void test_distributed_operations(const size_t n_qubits, const size_t n_workers, const size_t n_gates)
+{
+    threadpool_init(n_workers);
+
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_par = tableau_copy(tab);
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+
+        const size_t local_opcode = rand() % N_LOCAL_CLIFFORDS;
+        SINGLE_QUBIT_OPERATIONS[local_opcode](tab, ctrl);
+        threadpool_distribute_tableau_operation(tab_par, SINGLE_QUBIT_OPERATIONS_PAR[local_opcode], ctrl, NULL_TARG);
+
+        const size_t non_local_opcode = rand() % N_NON_LOCAL_CLIFFORDS;
+        TWO_QUBIT_OPERATIONS[non_local_opcode](tab, ctrl, targ);
+        threadpool_distribute_tableau_operation(tab_par, TWO_QUBIT_OPERATIONS_PAR[non_local_opcode], ctrl, targ);
+    }
+    threadpool_barrier();
+
+    assert_tableau_equal(tab, tab_par);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_par);
+    threadpool_destroy();
+}
+
+/*
+ * compare_parse_instruction_block
+ * Parses a stream with and without the threadpool and compares the resulting widgets
+ */
+void compare_parse_instruction_block(
+    const size_t n_qubits,
+    const size_t n_workers,
+    instruction_stream_u* inst,
+    const size_t n_gates)
+{
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits);
+    widget_t* wid_par = widget_create(n_qubits, 2 * n_qubits);
+
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(wid);
+
+    threadpool_init(n_workers);
+    parse_instruction_block(wid_par, inst, n_gates);
+    apply_local_cliffords(wid_par);
+    threadpool_destroy();
+
+    assert(wid->n_qubits == wid_par->n_qubits);
+    assert_tableau_equal(wid->tableau, wid_par->tableau);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(wid->q_map[i] == wid_par->q_map[i]);
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_par);
+}
+
+void random_local_clifford(instruction_stream_u* inst, const size_t arg)
+{
+    // Input streams only contain the I, X, Y, Z, H, S and R local Cliffords
+    inst->single.opcode = LOCAL_CLIFFORD_MASK | (rand() % 7);
+    inst->single.arg = arg;
+}
+
+void random_non_local_clifford(instruction_stream_u* inst, const size_t ctrl, const size_t targ)
+{
+    inst->multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+    inst->multi.ctrl = ctrl;
+    inst->multi.targ = targ;
+}
+
+void test_parse_instruction_block_random(const size_t n_qubits, const size_t n_workers, const size_t n_gates)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        switch (rand() % 4)
+        {
+            case 0:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = i;
+                break;
+            case 1:
+            {
+                const size_t ctrl = rand() % n_qubits;
+                random_non_local_clifford(inst + i, ctrl, (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits);
+                break;
+            }
+            default:
+                random_local_clifford(inst + i, rand() % n_qubits);
+                break;
+        }
+    }
+
+    compare_parse_instruction_block(n_qubits, n_workers, inst, n_gates);
+    free(inst);
+}
+
+/*
+ * test_parse_instruction_block_brickwork
+ * Layers of gates on disjoint qubits, these form large batches
+ */
+void test_parse_instruction_block_brickwork(const size_t n_qubits, const size_t n_workers, const size_t n_layers)
+{
+    const size_t n_gates = n_layers * (n_qubits + n_qubits / 2) + n_qubits / 2;
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+
+    size_t idx = 0;
+    for (size_t layer = 0; layer < n_layers; layer++)
+    {
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            random_local_clifford(inst + idx++, i);
+        }
+        for (size_t i = layer % 2; i + 1 < n_qubits; i += 2)
+        {
+            random_non_local_clifford(inst + idx++, i, i + 1);
+        }
+    }
+    for (size_t i = 0; i < n_qubits / 2; i++)
+    {
+        inst[idx].rz.opcode = _RZ_;
+        inst[idx].rz.arg = 2 * i;
+        inst[idx].rz.tag = i;
+        idx++;
+    }
+    assert(idx <= n_gates);
+
+    compare_parse_instruction_block(n_qubits, n_workers, inst, idx);
+    free(inst);
+}
+
+/*
+ * test_decompose_distributed
+ * Decomposes a widget with and without the threadpool and compares the resulting widgets
+ * :: m4ri : const bool :: Uses the M4RI elimination with the threadpool
+ */
+void test_decompose_distributed(const size_t n_qubits, const size_t n_workers, const bool m4ri)
+{
+    const size_t n_gates = 2 * n_qubits;
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(sizeof(instruction_stream_u) * n_gates);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        if (rand() % 2)
+        {
+            random_local_clifford(inst + i, ctrl);
+        }
+        else
+        {
+            random_non_local_clifford(inst + i, ctrl, (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits);
+        }
+    }
+
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits);
+    widget_t* wid_par = widget_create(n_qubits, 2 * n_qubits);
+    teleport_input(wid, n_qubits);
+    teleport_input(wid_par, n_qubits);
+
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(wid);
+    widget_decompose(wid);
+
+    parse_instruction_block(wid_par, inst, n_gates);
+    apply_local_cliffords(wid_par);
+    threadpool_init(n_workers);
+    if (m4ri)
+    {
+        widget_decompose_m4ri(wid_par);
+    }
+    else
+    {
+        widget_decompose(wid_par);
+    }
+    threadpool_destroy();
+
+    assert(wid->n_qubits == wid_par->n_qubits);
+    assert_tableau_equal(wid->tableau, wid_par->tableau);
+    assert(0 == memcmp(wid->queue->table, wid_par->queue->table, wid->n_qubits * sizeof(instruction_t)));
+
+    widget_destroy(wid);
+    widget_destroy(wid_par);
+    free(inst);
+}
+
+/*
+ * test_transpose_distributed
+ * Transposes a tableau with and without the threadpool and compares the resulting tableaus
+ */
+void test_transpose_distributed(const size_t n_qubits, const size_t n_workers)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_par = tableau_copy(tab);
+
+    tableau_transpose(tab);
+
+    threadpool_init(n_workers);
+    tableau_transpose(tab_par);
+    threadpool_destroy();
+
+    assert_tableau_equal(tab, tab_par);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_par);
+}
+
+/*
+ * test_worker_range
+ * The worker ranges are cache aligned and cover each slice without overlap
+ */
+void test_worker_range(const size_t slice_len, const size_t n_workers)
+{
+    threadpool_init(n_workers);
+
+    size_t expected_start = 0;
+    for (size_t i = 0; i < n_workers; i++)
+    {
+        size_t start = 0;
+        size_t stop = 0;
+        threadpool_worker_range(slice_len, i, &start, &stop);
+        assert(start == expected_start);
+        assert(start <= stop);
+        assert(0 == start % CACHE_SIZE);
+        assert(0 == stop % CACHE_SIZE);
+        expected_start = stop;
+    }
+    assert(expected_start == slice_len);
+
+    threadpool_destroy();
+}
+
+/*
+ * test_numa_placement
+ * Creates tableaus under each placement policy with pinned workers
+ * Placement must not change the tableau or the results of distributed operations
+ */
+void test_numa_placement(const size_t n_qubits, const size_t n_workers, const size_t n_gates)
+{
+    const enum tableau_alloc_mode_e alloc_mode = tableau_get_alloc_mode();
+    tableau_set_alloc_mode(TABLEAU_ALLOC_MMAP);
+    threadpool_set_pinning(THREADPOOL_PIN_ALWAYS);
+    threadpool_init(n_workers);
+
+    assert(threadpool_get_n_nodes() >= 1);
+    assert(threadpool_get_n_nodes() <= numa_n_nodes());
+
+    tableau_set_numa_policy(TABLEAU_NUMA_LOCAL);
+    tableau_t* tab = tableau_create(n_qubits);
+
+    const enum tableau_numa_policy_e policies[] = {
+        TABLEAU_NUMA_AUTO, TABLEAU_NUMA_INTERLEAVE, TABLEAU_NUMA_FIRST_TOUCH};
+    for (size_t i = 0; i < sizeof(policies) / sizeof(enum tableau_numa_policy_e); i++)
+    {
+        tableau_set_numa_policy(policies[i]);
+        tableau_t* tab_placed = tableau_create(n_qubits);
+        assert(TABLEAU_ALLOC_MMAP == tab_placed->alloc_mode);
+        assert_tableau_equal(tab, tab_placed);
+
+        tableau_t* tab_serial = tableau_copy(tab);
+        for (size_t j = 0; j < n_gates; j++)
+        {
+            const size_t ctrl = rand() % n_qubits;
+            const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+            const size_t opcode = rand() % N_NON_LOCAL_CLIFFORDS;
+            TWO_QUBIT_OPERATIONS[opcode](tab_serial, ctrl, targ);
+            threadpool_distribute_tableau_operation(tab_placed, TWO_QUBIT_OPERATIONS_PAR[opcode], ctrl, targ);
+        }
+        threadpool_barrier();
+        assert_tableau_equal(tab_serial, tab_placed);
+
+        tableau_destroy(tab_serial);
+        tableau_destroy(tab_placed);
+    }
+
+    tableau_destroy(tab);
+    threadpool_destroy();
+    tableau_set_numa_policy(TABLEAU_NUMA_AUTO);
+    threadpool_set_pinning(THREADPOOL_PIN_AUTO);
+    tableau_set_alloc_mode(alloc_mode);
+}
+
+int main()
+{
+    srand(0);
+
+    for (size_t n_workers = 1; n_workers <= 8; n_workers++)
+    {
+        test_add_task(n_workers, 1024);
+    }
+
+    // Includes tableaus with fewer cache lines than workers
+    for (size_t n_qubits = 64; n_qubits <= 2048; n_qubits *= 2)
+    {
+        test_distributed_operations(n_qubits, 3, 256);
+        test_distributed_operations(n_qubits, 8, 256);
+    }
+
+    // Distributed by rows
+    test_parse_instruction_block_random(N_QUBITS_DISTRIBUTABLE / 2, 4, 4096);
+    test_parse_instruction_block_brickwork(N_QUBITS_DISTRIBUTABLE / 2, 4, 4);
+
+    // Distributed by batches of gates
+    for (size_t n_qubits = 64; n_qubits < N_QUBITS_DISTRIBUTABLE / 2; n_qubits *= 2)
+    {
+        test_parse_instruction_block_random(n_qubits, 4, 2 * n_qubits);
+        test_parse_instruction_block_brickwork(n_qubits, 3, 8);
+    }
+
+    // Distributed transpose, including a partial block 
+    test_transpose_distributed(TRANSPOSE_PAR_MIN_QUBITS, 3);
+    test_transpose_distributed(TRANSPOSE_PAR_MIN_QUBITS + 64 * TRANSPOSE_TILE_BLOCKS + 17, 8);
+
+    // Worker ranges, including more workers than cache lines
+    test_worker_range(CACHE_SIZE, 3);
+    test_worker_range(CACHE_SIZE * 17, 4);
+    test_worker_range(CACHE_SIZE * 64, 8);
+
+    // Placement, with and without a CPU for each worker
+    test_numa_placement(4096, 1, 64);
+    test_numa_placement(4096 + 64, 4, 64);
+
+    // Distributed elimination
+    test_decompose_distributed(DECOMP_PAR_MIN_QUBITS / 2, 3, false);
+    test_decompose_distributed(DECOMP_PAR_MIN_QUBITS, 8, false);
+    test_decompose_distributed(DECOMP_PAR_MIN_QUBITS, 3, true);
+
+    return 0;
+}
@@ -6,6 +6,9 @@
 #include "widget.h"
 #include "input_stream.h"
 #include "instructions.h"
+#include "simd_dispatch.h"
+
+#include "test_widget.h"
 
 #define N_TEST_ITERATIONS (10)
 void test_widget_create()
@@ -50,11 +53,169 @@ void test_initial_cliffords()
     }
 }
 
+/*
+ * test_widget_growth
+ * Compares a widget that grows as qubits are allocated against one allocated at the maximum size 
+ */
+void test_widget_growth(const size_t n_qubits, const size_t n_gates)
+{
+    const size_t max_qubits = n_qubits + n_gates;
+
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_max = widget_create(n_qubits, max_qubits);
+    widget_reserve(wid_max, max_qubits);
+
+    const size_t capacity = wid->tableau->n_qubits;
+    assert(capacity <= wid_max->tableau->n_qubits);
+
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(wid);
+    parse_instruction_block(wid_max, inst, n_gates);
+    apply_local_cliffords(wid_max);
+
+    // Grown geometrically, but only as far as required 
+    assert(wid->tableau->n_qubits >= wid->n_qubits);
+    assert((wid->tableau->n_qubits == capacity) || (wid->tableau->n_qubits < 2 * wid->n_qubits + 64));
+    assert_widget_equal(wid, wid_max);
+
+    widget_decompose(wid);
+    widget_decompose(wid_max);
+    assert_widget_equal(wid, wid_max);
+
+    free(inst);
+    widget_destroy(wid);
+    widget_destroy(wid_max);
+}
+
+/*
+ * test_widget_compact
+ * Compares a decomposition of a compacted tableau against a decomposition at the maximum size 
+ * :: layout : const enum tableau_layout_e :: Layout of the compacted tableau, the other is always planar
+ */
+void test_widget_compact(
+    const size_t n_qubits,
+    const size_t n_gates,
+    const enum tableau_alloc_mode_e mode,
+    const enum tableau_layout_e layout)
+{
+    const size_t max_qubits = 4 * (n_qubits + n_gates);
+    const enum tableau_alloc_mode_e default_mode = tableau_get_alloc_mode();
+    tableau_set_alloc_mode(mode);
+
+    tableau_set_layout_mode(layout);
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    tableau_set_layout_mode(TABLEAU_LAYOUT_PLANAR);
+    widget_t* wid_max = widget_create(n_qubits, max_qubits);
+    widget_reserve(wid, max_qubits);
+    widget_reserve(wid_max, max_qubits);
+
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(wid);
+    parse_instruction_block(wid_max, inst, n_gates);
+    apply_local_cliffords(wid_max);
+
+    assert(layout == wid->tableau->layout);
+    widget_decompose(wid);
+    assert(wid->tableau->n_qubits == wid->n_qubits + (!!(wid->n_qubits % 64)) * (64 - (wid->n_qubits % 64)));
+    assert(TABLEAU_LAYOUT_PLANAR == wid->tableau->layout);
+
+    // Skips the compaction
+    SIMD_DISPATCH_g.widget_decompose(wid_max);
+    assert(wid_max->tableau->n_qubits > wid->tableau->n_qubits);
+    assert_widget_equal(wid, wid_max);
+
+    free(inst);
+    widget_destroy(wid);
+    widget_destroy(wid_max);
+    tableau_set_alloc_mode(default_mode);
+}
+
+/*
+ * test_widget_pool
+ * Compares widgets reused through the pool against newly created widgets
+ * Each reused widget has previously been grown, acted on and decomposed
+ */
+void test_widget_pool(const size_t n_qubits, const size_t n_gates, const size_t n_rounds)
+{
+    const size_t max_qubits = 2 * n_qubits + n_gates;
+
+    widget_t* prev = NULL;
+    for (size_t i = 0; i < n_rounds; i++)
+    {
+        // Alternates between the width and half the width
+        const size_t width = (i % 2) ? n_qubits / 2 : n_qubits;
+
+        widget_t* wid = widget_pool_acquire(width, max_qubits);
+        widget_t* wid_new = widget_create(width, max_qubits);
+        assert((0 == i) || (wid == prev));
+        assert(width == wid->n_qubits);
+        assert(width == wid->n_initial_qubits);
+
+        teleport_input(wid, width);
+        teleport_input(wid_new, width);
+        for (size_t j = 0; j < width; j++)
+        {
+            assert(wid->q_map[j] == wid_new->q_map[j]);
+        }
+
+        instruction_stream_u* inst = random_stream(width, n_gates);
+        parse_instruction_block(wid, inst, n_gates);
+        apply_local_cliffords(wid);
+        parse_instruction_block(wid_new, inst, n_gates);
+        apply_local_cliffords(wid_new);
+        assert_widget_equal(wid, wid_new);
+        for (size_t j = 0; j < wid->n_qubits; j++)
+        {
+            assert(wid->queue->non_cliffords[j] == wid_new->queue->non_cliffords[j]);
+        }
+
+        widget_decompose(wid);
+        widget_decompose(wid_new);
+        assert_widget_equal(wid, wid_new);
+
+        free(inst);
+        widget_destroy(wid_new);
+        widget_pool_release(wid);
+        prev = wid;
+    }
+
+    // Widgets of a different shape are not reused
+    widget_t* wid = widget_pool_acquire(n_qubits, max_qubits + 64);
+    assert(wid != prev);
+
+    // Releases past the size of the pool are destroyed
+    for (size_t i = 0; i < WIDGET_POOL_SIZE + 1; i++)
+    {
+        widget_pool_release(widget_create(n_qubits, max_qubits));
+    }
+    widget_pool_release(wid);
+    widget_pool_clear();
+}
 
 int main()
 {
     test_widget_create();
     test_initial_map();
     test_initial_cliffords();
+
+    for (size_t n_qubits = 16; n_qubits <= 1024; n_qubits *= 4)
+    {
+        test_widget_growth(n_qubits, 3 * n_qubits);
+    }
+
+    for (uint8_t mode = TABLEAU_ALLOC_HEAP; mode <= TABLEAU_ALLOC_HUGETLB; mode++)
+    {
+        for (uint8_t layout = TABLEAU_LAYOUT_PLANAR; layout <= TABLEAU_LAYOUT_INTERLEAVED; layout++)
+        {
+            test_widget_compact(100, 300, mode, layout);
+            test_widget_compact(300, 900, mode, layout);
+        }
+    }
+
+    test_widget_pool(64, 256, 4);
+    test_widget_pool(300, 600, 5);
     return 0;
 }
@@ -0,0 +1,200 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "widget_sequence.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "threadpool.h"
+
+#include "test_widget.h"
+
+/*
+ * assert_widget_io_equal
+ * Compares two widgets along with their qubit maps
+ */
+void assert_widget_io_equal(widget_t* wid_a, widget_t* wid_b)
+{
+    assert_widget_equal(wid_a, wid_b);
+    assert(wid_a->n_initial_qubits == wid_b->n_initial_qubits);
+    for (size_t i = 0; i < wid_a->n_initial_qubits; i++)
+    {
+        assert(wid_a->q_map[i] == wid_b->q_map[i]);
+    }
+}
+
+/*
+ * test_widget_sequence_split
+ * Each block other than the last holds exactly the threshold of Rz gates
+ */
+void test_widget_sequence_split(const size_t n_qubits, const size_t n_gates, const size_t rz_threshold)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_gates);
+
+    const size_t n_blocks = widget_sequence_split(inst, n_gates, rz_threshold, NULL);
+    size_t* starts = (size_t*)malloc((n_blocks + 1) * sizeof(size_t));
+    assert(n_blocks == widget_sequence_split(inst, n_gates, rz_threshold, starts));
+
+    assert(0 == starts[0]);
+    assert(n_gates == starts[n_blocks]);
+    for (size_t i = 0; i < n_blocks; i++)
+    {
+        size_t n_rz = 0;
+        for (size_t j = starts[i]; j < starts[i + 1]; j++)
+        {
+            n_rz += (INSTRUCTION_TYPE(inst[j].instruction) == INSTRUCTION_TYPE(RZ_MASK));
+        }
+        assert(n_rz <= rz_threshold);
+        assert((i + 1 == n_blocks) || (n_rz == rz_threshold));
+        assert((0 == i) || (_RZ_ == inst[starts[i]].instruction));
+    }
+
+    free(starts);
+    free(inst);
+}
+
+/*
+ * test_widget_sequence
+ * Compares widgets compiled by the sequence against widgets compiled serially
+ * :: n_workers : const size_t :: Threadpool workers, zero leaves the threadpool uninitialised
+ */
+void test_widget_sequence(
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_gates,
+    const size_t n_threads,
+    const size_t window,
+    const size_t n_workers)
+{
+    if (n_workers > 0)
+    {
+        threadpool_init(n_workers);
+    }
+
+    instruction_stream_u* inst = random_stream(qubit_width, n_gates);
+
+    const size_t rz_threshold = max_qubits - 2 * qubit_width;
+    const size_t n_widgets = widget_sequence_split(inst, n_gates, rz_threshold, NULL);
+    size_t* starts = (size_t*)malloc((n_widgets + 1) * sizeof(size_t));
+    widget_sequence_split(inst, n_gates, rz_threshold, starts);
+
+    widget_sequence_t* seq = widget_sequence_create(inst, n_gates, qubit_width, max_qubits, n_threads, window);
+    assert(n_widgets == widget_sequence_get_n_widgets(seq));
+    assert(seq->n_threads <= seq->window);
+
+    for (size_t i = 0; i < n_widgets; i++)
+    {
+        widget_t* wid = widget_sequence_next(seq);
+        assert(NULL != wid);
+
+        widget_t* wid_serial = widget_create(qubit_width, max_qubits);
+        teleport_input(wid_serial, qubit_width);
+        parse_instruction_block(wid_serial, inst + starts[i], starts[i + 1] - starts[i]);
+        widget_decompose(wid_serial);
+
+        assert_widget_io_equal(wid, wid_serial);
+
+        widget_destroy(wid_serial);
+        widget_pool_release(wid);
+    }
+    assert(NULL == widget_sequence_next(seq));
+    widget_sequence_destroy(seq);
+
+    free(starts);
+    free(inst);
+    widget_pool_clear();
+
+    if (n_workers > 0)
+    {
+        threadpool_destroy();
+    }
+}
+
+/*
+ * test_widget_sequence_packed
+ * Compares widgets compiled from a packed stream against widgets compiled from the fixed stream
+ */
+void test_widget_sequence_packed(
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_gates,
+    const size_t n_threads)
+{
+    instruction_stream_u* inst = random_stream(qubit_width, n_gates);
+    uint8_t* packed = (uint8_t*)malloc(instruction_packed_bound(n_gates));
+    const size_t n_bytes = instruction_pack(inst, n_gates, packed);
+
+    const size_t rz_threshold = max_qubits - 2 * qubit_width;
+    const size_t n_widgets = widget_sequence_split(inst, n_gates, rz_threshold, NULL);
+    assert(n_widgets == widget_sequence_split_packed(packed, n_bytes, rz_threshold, NULL));
+
+    widget_sequence_t* seq = widget_sequence_create(inst, n_gates, qubit_width, max_qubits, n_threads, 0);
+    widget_sequence_t* seq_packed = widget_sequence_create_packed(packed, n_bytes, qubit_width, max_qubits, n_threads, 0);
+    assert(n_widgets == widget_sequence_get_n_widgets(seq_packed));
+
+    for (size_t i = 0; i < n_widgets; i++)
+    {
+        widget_t* wid = widget_sequence_next(seq);
+        widget_t* wid_packed = widget_sequence_next(seq_packed);
+        assert_widget_io_equal(wid, wid_packed);
+        widget_pool_release(wid);
+        widget_pool_release(wid_packed);
+    }
+    assert(NULL == widget_sequence_next(seq_packed));
+
+    widget_sequence_destroy(seq);
+    widget_sequence_destroy(seq_packed);
+    free(packed);
+    free(inst);
+    widget_pool_clear();
+}
+
+/*
+ * test_widget_sequence_early_destroy
+ * Destroys a sequence before all widgets have been consumed
+ */
+void test_widget_sequence_early_destroy(
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const size_t n_gates,
+    const size_t n_threads)
+{
+    instruction_stream_u* inst = random_stream(qubit_width, n_gates);
+    widget_sequence_t* seq = widget_sequence_create(inst, n_gates, qubit_width, max_qubits, n_threads, 2);
+    assert(widget_sequence_get_n_widgets(seq) > 2);
+
+    widget_pool_release(widget_sequence_next(seq));
+    widget_sequence_destroy(seq);
+
+    free(inst);
+    widget_pool_clear();
+}
+
+int main()
+{
+    test_widget_sequence_split(16, 1024, 1);
+    test_widget_sequence_split(16, 1024, 32);
+    test_widget_sequence_split(16, 1024, 4096);
+    test_widget_sequence_split(16, 0, 8);
+
+    for (size_t n_threads = 1; n_threads <= 4; n_threads++)
+    {
+        test_widget_sequence(16, 64, 512, n_threads, 1, 0);
+        test_widget_sequence(16, 64, 512, n_threads, 3, 0);
+        test_widget_sequence(64, 300, 2048, n_threads, 0, 0);
+    }
+
+    // Compile threads do not submit work to the threadpool
+    test_widget_sequence(64, 300, 2048, 3, 2, 4);
+    test_widget_sequence(128, 2048, 4096, 0, 0, 4);
+
+    test_widget_sequence_packed(16, 64, 512, 1);
+    test_widget_sequence_packed(64, 300, 2048, 3);
+
+    test_widget_sequence_early_destroy(16, 64, 1024, 1);
+    test_widget_sequence_early_destroy(16, 64, 1024, 2);
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+'''
+    Instruction File
+    Binary instruction streams that are memory mapped by the c_lib
+'''
+from ctypes import POINTER, c_bool, c_int, c_size_t
+
+from cabaliser.operations import OperationType
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.utils import void_p
+
+from cabaliser.lib_cabaliser import lib
+lib.instruction_file_open.restype = void_p  # Opaque Pointer
+lib.instruction_file_writer_open.restype = void_p  # Opaque Pointer
+lib.instruction_file_writer_append.restype = c_bool
+lib.instruction_file_writer_close.restype = c_bool
+lib.instruction_file_write.restype = c_bool
+lib.instruction_file_get_n_instructions.restype = c_size_t
+lib.instruction_file_get_n_qubits.restype = c_size_t
+lib.instruction_file_get_n_rz.restype = c_size_t
+lib.instruction_file_get_instructions.restype = POINTER(OperationType)
+lib.instruction_file_get_encoding.restype = c_int
+lib.instruction_file_get_n_bytes.restype = c_size_t
+lib.instruction_file_parse.restype = c_bool
+
+# Values of instruction_file_encoding_e
+INSTRUCTION_FILE_FIXED = 0
+INSTRUCTION_FILE_PACKED = 1
+
+
+class InstructionFile():
+    '''
+        Read only view of a binary instruction stream
+        The stream is memory mapped, instructions are read from the file as they are parsed
+        May be passed to a Widget or a WidgetSequence in place of an OperationSequence
+        :: path : str :: Path of a file written by InstructionFile.write or an InstructionFileWriter
+        Instructions may only be indexed in files that are not packed
+    '''
+    def __init__(self, path: str):
+        self.path = path
+        self.file = lib.instruction_file_open(str(path).encode())
+        if not self.file:
+            raise OSError(f"Could not map instruction file {path}")
+
+        self.packed = INSTRUCTION_FILE_PACKED == lib.instruction_file_get_encoding(self.file)
+        self.n_bytes = lib.instruction_file_get_n_bytes(self.file)
+        self.ops = None if self.packed else lib.instruction_file_get_instructions(self.file)
+        self.curr_instructions = lib.instruction_file_get_n_instructions(self.file)
+        self.n_instructions = self.curr_instructions
+        self.max_qubit_index = lib.instruction_file_get_n_qubits(self.file)
+        self.n_rz_operations = lib.instruction_file_get_n_rz(self.file)
+
+    def __len__(self):
+        return self.curr_instructions
+
+    def __getitem__(self, idx: int):
+        if self.packed:
+            raise TypeError("Packed instruction files may not be indexed")
+        if idx >= self.curr_instructions:
+            raise IndexError(idx)
+        return self.ops[idx]
+
+    def parse(self, widget, start: int = 0, n_instructions: int = None):
+        '''
+            Parses a range of the stream into a widget
+            :: widget : POINTER(WidgetType) :: Widget
+            :: start : int :: First instruction to parse
+            :: n_instructions : int :: Number of instructions, defaults to the rest of the stream
+        '''
+        if n_instructions is None:
+            n_instructions = self.curr_instructions - start
+        if start + n_instructions > self.curr_instructions:
+            raise IndexError("Range exceeds the instruction file")
+        if not lib.instruction_file_parse(widget, self.file, c_size_t(start), c_size_t(n_instructions)):
+            raise OSError(f"Could not decode instruction file {self.path}")
+
+    def close(self):
+        '''
+            Unmaps the file
+            Any widget sequence over this file must be exhausted or destroyed first
+        '''
+        if self.file:
+            lib.instruction_file_close(self.file)
+            self.file = None
+            self.ops = None
+
+    def __del__(self):
+        self.close()
+
+    @staticmethod
+    def write(path: str, ops: OperationSequence, packed: bool = False):
+        '''
+            Writes an operation sequence as a binary instruction stream
+            :: path : str :: Path of the file, any existing file is replaced
+            :: ops : OperationSequence :: Operations to write
+            :: packed : bool :: Packs instructions into a variable length encoding,
+                typically a third to a half of the size of the fixed encoding
+        '''
+        encoding = INSTRUCTION_FILE_PACKED if packed else INSTRUCTION_FILE_FIXED
+        if not lib.instruction_file_write(
+                str(path).encode(), ops.ops, c_size_t(ops.curr_instructions), c_int(encoding)):
+            raise OSError(f"Could not write instruction file {path}")
+
+
+class InstructionFileWriter():
+    '''
+        Appends operation sequences to a binary instruction stream
+        Streams may be written a block at a time without holding the whole circuit
+        :: path : str :: Path of the file, any existing file is replaced
+        :: packed : bool :: Packs instructions into a variable length encoding
+    '''
+    def __init__(self, path: str, packed: bool = False):
+        self.path = path
+        encoding = INSTRUCTION_FILE_PACKED if packed else INSTRUCTION_FILE_FIXED
+        self.writer = lib.instruction_file_writer_open(str(path).encode(), c_int(encoding))
+        if not self.writer:
+            raise OSError(f"Could not create instruction file {path}")
+
+    def append(self, ops: OperationSequence):
+        '''
+            Appends the operations of a sequence
+            :: ops : OperationSequence :: Operations to append
+        '''
+        if not lib.instruction_file_writer_append(self.writer, ops.ops, c_size_t(ops.curr_instructions)):
+            raise OSError(f"Could not write instruction file {self.path}")
+
+    def close(self):
+        '''
+            Writes the header and closes the file
+        '''
+        if self.writer:
+            written = lib.instruction_file_writer_close(self.writer)
+            self.writer = None
+            if not written:
+                raise OSError(f"Could not write instruction file {self.path}")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
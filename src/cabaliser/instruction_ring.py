@@ -0,0 +1,94 @@
+'''
+    Instruction Ring
+    Streams instructions into a widget through a bounded queue in the c_lib
+'''
+import threading
+from ctypes import c_bool, c_int, c_size_t
+
+from cabaliser.instruction_file import INSTRUCTION_FILE_FIXED, INSTRUCTION_FILE_PACKED
+from cabaliser.utils import void_p
+
+from cabaliser.lib_cabaliser import lib
+lib.instruction_ring_create.restype = void_p  # Opaque Pointer
+lib.instruction_ring_get_capacity.restype = c_size_t
+lib.instruction_ring_reader_start.restype = void_p  # Opaque Pointer
+lib.instruction_ring_reader_join.restype = c_bool
+lib.parse_instruction_ring.restype = c_size_t
+
+# Default of INSTRUCTION_RING_CAPACITY
+INSTRUCTION_RING_CAPACITY = 1 << 16
+
+
+class InstructionRing():
+    '''
+        Single producer, single consumer ring of instructions
+        A producer thread fills the ring while the widget parses from it,
+        so at most capacity instructions are held in memory at once
+        Each ring carries a single stream
+        :: capacity : int :: Minimum number of instructions held by the ring
+    '''
+    def __init__(self, capacity: int = INSTRUCTION_RING_CAPACITY):
+        self.ring = lib.instruction_ring_create(c_size_t(capacity))
+        self.capacity = lib.instruction_ring_get_capacity(self.ring)
+        self.streamed = False
+
+    def stream(self, widget, source, packed: bool = False) -> int:
+        '''
+            Parses a stream of instructions into a widget
+            :: widget : POINTER(WidgetType) :: Widget
+            :: source : Iterable[OperationSequence] | int | file :: Blocks of operations,
+                or a file descriptor or file object holding a raw instruction stream
+            :: packed : bool :: Whether a raw instruction stream uses the packed encoding
+            Returns the number of instructions parsed
+        '''
+        if self.streamed:
+            raise RuntimeError("Instruction ring has already been streamed")
+        self.streamed = True
+
+        if isinstance(source, int) or hasattr(source, 'fileno'):
+            return self.__stream_fd(widget, source, packed)
+        return self.__stream_blocks(widget, source)
+
+    def __stream_blocks(self, widget, blocks) -> int:
+        '''
+            Pushes blocks from a Python thread, the GIL is released while the widget parses
+        '''
+        errors = []
+
+        def produce():
+            try:
+                for ops in blocks:
+                    lib.instruction_ring_push(self.ring, ops.ops, c_size_t(ops.curr_instructions))
+            except Exception as err:  # Re-raised on the consumer's thread
+                errors.append(err)
+            finally:
+                lib.instruction_ring_close(self.ring)
+
+        producer = threading.Thread(target=produce, daemon=True)
+        producer.start()
+        n_parsed = lib.parse_instruction_ring(widget, self.ring)
+        producer.join()
+
+        if errors:
+            raise errors[0]
+        return n_parsed
+
+    def __stream_fd(self, widget, source, packed: bool) -> int:
+        '''
+            Reads a raw instruction stream on a thread in the c_lib
+        '''
+        fd = source if isinstance(source, int) else source.fileno()
+        encoding = INSTRUCTION_FILE_PACKED if packed else INSTRUCTION_FILE_FIXED
+        reader = lib.instruction_ring_reader_start(self.ring, c_int(fd), c_int(encoding))
+        if not reader:
+            raise OSError("Could not start instruction stream reader")
+
+        n_parsed = lib.parse_instruction_ring(widget, self.ring)
+        if not lib.instruction_ring_reader_join(reader):
+            raise OSError(f"Instruction stream was unreadable or truncated after {n_parsed} instructions")
+        return n_parsed
+
+    def __del__(self):
+        if self.ring:
+            lib.instruction_ring_destroy(self.ring)
+            self.ring = None
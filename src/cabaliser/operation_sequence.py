@@ -6,15 +6,33 @@
 from itertools import chain, repeat
 import ctypes
 
-from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES
+import numpy as np
+
+from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES, PERMUTATION_GATES
 from cabaliser.gates import RZ_GATES, CONDITIONAL_OPERATION_GATES, RZ, MEASUREMENT_GATE
+from cabaliser.gates import OPCODE_TYPE_MASK, RZ_MASK
 from cabaliser.operations import (
     OperationType, SingleQubitOperation,
     TwoQubitOperation, RzOperation,
-    ConditionalOperation)
+    ConditionalOperation, TwoQubitOperationType)
 
 from cabaliser.utils import unbound_table_element
 
+from cabaliser.lib_cabaliser import lib
+lib.widget_sequence_split.restype = ctypes.c_size_t
+lib.peephole_optimise.restype = ctypes.c_size_t
+lib.qubit_permutation_swaps.restype = ctypes.c_size_t
+
+# Structured layout of an operation
+# Every operation places its operands at the offsets of the two qubit operation,
+# ctrl holds the arg of single qubit and rz operations and targ holds the tag of rz operations
+OPERATION_DTYPE = np.dtype({
+    'names': ['opcode', 'ctrl', 'targ'],
+    'formats': [np.uint8, np.uint32, np.uint32],
+    'offsets': [0, TwoQubitOperationType.ctrl.offset, TwoQubitOperationType.targ.offset],
+    'itemsize': ctypes.sizeof(OperationType)
+})
+
 
 class OperationSequence():
     '''
@@ -30,12 +48,17 @@ class OperationSequence():
     for idx, fn in chain(
             zip(SINGLE_QUBIT_GATES, repeat(SingleQubitOperation)),
             zip(TWO_QUBIT_GATES, repeat(TwoQubitOperation)),
+            zip(PERMUTATION_GATES, repeat(TwoQubitOperation)),
             zip(RZ_GATES, repeat(RzOperation)),
             zip(MEASUREMENT_GATE, repeat(SingleQubitOperation)),
             zip(CONDITIONAL_OPERATION_GATES, repeat(ConditionalOperation))
             ):
         CONSTRUCTOR_MAP[idx] = fn
 
+    VALID_OPCODES = np.array([fn is not unbound_table_element for fn in CONSTRUCTOR_MAP])
+    TWO_OPERAND_OPCODES = np.zeros(256, dtype=bool)
+    TWO_OPERAND_OPCODES[list(TWO_QUBIT_GATES | PERMUTATION_GATES | CONDITIONAL_OPERATION_GATES)] = True
+
     def __init__(self, n_instructions: int):
         '''
         Constructor for the operation sequence object
@@ -104,6 +127,122 @@ class OperationSequence():
             self.sequence_params(*args)
         self.curr_instructions += 1
 
+    def append_permutation(self, perm):
+        '''
+            append_permutation
+            Appends a permutation of qubits as SWAP operations
+            :: perm : array_like :: The state of qubit i is moved to qubit perm[i]
+            A cycle of length k is appended as k - 1 SWAP operations,
+             each only relabels qubits in the widget
+        '''
+        perm = np.ascontiguousarray(perm, dtype=np.uint32)
+        n_qubits = len(perm)
+        swaps = (OperationType * max(n_qubits - 1, 1))()
+        n_swaps = lib.qubit_permutation_swaps(
+            perm.ctypes.data_as(ctypes.POINTER(ctypes.c_uint32)),
+            ctypes.c_size_t(n_qubits),
+            swaps)
+        if n_swaps > n_qubits:
+            raise ValueError("Not a permutation")
+        if self.curr_instructions + n_swaps > self.n_instructions:
+            raise IndexError("Exceeded Length of Array")
+
+        ctypes.memmove(
+            ctypes.byref(self.ops, self.curr_instructions * ctypes.sizeof(OperationType)),
+            swaps,
+            n_swaps * ctypes.sizeof(OperationType))
+        self.curr_instructions += n_swaps
+        if n_swaps > 0:
+            moved = np.flatnonzero(perm != np.arange(n_qubits))
+            self.max_qubit_index = max(self.max_qubit_index, int(moved.max()))
+
+    @classmethod
+    def from_arrays(cls, opcodes, ctrl, targ=None, tags=None):
+        '''
+            from_arrays
+            Builds a sequence from arrays of operations, see extend_arrays
+        '''
+        seq = cls(len(opcodes))
+        seq.extend_arrays(opcodes, ctrl, targ=targ, tags=tags)
+        return seq
+
+    def extend_arrays(self, opcodes, ctrl, targ=None, tags=None):
+        '''
+            extend_arrays
+            Appends operations from arrays, writing directly into the operation buffer
+            :: opcodes : array_like :: Operation codes
+            :: ctrl : array_like :: Qubit of single qubit and rz operations, first qubit of all other operations
+            :: targ : array_like :: Optional, second qubit of two qubit and conditional operations
+            :: tags : array_like :: Optional, tags of rz operations, default to zero
+            Entries of targ and tags are ignored for operations that do not take them
+            No Python objects are constructed per operation
+        '''
+        opcodes = np.asarray(opcodes, dtype=np.uint8)
+        n_ops = len(opcodes)
+        if self.curr_instructions + n_ops > self.n_instructions:
+            raise IndexError("Exceeded Length of Array")
+        if not self.VALID_OPCODES[opcodes].all():
+            raise ValueError("Invalid Opcode")
+
+        two_operands = self.TWO_OPERAND_OPCODES[opcodes]
+        is_rz = RZ_MASK == (opcodes & OPCODE_TYPE_MASK)
+        ctrl = np.broadcast_to(np.asarray(ctrl, dtype=np.uint32), n_ops)
+
+        second = np.zeros(n_ops, dtype=np.uint32)
+        if targ is not None:
+            targ = np.broadcast_to(np.asarray(targ, dtype=np.uint32), n_ops)
+            np.copyto(second, targ, where=two_operands)
+        elif two_operands.any():
+            raise ValueError("Two qubit operations require a target")
+        if tags is not None:
+            np.copyto(second, np.broadcast_to(np.asarray(tags, dtype=np.uint32), n_ops), where=is_rz)
+
+        view = np.frombuffer(
+            self.ops,
+            dtype=OPERATION_DTYPE,
+            count=n_ops,
+            offset=self.curr_instructions * OPERATION_DTYPE.itemsize)
+        view['opcode'] = opcodes
+        view['ctrl'] = ctrl
+        view['targ'] = second
+
+        if n_ops > 0:
+            max_qubit_index = int(ctrl.max())
+            if two_operands.any():
+                max_qubit_index = max(max_qubit_index, int(second[two_operands].max()))
+            self.max_qubit_index = max(self.max_qubit_index, max_qubit_index)
+        self.n_rz_operations += int(np.count_nonzero(is_rz))
+        self.curr_instructions += n_ops
+
+    @property
+    def array(self):
+        '''
+            array
+            Structured NumPy view of the current operations, with fields opcode, ctrl and targ
+            Writes through the view act on the sequence in place
+        '''
+        return np.frombuffer(self.ops, dtype=OPERATION_DTYPE, count=self.curr_instructions)
+
+    def peephole(self, merge_rz: bool = False):
+        '''
+            peephole
+            Optimises the sequence in place before it is passed to a widget
+            Adjacent cancelling pairs of CNOT, CZ and local Cliffords are removed,
+             and H(b) CNOT(a, b) H(b) is replaced by CZ(a, b)
+            :: merge_rz : bool :: Merges Rz operations on a qubit separated only by diagonal gates,
+                tags must be angles encoded by RZ_angle
+            Returns the number of operations removed
+        '''
+        n_instructions = lib.peephole_optimise(
+            self.ops,
+            ctypes.c_size_t(self.curr_instructions),
+            ctypes.c_bool(merge_rz))
+        n_removed = self.curr_instructions - n_instructions
+        self.curr_instructions = n_instructions
+        self.n_rz_operations = int(np.count_nonzero(
+            RZ_MASK == (self.array['opcode'] & OPCODE_TYPE_MASK)))
+        return n_removed
+
     def _append(self, *operations):
         if self.curr_instructions + len(operations) > self.n_instructions:
             raise IndexError("Exceeded Length of Array")
@@ -153,41 +292,38 @@ class OperationSequence():
     def split(self, rz_threshold):
         '''
         Splits sequence on an rz threshold
+        Boundaries are found by a single scan in the c_lib
+        Each subsequence is a view of this sequence's operations, no operations are copied
+        Subsequences other than the last hold exactly rz_threshold rz operations
         '''
         if self.n_rz_operations < rz_threshold:
             return [self,]
 
-        sequences = list()
+        # Every block but the last holds at least rz_threshold operations
+        starts = (ctypes.c_size_t * (self.curr_instructions // rz_threshold + 2))()
+        n_blocks = lib.widget_sequence_split(
+            self.ops,
+            ctypes.c_size_t(self.curr_instructions),
+            ctypes.c_size_t(rz_threshold),
+            starts)
 
-        rz_instructions = 0
-        start_ops = 0
-        for i in range(self.n_instructions):
-            if self.ops[i].is_rz():
-                if rz_instructions < rz_threshold:
-                    rz_instructions += 1
-                else:
-                    sequences.append(self._subsequence(start_ops, i))
-                    rz_instructions = 1
-                    start_ops = i
-
-        # Final Sequence
-        sequences.append(self._subsequence(start_ops, i))
+        sequences = list()
+        for i in range(n_blocks):
+            n_rz_operations = rz_threshold
+            if i == n_blocks - 1:
+                n_rz_operations = self.n_rz_operations - rz_threshold * (n_blocks - 1)
+            sequences.append(self._subsequence(starts[i], starts[i + 1], n_rz_operations))
         return sequences
 
-    def _subsequence(self, start, end):
+    def _subsequence(self, start, end, n_rz_operations=None):
         '''
-            Copies a subsequence from self to a new sequence
+            Creates a view of a subsequence of self
+            :: start : int :: First operation of the view
+            :: end : int :: One past the last operation of the view
+            :: n_rz_operations : int :: Optional, number of rz operations in the range,
+                counted if not provided
         '''
-        sequence_length = end - start
-        seq = OperationSequence(sequence_length)
-        seq.curr_instructions = sequence_length
-        seq.n_instructions = sequence_length
-        seq.max_qubit_index = self.max_qubit_index
-        for j in range(sequence_length):
-            if self[start + j].is_rz():
-                seq.n_rz_operations += 1
-            seq[j] = self[start + j]
-        return seq
+        return OperationSequenceView(self, start, end, n_rz_operations)
 
     @staticmethod
     def op_dump(ops):
@@ -229,3 +365,37 @@ class OperationSequence():
         self.curr_instructions = state['curr_instructions']
         self.max_qubit_index = state['max_qubit_index']
         self.n_rz_operations = state['n_rz_operations']
+
+
+class OperationSequenceView(OperationSequence):
+    '''
+        View of a range of the operations of another sequence
+        The view shares the buffer of the parent sequence and keeps it alive,
+        writes through the view are visible in the parent
+        Views are full, operations may not be appended
+        :: parent : OperationSequence :: Sequence to view
+        :: start : int :: First operation of the view
+        :: end : int :: One past the last operation of the view
+        :: n_rz_operations : int :: Optional, number of rz operations in the range,
+            counted if not provided
+    '''
+    def __init__(self, parent: OperationSequence, start: int, end: int, n_rz_operations: int = None):
+        if not 0 <= start <= end <= parent.curr_instructions:
+            raise IndexError("Subsequence exceeds the parent sequence")
+
+        sequence_length = end - start
+        self.n_instructions = sequence_length
+        self.curr_instructions = sequence_length
+        self.ops = (OperationType * sequence_length).from_buffer(
+            parent.ops, start * ctypes.sizeof(OperationType))
+        self.max_qubit_index = parent.max_qubit_index
+
+        if n_rz_operations is None:
+            n_rz_operations = sum(1 for op in self if op.is_rz())
+        self.n_rz_operations = n_rz_operations
+
+    def peephole(self, merge_rz: bool = False):
+        '''
+            Views may not be optimised, compacting the view would leave stale operations in the parent
+        '''
+        raise TypeError("Views of a sequence may not be optimised in place")
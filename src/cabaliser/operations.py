@@ -4,7 +4,7 @@
 from itertools import chain, repeat
 
 from ctypes import Structure, Union, c_uint32, c_uint8
-from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES, LOCAL_CLIFFORD_MASK, NON_LOCAL_CLIFFORD_MASK, RZ_MASK, OPCODE_TYPE_MASK, RZ_GATES, CONDITIONAL_OPERATION_GATES, SINGLE_QUBIT_GATE_ARR
+from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES, PERMUTATION_GATES, LOCAL_CLIFFORD_MASK, NON_LOCAL_CLIFFORD_MASK, RZ_MASK, OPCODE_TYPE_MASK, RZ_GATES, CONDITIONAL_OPERATION_GATES, SINGLE_QUBIT_GATE_ARR
 from cabaliser.utils import unbound_table_element
 
 OpcodeType = c_uint8
@@ -149,6 +149,7 @@ opcode_map = [unbound_table_element for _ in range(256)]
 for idx, fn in chain(
     zip(SINGLE_QUBIT_GATES, repeat(lambda x: x.single)),
     zip(TWO_QUBIT_GATES, repeat(lambda x: x.two_qubits)),
+    zip(PERMUTATION_GATES, repeat(lambda x: x.two_qubits)),
     zip(RZ_GATES, repeat(lambda x: x.rz)),
     zip(CONDITIONAL_OPERATION_GATES, repeat(lambda x: x.cond_op))
     ):
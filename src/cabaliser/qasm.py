@@ -0,0 +1,82 @@
+'''
+    OpenQASM
+    Clifford, Rz and conditioned Pauli subset of OpenQASM 2 and 3, parsed by the c_lib
+'''
+from ctypes import c_bool, c_char_p, c_int, c_size_t, cast
+
+from cabaliser.instruction_file import INSTRUCTION_FILE_FIXED, INSTRUCTION_FILE_PACKED
+from cabaliser.utils import void_p
+
+from cabaliser.lib_cabaliser import lib
+lib.qasm_parser_create.restype = void_p  # Opaque Pointer
+lib.qasm_parser_read_file.restype = c_bool
+lib.qasm_parser_get_n_qubits.restype = c_size_t
+lib.qasm_parser_get_n_bits.restype = c_size_t
+lib.qasm_parser_get_n_instructions.restype = c_size_t
+lib.qasm_parser_get_n_rz.restype = c_size_t
+lib.qasm_parser_get_line.restype = c_size_t
+lib.qasm_parser_get_error.restype = c_char_p
+lib.instruction_file_writer_open.restype = void_p  # Opaque Pointer
+lib.instruction_file_writer_close.restype = c_bool
+
+# Emitters passed to the parser
+QASM_EMIT_WIDGET = cast(lib.qasm_emit_widget, void_p)
+QASM_EMIT_INSTRUCTION_FILE = cast(lib.qasm_emit_instruction_file, void_p)
+
+
+class QasmFile():
+    '''
+        OpenQASM source file
+        The file is scanned on construction to count its qubits and operations,
+        and is parsed again each time it is passed to a widget
+        May be passed to a Widget in place of an OperationSequence
+        :: path : str :: Path of the source file
+    '''
+    def __init__(self, path: str):
+        self.path = path
+        parser = self.__read(None, None)
+        self.max_qubit_index = lib.qasm_parser_get_n_qubits(parser)
+        self.n_bits = lib.qasm_parser_get_n_bits(parser)
+        self.curr_instructions = lib.qasm_parser_get_n_instructions(parser)
+        self.n_instructions = self.curr_instructions
+        self.n_rz_operations = lib.qasm_parser_get_n_rz(parser)
+        lib.qasm_parser_destroy(parser)
+
+    def __len__(self):
+        return self.curr_instructions
+
+    def __read(self, emit, ctx):
+        '''
+            Parses the file, raising on errors
+            Returns the parser, which must be destroyed by the caller
+        '''
+        parser = lib.qasm_parser_create(emit, ctx)
+        if not lib.qasm_parser_read_file(parser, str(self.path).encode()):
+            error = lib.qasm_parser_get_error(parser).decode()
+            line = lib.qasm_parser_get_line(parser)
+            lib.qasm_parser_destroy(parser)
+            raise ValueError(f"{self.path}:{line}: {error}")
+        return parser
+
+    def parse(self, widget):
+        '''
+            Parses the file into a widget
+            :: widget : POINTER(WidgetType) :: Widget of at least max_qubit_index qubits
+        '''
+        lib.qasm_parser_destroy(self.__read(QASM_EMIT_WIDGET, widget))
+
+    def write(self, path: str, packed: bool = False):
+        '''
+            Converts the file to a binary instruction stream, see InstructionFile
+            :: path : str :: Path of the instruction file, any existing file is replaced
+            :: packed : bool :: Packs instructions into a variable length encoding
+        '''
+        encoding = INSTRUCTION_FILE_PACKED if packed else INSTRUCTION_FILE_FIXED
+        writer = lib.instruction_file_writer_open(str(path).encode(), c_int(encoding))
+        if not writer:
+            raise OSError(f"Could not create instruction file {path}")
+        try:
+            lib.qasm_parser_destroy(self.__read(QASM_EMIT_INSTRUCTION_FILE, writer))
+        finally:
+            if not lib.instruction_file_writer_close(writer):
+                raise OSError(f"Could not write instruction file {path}")
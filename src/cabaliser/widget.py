@@ -5,6 +5,9 @@
 from ctypes import POINTER, c_buffer
 
 from cabaliser.operation_sequence import OperationSequence
+from cabaliser.instruction_file import InstructionFile
+from cabaliser.instruction_ring import InstructionRing, INSTRUCTION_RING_CAPACITY
+from cabaliser.qasm import QasmFile
 from cabaliser.structs import AdjacencyType, WidgetType
 from cabaliser.structs import LocalCliffordType, MeasurementTagType, IOMapType
 from cabaliser.io_array_wrappers import MeasurementTags, LocalCliffords, IOMap
@@ -19,6 +22,7 @@ from cabaliser import local_simulator
 from cabaliser.lib_cabaliser import lib
 # Override return type
 lib.widget_create.restype = POINTER(WidgetType)
+lib.widget_pool_acquire.restype = POINTER(WidgetType)
 
 
 class Widget():
@@ -26,7 +30,7 @@ class Widget():
         Widget object
         Exposes an API to the cabaliser c_lib's widget object
     '''
-    def __init__(self, n_qubits: int, n_qubits_max: int, teleport_input: bool = True, n_inputs: int=None):
+    def __init__(self, n_qubits: int, n_qubits_max: int, teleport_input: bool = True, n_inputs: int=None, pooled: bool = False):
         '''
             __init__
             Constructor for the widget
@@ -35,6 +39,8 @@ class Widget():
             :: n_qubits_max : int :: Maximum size of the widget 
             :: teleport_input : bool :: Whether the inputs should be teleported
             :: n_inputs : int :: Optional, If the number of inputs differs from the size of the register   
+            :: pooled : bool :: Reuses the buffers of a released widget with the same maximum size,
+                and releases this widget's buffers for reuse when it is freed 
         '''
         self.decomposed = False
 
@@ -45,7 +51,11 @@ class Widget():
 
         self.n_inputs = n_inputs
 
-        self.widget = lib.widget_create(n_qubits, n_qubits_max)
+        self.pooled = pooled
+        if self.pooled:
+            self.widget = lib.widget_pool_acquire(n_qubits, n_qubits_max)
+        else:
+            self.widget = lib.widget_create(n_qubits, n_qubits_max)
         self.teleport_input = teleport_input
 
         if self.teleport_input:
@@ -58,6 +68,30 @@ class Widget():
         self.io_map = None
         self.pauli_tracker = PauliTracker(self)
 
+    @classmethod
+    def from_compiled(cls, widget_ptr, pooled: bool = True):
+        '''
+            from_compiled
+            Wraps a widget that has already been teleported, parsed and decomposed in the c_lib
+            :: widget_ptr : POINTER(WidgetType) :: Widget, ownership passes to the wrapper
+            :: pooled : bool :: Whether the widget is released to the pool when it is freed
+        '''
+        wid = cls.__new__(cls)
+        wid.decomposed = False
+        wid.widget = widget_ptr
+        wid.pooled = pooled
+        wid.teleport_input = True
+        wid.n_inputs = wid.n_initial_qubits
+
+        wid.local_cliffords = None
+        wid.measurement_tags = None
+        wid.io_map = None
+        wid.pauli_tracker = PauliTracker(wid)
+
+        wid.__schedule()
+        wid.decomposed = True
+        return wid
+
     def get_n_qubits(self) -> int:
         '''
             get_n_qubits
@@ -116,14 +150,30 @@ class Widget():
     def process_operations(self, operations: OperationSequence):
         '''
             Parses an array of operations
-            :: operations: Operations :: Wrapper around an array of operations
+            :: operations: Operations :: Wrapper around an array of operations, an InstructionFile or a QasmFile
             Acts in place on the widget
         '''
+        if isinstance(operations, (InstructionFile, QasmFile)):
+            operations.parse(self.widget)
+            return
+
         lib.parse_instruction_block(
             self.widget,
             operations.ops,
             operations.curr_instructions)
 
+    def process_stream(self, source, packed: bool = False, capacity: int = INSTRUCTION_RING_CAPACITY) -> int:
+        '''
+            Parses a stream of operations through a bounded ring buffer
+            :: source : Iterable[OperationSequence] | int | file :: Generator of operation sequences,
+                or a file descriptor or file object holding a raw instruction stream
+            :: packed : bool :: Whether a raw instruction stream uses the packed encoding
+            :: capacity : int :: Maximum number of instructions buffered ahead of the widget
+            The source is read on another thread while the widget parses
+            Returns the number of operations parsed
+        '''
+        return InstructionRing(capacity).stream(self.widget, source, packed)
+
     def __call__(self, *args, **kwargs):
         '''
             Consumes a list of operations
@@ -136,7 +186,10 @@ class Widget():
             Explicit destructor for the widget
             Frees the underlying C object
         '''
-        lib.widget_destroy(self.widget)
+        if self.pooled:
+            lib.widget_pool_release(self.widget)
+        else:
+            lib.widget_destroy(self.widget)
 
     def json(self, rz_to_float=False, local_clifford_to_string=True):
         '''
@@ -259,11 +312,16 @@ class Widget():
         return adj
 
     @require_not_decomposed
-    def decompose(self):
+    def decompose(self, m4ri=False):
         '''
             Decomposes the operation sequence into an algorithmically specific graph (asg)
+            :: m4ri : bool :: Eliminates using tables of pivot row products
+                This produces the same graph and is typically faster on wide widgets
         '''
-        lib.widget_decompose(self.widget)
+        if m4ri:
+            lib.widget_decompose_m4ri(self.widget)
+        else:
+            lib.widget_decompose(self.widget)
 
         # Create the measurement schedule
         self.__schedule()
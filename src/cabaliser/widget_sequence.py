@@ -2,10 +2,21 @@
 Widget Sequence
 """
 
+from ctypes import POINTER, c_size_t
+
 from cabaliser.widget import Widget
 from cabaliser.operation_sequence import OperationSequence
+from cabaliser.instruction_file import InstructionFile
+from cabaliser.structs import WidgetType
+from cabaliser.utils import void_p
 from cabaliser import exceptions
 
+from cabaliser.lib_cabaliser import lib
+lib.widget_sequence_create.restype = void_p  # Opaque Pointer
+lib.widget_sequence_create_file.restype = void_p  # Opaque Pointer
+lib.widget_sequence_get_n_widgets.restype = c_size_t
+lib.widget_sequence_next.restype = POINTER(WidgetType)
+
 class WidgetSequence:
     """
     Creates a sequence of widget objects
@@ -53,30 +64,86 @@ class WidgetSequence:
         ops: OperationSequence,
         progress: bool = False,
         json_output: bool = False,
+        n_threads: int = None,
         **widget_args
     ):
         """
         Processes an operations sequence
-        :: ops : OperationSequence :: Sequence of operations to split and process
+        :: ops : OperationSequence :: Sequence of operations to split and process, or an InstructionFile
         :: progress : bool :: Simple progress printer
         :: json_output : bool :: Whether to yield json objects or widgets 
+        :: n_threads : int :: Optional, compiles widgets concurrently in the c_lib on this many threads,
+            zero uses every core
         :: **widget_args :: Args for the widget
             - rz_to_float=False
             - local_clifford_to_string=True 
+        Widgets are drawn from the widget pool, each reuses the buffers of a freed widget
+        """
+        # Instruction files are only split by the c_lib
+        if isinstance(ops, InstructionFile) and n_threads is None:
+            n_threads = 1
+
+        if n_threads is not None:
+            widgets = self._compile_concurrent(ops, n_threads, progress)
+        else:
+            widgets = self._compile_serial(ops, progress)
+
+        for wid in widgets:
+            if json_output:
+                self._json.append(wid.json(**widget_args))
+                # Returns the buffers to the pool before the next widget is created
+                del wid
+                yield None
+            else:
+                yield wid
+
+    def _compile_serial(self, ops: OperationSequence, progress: bool):
+        """
+        Splits and compiles widgets one at a time
         """
         ops_sequence = ops.split(self.rz_threshold)
         for i, seq in enumerate(ops_sequence):
             if progress:
                 print(f"\r{i + 1} of {len(ops_sequence)}", flush=True, end="")
 
-            wid = Widget(self.qubit_width, self.max_qubits)
+            wid = Widget(self.qubit_width, self.max_qubits, pooled=True)
             wid(seq)
             wid.decompose()
+            yield wid
+            # Drops this frame's reference so the consumer may return the buffers to the pool
+            del wid
 
-            if json_output:
-                yield self._json.append(wid.json(**widget_args))
-            else:
-                yield wid
+    def _compile_concurrent(self, ops: OperationSequence, n_threads: int, progress: bool):
+        """
+        Splits and compiles widgets on c_lib threads
+        Widgets are compiled ahead of the consumer, bounded by the sequence window
+        """
+        if isinstance(ops, InstructionFile):
+            seq = lib.widget_sequence_create_file(
+                ops.file,
+                c_size_t(self.qubit_width),
+                c_size_t(self.max_qubits),
+                c_size_t(n_threads),
+                c_size_t(0)
+            )
+        else:
+            seq = lib.widget_sequence_create(
+                ops.ops,
+                c_size_t(ops.curr_instructions),
+                c_size_t(self.qubit_width),
+                c_size_t(self.max_qubits),
+                c_size_t(n_threads),
+                c_size_t(0)
+            )
+        try:
+            n_widgets = lib.widget_sequence_get_n_widgets(seq)
+            for i in range(n_widgets):
+                if progress:
+                    print(f"\r{i + 1} of {n_widgets}", flush=True, end="")
+                yield Widget.from_compiled(lib.widget_sequence_next(seq))
+        finally:
+            # Joins the compile threads while ops still holds the instruction array
+            lib.widget_sequence_destroy(seq)
 
     def __iter__(self, *args, **kwargs):
         """
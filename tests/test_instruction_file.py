@@ -0,0 +1,100 @@
+import os
+import tempfile
+import unittest
+from cabaliser import gates
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.instruction_file import InstructionFile, InstructionFileWriter
+from cabaliser.widget import Widget
+from cabaliser.widget_sequence import WidgetSequence
+
+
+class InstructionFileTest(unittest.TestCase):
+
+    def setUp(self):
+        fd, self.path = tempfile.mkstemp(suffix='.cab')
+        os.close(fd)
+
+    def tearDown(self):
+        os.unlink(self.path)
+
+    def test_header(self):
+        ops = ghz_ops(12)
+        InstructionFile.write(self.path, ops)
+
+        stream = InstructionFile(self.path)
+        self.assertEqual(len(stream), ops.curr_instructions)
+        self.assertEqual(stream.n_rz_operations, ops.n_rz_operations)
+        self.assertEqual(stream.max_qubit_index, 12)
+        for i in range(len(stream)):
+            self.assertEqual(stream[i].single.opcode, ops[i].single.opcode)
+        stream.close()
+
+    def test_header_packed(self):
+        ops = ghz_ops(12)
+        InstructionFile.write(self.path, ops, packed=True)
+
+        stream = InstructionFile(self.path)
+        self.assertTrue(stream.packed)
+        self.assertEqual(len(stream), ops.curr_instructions)
+        self.assertEqual(stream.n_rz_operations, ops.n_rz_operations)
+        self.assertEqual(stream.max_qubit_index, 12)
+        self.assertLess(stream.n_bytes, 4 * ops.curr_instructions)
+        stream.close()
+
+    def test_widget(self):
+        self.__test_widget(False)
+
+    def test_widget_packed(self):
+        self.__test_widget(True)
+
+    def test_widget_sequence(self):
+        self.__test_widget_sequence(False)
+
+    def test_widget_sequence_packed(self):
+        self.__test_widget_sequence(True)
+
+    def __test_widget(self, packed):
+        n_qubits = 12
+        ops = ghz_ops(n_qubits)
+        with InstructionFileWriter(self.path, packed=packed) as writer:
+            writer.append(ops)
+
+        wid = Widget(n_qubits, 4 * n_qubits)
+        wid(ops)
+        wid.decompose()
+
+        wid_file = Widget(n_qubits, 4 * n_qubits)
+        wid_file(InstructionFile(self.path))
+        wid_file.decompose()
+
+        self.assertEqual(wid.n_qubits, wid_file.n_qubits)
+        for i in range(wid.n_qubits):
+            self.assertEqual(
+                wid.get_adjacencies(i).to_list(),
+                wid_file.get_adjacencies(i).to_list()
+            )
+
+    def __test_widget_sequence(self, packed):
+        n_qubits = 8
+        ops = ghz_ops(n_qubits)
+        with InstructionFileWriter(self.path, packed=packed) as writer:
+            for _ in range(16):
+                writer.append(ops)
+
+        seq = WidgetSequence(n_qubits, 3 * n_qubits)
+        widgets = seq.widgetise_operation_sequence(InstructionFile(self.path), json_output=False)
+        self.assertEqual(len(widgets), (16 * ops.n_rz_operations + n_qubits - 1) // n_qubits)
+
+
+def ghz_ops(n_qubits):
+    ops = OperationSequence(3 * n_qubits)
+    ops.append(gates.H, 0)
+    for i in range(n_qubits - 1):
+        ops.append(gates.CNOT, i, i + 1)
+    for i in range(n_qubits):
+        ops.append(gates.RZ, i, i)
+    return ops
+
+
+if __name__ == '__main__':
+    unittest.main()
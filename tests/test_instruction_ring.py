@@ -0,0 +1,128 @@
+import os
+import tempfile
+import threading
+import unittest
+from ctypes import sizeof
+from cabaliser import gates
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.operations import OperationType
+from cabaliser.instruction_file import InstructionFile
+from cabaliser.widget import Widget
+
+# Instructions follow the header of an instruction file
+INSTRUCTION_FILE_HEADER_BYTES = 64
+
+
+class InstructionRingTest(unittest.TestCase):
+
+    def test_generator(self):
+        n_qubits = 8
+        n_blocks = 12
+        ops = ghz_ops(n_qubits)
+
+        def blocks():
+            for _ in range(n_blocks):
+                yield ops
+
+        wid = Widget(n_qubits, (n_blocks + 2) * n_qubits)
+        for _ in range(n_blocks):
+            wid(ops)
+        wid.decompose()
+
+        # A ring smaller than each block forces the producer to wait on the widget
+        wid_ring = Widget(n_qubits, (n_blocks + 2) * n_qubits)
+        self.assertEqual(wid_ring.process_stream(blocks(), capacity=4), n_blocks * ops.curr_instructions)
+        wid_ring.decompose()
+
+        self.assert_widgets_equal(wid, wid_ring)
+
+    def test_generator_exception(self):
+        def blocks():
+            yield ghz_ops(4)
+            raise ValueError("Generator failed")
+
+        wid = Widget(4, 32)
+        with self.assertRaises(ValueError):
+            wid.process_stream(blocks())
+
+    def test_pipe(self):
+        n_qubits = 8
+        ops = ghz_ops(n_qubits)
+        raw = bytes(ops.ops)[:ops.curr_instructions * sizeof(OperationType)]
+
+        read_fd, write_fd = os.pipe()
+
+        def write():
+            with os.fdopen(write_fd, 'wb') as pipe:
+                pipe.write(raw)
+
+        writer = threading.Thread(target=write)
+        writer.start()
+
+        wid = Widget(n_qubits, 4 * n_qubits)
+        wid(ops)
+        wid.decompose()
+
+        wid_ring = Widget(n_qubits, 4 * n_qubits)
+        self.assertEqual(wid_ring.process_stream(read_fd), ops.curr_instructions)
+        wid_ring.decompose()
+        writer.join()
+        os.close(read_fd)
+
+        self.assert_widgets_equal(wid, wid_ring)
+
+    def test_packed_file(self):
+        n_qubits = 8
+        ops = ghz_ops(n_qubits)
+        fd, path = tempfile.mkstemp(suffix='.cab')
+        os.close(fd)
+        try:
+            InstructionFile.write(path, ops, packed=True)
+
+            wid = Widget(n_qubits, 4 * n_qubits)
+            wid(ops)
+            wid.decompose()
+
+            wid_ring = Widget(n_qubits, 4 * n_qubits)
+            with open(path, 'rb') as stream:
+                stream.seek(INSTRUCTION_FILE_HEADER_BYTES)
+                self.assertEqual(wid_ring.process_stream(stream, packed=True), ops.curr_instructions)
+            wid_ring.decompose()
+
+            self.assert_widgets_equal(wid, wid_ring)
+        finally:
+            os.unlink(path)
+
+    def test_truncated_stream(self):
+        ops = ghz_ops(4)
+        raw = bytes(ops.ops)[:ops.curr_instructions * sizeof(OperationType) - 1]
+        read_fd, write_fd = os.pipe()
+        os.write(write_fd, raw)
+        os.close(write_fd)
+
+        wid = Widget(4, 16)
+        with self.assertRaises(OSError):
+            wid.process_stream(read_fd)
+        os.close(read_fd)
+
+    def assert_widgets_equal(self, wid_a, wid_b):
+        self.assertEqual(wid_a.n_qubits, wid_b.n_qubits)
+        for i in range(wid_a.n_qubits):
+            self.assertEqual(
+                wid_a.get_adjacencies(i).to_list(),
+                wid_b.get_adjacencies(i).to_list()
+            )
+
+
+def ghz_ops(n_qubits):
+    ops = OperationSequence(3 * n_qubits)
+    ops.append(gates.H, 0)
+    for i in range(n_qubits - 1):
+        ops.append(gates.CNOT, i, i + 1)
+    for i in range(n_qubits):
+        ops.append(gates.RZ, i, i)
+    return ops
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,79 @@
+import unittest
+import numpy as np
+from cabaliser import gates
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.widget import Widget
+
+
+class OperationSequenceArrayTest(unittest.TestCase):
+
+    def test_matches_append(self):
+        ops = OperationSequence(6)
+        ops.append(gates.H, 3)
+        ops.append(gates.CNOT, 1, 5)
+        ops.append(gates.RZ, 2, 9)
+        ops.append(gates.MEAS, 4)
+        ops.append(gates.MCX, 0, 7)
+        ops.append(gates.CZ, 6, 2)
+
+        seq = OperationSequence.from_arrays(
+            [gates.H, gates.CNOT, gates.RZ, gates.MEAS, gates.MCX, gates.CZ],
+            [3, 1, 2, 4, 0, 6],
+            targ=[100, 5, 100, 100, 7, 2],
+            tags=[100, 100, 9, 100, 100, 100]
+        )
+
+        self.assertEqual(bytes(seq.ops), bytes(ops.ops))
+        self.assertEqual(seq.curr_instructions, ops.curr_instructions)
+        self.assertEqual(seq.n_rz_operations, 1)
+        self.assertEqual(seq.max_qubit_index, 7)
+
+        view = seq.array
+        self.assertEqual(list(view['opcode']), [op.opcode for op in ops])
+        view['ctrl'][0] = 5
+        self.assertEqual(seq[0].single.arg, 5)
+
+    def test_extend(self):
+        n_qubits = 16
+        ops = OperationSequence(3 * n_qubits)
+        ops.append(gates.H, 0)
+        for i in range(n_qubits - 1):
+            ops.append(gates.CNOT, i, i + 1)
+        for i in range(n_qubits):
+            ops.append(gates.RZ, i, i)
+
+        seq = OperationSequence(3 * n_qubits)
+        seq.extend_arrays([gates.H], [0])
+        seq.extend_arrays(np.full(n_qubits - 1, gates.CNOT), np.arange(n_qubits - 1), targ=np.arange(1, n_qubits))
+        seq.extend_arrays(np.full(n_qubits, gates.RZ), np.arange(n_qubits), tags=np.arange(n_qubits))
+        self.assertEqual(bytes(seq.ops), bytes(ops.ops))
+        self.assertEqual(seq.n_rz_operations, n_qubits)
+
+        wid = Widget(n_qubits, 4 * n_qubits)
+        wid(ops)
+        wid.decompose()
+
+        wid_arrays = Widget(n_qubits, 4 * n_qubits)
+        wid_arrays(seq)
+        wid_arrays.decompose()
+
+        self.assertEqual(wid.n_qubits, wid_arrays.n_qubits)
+        for i in range(wid.n_qubits):
+            self.assertEqual(
+                wid.get_adjacencies(i).to_list(),
+                wid_arrays.get_adjacencies(i).to_list()
+            )
+
+    def test_invalid(self):
+        seq = OperationSequence(2)
+        with self.assertRaises(ValueError):
+            seq.extend_arrays([0xff], [0])
+        with self.assertRaises(ValueError):
+            seq.extend_arrays([gates.CNOT], [0])
+        with self.assertRaises(IndexError):
+            seq.extend_arrays([gates.H] * 3, [0] * 3)
+        self.assertEqual(seq.curr_instructions, 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
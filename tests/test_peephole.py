@@ -0,0 +1,90 @@
+import unittest
+from math import pi
+import numpy as np
+from cabaliser import gates
+from cabaliser.gate_constructors import RZ_angle
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.widget import Widget
+
+
+def append_rz(ops, targ, angle):
+    opcode, args = RZ_angle(targ, angle)
+    ops.append(opcode, *args)
+
+
+class PeepholeTest(unittest.TestCase):
+
+    def test_cancellation(self):
+        ops = OperationSequence(8)
+        ops.append(gates.CNOT, 0, 1)
+        ops.append(gates.H, 2)
+        ops.append(gates.CZ, 1, 0)
+        ops.append(gates.CZ, 0, 1)
+        ops.append(gates.CNOT, 0, 1)
+        ops.append(gates.H, 1)
+        ops.append(gates.CNOT, 2, 1)
+        ops.append(gates.H, 1)
+
+        self.assertEqual(ops.peephole(), 6)
+        self.assertEqual([op.opcode for op in ops], [gates.H, gates.CZ])
+        self.assertEqual((ops[1].two_qubits.ctrl, ops[1].two_qubits.targ), (2, 1))
+
+    def test_equivalence(self):
+        rng = np.random.default_rng(0)
+        n_qubits = 4
+        n_ops = 2000
+        opcodes = rng.choice([gates.H, gates.S, gates.Sd, gates.CNOT, gates.CZ], n_ops)
+        ctrl = rng.integers(n_qubits, size=n_ops)
+        targ = (ctrl + rng.integers(1, n_qubits, size=n_ops)) % n_qubits
+
+        ops = OperationSequence.from_arrays(opcodes, ctrl, targ=targ)
+        optimised = OperationSequence.from_arrays(opcodes, ctrl, targ=targ)
+        self.assertGreater(optimised.peephole(), 0)
+
+        wid = Widget(n_qubits, 2 * n_qubits)
+        wid(ops)
+        wid.decompose()
+
+        wid_opt = Widget(n_qubits, 2 * n_qubits)
+        wid_opt(optimised)
+        wid_opt.decompose()
+
+        self.assertEqual(wid.n_qubits, wid_opt.n_qubits)
+        for i in range(wid.n_qubits):
+            self.assertEqual(
+                wid.get_adjacencies(i).to_list(),
+                wid_opt.get_adjacencies(i).to_list()
+            )
+
+    def test_merge_rz(self):
+        ops = OperationSequence(6)
+        append_rz(ops, 0, pi / 4)
+        ops.append(gates.CZ, 0, 1)
+        append_rz(ops, 0, pi / 4)
+        append_rz(ops, 1, 0.1)
+        append_rz(ops, 1, 0.2)
+        ops.append(gates.H, 1)
+        self.assertEqual(ops.n_rz_operations, 4)
+
+        self.assertEqual(ops.peephole(), 0)
+        self.assertEqual(ops.peephole(merge_rz=True), 2)
+        self.assertEqual(ops.n_rz_operations, 1)
+        self.assertEqual(
+            [op.opcode for op in ops],
+            [gates.S, gates.CZ, gates.RZ, gates.H])
+
+        wid = Widget(2, 8)
+        wid(ops)
+        wid.decompose()
+        self.assertEqual(wid.n_qubits, 2 * 2 + 1)
+
+    def test_view(self):
+        ops = OperationSequence(4)
+        for i in range(4):
+            ops.append(gates.RZ, 0, i)
+        with self.assertRaises(TypeError):
+            ops.split(2)[0].peephole()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,107 @@
+import os
+import tempfile
+import unittest
+from cabaliser import gates
+from cabaliser.gate_constructors import RZ_angle
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.instruction_file import InstructionFile
+from cabaliser.qasm import QasmFile
+from cabaliser.widget import Widget
+from cabaliser.widget_sequence import WidgetSequence
+
+QFT_QASM = '''
+OPENQASM 2.0;
+include "qelib1.inc";
+qreg q[4];
+h q[0];
+cx q[0], q[1];
+rz(0.25) q[1];
+cx q[0], q[1];
+rz(-0.25) q[1];
+h q[1];
+swap q[1], q[3];
+t q[2];
+cz q[2], q[3];
+s q[3];
+rz(pi) q[0];
+'''
+
+
+def append_rz(ops, targ, angle):
+    opcode, args = RZ_angle(targ, angle)
+    ops.append(opcode, *args)
+
+
+def qft_ops():
+    ops = OperationSequence(32)
+    ops.append(gates.H, 0)
+    ops.append(gates.CNOT, 0, 1)
+    append_rz(ops, 1, 0.25)
+    ops.append(gates.CNOT, 0, 1)
+    append_rz(ops, 1, -0.25)
+    ops.append(gates.H, 1)
+    ops.append(gates.SWAP, 1, 3)
+    append_rz(ops, 2, 0.7853981633974483)
+    ops.append(gates.CZ, 2, 3)
+    ops.append(gates.S, 3)
+    ops.append(gates.Z, 0)
+    return ops
+
+
+class QasmTest(unittest.TestCase):
+
+    def setUp(self):
+        fd, self.path = tempfile.mkstemp(suffix='.qasm')
+        with os.fdopen(fd, 'w') as source:
+            source.write(QFT_QASM)
+
+    def tearDown(self):
+        os.unlink(self.path)
+
+    def test_scan(self):
+        qasm = QasmFile(self.path)
+        ops = qft_ops()
+        self.assertEqual(qasm.max_qubit_index, 4)
+        self.assertEqual(len(qasm), ops.curr_instructions)
+        self.assertEqual(qasm.n_rz_operations, 3)
+
+    def test_widget(self):
+        ops = qft_ops()
+        wid = Widget(4, 16)
+        wid(ops)
+        wid.decompose()
+
+        wid_qasm = Widget(4, 16)
+        wid_qasm(QasmFile(self.path))
+        wid_qasm.decompose()
+
+        self.assertEqual(wid.json(), wid_qasm.json())
+
+    def test_instruction_file(self):
+        fd, path = tempfile.mkstemp(suffix='.cab')
+        os.close(fd)
+        try:
+            QasmFile(self.path).write(path, packed=True)
+            stream = InstructionFile(path)
+            self.assertEqual(len(stream), qft_ops().curr_instructions)
+            widgets = WidgetSequence(4, 10).widgetise_operation_sequence(stream, json_output=False)
+            self.assertEqual(len(widgets), 2)
+            stream.close()
+        finally:
+            os.unlink(path)
+
+    def test_error(self):
+        with open(self.path, 'a') as source:
+            source.write('ccx q[0], q[1], q[2];\n')
+        with self.assertRaisesRegex(ValueError, 'unsupported gate ccx'):
+            QasmFile(self.path)
+
+    def test_non_finite_angle(self):
+        with open(self.path, 'a') as source:
+            source.write('rz(pi/0) q[0];\n')
+        with self.assertRaisesRegex(ValueError, 'division by zero'):
+            QasmFile(self.path)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,97 @@
+import unittest
+import numpy as np
+from cabaliser import gates
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.widget import Widget
+
+
+def random_sequence(rng, n_qubits, n_ops, swaps):
+    '''
+        random_sequence
+        Returns a random sequence and the sequence with its swaps replaced by relabelling later operations
+        Also returns the qubit holding the state of each qubit at the end of the relabelled sequence
+    '''
+    opcodes = [gates.H, gates.S, gates.CNOT, gates.CZ] + ([gates.SWAP] if swaps else [])
+    ops = OperationSequence(n_ops)
+    relabelled = OperationSequence(n_ops)
+    labels = list(range(n_qubits))
+    for opcode in rng.choice(opcodes, n_ops):
+        ctrl = int(rng.integers(n_qubits))
+        targ = (ctrl + int(rng.integers(1, n_qubits))) % n_qubits
+        if opcode in gates.SINGLE_QUBIT_GATES:
+            ops.append(opcode, ctrl)
+            relabelled.append(opcode, labels[ctrl])
+        else:
+            ops.append(opcode, ctrl, targ)
+            if opcode == gates.SWAP:
+                labels[ctrl], labels[targ] = labels[targ], labels[ctrl]
+            else:
+                relabelled.append(opcode, labels[ctrl], labels[targ])
+    return ops, relabelled, labels
+
+
+class SwapTest(unittest.TestCase):
+
+    def test_relabel(self):
+        rng = np.random.default_rng(0)
+        n_qubits = 6
+        ops, relabelled, labels = random_sequence(rng, n_qubits, 500, True)
+
+        wid = Widget(n_qubits, 2 * n_qubits)
+        wid(ops)
+        wid.decompose()
+
+        wid_relabelled = Widget(n_qubits, 2 * n_qubits)
+        wid_relabelled(relabelled)
+        wid_relabelled.decompose()
+
+        self.assertEqual(wid.n_qubits, wid_relabelled.n_qubits)
+        for i in range(wid.n_qubits):
+            self.assertEqual(
+                wid.get_adjacencies(i).to_list(),
+                wid_relabelled.get_adjacencies(i).to_list()
+            )
+
+        io_map = wid.get_io_map()
+        io_map_relabelled = wid_relabelled.get_io_map()
+        for i in range(n_qubits):
+            self.assertEqual(io_map[i], io_map_relabelled[labels[i]])
+
+    def test_append_permutation(self):
+        rng = np.random.default_rng(1)
+        n_qubits = 32
+        perm = rng.permutation(n_qubits)
+
+        ops = OperationSequence(n_qubits)
+        ops.append_permutation(perm)
+        self.assertLess(len(ops), n_qubits)
+        self.assertEqual(ops.max_qubit_index, int(np.flatnonzero(perm != np.arange(n_qubits)).max()))
+
+        labels = list(range(n_qubits))
+        for op in ops:
+            self.assertEqual(op.opcode, gates.SWAP)
+            a, b = op.two_qubits.ctrl, op.two_qubits.targ
+            labels[a], labels[b] = labels[b], labels[a]
+        for i in range(n_qubits):
+            self.assertEqual(labels[perm[i]], i)
+
+    def test_append_permutation_identity(self):
+        ops = OperationSequence(1)
+        ops.append_permutation(np.arange(8))
+        self.assertEqual(len(ops), 0)
+
+    def test_append_permutation_errors(self):
+        ops = OperationSequence(8)
+        with self.assertRaises(ValueError):
+            ops.append_permutation([0, 0, 1])
+        with self.assertRaises(ValueError):
+            ops.append_permutation([0, 3, 1])
+        self.assertEqual(len(ops), 0)
+
+        ops = OperationSequence(2)
+        with self.assertRaises(IndexError):
+            ops.append_permutation([1, 2, 3, 0])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,6 +1,8 @@
 import unittest
+from ctypes import addressof, sizeof
 from cabaliser import gates
 from cabaliser.operation_sequence import OperationSequence 
+from cabaliser.operations import OperationType
 from cabaliser.widget_sequence import WidgetSequence
 
 
@@ -15,6 +17,54 @@ class WidgetSequenceTest(unittest.TestCase):
     def test_large_qft(self):
         self.__test_qft(100, 2500)
 
+    def test_split_views(self):
+        qft_seq = qft(12)
+        ops = OperationSequence(len(qft_seq) + 8)
+        for opcode, args in qft_seq:
+            ops.append(opcode, *args)
+
+        rz_threshold = 7
+        sequences = ops.split(rz_threshold)
+
+        # Views cover every operation once, in order, without copying
+        self.assertEqual(sum(len(seq) for seq in sequences), ops.curr_instructions)
+        idx = 0
+        for seq in sequences:
+            self.assertEqual(addressof(seq.ops), addressof(ops.ops) + idx * sizeof(OperationType))
+            n_rz = 0
+            for op in seq:
+                self.assertEqual(op.single.opcode, ops[idx].single.opcode)
+                self.assertEqual(op.single.arg, ops[idx].single.arg)
+                n_rz += op.is_rz()
+                idx += 1
+            self.assertEqual(seq.n_rz_operations, n_rz)
+            self.assertLessEqual(n_rz, rz_threshold)
+        self.assertTrue(all(seq.n_rz_operations == rz_threshold for seq in sequences[:-1]))
+
+    def test_serial_matches_concurrent(self):
+        n_qubits = 8
+        qft_seq = qft(n_qubits)
+        ops = OperationSequence(len(qft_seq))
+        for opcode, args in qft_seq:
+            ops.append(opcode, *args)
+
+        # Python and c_lib splits place every boundary, including the last, at the same operation
+        for max_qubits in (2 * n_qubits + 1, 2 * n_qubits + 7, 2 * n_qubits + 5000):
+            widget_seq = WidgetSequence(n_qubits, max_qubits)
+            serial = widget_seq.widgetise_operation_sequence(ops, json_output=False)
+            concurrent = widget_seq.widgetise_operation_sequence(ops, json_output=False, n_threads=2)
+
+            self.assertEqual(len(serial), len(ops.split(widget_seq.rz_threshold)))
+            self.assertEqual(len(serial), len(concurrent))
+            for wid, wid_concurrent in zip(serial, concurrent):
+                self.assertEqual(wid.n_qubits, wid_concurrent.n_qubits)
+                self.assertEqual(list(wid.get_io_map()), list(wid_concurrent.get_io_map()))
+                for i in range(wid.n_qubits):
+                    self.assertEqual(
+                        wid.get_adjacencies(i).to_list(),
+                        wid_concurrent.get_adjacencies(i).to_list()
+                    )
+
     def __test_qft(self, n_qubits, max_qubits):
         qft_seq = qft(n_qubits)
         ops = OperationSequence(len(qft_seq))